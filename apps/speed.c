@@ -39,10 +39,14 @@
 #include <openssl/rand.h>
 #include <openssl/err.h>
 #include <openssl/evp.h>
+#include <openssl/kdf.h>
 #include <openssl/objects.h>
 #include <openssl/core_names.h>
 #include <openssl/async.h>
 #include <openssl/provider.h>
+#include <openssl/thread.h>
+#include <openssl/encoder.h>
+#include <openssl/decoder.h>
 #if !defined(OPENSSL_SYS_MSDOS)
 # include <unistd.h>
 #endif
@@ -551,8 +555,98 @@ static const OPT_PAIR eddsa_choices[EdDSA_NUM] = {
 
 };
 static double eddsa_results[EdDSA_NUM][2];    /* 2 ops: sign then verify */
+
+static const int eddsa_batch_sizes[] = {
+    8, 16, 32, 64, 128, 256, 512, 1024
+};
+# define EdDSA_BATCH_NUM OSSL_NELEM(eddsa_batch_sizes)
+# define EdDSA_BATCH_MAX 1024
+static double eddsa_batch_results[EdDSA_BATCH_NUM]; /* signatures verified */
+
+/* A batch of Ed25519 signatures on |buf|, each under its own key */
+typedef struct {
+    EVP_MD_CTX *ctx;
+    EVP_PKEY *pkeys[EdDSA_BATCH_MAX];
+    unsigned char sigbuf[EdDSA_BATCH_MAX][64];
+    const unsigned char *sigs[EdDSA_BATCH_MAX];
+    size_t siglens[EdDSA_BATCH_MAX];
+    const unsigned char *tbs[EdDSA_BATCH_MAX];
+    size_t tbslens[EdDSA_BATCH_MAX];
+    int results[EdDSA_BATCH_MAX];
+} eddsa_batch_t;
+
+static const int x25519_batch_sizes[] = {
+    1, 8, 32, 128
+};
+# define X25519_BATCH_NUM OSSL_NELEM(x25519_batch_sizes)
+# define X25519_BATCH_MAX 128
+static double x25519_batch_results[X25519_BATCH_NUM]; /* keys generated */
+#endif /* OPENSSL_NO_EC */
+
+static const int pbkdf2_keylens[] = {
+    32, 64, 128, 256
+};
+#define PBKDF2_NUM OSSL_NELEM(pbkdf2_keylens)
+#define PBKDF2_KEYLEN_MAX 256
+#define PBKDF2_ITER 1000
+static double pbkdf2_results[PBKDF2_NUM]; /* HMAC iterations */
+
+#ifndef OPENSSL_NO_SCRYPT
+/* N is fixed at 2^14 with r = 8, so each instance uses 16 MiB */
+static const struct {
+    unsigned int p, threads;
+} scrypt_params[] = {
+    { 1, 1 }, { 4, 1 }, { 4, 4 }
+};
+# define SCRYPT_NUM OSSL_NELEM(scrypt_params)
+# define SCRYPT_N 16384
+# define SCRYPT_R 8
+static double scrypt_results[SCRYPT_NUM]; /* derivations */
+#endif /* OPENSSL_NO_SCRYPT */
+
+/* The rows with two threads generate q on a thread of the library's pool */
+static const struct {
+    int bits;
+    unsigned int threads;
+} rsa_keygen_params[] = {
+    { 2048, 1 }, { 3072, 1 }, { 3072, 2 }, { 4096, 1 }, { 4096, 2 }
+};
+#define RSA_KEYGEN_NUM OSSL_NELEM(rsa_keygen_params)
+#define RSA_KEYGEN_SAMPLES 4096
+static double rsa_keygen_results[RSA_KEYGEN_NUM]; /* keys generated */
+/* Latencies of one run, then their median, 90th, 99th percentile and max */
+static double rsa_keygen_lat[RSA_KEYGEN_SAMPLES];
+static int rsa_keygen_nlat;
+static double rsa_keygen_pct[RSA_KEYGEN_NUM][4];
+
+#ifndef OPENSSL_NO_EC
+/* ECDSA over SHA-256 digests, with random and with RFC 6979 nonces */
+static const struct {
+    const char *name;
+    unsigned int bits;
+} detsign_curves[] = {
+    { "P-256", 256 }, { "P-384", 384 }, { "P-521", 521 }
+};
+# define DETSIGN_NUM OSSL_NELEM(detsign_curves)
+static double detsign_results[DETSIGN_NUM][2]; /* random, deterministic */
 #endif /* OPENSSL_NO_EC */
 
+/* Private keys decoded from DER with OSSL_DECODER_from_data() */
+static const struct {
+    const char *keytype;
+    const char *name;           /* RSA bits or EC curve */
+    const char *structure;
+} keyload_params[] = {
+    { "RSA", "2048", "type-specific" }, { "RSA", "2048", "PrivateKeyInfo" },
+    { "RSA", "4096", "type-specific" }, { "RSA", "4096", "PrivateKeyInfo" },
+#ifndef OPENSSL_NO_EC
+    { "EC", "P-256", "type-specific" }, { "EC", "P-256", "PrivateKeyInfo" },
+    { "EC", "P-384", "type-specific" }, { "EC", "P-384", "PrivateKeyInfo" },
+#endif /* OPENSSL_NO_EC */
+};
+#define KEYLOAD_NUM OSSL_NELEM(keyload_params)
+static double keyload_results[KEYLOAD_NUM]; /* keys decoded */
+
 #ifndef OPENSSL_NO_SM2
 enum { R_EC_CURVESM2, SM2_NUM };
 static const OPT_PAIR sm2_choices[SM2_NUM] = {
@@ -599,7 +693,22 @@ typedef struct loopargs_st {
 #ifndef OPENSSL_NO_EC
     EVP_MD_CTX *eddsa_ctx[EdDSA_NUM];
     EVP_MD_CTX *eddsa_ctx2[EdDSA_NUM];
+    eddsa_batch_t *eddsa_batch;
+    EVP_PKEY_CTX *x25519_gen_ctx;
+    EVP_PKEY *x25519_keys[X25519_BATCH_MAX];
+    EVP_PKEY_CTX *detsign_ctx;
 #endif /* OPENSSL_NO_EC */
+    EVP_KDF_CTX *pbkdf2_ctx;
+    unsigned char pbkdf2_key[PBKDF2_KEYLEN_MAX];
+    EVP_PKEY_CTX *rsa_gen_ctx;
+    OSSL_DECODER_CTX *keyload_ctx;
+    EVP_PKEY *keyload_pkey;
+    const unsigned char *keyload_der;
+    size_t keyload_derlen;
+#ifndef OPENSSL_NO_SCRYPT
+    EVP_KDF_CTX *scrypt_ctx;
+    unsigned char scrypt_key[64];
+#endif /* OPENSSL_NO_SCRYPT */
 #ifndef OPENSSL_NO_SM2
     EVP_MD_CTX *sm2_ctx[SM2_NUM];
     EVP_MD_CTX *sm2_vfy_ctx[SM2_NUM];
@@ -1101,6 +1210,85 @@ static int RSA_decrypt_loop(void *args)
     return count;
 }
 
+/*
+ * Times each key on the wall clock, to the resolution of the process timer,
+ * as latency rather than throughput is what a caller waiting for a key sees
+ */
+static int RSA_keygen_loop(void *args)
+{
+    loopargs_t *tempargs = *(loopargs_t **) args;
+    EVP_PKEY *pkey = NULL;
+    double last = app_tminterval(TM_STOP, 0), now;
+    int count;
+
+    for (count = 0; COND(0); count++) {
+        if (EVP_PKEY_keygen(tempargs->rsa_gen_ctx, &pkey) <= 0) {
+            BIO_printf(bio_err, "RSA keygen failure\n");
+            ERR_print_errors(bio_err);
+            count = -1;
+            break;
+        }
+        EVP_PKEY_free(pkey);
+        pkey = NULL;
+        now = app_tminterval(TM_STOP, 0);
+        if (rsa_keygen_nlat < RSA_KEYGEN_SAMPLES)
+            rsa_keygen_lat[rsa_keygen_nlat++] = now - last;
+        last = now;
+    }
+    return count;
+}
+
+static int rsa_keygen_lat_cmp(const void *a, const void *b)
+{
+    double x = *(const double *)a, y = *(const double *)b;
+
+    return x < y ? -1 : x > y;
+}
+
+static int KEYLOAD_loop(void *args)
+{
+    loopargs_t *tempargs = *(loopargs_t **) args;
+    const unsigned char *der;
+    size_t derlen;
+    int count;
+
+    for (count = 0; COND(0); count++) {
+        der = tempargs->keyload_der;
+        derlen = tempargs->keyload_derlen;
+        if (!OSSL_DECODER_from_data(tempargs->keyload_ctx, &der, &derlen)
+                || tempargs->keyload_pkey == NULL) {
+            BIO_printf(bio_err, "key decoding failure\n");
+            ERR_print_errors(bio_err);
+            count = -1;
+            break;
+        }
+        EVP_PKEY_free(tempargs->keyload_pkey);
+        tempargs->keyload_pkey = NULL;
+    }
+    return count;
+}
+
+#ifndef OPENSSL_NO_EC
+static int DETSIGN_loop(void *args)
+{
+    loopargs_t *tempargs = *(loopargs_t **) args;
+    size_t siglen;
+    int count;
+
+    for (count = 0; COND(0); count++) {
+        siglen = tempargs->buflen;
+        if (EVP_PKEY_sign(tempargs->detsign_ctx, tempargs->buf2, &siglen,
+                          tempargs->buf, 32) <= 0) {
+            BIO_printf(bio_err, "ECDSA sign failure\n");
+            ERR_print_errors(bio_err);
+            count = -1;
+            break;
+        }
+    }
+    return count;
+}
+#endif /* OPENSSL_NO_EC */
+
 #ifndef OPENSSL_NO_DH
 
 static int FFDH_derive_key_loop(void *args)
@@ -1279,6 +1467,131 @@ static int EdDSA_verify_loop(void *args)
     }
     return count;
 }
+
+static int EdDSA_verify_batch_loop(void *args)
+{
+    loopargs_t *tempargs = *(loopargs_t **) args;
+    eddsa_batch_t *batch = tempargs->eddsa_batch;
+    int ret, count;
+
+    for (count = 0; COND(0); count++) {
+        ret = EVP_DigestVerifyBatch(batch->ctx, eddsa_batch_sizes[testnum],
+                                    batch->pkeys, batch->sigs, batch->siglens,
+                                    batch->tbs, batch->tbslens,
+                                    batch->results);
+        if (ret != 1) {
+            BIO_printf(bio_err, "EdDSA batch verify failure\n");
+            ERR_print_errors(bio_err);
+            count = -1;
+            break;
+        }
+    }
+    return count;
+}
+
+static int X25519_keygen_batch_loop(void *args)
+{
+    loopargs_t *tempargs = *(loopargs_t **) args;
+    EVP_PKEY **keys = tempargs->x25519_keys;
+    int count, i, n = x25519_batch_sizes[testnum];
+
+    for (count = 0; COND(0); count++) {
+        if (EVP_PKEY_generate_batch(tempargs->x25519_gen_ctx, keys, n) <= 0) {
+            BIO_printf(bio_err, "X25519 batch keygen failure\n");
+            ERR_print_errors(bio_err);
+            count = -1;
+            break;
+        }
+        for (i = 0; i < n; i++)
+            EVP_PKEY_free(keys[i]);
+    }
+    return count;
+}
+
+static int PBKDF2_loop(void *args)
+{
+    loopargs_t *tempargs = *(loopargs_t **) args;
+    int count;
+
+    for (count = 0; COND(0); count++) {
+        if (EVP_KDF_derive(tempargs->pbkdf2_ctx, tempargs->pbkdf2_key,
+                           pbkdf2_keylens[testnum], NULL) <= 0) {
+            BIO_printf(bio_err, "PBKDF2 derive failure\n");
+            ERR_print_errors(bio_err);
+            count = -1;
+            break;
+        }
+    }
+    return count;
+}
+
+#ifndef OPENSSL_NO_SCRYPT
+static int SCRYPT_loop(void *args)
+{
+    loopargs_t *tempargs = *(loopargs_t **) args;
+    int count;
+
+    for (count = 0; COND(0); count++) {
+        if (EVP_KDF_derive(tempargs->scrypt_ctx, tempargs->scrypt_key,
+                           sizeof(tempargs->scrypt_key), NULL) <= 0) {
+            BIO_printf(bio_err, "scrypt derive failure\n");
+            ERR_print_errors(bio_err);
+            count = -1;
+            break;
+        }
+    }
+    return count;
+}
+#endif /* OPENSSL_NO_SCRYPT */
+
+static void eddsa_batch_free(eddsa_batch_t *batch)
+{
+    int i;
+
+    if (batch == NULL)
+        return;
+    EVP_MD_CTX_free(batch->ctx);
+    for (i = 0; i < EdDSA_BATCH_MAX; i++)
+        EVP_PKEY_free(batch->pkeys[i]);
+    OPENSSL_free(batch);
+}
+
+static eddsa_batch_t *eddsa_batch_new(const unsigned char *buf)
+{
+    eddsa_batch_t *batch = app_malloc(sizeof(*batch), "EdDSA batch");
+    EVP_MD_CTX *sign_ctx = NULL;
+    int i;
+
+    memset(batch, 0, sizeof(*batch));
+    if ((batch->ctx = EVP_MD_CTX_new()) == NULL)
+        goto err;
+    for (i = 0; i < EdDSA_BATCH_MAX; i++) {
+        EVP_MD_CTX_free(sign_ctx);
+        if ((sign_ctx = EVP_MD_CTX_new()) == NULL)
+            goto err;
+        batch->sigs[i] = batch->sigbuf[i];
+        batch->siglens[i] = sizeof(batch->sigbuf[i]);
+        batch->tbs[i] = buf;
+        batch->tbslens[i] = 20;
+        if ((batch->pkeys[i] = EVP_PKEY_Q_keygen(app_get0_libctx(),
+                                                 app_get0_propq(),
+                                                 "ED25519")) == NULL
+                || !EVP_DigestSignInit(sign_ctx, NULL, NULL, NULL,
+                                       batch->pkeys[i])
+                || !EVP_DigestSign(sign_ctx, batch->sigbuf[i],
+                                   &batch->siglens[i], buf, 20))
+            goto err;
+    }
+    if (!EVP_DigestVerifyInit(batch->ctx, NULL, NULL, NULL, batch->pkeys[0]))
+        goto err;
+    EVP_MD_CTX_free(sign_ctx);
+    return batch;
+
+ err:
+    EVP_MD_CTX_free(sign_ctx);
+    eddsa_batch_free(batch);
+    return NULL;
+}
 #endif /* OPENSSL_NO_EC */
 
 #ifndef OPENSSL_NO_SM2
@@ -1923,7 +2236,18 @@ int speed_main(int argc, char **argv)
     uint8_t ecdh_doit[EC_NUM] = { 0 };
 #ifndef OPENSSL_NO_EC
     uint8_t eddsa_doit[EdDSA_NUM] = { 0 };
+    uint8_t eddsa_batch_doit = 0;
+    uint8_t x25519_batch_doit = 0;
+#endif /* OPENSSL_NO_EC */
+    uint8_t pbkdf2_doit = 0;
+#ifndef OPENSSL_NO_SCRYPT
+    uint8_t scrypt_doit = 0;
+#endif /* OPENSSL_NO_SCRYPT */
+    uint8_t rsa_keygen_doit = 0;
+#ifndef OPENSSL_NO_EC
+    uint8_t detsign_doit = 0;
 #endif /* OPENSSL_NO_EC */
+    uint8_t keyload_doit = 0;
 
     uint8_t kems_doit[MAX_KEM_NUM] = { 0 };
     uint8_t sigs_doit[MAX_SIG_NUM] = { 0 };
@@ -2298,6 +2622,38 @@ int speed_main(int argc, char **argv)
             eddsa_doit[i] = 2;
             algo_found = 1;
         }
+        if (strcmp(algo, "ed25519batch") == 0) {
+            eddsa_batch_doit = 1;
+            algo_found = 1;
+        }
+        if (strcmp(algo, "x25519batch") == 0) {
+            x25519_batch_doit = 1;
+            algo_found = 1;
+        }
+#endif /* OPENSSL_NO_EC */
+        if (strcmp(algo, "pbkdf2") == 0) {
+            pbkdf2_doit = 1;
+            algo_found = 1;
+        }
+#ifndef OPENSSL_NO_SCRYPT
+        if (strcmp(algo, "scrypt") == 0) {
+            scrypt_doit = 1;
+            algo_found = 1;
+        }
+#endif /* OPENSSL_NO_SCRYPT */
+        if (strcmp(algo, "rsakeygen") == 0) {
+            rsa_keygen_doit = 1;
+            algo_found = 1;
+        }
+        if (strcmp(algo, "keyload") == 0) {
+            keyload_doit = 1;
+            algo_found = 1;
+        }
+#ifndef OPENSSL_NO_EC
+        if (strcmp(algo, "detsign") == 0) {
+            detsign_doit = 1;
+            algo_found = 1;
+        }
 #endif /* OPENSSL_NO_EC */
 #ifndef OPENSSL_NO_SM2
         if (strcmp(algo, "sm2") == 0) {
@@ -3489,8 +3845,389 @@ int speed_main(int argc, char **argv)
             }
         }
     }
+
+    if (eddsa_batch_doit) {
+        int st = 1;
+
+        for (i = 0; i < loopargs_len; i++) {
+            loopargs[i].eddsa_batch = eddsa_batch_new(loopargs[i].buf);
+            if (loopargs[i].eddsa_batch == NULL) {
+                st = 0;
+                break;
+            }
+        }
+        if (st == 0) {
+            BIO_printf(bio_err, "EdDSA batch failure.\n");
+            ERR_print_errors(bio_err);
+            eddsa_batch_doit = 0;
+        }
+        for (testnum = 0; eddsa_batch_doit && testnum < EdDSA_BATCH_NUM;
+             testnum++) {
+            char name[32];
+
+            BIO_snprintf(name, sizeof(name), "Ed25519 batch of %d",
+                         eddsa_batch_sizes[testnum]);
+            pkey_print_message("verify", name, 253, seconds.eddsa);
+            Time_F(START);
+            count = run_benchmark(async_jobs, EdDSA_verify_batch_loop,
+                                  loopargs);
+            d = Time_F(STOP);
+            BIO_printf(bio_err,
+                       mr ? "+R21:%ld:%d:%.2f\n"
+                       : "%ld batches of %d verify ops in %.2fs\n",
+                       count, eddsa_batch_sizes[testnum], d);
+            if (count < 0) {
+                eddsa_batch_doit = 0;
+                break;
+            }
+            eddsa_batch_results[testnum] =
+                (double)count * eddsa_batch_sizes[testnum] / d;
+        }
+    }
+
+    if (x25519_batch_doit) {
+        int st = 1;
+
+        for (i = 0; i < loopargs_len; i++) {
+            EVP_PKEY_CTX *ctx = EVP_PKEY_CTX_new_from_name(app_get0_libctx(),
+                                                           "X25519",
+                                                           app_get0_propq());
+
+            loopargs[i].x25519_gen_ctx = ctx;
+            if (ctx == NULL || EVP_PKEY_keygen_init(ctx) <= 0) {
+                st = 0;
+                break;
+            }
+        }
+        if (st == 0) {
+            BIO_printf(bio_err, "X25519 batch failure.\n");
+            ERR_print_errors(bio_err);
+            x25519_batch_doit = 0;
+        }
+        for (testnum = 0; x25519_batch_doit && testnum < X25519_BATCH_NUM;
+             testnum++) {
+            char name[32];
+
+            BIO_snprintf(name, sizeof(name), "X25519 batch of %d",
+                         x25519_batch_sizes[testnum]);
+            pkey_print_message("keygen", name, 253, seconds.ecdh);
+            Time_F(START);
+            count = run_benchmark(async_jobs, X25519_keygen_batch_loop,
+                                  loopargs);
+            d = Time_F(STOP);
+            BIO_printf(bio_err,
+                       mr ? "+R22:%ld:%d:%.2f\n"
+                       : "%ld batches of %d keygen ops in %.2fs\n",
+                       count, x25519_batch_sizes[testnum], d);
+            if (count < 0) {
+                x25519_batch_doit = 0;
+                break;
+            }
+            x25519_batch_results[testnum] =
+                (double)count * x25519_batch_sizes[testnum] / d;
+        }
+    }
 #endif /* OPENSSL_NO_EC */
 
+    if (pbkdf2_doit) {
+        EVP_KDF *kdf = EVP_KDF_fetch(app_get0_libctx(), "PBKDF2",
+                                     app_get0_propq());
+        unsigned int iter = PBKDF2_ITER;
+        OSSL_PARAM params[5];
+        int st = kdf != NULL;
+
+        params[0] = OSSL_PARAM_construct_octet_string(OSSL_KDF_PARAM_PASSWORD,
+                                                      "password", 8);
+        params[1] = OSSL_PARAM_construct_octet_string(OSSL_KDF_PARAM_SALT,
+                                                      "saltSALTsaltSALT", 16);
+        params[2] = OSSL_PARAM_construct_uint(OSSL_KDF_PARAM_ITER, &iter);
+        params[3] = OSSL_PARAM_construct_utf8_string(OSSL_KDF_PARAM_DIGEST,
+                                                     "SHA256", 0);
+        params[4] = OSSL_PARAM_construct_end();
+        for (i = 0; st && i < loopargs_len; i++) {
+            loopargs[i].pbkdf2_ctx = EVP_KDF_CTX_new(kdf);
+            if (loopargs[i].pbkdf2_ctx == NULL
+                    || EVP_KDF_CTX_set_params(loopargs[i].pbkdf2_ctx,
+                                              params) <= 0)
+                st = 0;
+        }
+        EVP_KDF_free(kdf);
+        if (st == 0) {
+            BIO_printf(bio_err, "PBKDF2 failure.\n");
+            ERR_print_errors(bio_err);
+            pbkdf2_doit = 0;
+        }
+        for (testnum = 0; pbkdf2_doit && testnum < PBKDF2_NUM; testnum++) {
+            char name[32];
+
+            BIO_snprintf(name, sizeof(name), "%d-byte key",
+                         pbkdf2_keylens[testnum]);
+            kskey_print_message("PBKDF2-SHA256", name, seconds.sym);
+            Time_F(START);
+            count = run_benchmark(async_jobs, PBKDF2_loop, loopargs);
+            d = Time_F(STOP);
+            BIO_printf(bio_err,
+                       mr ? "+R23:%ld:%d:%.2f\n"
+                       : "%ld %d-byte PBKDF2 derivations in %.2fs\n",
+                       count, pbkdf2_keylens[testnum], d);
+            if (count < 0) {
+                pbkdf2_doit = 0;
+                break;
+            }
+            /* Each output block of the hash size takes its own iterations */
+            pbkdf2_results[testnum] = (double)count * PBKDF2_ITER
+                * ((pbkdf2_keylens[testnum] + 31) / 32) / d;
+        }
+    }
+
+#ifndef OPENSSL_NO_SCRYPT
+    if (scrypt_doit) {
+        EVP_KDF *kdf = EVP_KDF_fetch(app_get0_libctx(), "SCRYPT",
+                                     app_get0_propq());
+        int st = kdf != NULL;
+
+        for (i = 0; st && i < loopargs_len; i++) {
+            loopargs[i].scrypt_ctx = EVP_KDF_CTX_new(kdf);
+            if (loopargs[i].scrypt_ctx == NULL)
+                st = 0;
+        }
+        EVP_KDF_free(kdf);
+        if (st == 0) {
+            BIO_printf(bio_err, "scrypt failure.\n");
+            ERR_print_errors(bio_err);
+            scrypt_doit = 0;
+        }
+        for (testnum = 0; scrypt_doit && testnum < SCRYPT_NUM; testnum++) {
+            uint64_t n = SCRYPT_N;
+            unsigned int r = SCRYPT_R;
+            unsigned int p = scrypt_params[testnum].p;
+            unsigned int threads = scrypt_params[testnum].threads;
+            OSSL_PARAM params[7];
+            char name[32];
+
+            params[0] = OSSL_PARAM_construct_octet_string(OSSL_KDF_PARAM_PASSWORD,
+                                                          "password", 8);
+            params[1] = OSSL_PARAM_construct_octet_string(OSSL_KDF_PARAM_SALT,
+                                                          "saltSALTsaltSALT",
+                                                          16);
+            params[2] = OSSL_PARAM_construct_uint64(OSSL_KDF_PARAM_SCRYPT_N,
+                                                    &n);
+            params[3] = OSSL_PARAM_construct_uint(OSSL_KDF_PARAM_SCRYPT_R, &r);
+            params[4] = OSSL_PARAM_construct_uint(OSSL_KDF_PARAM_SCRYPT_P, &p);
+            params[5] = OSSL_PARAM_construct_uint(OSSL_KDF_PARAM_THREADS,
+                                                  &threads);
+            params[6] = OSSL_PARAM_construct_end();
+            /*
+             * The threaded rows need the library's thread pool; without one
+             * they run on a single thread
+             */
+            if (threads > 1)
+                OSSL_set_max_threads(app_get0_libctx(),
+                                     (uint64_t)threads * loopargs_len);
+            for (i = 0; st && i < loopargs_len; i++)
+                if (EVP_KDF_CTX_set_params(loopargs[i].scrypt_ctx,
+                                           params) <= 0)
+                    st = 0;
+            if (st == 0) {
+                BIO_printf(bio_err, "scrypt failure.\n");
+                ERR_print_errors(bio_err);
+                scrypt_doit = 0;
+                break;
+            }
+
+            BIO_snprintf(name, sizeof(name), "p=%u %u thread%s", p, threads,
+                         threads > 1 ? "s" : "");
+            kskey_print_message("scrypt", name, seconds.sym);
+            Time_F(START);
+            count = run_benchmark(async_jobs, SCRYPT_loop, loopargs);
+            d = Time_F(STOP);
+            BIO_printf(bio_err,
+                       mr ? "+R24:%ld:%u:%u:%.2f\n"
+                       : "%ld scrypt p=%u derivations on %u threads in %.2fs\n",
+                       count, p, threads, d);
+            if (count < 0) {
+                scrypt_doit = 0;
+                break;
+            }
+            scrypt_results[testnum] = (double)count / d;
+        }
+        OSSL_set_max_threads(app_get0_libctx(), 0);
+    }
+#endif /* OPENSSL_NO_SCRYPT */
+
+    for (testnum = 0; rsa_keygen_doit && testnum < RSA_KEYGEN_NUM; testnum++) {
+        int bits = rsa_keygen_params[testnum].bits;
+        unsigned int threads = rsa_keygen_params[testnum].threads;
+        int st = 1, n;
+        char name[32];
+
+        if (threads > 1)
+            OSSL_set_max_threads(app_get0_libctx(),
+                                 (uint64_t)(threads - 1) * loopargs_len);
+        for (i = 0; st && i < loopargs_len; i++) {
+            EVP_PKEY_CTX_free(loopargs[i].rsa_gen_ctx);
+            loopargs[i].rsa_gen_ctx =
+                EVP_PKEY_CTX_new_from_name(app_get0_libctx(), "RSA",
+                                           app_get0_propq());
+            if (loopargs[i].rsa_gen_ctx == NULL
+                    || EVP_PKEY_keygen_init(loopargs[i].rsa_gen_ctx) <= 0
+                    || EVP_PKEY_CTX_set_rsa_keygen_bits(loopargs[i].rsa_gen_ctx,
+                                                        bits) <= 0)
+                st = 0;
+        }
+        if (st == 0) {
+            BIO_printf(bio_err, "RSA keygen failure.\n");
+            ERR_print_errors(bio_err);
+            rsa_keygen_doit = 0;
+            break;
+        }
+
+        BIO_snprintf(name, sizeof(name), "%u thread%s", threads,
+                     threads > 1 ? "s" : "");
+        pkey_print_message("RSA keygen", name, bits, seconds.rsa);
+        rsa_keygen_nlat = 0;
+        Time_F(START);
+        count = run_benchmark(async_jobs, RSA_keygen_loop, loopargs);
+        d = Time_F(STOP);
+        BIO_printf(bio_err,
+                   mr ? "+R25:%ld:%d:%u:%.2f\n"
+                   : "%ld %d bits RSA keys generated on %u threads in %.2fs\n",
+                   count, bits, threads, d);
+        OSSL_set_max_threads(app_get0_libctx(), 0);
+        if (count < 0) {
+            rsa_keygen_doit = 0;
+            break;
+        }
+        rsa_keygen_results[testnum] = (double)count / d;
+        if ((n = rsa_keygen_nlat) > 0) {
+            qsort(rsa_keygen_lat, n, sizeof(*rsa_keygen_lat),
+                  rsa_keygen_lat_cmp);
+            rsa_keygen_pct[testnum][0] = rsa_keygen_lat[n / 2];
+            rsa_keygen_pct[testnum][1] = rsa_keygen_lat[n * 9 / 10];
+            rsa_keygen_pct[testnum][2] = rsa_keygen_lat[n * 99 / 100];
+            rsa_keygen_pct[testnum][3] = rsa_keygen_lat[n - 1];
+        }
+    }
+
+#ifndef OPENSSL_NO_EC
+    for (testnum = 0; detsign_doit && testnum < DETSIGN_NUM; testnum++) {
+        EVP_PKEY *pkey = EVP_PKEY_Q_keygen(app_get0_libctx(), app_get0_propq(),
+                                           "EC", detsign_curves[testnum].name);
+        unsigned int nonce_type;
+        int st = pkey != NULL;
+
+        for (nonce_type = 0; st && nonce_type < 2; nonce_type++) {
+            OSSL_PARAM params[2];
+
+            params[0] = OSSL_PARAM_construct_uint(OSSL_SIGNATURE_PARAM_NONCE_TYPE,
+                                                  &nonce_type);
+            params[1] = OSSL_PARAM_construct_end();
+            for (i = 0; st && i < loopargs_len; i++) {
+                EVP_PKEY_CTX_free(loopargs[i].detsign_ctx);
+                loopargs[i].detsign_ctx =
+                    EVP_PKEY_CTX_new_from_pkey(app_get0_libctx(), pkey,
+                                               app_get0_propq());
+                if (loopargs[i].detsign_ctx == NULL
+                        || EVP_PKEY_sign_init_ex(loopargs[i].detsign_ctx,
+                                                 params) <= 0
+                        || EVP_PKEY_CTX_set_signature_md(loopargs[i].detsign_ctx,
+                                                         EVP_sha256()) <= 0)
+                    st = 0;
+            }
+            if (st == 0)
+                break;
+
+            pkey_print_message(nonce_type ? "deterministic sign" : "sign",
+                               detsign_curves[testnum].name,
+                               detsign_curves[testnum].bits, seconds.ecdsa);
+            Time_F(START);
+            count = run_benchmark(async_jobs, DETSIGN_loop, loopargs);
+            d = Time_F(STOP);
+            BIO_printf(bio_err,
+                       mr ? "+R26:%ld:%u:%u:%.2f\n"
+                       : "%ld %u bits ECDSA signs with nonce type %u in %.2fs\n",
+                       count, detsign_curves[testnum].bits, nonce_type, d);
+            if (count < 0)
+                st = 0;
+            else
+                detsign_results[testnum][nonce_type] = (double)count / d;
+        }
+        EVP_PKEY_free(pkey);
+        if (st == 0) {
+            BIO_printf(bio_err, "ECDSA deterministic sign failure.\n");
+            ERR_print_errors(bio_err);
+            detsign_doit = 0;
+        }
+    }
+#endif /* OPENSSL_NO_EC */
+
+    for (testnum = 0; keyload_doit && testnum < KEYLOAD_NUM; testnum++) {
+        const char *keytype = keyload_params[testnum].keytype;
+        const char *structure = keyload_params[testnum].structure;
+        EVP_PKEY *pkey;
+        OSSL_ENCODER_CTX *ectx = NULL;
+        unsigned char *der = NULL;
+        size_t derlen = 0;
+        int st;
+        char name[32];
+
+        if (strcmp(keytype, "RSA") == 0)
+            pkey = EVP_PKEY_Q_keygen(app_get0_libctx(), app_get0_propq(),
+                                     keytype,
+                                     (size_t)atoi(keyload_params[testnum].name));
+        else
+            pkey = EVP_PKEY_Q_keygen(app_get0_libctx(), app_get0_propq(),
+                                     keytype, keyload_params[testnum].name);
+        st = pkey != NULL
+             && (ectx = OSSL_ENCODER_CTX_new_for_pkey(pkey, EVP_PKEY_KEYPAIR,
+                                                      "DER", structure,
+                                                      app_get0_propq())) != NULL
+             && OSSL_ENCODER_to_data(ectx, &der, &derlen);
+        OSSL_ENCODER_CTX_free(ectx);
+        EVP_PKEY_free(pkey);
+        for (i = 0; st && i < loopargs_len; i++) {
+            OSSL_DECODER_CTX_free(loopargs[i].keyload_ctx);
+            loopargs[i].keyload_ctx =
+                OSSL_DECODER_CTX_new_for_pkey(&loopargs[i].keyload_pkey, "DER",
+                                              structure, keytype,
+                                              EVP_PKEY_KEYPAIR,
+                                              app_get0_libctx(),
+                                              app_get0_propq());
+            loopargs[i].keyload_der = der;
+            loopargs[i].keyload_derlen = derlen;
+            if (loopargs[i].keyload_ctx == NULL)
+                st = 0;
+        }
+        if (st == 0) {
+            BIO_printf(bio_err, "Key decoding failure.\n");
+            ERR_print_errors(bio_err);
+            OPENSSL_free(der);
+            keyload_doit = 0;
+            break;
+        }
+
+        BIO_snprintf(name, sizeof(name), "%s %s", keytype,
+                     keyload_params[testnum].name);
+        kskey_print_message("decode", name, seconds.sym);
+        Time_F(START);
+        count = run_benchmark(async_jobs, KEYLOAD_loop, loopargs);
+        d = Time_F(STOP);
+        BIO_printf(bio_err,
+                   mr ? "+R27:%ld:%s:%s:%.2f\n"
+                   : "%ld %s %s keys decoded in %.2fs\n",
+                   count, name, structure, d);
+        for (i = 0; i < loopargs_len; i++) {
+            loopargs[i].keyload_der = NULL;
+            loopargs[i].keyload_derlen = 0;
+        }
+        OPENSSL_free(der);
+        if (count < 0) {
+            keyload_doit = 0;
+            break;
+        }
+        keyload_results[testnum] = (double)count / d;
+    }
+
 #ifndef OPENSSL_NO_SM2
     for (testnum = 0; testnum < SM2_NUM; testnum++) {
         int st = 1;
@@ -4319,6 +5056,129 @@ int speed_main(int argc, char **argv)
                    1.0 / eddsa_results[k][0], 1.0 / eddsa_results[k][1],
                    eddsa_results[k][0], eddsa_results[k][1]);
     }
+
+    testnum = 1;
+    for (k = 0; eddsa_batch_doit && k < EdDSA_BATCH_NUM; k++) {
+        if (testnum && !mr) {
+            printf("%36sverify verify/s\n", " ");
+            testnum = 0;
+        }
+
+        if (mr)
+            printf("+F11:%u:%d:%f\n",
+                   k, eddsa_batch_sizes[k], eddsa_batch_results[k]);
+        else
+            printf("Ed25519 batch of %4d signatures %8.6fs %8.1f\n",
+                   eddsa_batch_sizes[k], 1.0 / eddsa_batch_results[k],
+                   eddsa_batch_results[k]);
+    }
+
+    testnum = 1;
+    for (k = 0; x25519_batch_doit && k < X25519_BATCH_NUM; k++) {
+        if (testnum && !mr) {
+            printf("%36skeygen keygen/s\n", " ");
+            testnum = 0;
+        }
+
+        if (mr)
+            printf("+F12:%u:%d:%f\n",
+                   k, x25519_batch_sizes[k], x25519_batch_results[k]);
+        else
+            printf("X25519 batch of %4d keys       %8.6fs %8.1f\n",
+                   x25519_batch_sizes[k], 1.0 / x25519_batch_results[k],
+                   x25519_batch_results[k]);
+    }
+#endif /* OPENSSL_NO_EC */
+
+    testnum = 1;
+    for (k = 0; pbkdf2_doit && k < PBKDF2_NUM; k++) {
+        if (testnum && !mr) {
+            printf("%36siteration iterations/s\n", " ");
+            testnum = 0;
+        }
+
+        if (mr)
+            printf("+F13:%u:%d:%f\n",
+                   k, pbkdf2_keylens[k], pbkdf2_results[k]);
+        else
+            printf("PBKDF2-SHA256 %3d-byte key       %8.3fns %10.1f\n",
+                   pbkdf2_keylens[k], 1e9 / pbkdf2_results[k],
+                   pbkdf2_results[k]);
+    }
+
+#ifndef OPENSSL_NO_SCRYPT
+    testnum = 1;
+    for (k = 0; scrypt_doit && k < SCRYPT_NUM; k++) {
+        if (testnum && !mr) {
+            printf("%36sderive    derive/s\n", " ");
+            testnum = 0;
+        }
+
+        if (mr)
+            printf("+F14:%u:%u:%u:%f\n", k, scrypt_params[k].p,
+                   scrypt_params[k].threads, scrypt_results[k]);
+        else
+            printf("scrypt N=%d p=%u %u thread%s      %8.4fs %8.1f\n",
+                   SCRYPT_N, scrypt_params[k].p, scrypt_params[k].threads,
+                   scrypt_params[k].threads > 1 ? "s" : " ",
+                   1.0 / scrypt_results[k], scrypt_results[k]);
+    }
+#endif /* OPENSSL_NO_SCRYPT */
+
+    testnum = 1;
+    for (k = 0; rsa_keygen_doit && k < RSA_KEYGEN_NUM; k++) {
+        if (testnum && !mr) {
+            printf("%30skeygen/s   median      p90      p99      max\n", " ");
+            testnum = 0;
+        }
+
+        if (mr)
+            printf("+F15:%u:%d:%u:%f\n", k, rsa_keygen_params[k].bits,
+                   rsa_keygen_params[k].threads, rsa_keygen_results[k]);
+        else
+            printf("RSA keygen %4d bits %u thread%s %8.2f %7.3fs %7.3fs %7.3fs %7.3fs\n",
+                   rsa_keygen_params[k].bits, rsa_keygen_params[k].threads,
+                   rsa_keygen_params[k].threads > 1 ? "s" : " ",
+                   rsa_keygen_results[k], rsa_keygen_pct[k][0],
+                   rsa_keygen_pct[k][1], rsa_keygen_pct[k][2],
+                   rsa_keygen_pct[k][3]);
+    }
+
+    testnum = 1;
+    for (k = 0; keyload_doit && k < KEYLOAD_NUM; k++) {
+        if (testnum && !mr) {
+            printf("%31sdecode  decode/s\n", " ");
+            testnum = 0;
+        }
+
+        if (mr)
+            printf("+F17:%u:%s:%s:%s:%f\n", k, keyload_params[k].keytype,
+                   keyload_params[k].name, keyload_params[k].structure,
+                   keyload_results[k]);
+        else
+            printf("%-3s %-5s %-14s     %8.6fs %9.1f\n",
+                   keyload_params[k].keytype, keyload_params[k].name,
+                   keyload_params[k].structure,
+                   1.0 / keyload_results[k], keyload_results[k]);
+    }
+
+#ifndef OPENSSL_NO_EC
+    testnum = 1;
+    for (k = 0; detsign_doit && k < DETSIGN_NUM; k++) {
+        if (testnum && !mr) {
+            printf("%32srandom  determ. random/s determ./s\n", " ");
+            testnum = 0;
+        }
+
+        if (mr)
+            printf("+F16:%u:%u:%f:%f\n", k, detsign_curves[k].bits,
+                   detsign_results[k][0], detsign_results[k][1]);
+        else
+            printf("%4u bits ecdsa sign (%s) %8.4fs %8.4fs %8.1f %8.1f\n",
+                   detsign_curves[k].bits, detsign_curves[k].name,
+                   1.0 / detsign_results[k][0], 1.0 / detsign_results[k][1],
+                   detsign_results[k][0], detsign_results[k][1]);
+    }
 #endif /* OPENSSL_NO_EC */
 
 #ifndef OPENSSL_NO_SM2
@@ -4442,7 +5302,17 @@ int speed_main(int argc, char **argv)
             EVP_MD_CTX_free(loopargs[i].eddsa_ctx[k]);
             EVP_MD_CTX_free(loopargs[i].eddsa_ctx2[k]);
         }
+        eddsa_batch_free(loopargs[i].eddsa_batch);
+        EVP_PKEY_CTX_free(loopargs[i].x25519_gen_ctx);
+        EVP_PKEY_CTX_free(loopargs[i].detsign_ctx);
 #endif /* OPENSSL_NO_EC */
+        EVP_KDF_CTX_free(loopargs[i].pbkdf2_ctx);
+#ifndef OPENSSL_NO_SCRYPT
+        EVP_KDF_CTX_free(loopargs[i].scrypt_ctx);
+#endif /* OPENSSL_NO_SCRYPT */
+        EVP_PKEY_CTX_free(loopargs[i].rsa_gen_ctx);
+        OSSL_DECODER_CTX_free(loopargs[i].keyload_ctx);
+        EVP_PKEY_free(loopargs[i].keyload_pkey);
 #ifndef OPENSSL_NO_SM2
         for (k = 0; k < SM2_NUM; k++) {
             EVP_PKEY_CTX *pctx = NULL;
@@ -4722,7 +5592,74 @@ static int do_multi(int multi, int size_num)
                     d = atof(sstrsep(&p, sep));
                     eddsa_results[k][1] += d;
                 }
+            } else if (CHECK_AND_SKIP_PREFIX(p, "+F11:")) {
+                tk = sstrsep(&p, sep);
+                if (strtoint(tk, 0, OSSL_NELEM(eddsa_batch_results), &k)) {
+                    sstrsep(&p, sep);
+
+                    d = atof(sstrsep(&p, sep));
+                    eddsa_batch_results[k] += d;
+                }
+            } else if (CHECK_AND_SKIP_PREFIX(p, "+F12:")) {
+                tk = sstrsep(&p, sep);
+                if (strtoint(tk, 0, OSSL_NELEM(x25519_batch_results), &k)) {
+                    sstrsep(&p, sep);
+
+                    d = atof(sstrsep(&p, sep));
+                    x25519_batch_results[k] += d;
+                }
+# endif /* OPENSSL_NO_EC */
+            } else if (CHECK_AND_SKIP_PREFIX(p, "+F13:")) {
+                tk = sstrsep(&p, sep);
+                if (strtoint(tk, 0, OSSL_NELEM(pbkdf2_results), &k)) {
+                    sstrsep(&p, sep);
+
+                    d = atof(sstrsep(&p, sep));
+                    pbkdf2_results[k] += d;
+                }
+# ifndef OPENSSL_NO_SCRYPT
+            } else if (CHECK_AND_SKIP_PREFIX(p, "+F14:")) {
+                tk = sstrsep(&p, sep);
+                if (strtoint(tk, 0, OSSL_NELEM(scrypt_results), &k)) {
+                    sstrsep(&p, sep);
+                    sstrsep(&p, sep);
+
+                    d = atof(sstrsep(&p, sep));
+                    scrypt_results[k] += d;
+                }
+# endif /* OPENSSL_NO_SCRYPT */
+            } else if (CHECK_AND_SKIP_PREFIX(p, "+F15:")) {
+                tk = sstrsep(&p, sep);
+                if (strtoint(tk, 0, OSSL_NELEM(rsa_keygen_results), &k)) {
+                    sstrsep(&p, sep);
+                    sstrsep(&p, sep);
+
+                    d = atof(sstrsep(&p, sep));
+                    rsa_keygen_results[k] += d;
+                }
+# ifndef OPENSSL_NO_EC
+            } else if (CHECK_AND_SKIP_PREFIX(p, "+F16:")) {
+                tk = sstrsep(&p, sep);
+                if (strtoint(tk, 0, OSSL_NELEM(detsign_results), &k)) {
+                    sstrsep(&p, sep);
+
+                    d = atof(sstrsep(&p, sep));
+                    detsign_results[k][0] += d;
+
+                    d = atof(sstrsep(&p, sep));
+                    detsign_results[k][1] += d;
+                }
 # endif /* OPENSSL_NO_EC */
+            } else if (CHECK_AND_SKIP_PREFIX(p, "+F17:")) {
+                tk = sstrsep(&p, sep);
+                if (strtoint(tk, 0, OSSL_NELEM(keyload_results), &k)) {
+                    sstrsep(&p, sep);
+                    sstrsep(&p, sep);
+                    sstrsep(&p, sep);
+
+                    d = atof(sstrsep(&p, sep));
+                    keyload_results[k] += d;
+                }
 # ifndef OPENSSL_NO_SM2
             } else if (CHECK_AND_SKIP_PREFIX(p, "+F7:")) {
                 tk = sstrsep(&p, sep);
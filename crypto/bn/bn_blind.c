@@ -20,6 +20,7 @@ struct bn_blinding_st {
     BIGNUM *mod;                /* just a reference */
     CRYPTO_THREAD_ID tid;
     int counter;
+    int prepared;               /* updated ahead of its next use */
     unsigned long flags;
     BN_MONT_CTX *m_ctx;
     int (*bn_mod_exp) (BIGNUM *r, const BIGNUM *a, const BIGNUM *p,
@@ -143,6 +144,9 @@ int BN_BLINDING_convert_ex(BIGNUM *n, BIGNUM *r, BN_BLINDING *b, BN_CTX *ctx)
     if (b->counter == -1)
         /* Fresh blinding, doesn't need updating. */
         b->counter = 0;
+    else if (b->prepared)
+        /* Already updated by ossl_bn_blinding_prepare(). */
+        b->prepared = 0;
     else if (!BN_BLINDING_update(b, ctx))
         return 0;
 
@@ -157,6 +161,21 @@ int BN_BLINDING_convert_ex(BIGNUM *n, BIGNUM *r, BN_BLINDING *b, BN_CTX *ctx)
     return ret;
 }
 
+/*
+ * Does the update that the next BN_BLINDING_convert_ex() would otherwise do
+ * first, so that a blinding can be made ready for its next use at a time
+ * that suits the caller, e.g. before handing it back to a pool.
+ */
+int ossl_bn_blinding_prepare(BN_BLINDING *b, BN_CTX *ctx)
+{
+    if (b->counter == -1 || b->prepared)
+        return 1;
+    if (!BN_BLINDING_update(b, ctx))
+        return 0;
+    b->prepared = 1;
+    return 1;
+}
+
 int BN_BLINDING_invert(BIGNUM *n, BN_BLINDING *b, BN_CTX *ctx)
 {
     return BN_BLINDING_invert_ex(n, NULL, b, ctx);
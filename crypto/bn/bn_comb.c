@@ -0,0 +1,216 @@
+/*
+ * Copyright 2024 The OpenSSL Project Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License 2.0 (the "License").  You may not use
+ * this file except in compliance with the License.  You can obtain a copy
+ * in the file LICENSE in the source distribution or at
+ * https://www.openssl.org/source/license.html
+ */
+
+#include "internal/cryptlib.h"
+#include "internal/constant_time.h"
+#include "bn_local.h"
+
+/*
+ * Fixed-base exponentiation with a comb (Lim and Lee).  An exponent of
+ * up to BN_COMB_TEETH * d bits is laid out as BN_COMB_TEETH rows of d bits,
+ * and column k of those rows picks one of the 2^BN_COMB_TEETH products of
+ * g^(2^(j*d)) kept in the table.  An exponentiation then takes d squarings
+ * and d multiplications, where a sliding window needs a squaring for every
+ * bit of the exponent.
+ *
+ * Every entry of the table is read for every column, so neither the
+ * sequence of operations nor the memory access pattern depends on the
+ * exponent.
+ */
+#define BN_COMB_TEETH   5
+#define BN_COMB_ENTRIES (1 << BN_COMB_TEETH)
+
+struct bn_comb_st {
+    BN_MONT_CTX *mont;
+    int d;              /* Number of columns */
+    int num;            /* Words in a table entry */
+    BN_ULONG *table;    /* BN_COMB_ENTRIES entries, in Montgomery form */
+};
+
+/* Make |r| a fixed-top copy of the |num| words at |words| */
+static int comb_load(BIGNUM *r, const BN_ULONG *words, int num)
+{
+    if (bn_wexpand(r, num) == NULL)
+        return 0;
+    memcpy(r->d, words, sizeof(*words) * num);
+    r->top = num;
+    r->neg = 0;
+    r->flags |= BN_FLG_FIXED_TOP;
+    return 1;
+}
+
+/* Load entry |idx| into |r| without revealing |idx| */
+static int comb_gather(BIGNUM *r, const BN_COMB *comb, unsigned int idx)
+{
+    const BN_ULONG *p = comb->table;
+    BN_ULONG mask;
+    unsigned int i;
+    int j;
+
+    if (bn_wexpand(r, comb->num) == NULL)
+        return 0;
+    memset(r->d, 0, sizeof(*r->d) * comb->num);
+    for (i = 0; i < BN_COMB_ENTRIES; i++, p += comb->num) {
+        mask = (BN_ULONG)0 - (BN_ULONG)(constant_time_eq(i, idx) & 1);
+        for (j = 0; j < comb->num; j++)
+            r->d[j] |= p[j] & mask;
+    }
+    r->top = comb->num;
+    r->neg = 0;
+    r->flags |= BN_FLG_FIXED_TOP;
+    return 1;
+}
+
+BN_COMB *ossl_bn_comb_new(const BIGNUM *g, const BIGNUM *m, int bits,
+                          BN_CTX *ctx)
+{
+    BN_COMB *comb;
+    BIGNUM *acc, *t;
+    int i, j, ok = 0;
+
+    if (bits <= 0) {
+        ERR_raise(ERR_LIB_BN, ERR_R_PASSED_INVALID_ARGUMENT);
+        return NULL;
+    }
+    if (!BN_is_odd(m)) {
+        ERR_raise(ERR_LIB_BN, BN_R_CALLED_WITH_EVEN_MODULUS);
+        return NULL;
+    }
+
+    if ((comb = OPENSSL_zalloc(sizeof(*comb))) == NULL)
+        return NULL;
+    comb->d = (bits + BN_COMB_TEETH - 1) / BN_COMB_TEETH;
+    comb->num = m->top;
+    comb->table = OPENSSL_malloc(sizeof(*comb->table) * comb->num
+                                 * BN_COMB_ENTRIES);
+    if (comb->table == NULL
+            || (comb->mont = BN_MONT_CTX_new()) == NULL
+            || !BN_MONT_CTX_set(comb->mont, m, ctx)) {
+        ossl_bn_comb_free(comb);
+        return NULL;
+    }
+
+    BN_CTX_start(ctx);
+    acc = BN_CTX_get(ctx);
+    t = BN_CTX_get(ctx);
+    if (t == NULL)
+        goto err;
+
+    /* Entry 0 is one and entry 2^j is g^(2^(j*d)) */
+    if (!bn_to_mont_fixed_top(acc, BN_value_one(), comb->mont, ctx)
+            || !bn_copy_words(comb->table, acc, comb->num)
+            || !BN_nnmod(t, g, m, ctx)
+            || !bn_to_mont_fixed_top(acc, t, comb->mont, ctx))
+        goto err;
+    for (j = 0; j < BN_COMB_TEETH; j++) {
+        for (i = 0; j > 0 && i < comb->d; i++)
+            if (!bn_mul_mont_fixed_top(acc, acc, acc, comb->mont, ctx))
+                goto err;
+        if (!bn_copy_words(comb->table + comb->num * (1 << j), acc,
+                           comb->num))
+            goto err;
+    }
+
+    /* The others are products of those, built up from the smaller ones */
+    for (i = 3; i < BN_COMB_ENTRIES; i++) {
+        int top = 1;
+
+        if ((i & (i - 1)) == 0)
+            continue;
+        while (top * 2 < i)
+            top *= 2;
+        if (!comb_load(acc, comb->table + comb->num * (i - top), comb->num)
+                || !comb_load(t, comb->table + comb->num * top, comb->num)
+                || !bn_mul_mont_fixed_top(acc, acc, t, comb->mont, ctx)
+                || !bn_copy_words(comb->table + comb->num * i, acc,
+                                  comb->num))
+            goto err;
+    }
+    ok = 1;
+ err:
+    BN_CTX_end(ctx);
+    if (!ok) {
+        ossl_bn_comb_free(comb);
+        comb = NULL;
+    }
+    return comb;
+}
+
+void ossl_bn_comb_free(BN_COMB *comb)
+{
+    if (comb == NULL)
+        return;
+    BN_MONT_CTX_free(comb->mont);
+    OPENSSL_free(comb->table);
+    OPENSSL_free(comb);
+}
+
+int ossl_bn_comb_bits(const BN_COMB *comb)
+{
+    return comb->d * BN_COMB_TEETH;
+}
+
+/*
+ * r = g^e mod m for the g and m |comb| was made with.  |e| must not be
+ * negative and must have no more than ossl_bn_comb_bits(comb) bits.
+ */
+int ossl_bn_mod_exp_comb(BIGNUM *r, const BIGNUM *e, const BN_COMB *comb,
+                         BN_CTX *ctx)
+{
+    unsigned char *buf;
+    int buflen = (ossl_bn_comb_bits(comb) + 7) / 8;
+    unsigned int idx;
+    BIGNUM *acc, *t;
+    int b, j, k, ret = 0;
+
+    if (BN_is_negative(e)) {
+        ERR_raise(ERR_LIB_BN, ERR_R_PASSED_INVALID_ARGUMENT);
+        return 0;
+    }
+    if (BN_num_bits(e) > ossl_bn_comb_bits(comb)) {
+        ERR_raise(ERR_LIB_BN, BN_R_BIGNUM_TOO_LONG);
+        return 0;
+    }
+    if ((buf = OPENSSL_malloc(buflen)) == NULL)
+        return 0;
+    if (BN_bn2lebinpad(e, buf, buflen) < 0) {
+        OPENSSL_free(buf);
+        return 0;
+    }
+
+    BN_CTX_start(ctx);
+    acc = BN_CTX_get(ctx);
+    t = BN_CTX_get(ctx);
+    if (t == NULL)
+        goto err;
+
+    for (k = comb->d - 1; k >= 0; k--) {
+        idx = 0;
+        for (j = 0; j < BN_COMB_TEETH; j++) {
+            b = j * comb->d + k;
+            idx |= ((buf[b >> 3] >> (b & 7)) & 1) << j;
+        }
+        if (k == comb->d - 1) {
+            if (!comb_gather(acc, comb, idx))
+                goto err;
+            continue;
+        }
+        if (!bn_mul_mont_fixed_top(acc, acc, acc, comb->mont, ctx)
+                || !comb_gather(t, comb, idx)
+                || !bn_mul_mont_fixed_top(acc, acc, t, comb->mont, ctx))
+            goto err;
+    }
+    if (!BN_from_montgomery(r, acc, comb->mont, ctx))
+        goto err;
+    ret = 1;
+ err:
+    BN_CTX_end(ctx);
+    OPENSSL_clear_free(buf, buflen);
+    return ret;
+}
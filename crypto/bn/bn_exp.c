@@ -486,6 +486,72 @@ int BN_mod_exp_mont(BIGNUM *rr, const BIGNUM *a, const BIGNUM *p,
     return ret;
 }
 
+/*
+ * rr = a^e mod m for an odd exponent e > 1 that fits in a word, such as the
+ * RSA public exponent 65537.  |mont| must be set up for m, and a must be
+ * reduced modulo m.
+ *
+ * This is BN_mod_exp_mont() cut down for that case.  Square-and-multiply
+ * needs no table of powers, the working values live on the stack rather
+ * than in |ctx|, and because the last bit of e is set, the final
+ * multiplication by a is done with a out of Montgomery form, which takes
+ * the result out of Montgomery form too.  Nothing is secret here, so none
+ * of this is constant time.
+ */
+int ossl_bn_mod_exp_mont_word_exp(BIGNUM *rr, const BIGNUM *a, BN_ULONG e,
+                                  BN_MONT_CTX *mont, BN_CTX *ctx)
+{
+    int i, top = mont->N.top, ret = 0;
+    size_t buflen = sizeof(a->d[0]) * top * 3;
+    BN_ULONG *buf, *buffree = NULL;
+    BIGNUM am, base, r;
+
+    bn_check_top(a);
+
+    if ((e & 1) == 0 || e == 1 || a->neg || BN_ucmp(a, &mont->N) >= 0) {
+        ERR_raise(ERR_LIB_BN, ERR_R_PASSED_INVALID_ARGUMENT);
+        return 0;
+    }
+
+#ifdef alloca
+    if (buflen < 3072)
+        buf = alloca(buflen);
+    else
+#endif
+        if ((buf = buffree = OPENSSL_malloc(buflen)) == NULL)
+            return 0;
+
+    /* |base| is a zero padded to the width of m, so bn_mul_mont() takes it */
+    base.d = buf;
+    am.d = buf + top;
+    r.d = buf + 2 * top;
+    base.top = am.top = r.top = top;
+    base.dmax = am.dmax = r.dmax = top;
+    base.neg = am.neg = r.neg = 0;
+    base.flags = am.flags = r.flags = BN_FLG_STATIC_DATA | BN_FLG_FIXED_TOP;
+    if (!bn_copy_words(base.d, a, top)
+            || !bn_to_mont_fixed_top(&am, &base, mont, ctx))
+        goto err;
+    memcpy(r.d, am.d, sizeof(r.d[0]) * top);
+
+    for (i = BN_num_bits_word(e) - 2; i >= 0; i--) {
+        if (!bn_mul_mont_fixed_top(&r, &r, &r, mont, ctx))
+            goto err;
+        if (((e >> i) & 1) != 0
+                && !bn_mul_mont_fixed_top(&r, &r, i == 0 ? &base : &am,
+                                          mont, ctx))
+            goto err;
+    }
+
+    if (BN_copy(rr, &r) == NULL)
+        goto err;
+    bn_correct_top(rr);
+    ret = 1;
+ err:
+    OPENSSL_free(buffree);
+    return ret;
+}
+
 static BN_ULONG bn_get_bits(const BIGNUM *a, int bitpos)
 {
     BN_ULONG ret = 0;
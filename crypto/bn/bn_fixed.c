@@ -0,0 +1,128 @@
+/*
+ * Copyright 2024 The OpenSSL Project Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License 2.0 (the "License").  You may not use
+ * this file except in compliance with the License.  You can obtain a copy
+ * in the file LICENSE in the source distribution or at
+ * https://www.openssl.org/source/license.html
+ */
+
+#include "internal/cryptlib.h"
+#include "bn_local.h"
+
+/*
+ * Fixed-width arithmetic modulo the modulus of a Montgomery context, for
+ * callers that keep their values in word arrays on the stack.  Every array
+ * is exactly as wide as the modulus and holds a value below it, so there is
+ * no width to track, nothing to allocate and no BN_CTX.  Apart from the
+ * Montgomery multiplication, which is whatever bn_mul_mont() is, the code
+ * takes the same path whatever the values.
+ */
+
+int ossl_bn_fixed_words(const BN_MONT_CTX *mont)
+{
+    int num = mont->N.top;
+
+    if (num < 1 || num > OSSL_BN_FIXED_MAX_WORDS)
+        return 0;
+    return num;
+}
+
+int ossl_bn_fixed_load(BN_ULONG *r, const BIGNUM *a, const BN_MONT_CTX *mont)
+{
+    if (a->neg)
+        return 0;
+    return bn_copy_words(r, a, mont->N.top);
+}
+
+int ossl_bn_fixed_store(BIGNUM *r, const BN_ULONG *a,
+                        const BN_MONT_CTX *mont)
+{
+    if (!bn_set_words(r, a, mont->N.top))
+        return 0;
+    r->neg = 0;
+    return 1;
+}
+
+void ossl_bn_fixed_mont_mul(BN_ULONG *r, const BN_ULONG *a, const BN_ULONG *b,
+                            const BN_MONT_CTX *mont)
+{
+    BN_ULONG t[2 * OSSL_BN_FIXED_MAX_WORDS], *tp = t, carry, v;
+    const BN_ULONG *np = mont->N.d;
+    int i, num = mont->N.top;
+
+#ifdef OPENSSL_BN_ASM_MONT
+    if (num > 1 && bn_mul_mont(r, a, b, np, mont->n0, num))
+        return;
+#endif
+
+    /* As bn_from_montgomery_word(), with the product in |t| */
+    bn_mul_normal(t, (BN_ULONG *)a, num, (BN_ULONG *)b, num);
+    for (carry = 0, i = 0; i < num; i++, tp++) {
+        v = bn_mul_add_words(tp, np, num, (tp[0] * mont->n0[0]) & BN_MASK2);
+        v = (v + carry + tp[num]) & BN_MASK2;
+        carry |= (v != tp[num]);
+        carry &= (v <= tp[num]);
+        tp[num] = v;
+    }
+    carry -= bn_sub_words(r, tp, np, num);
+    for (i = 0; i < num; i++)
+        r[i] = (carry & tp[i]) | (~carry & r[i]);
+    OPENSSL_cleanse(t, sizeof(t[0]) * 2 * num);
+}
+
+/* As bn_mod_add_fixed_top() */
+void ossl_bn_fixed_mod_add(BN_ULONG *r, const BN_ULONG *a, const BN_ULONG *b,
+                           const BN_MONT_CTX *mont)
+{
+    BN_ULONG t[OSSL_BN_FIXED_MAX_WORDS], carry;
+    int i, num = mont->N.top;
+
+    carry = bn_add_words(t, a, b, num);
+    carry -= bn_sub_words(r, t, mont->N.d, num);
+    for (i = 0; i < num; i++)
+        r[i] = (carry & t[i]) | (~carry & r[i]);
+}
+
+void ossl_bn_fixed_mod_sub(BN_ULONG *r, const BN_ULONG *a, const BN_ULONG *b,
+                           const BN_MONT_CTX *mont)
+{
+    BN_ULONG t[OSSL_BN_FIXED_MAX_WORDS], mask;
+    int i, num = mont->N.top;
+
+    mask = (BN_ULONG)0 - bn_sub_words(t, a, b, num);
+    for (i = 0; i < num; i++)
+        r[i] = mont->N.d[i] & mask;
+    bn_add_words(r, t, r, num);
+}
+
+/* r = a / 2, that is (a + m) / 2 if a is odd */
+void ossl_bn_fixed_mod_half(BN_ULONG *r, const BN_ULONG *a,
+                            const BN_MONT_CTX *mont)
+{
+    BN_ULONG t[OSSL_BN_FIXED_MAX_WORDS], mask, carry, v, w;
+    int i, num = mont->N.top;
+
+    mask = (BN_ULONG)0 - (a[0] & 1);
+    for (carry = 0, i = 0; i < num; i++) {
+        w = mont->N.d[i] & mask;
+        v = (a[i] + carry) & BN_MASK2;
+        carry = v < carry;
+        v = (v + w) & BN_MASK2;
+        carry += v < w;
+        t[i] = v;
+    }
+    for (i = 0; i < num - 1; i++)
+        r[i] = ((t[i] >> 1) | (t[i + 1] << (BN_BITS2 - 1))) & BN_MASK2;
+    r[num - 1] = ((t[num - 1] >> 1) | (carry << (BN_BITS2 - 1))) & BN_MASK2;
+}
+
+int ossl_bn_fixed_is_zero(const BN_ULONG *a, const BN_MONT_CTX *mont)
+{
+    BN_ULONG acc = 0;
+    int i;
+
+    for (i = 0; i < mont->N.top; i++)
+        acc |= a[i];
+    return acc == 0;
+}
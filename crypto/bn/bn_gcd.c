@@ -676,3 +676,318 @@ int BN_gcd(BIGNUM *r, const BIGNUM *in_a, const BIGNUM *in_b, BN_CTX *ctx)
     bn_check_top(r);
     return ret;
 }
+
+/*-
+ * Constant-time modular inversion with the safegcd algorithm of Bernstein
+ * and Yang (https://eprint.iacr.org/2019/266), in the form used by
+ * libsecp256k1.  Numbers are held in signed limbs of SG_BITS bits.  Each
+ * round works out SG_BITS divsteps from the bottom limbs of f and g alone,
+ * as a 2x2 matrix scaled by 2^SG_BITS, and then applies that matrix to the
+ * whole of f, g and of the Bezout coefficients d and e.  The number of
+ * rounds is the Bernstein-Yang bound for the size of the modulus, and
+ * nothing else depends on the values.
+ */
+#ifdef INT128_MAX
+typedef int64_t sg_limb;
+typedef uint64_t sg_ulimb;
+typedef int128_t sg_dlimb;
+# define SG_BITS 62
+#else
+typedef int32_t sg_limb;
+typedef uint32_t sg_ulimb;
+typedef int64_t sg_dlimb;
+# define SG_BITS 30
+#endif
+#define SG_SIGN         ((int)sizeof(sg_limb) * 8 - 1)
+#define SG_MASK         ((sg_limb)(((sg_ulimb)1 << SG_BITS) - 1))
+#define SG_MAX_BITS     4096
+#define SG_MAX_LIMBS    (SG_MAX_BITS / SG_BITS + 1)
+
+typedef struct {
+    sg_limb u, v, q, r;
+} SG_MATRIX;
+
+/*
+ * SG_BITS divsteps on the bottom limbs of f and g, with eta = -delta.  The
+ * matrix |t| is such that 2^SG_BITS * (f', g') = t * (f, g).
+ */
+static sg_limb sg_divsteps(sg_limb eta, sg_ulimb f, sg_ulimb g, SG_MATRIX *t)
+{
+    sg_ulimb u = 1, v = 0, q = 0, r = 1, c1, c2, x, y, z;
+    int i;
+
+    for (i = 0; i < SG_BITS; i++) {
+        /* Masks for eta < 0 and for g odd */
+        c1 = (sg_ulimb)(eta >> SG_SIGN);
+        c2 = (sg_ulimb)0 - (g & 1);
+        /* g += f, or g -= f if eta < 0, when g is odd */
+        x = (f ^ c1) - c1;
+        y = (u ^ c1) - c1;
+        z = (v ^ c1) - c1;
+        g += x & c2;
+        q += y & c2;
+        r += z & c2;
+        /* When both, f becomes the old g and eta becomes -eta */
+        c1 &= c2;
+        eta = (eta ^ (sg_limb)c1) - (sg_limb)(c1 + 1);
+        f += g & c1;
+        u += q & c1;
+        v += r & c1;
+        g >>= 1;
+        u <<= 1;
+        v <<= 1;
+    }
+    t->u = (sg_limb)u;
+    t->v = (sg_limb)v;
+    t->q = (sg_limb)q;
+    t->r = (sg_limb)r;
+    return eta;
+}
+
+/* (f, g) = t * (f, g) / 2^SG_BITS, which divides exactly */
+static void sg_update_fg(sg_limb *f, sg_limb *g, const SG_MATRIX *t, int n)
+{
+    sg_dlimb cf, cg;
+    int i;
+
+    cf = (sg_dlimb)t->u * f[0] + (sg_dlimb)t->v * g[0];
+    cg = (sg_dlimb)t->q * f[0] + (sg_dlimb)t->r * g[0];
+    cf >>= SG_BITS;
+    cg >>= SG_BITS;
+    for (i = 1; i < n; i++) {
+        cf += (sg_dlimb)t->u * f[i] + (sg_dlimb)t->v * g[i];
+        cg += (sg_dlimb)t->q * f[i] + (sg_dlimb)t->r * g[i];
+        f[i - 1] = (sg_limb)(cf & SG_MASK);
+        g[i - 1] = (sg_limb)(cg & SG_MASK);
+        cf >>= SG_BITS;
+        cg >>= SG_BITS;
+    }
+    f[n - 1] = (sg_limb)cf;
+    g[n - 1] = (sg_limb)cg;
+}
+
+/*
+ * (d, e) = t * (d, e) / 2^SG_BITS mod m, where |minv| is m^-1 mod
+ * 2^SG_BITS.  Both d and e stay within (-2m, m).
+ */
+static void sg_update_de(sg_limb *d, sg_limb *e, const SG_MATRIX *t,
+                         const sg_limb *m, sg_ulimb minv, int n)
+{
+    sg_limb sd, se, md, me;
+    sg_dlimb cd, ce;
+    int i;
+
+    /* Add m times u or q for a negative d, and v or r for a negative e */
+    sd = d[n - 1] >> SG_SIGN;
+    se = e[n - 1] >> SG_SIGN;
+    md = (t->u & sd) + (t->v & se);
+    me = (t->q & sd) + (t->r & se);
+    cd = (sg_dlimb)t->u * d[0] + (sg_dlimb)t->v * e[0];
+    ce = (sg_dlimb)t->q * d[0] + (sg_dlimb)t->r * e[0];
+    /* and whatever more multiple of m clears the bottom limb */
+    md -= (sg_limb)((minv * (sg_ulimb)cd + (sg_ulimb)md) & SG_MASK);
+    me -= (sg_limb)((minv * (sg_ulimb)ce + (sg_ulimb)me) & SG_MASK);
+    cd += (sg_dlimb)m[0] * md;
+    ce += (sg_dlimb)m[0] * me;
+    cd >>= SG_BITS;
+    ce >>= SG_BITS;
+    for (i = 1; i < n; i++) {
+        cd += (sg_dlimb)t->u * d[i] + (sg_dlimb)t->v * e[i]
+              + (sg_dlimb)m[i] * md;
+        ce += (sg_dlimb)t->q * d[i] + (sg_dlimb)t->r * e[i]
+              + (sg_dlimb)m[i] * me;
+        d[i - 1] = (sg_limb)(cd & SG_MASK);
+        e[i - 1] = (sg_limb)(ce & SG_MASK);
+        cd >>= SG_BITS;
+        ce >>= SG_BITS;
+    }
+    d[n - 1] = (sg_limb)cd;
+    e[n - 1] = (sg_limb)ce;
+}
+
+/* Bring every limb but the top one back into [0, 2^SG_BITS) */
+static void sg_carry(sg_limb *r, int n)
+{
+    int i;
+
+    for (i = 0; i < n - 1; i++) {
+        r[i + 1] += r[i] >> SG_BITS;
+        r[i] &= SG_MASK;
+    }
+}
+
+/* Take r from (-2m, m) to [0, m), negated if |sign| is negative */
+static void sg_normalize(sg_limb *r, sg_limb sign, const sg_limb *m, int n)
+{
+    sg_limb cond;
+    int i;
+
+    cond = r[n - 1] >> SG_SIGN;
+    for (i = 0; i < n; i++)
+        r[i] += m[i] & cond;
+    cond = sign >> SG_SIGN;
+    for (i = 0; i < n; i++)
+        r[i] = (r[i] ^ cond) - cond;
+    sg_carry(r, n);
+    cond = r[n - 1] >> SG_SIGN;
+    for (i = 0; i < n; i++)
+        r[i] += m[i] & cond;
+    sg_carry(r, n);
+}
+
+static void sg_from_bn(sg_limb *r, int n, const BIGNUM *a)
+{
+    sg_ulimb v;
+    int i, k, w, s;
+
+    for (i = 0; i < n; i++) {
+        for (v = 0, k = 0; k < SG_BITS; k += BN_BITS2 - s) {
+            w = (i * SG_BITS + k) / BN_BITS2;
+            s = (i * SG_BITS + k) % BN_BITS2;
+            if (w < a->top)
+                v |= (sg_ulimb)(a->d[w] >> s) << k;
+        }
+        r[i] = (sg_limb)v & SG_MASK;
+    }
+}
+
+/* |a| must be normalized, so that every limb is in [0, 2^SG_BITS) */
+static int sg_to_bn(BIGNUM *r, const sg_limb *a, int n, int top)
+{
+    BN_ULONG v;
+    int i, k, w, s;
+
+    if (bn_wexpand(r, top) == NULL)
+        return 0;
+    for (w = 0; w < top; w++) {
+        for (v = 0, k = 0; k < BN_BITS2; k += SG_BITS - s) {
+            i = (w * BN_BITS2 + k) / SG_BITS;
+            s = (w * BN_BITS2 + k) % SG_BITS;
+            if (i < n)
+                v |= (BN_ULONG)((sg_ulimb)a[i] >> s) << k;
+        }
+        r->d[w] = v;
+    }
+    r->top = top;
+    r->neg = 0;
+    bn_correct_top(r);
+    return 1;
+}
+
+/* r = a^-1 mod m for an odd m of at most SG_MAX_BITS bits and 0 <= a < m */
+static int bn_mod_inverse_safegcd(BIGNUM *r, const BIGNUM *a, const BIGNUM *m)
+{
+    sg_limb f[SG_MAX_LIMBS], g[SG_MAX_LIMBS], d[SG_MAX_LIMBS];
+    sg_limb e[SG_MAX_LIMBS], mod[SG_MAX_LIMBS], eta = -1, acc;
+    sg_ulimb minv;
+    SG_MATRIX t;
+    int i, n, bits, steps, ret = 0;
+
+    bits = BN_num_bits(m);
+    n = bits / SG_BITS + 1;
+    steps = bits < 46 ? (49 * bits + 80) / 17 : (49 * bits + 57) / 17;
+
+    sg_from_bn(mod, n, m);
+    sg_from_bn(f, n, m);
+    sg_from_bn(g, n, a);
+    memset(d, 0, sizeof(*d) * n);
+    memset(e, 0, sizeof(*e) * n);
+    e[0] = 1;
+
+    /* m^-1 mod 2^SG_BITS by Newton iteration, each doubling the good bits */
+    for (minv = (sg_ulimb)mod[0], i = 0; i < 5; i++)
+        minv *= 2 - (sg_ulimb)mod[0] * minv;
+    minv &= (sg_ulimb)SG_MASK;
+
+    for (i = 0; i < steps; i += SG_BITS) {
+        eta = sg_divsteps(eta, (sg_ulimb)f[0], (sg_ulimb)g[0], &t);
+        sg_update_de(d, e, &t, mod, minv, n);
+        sg_update_fg(f, g, &t, n);
+    }
+
+    /* Now g is zero and f is gcd(a, m) or its negation */
+    sg_normalize(d, f[n - 1], mod, n);
+    acc = f[n - 1] >> SG_SIGN;
+    for (i = 0; i < n; i++)
+        f[i] = (f[i] ^ acc) - acc;
+    sg_carry(f, n);
+    acc = f[0] ^ 1;
+    for (i = 1; i < n; i++)
+        acc |= f[i];
+    for (i = 0; i < n; i++)
+        acc |= g[i];
+    if (acc != 0)
+        ERR_raise(ERR_LIB_BN, BN_R_NO_INVERSE);
+    else
+        ret = sg_to_bn(r, d, n, m->top);
+
+    OPENSSL_cleanse(f, sizeof(f));
+    OPENSSL_cleanse(g, sizeof(g));
+    OPENSSL_cleanse(d, sizeof(d));
+    OPENSSL_cleanse(e, sizeof(e));
+    return ret;
+}
+
+/*
+ * r = a^-1 mod m, in time that depends only on the sizes of a and m.  If m
+ * is odd, a is secret; if m is even, a must be odd and is taken to be
+ * public, as for e when computing an RSA d.  Then the inversion is done
+ * modulo a instead, with r = (1 + m * k) / a for k = -m^-1 mod a.
+ */
+int ossl_bn_mod_inverse_consttime(BIGNUM *r, const BIGNUM *a, const BIGNUM *m,
+                                  BN_CTX *ctx)
+{
+    BIGNUM *t, *k;
+    int ret = 0;
+
+    if (BN_is_zero(m) || BN_is_negative(m)) {
+        ERR_raise(ERR_LIB_BN, BN_R_NO_INVERSE);
+        return 0;
+    }
+
+    BN_CTX_start(ctx);
+    t = BN_CTX_get(ctx);
+    k = BN_CTX_get(ctx);
+    if (k == NULL)
+        goto err;
+
+    if (BN_is_odd(m)) {
+        if (BN_num_bits(m) > SG_MAX_BITS) {
+            if (BN_copy(t, a) == NULL)
+                goto err;
+            BN_set_flags(t, BN_FLG_CONSTTIME);
+            ret = BN_mod_inverse(r, t, m, ctx) != NULL;
+            goto err;
+        }
+        if (BN_is_negative(a) || BN_ucmp(a, m) >= 0) {
+            BN_set_flags(t, BN_FLG_CONSTTIME);
+            if (!BN_nnmod(t, a, m, ctx))
+                goto err;
+            a = t;
+        }
+        ret = bn_mod_inverse_safegcd(r, a, m);
+        goto err;
+    }
+
+    if (!BN_is_odd(a) || BN_is_negative(a)) {
+        ERR_raise(ERR_LIB_BN, BN_R_NO_INVERSE);
+        goto err;
+    }
+    if (BN_is_one(a)) {
+        ret = BN_one(r);
+        goto err;
+    }
+    BN_set_flags(t, BN_FLG_CONSTTIME);
+    BN_set_flags(k, BN_FLG_CONSTTIME);
+    if (!BN_nnmod(t, m, a, ctx)
+            || !ossl_bn_mod_inverse_consttime(k, t, a, ctx)
+            || !BN_sub(k, a, k)
+            || !BN_mul(t, m, k, ctx)
+            || !BN_add_word(t, 1)
+            || !BN_div(r, NULL, t, a, ctx))
+        goto err;
+    ret = 1;
+ err:
+    BN_CTX_end(ctx);
+    return ret;
+}
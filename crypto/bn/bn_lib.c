@@ -446,7 +446,27 @@ static BIGNUM *bin2bn(const unsigned char *s, int len, BIGNUM *ret,
     }
     ret->top = n;
     ret->neg = neg;
-    for (i = 0; n-- > 0; i++) {
+    i = 0;
+    /*
+     * Without a sign to strip there is no carry to propagate, so the chunks
+     * that are entirely filled can be assembled a chunk at a time.
+     */
+    if (signedness == UNSIGNED) {
+        for (; len >= BN_BYTES; i++, n--, len -= BN_BYTES) {
+            BN_ULONG l = 0;
+            int j;
+
+            if (endianness == BIG)
+                for (j = 0; j < BN_BYTES; j++)
+                    l = (l << 8) | s[j - BN_BYTES + 1];
+            else
+                for (j = BN_BYTES - 1; j >= 0; j--)
+                    l = (l << 8) | s[j];
+            ret->d[i] = l;
+            s += inc * BN_BYTES;
+        }
+    }
+    for (; n-- > 0; i++) {
         BN_ULONG l = 0;        /* Accumulator */
         unsigned int m = 0;    /* Offset in a bignum chunk, in bits */
 
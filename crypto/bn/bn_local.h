@@ -673,4 +673,11 @@ static inline BIGNUM *bn_expand(BIGNUM *a, int bits)
 int ossl_bn_check_prime(const BIGNUM *w, int checks, BN_CTX *ctx,
                         int do_trial_division, BN_GENCB *cb);
 
+typedef struct bn_prime_sieve_st BN_PRIME_SIEVE;
+
+BN_PRIME_SIEVE *ossl_bn_prime_sieve_new(const BIGNUM *step);
+void ossl_bn_prime_sieve_free(BN_PRIME_SIEVE *sieve);
+int ossl_bn_prime_sieve(const BN_PRIME_SIEVE *sieve, const BIGNUM *w,
+                        unsigned char *composite, size_t n);
+
 #endif
@@ -336,35 +336,52 @@ int BN_MONT_CTX_set(BN_MONT_CTX *mont, const BIGNUM *mod, BN_CTX *ctx)
         mont->n0[0] = (Ri->top > 0) ? Ri->d[0] : 0;
         mont->n0[1] = (Ri->top > 1) ? Ri->d[1] : 0;
 # else
-        BN_zero(R);
-        if (!(BN_set_bit(R, BN_BITS2)))
-            goto err;           /* R */
-
-        buf[0] = mod->d[0];     /* tmod = N mod word size */
-        buf[1] = 0;
-        tmod.top = buf[0] != 0 ? 1 : 0;
-        /* Ri = R^-1 mod N */
-        if (BN_is_one(&tmod))
-            BN_zero(Ri);
-        else if ((BN_mod_inverse(Ri, R, &tmod, ctx)) == NULL)
-            goto err;
-        if (!BN_lshift(Ri, Ri, BN_BITS2))
-            goto err;           /* R*Ri */
-        if (!BN_is_zero(Ri)) {
-            if (!BN_sub_word(Ri, 1))
-                goto err;
-        } else {                /* if N mod word size == 1 */
-
-            if (!BN_set_word(Ri, BN_MASK2))
-                goto err;       /* Ri-- (mod word size) */
-        }
-        if (!BN_div(Ri, NULL, Ri, &tmod, ctx))
-            goto err;
         /*
-         * Ni = (R*Ri-1)/N, keep only least significant word:
+         * For odd N, n0 = -N^-1 mod 2^BN_BITS2 comes from Newton's iteration
+         * x = x * (2 - N * x), which doubles the number of correct low bits
+         * of the inverse each time, starting from the three that N itself
+         * has right.  That takes a handful of word multiplications where
+         * BN_mod_inverse() takes a lot longer, and it does not depend on
+         * the value of N.  An even N is left to fail below as it always has.
          */
-        mont->n0[0] = (Ri->top > 0) ? Ri->d[0] : 0;
-        mont->n0[1] = 0;
+        if ((mod->d[0] & 1) != 0) {
+            BN_ULONG x = mod->d[0];
+
+            for (i = 3; i < BN_BITS2; i *= 2)
+                x = (x * (2 - mod->d[0] * x)) & BN_MASK2;
+            mont->n0[0] = (0 - x) & BN_MASK2;
+            mont->n0[1] = 0;
+        } else {
+            BN_zero(R);
+            if (!(BN_set_bit(R, BN_BITS2)))
+                goto err;           /* R */
+
+            buf[0] = mod->d[0];     /* tmod = N mod word size */
+            buf[1] = 0;
+            tmod.top = buf[0] != 0 ? 1 : 0;
+            /* Ri = R^-1 mod N */
+            if (BN_is_one(&tmod))
+                BN_zero(Ri);
+            else if ((BN_mod_inverse(Ri, R, &tmod, ctx)) == NULL)
+                goto err;
+            if (!BN_lshift(Ri, Ri, BN_BITS2))
+                goto err;           /* R*Ri */
+            if (!BN_is_zero(Ri)) {
+                if (!BN_sub_word(Ri, 1))
+                    goto err;
+            } else {                /* if N mod word size == 1 */
+
+                if (!BN_set_word(Ri, BN_MASK2))
+                    goto err;       /* Ri-- (mod word size) */
+            }
+            if (!BN_div(Ri, NULL, Ri, &tmod, ctx))
+                goto err;
+            /*
+             * Ni = (R*Ri-1)/N, keep only least significant word:
+             */
+            mont->n0[0] = (Ri->top > 0) ? Ri->d[0] : 0;
+            mont->n0[1] = 0;
+        }
 # endif
     }
 #else                           /* !MONT_WORD */
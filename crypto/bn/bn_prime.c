@@ -266,6 +266,93 @@ int BN_check_prime(const BIGNUM *p, BN_CTX *ctx, BN_GENCB *cb)
     return ossl_bn_check_prime(p, 0, ctx, 1, cb);
 }
 
+/*
+ * A sieve over the candidates w, w + step, w + 2 * step, ... that key
+ * generation walks through, using every prime in the table except 2.
+ * For each small prime p it keeps step^-1 mod p, or 0 if p divides step,
+ * so that the first multiple of p in a run of candidates takes a single
+ * division of w.
+ */
+struct bn_prime_sieve_st {
+    prime_t step_inv[NUMPRIMES];
+};
+
+/* Returns a^-1 mod p for a prime p that doesn't divide a */
+static prime_t small_mod_inverse(BN_ULONG a, prime_t p)
+{
+    long r0 = p, r1 = (long)a, t0 = 0, t1 = 1, q, tmp;
+
+    while (r1 != 0) {
+        q = r0 / r1;
+        tmp = r0 - q * r1;
+        r0 = r1;
+        r1 = tmp;
+        tmp = t0 - q * t1;
+        t0 = t1;
+        t1 = tmp;
+    }
+    return (prime_t)(t0 < 0 ? t0 + p : t0);
+}
+
+BN_PRIME_SIEVE *ossl_bn_prime_sieve_new(const BIGNUM *step)
+{
+    BN_PRIME_SIEVE *sieve;
+    BN_ULONG mod;
+    int i;
+
+    if ((sieve = OPENSSL_zalloc(sizeof(*sieve))) == NULL)
+        return NULL;
+    for (i = 1; i < NUMPRIMES; i++) {
+        mod = BN_mod_word(step, primes[i]);
+        if (mod == (BN_ULONG)-1) {
+            OPENSSL_free(sieve);
+            return NULL;
+        }
+        if (mod != 0)
+            sieve->step_inv[i] = small_mod_inverse(mod, primes[i]);
+    }
+    return sieve;
+}
+
+void ossl_bn_prime_sieve_free(BN_PRIME_SIEVE *sieve)
+{
+    OPENSSL_free(sieve);
+}
+
+/*
+ * Sets |composite|[k] to 1 if w + k * step has a small prime factor, and to
+ * 0 otherwise, for 0 <= k < |n|. The candidates must be larger than the
+ * primes in the table.
+ *
+ * Returns 1 on success and 0 on error.
+ */
+int ossl_bn_prime_sieve(const BN_PRIME_SIEVE *sieve, const BIGNUM *w,
+                        unsigned char *composite, size_t n)
+{
+    BN_ULONG mod;
+    size_t k;
+    int i;
+
+    memset(composite, 0, n);
+    for (i = 1; i < NUMPRIMES; i++) {
+        mod = BN_mod_word(w, primes[i]);
+        if (mod == (BN_ULONG)-1)
+            return 0;
+        if (sieve->step_inv[i] == 0) {
+            /* Either every candidate is a multiple of this prime or none */
+            if (mod == 0)
+                memset(composite, 1, n);
+            continue;
+        }
+        /* The first k with w + k * step = 0 mod p is -w * step^-1 mod p */
+        k = mod == 0 ? 0
+            : (size_t)((primes[i] - mod) * sieve->step_inv[i] % primes[i]);
+        for (; k < n; k += primes[i])
+            composite[k] = 1;
+    }
+    return 1;
+}
+
 /*
  * Tests that |w| is probably prime
  * See FIPS 186-4 C.3.1 Miller Rabin Probabilistic Primality Test.
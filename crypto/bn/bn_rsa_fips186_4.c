@@ -48,6 +48,12 @@ const BIGNUM ossl_bn_inv_sqrt_2 = {
     BN_FLG_STATIC_DATA
 };
 
+/*
+ * The number of candidates Y, Y + 2r1r2, ... sieved at a time when deriving
+ * p or q. Each prime is found after a few hundred candidates on average.
+ */
+#define RSA_PRIME_SIEVE_LEN 512
+
 /*
  * Refer to FIPS 186-5 Table B.1 for minimum rounds of Miller Rabin
  * required for generation of RSA aux primes (p1, p2, q1 and q2).
@@ -278,10 +284,12 @@ int ossl_bn_rsa_fips186_4_derive_prime(BIGNUM *Y, BIGNUM *X, const BIGNUM *Xin,
                                        BN_CTX *ctx, BN_GENCB *cb)
 {
     int ret = 0;
-    int i, imax, rounds;
+    int i, imax, rounds, status;
     int bits = nlen >> 1;
     BIGNUM *tmp, *R, *r1r2x2, *y1, *r1x2;
     BIGNUM *base, *range;
+    BN_PRIME_SIEVE *sieve = NULL;
+    unsigned char composite[RSA_PRIME_SIEVE_LEN];
 
     BN_CTX_start(ctx);
 
@@ -340,6 +348,13 @@ int ossl_bn_rsa_fips186_4_derive_prime(BIGNUM *Y, BIGNUM *X, const BIGNUM *Xin,
     if (BN_is_negative(R) && !BN_add(R, R, r1r2x2))
         goto err;
 
+    /*
+     * The candidates step by 2r1r2, so rather than trial dividing each one,
+     * sieve them a run at a time. Only the survivors get Miller-Rabin.
+     */
+    if ((sieve = ossl_bn_prime_sieve_new(r1r2x2)) == NULL)
+        goto err;
+
     /*
      * In FIPS 186-4 imax was set to 5 * nlen/2.
      * Analysis by Allen Roginsky
@@ -374,18 +389,25 @@ int ossl_bn_rsa_fips186_4_derive_prime(BIGNUM *Y, BIGNUM *X, const BIGNUM *Xin,
             }
             BN_GENCB_call(cb, 0, 2);
 
-            /* (Step 7) If GCD(Y-1) == 1 & Y is probably prime then return Y */
-            if (BN_copy(y1, Y) == NULL
-                    || !BN_sub_word(y1, 1))
+            if (i % RSA_PRIME_SIEVE_LEN == 0
+                    && !ossl_bn_prime_sieve(sieve, Y, composite,
+                                            sizeof(composite)))
                 goto err;
 
-            if (BN_are_coprime(y1, e, ctx)) {
-                int rv = ossl_bn_check_generated_prime(Y, rounds, ctx, cb);
-
-                if (rv > 0)
-                    goto end;
-                if (rv < 0)
+            /* (Step 7) If GCD(Y-1) == 1 & Y is probably prime then return Y */
+            if (!composite[i % RSA_PRIME_SIEVE_LEN]) {
+                if (BN_copy(y1, Y) == NULL
+                        || !BN_sub_word(y1, 1))
                     goto err;
+
+                if (BN_are_coprime(y1, e, ctx)) {
+                    if (!BN_GENCB_call(cb, 1, -1)
+                            || !ossl_bn_miller_rabin_is_prime(Y, rounds, ctx,
+                                                              cb, 0, &status))
+                        goto err;
+                    if (status == BN_PRIMETEST_PROBABLY_PRIME)
+                        goto end;
+                }
             }
             /* (Step 8-10) */
             if (++i >= imax) {
@@ -400,6 +422,8 @@ end:
     ret = 1;
     BN_GENCB_call(cb, 3, 0);
 err:
+    ossl_bn_prime_sieve_free(sieve);
+    OPENSSL_cleanse(composite, sizeof(composite));
     BN_clear(y1);
     BN_CTX_end(ctx);
     return ret;
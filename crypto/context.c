@@ -14,8 +14,17 @@
 #include <internal/core.h>
 #include <internal/bio.h>
 #include <internal/provider.h>
+#include <internal/namemap.h>
 #include <crypto/decoder.h>
 #include <crypto/context.h>
+#ifndef FIPS_MODULE
+# include <openssl/evp.h>
+# include <openssl/kdf.h>
+# include <openssl/encoder.h>
+# include <openssl/decoder.h>
+# include <openssl/store.h>
+# include <openssl/rand.h>
+#endif
 
 struct ossl_lib_ctx_st {
     CRYPTO_RWLOCK *lock, *rand_crngt_lock;
@@ -41,6 +50,12 @@ struct ossl_lib_ctx_st {
 #endif
 #if defined(OPENSSL_THREADS)
     void *threads;
+#endif
+#ifndef OPENSSL_NO_DH
+    void *dh_combs;
+#endif
+#if !defined(OPENSSL_NO_EC) && !defined(FIPS_MODULE)
+    void *ec_combs;
 #endif
     void *rand_crngt;
 #ifdef FIPS_MODULE
@@ -188,6 +203,18 @@ static int context_init(OSSL_LIB_CTX *ctx)
         goto err;
 #endif
 
+#ifndef OPENSSL_NO_DH
+    ctx->dh_combs = ossl_dh_combs_new(ctx);
+    if (ctx->dh_combs == NULL)
+        goto err;
+#endif
+
+#if !defined(OPENSSL_NO_EC) && !defined(FIPS_MODULE)
+    ctx->ec_combs = ossl_ec_combs_new(ctx);
+    if (ctx->ec_combs == NULL)
+        goto err;
+#endif
+
     /* Low priority. */
 #ifndef FIPS_MODULE
     ctx->child_provider = ossl_child_prov_ctx_new(ctx);
@@ -331,6 +358,20 @@ static void context_deinit_objs(OSSL_LIB_CTX *ctx)
     }
 #endif
 
+#ifndef OPENSSL_NO_DH
+    if (ctx->dh_combs != NULL) {
+        ossl_dh_combs_free(ctx->dh_combs);
+        ctx->dh_combs = NULL;
+    }
+#endif
+
+#if !defined(OPENSSL_NO_EC) && !defined(FIPS_MODULE)
+    if (ctx->ec_combs != NULL) {
+        ossl_ec_combs_free(ctx->ec_combs);
+        ctx->ec_combs = NULL;
+    }
+#endif
+
     /* Low priority. */
 #ifndef FIPS_MODULE
     if (ctx->child_provider != NULL) {
@@ -467,6 +508,76 @@ int OSSL_LIB_CTX_load_config(OSSL_LIB_CTX *ctx, const char *config_file)
 {
     return CONF_modules_load_file_ex(ctx, config_file, NULL, 0) > 0;
 }
+
+struct freeze_data_st {
+    OSSL_LIB_CTX *libctx;
+    const char *propq;
+};
+
+/*
+ * Fetch each provided algorithm again by name, so that the method store
+ * caches the result for the property query that will be used later.
+ */
+# define FREEZE_FN(TYPE)                                                \
+    static void freeze_##TYPE(TYPE *meth, void *arg)                    \
+    {                                                                   \
+        struct freeze_data_st *data = arg;                              \
+                                                                        \
+        TYPE##_free(TYPE##_fetch(data->libctx, TYPE##_get0_name(meth),  \
+                                 data->propq));                         \
+    }
+FREEZE_FN(EVP_MD)
+FREEZE_FN(EVP_CIPHER)
+FREEZE_FN(EVP_MAC)
+FREEZE_FN(EVP_KDF)
+FREEZE_FN(EVP_RAND)
+FREEZE_FN(EVP_KEYMGMT)
+FREEZE_FN(EVP_SIGNATURE)
+FREEZE_FN(EVP_ASYM_CIPHER)
+FREEZE_FN(EVP_KEYEXCH)
+FREEZE_FN(EVP_KEM)
+
+/*
+ * Encoders, decoders and store loaders are constructed into the method store
+ * by enumerating them, there is nothing more to do for each one.
+ */
+# define FREEZE_NOP_FN(TYPE)                                            \
+    static void freeze_##TYPE(TYPE *meth, void *arg)                    \
+    {                                                                   \
+    }
+FREEZE_NOP_FN(OSSL_ENCODER)
+FREEZE_NOP_FN(OSSL_DECODER)
+FREEZE_NOP_FN(OSSL_STORE_LOADER)
+
+int OSSL_LIB_CTX_freeze(OSSL_LIB_CTX *ctx, const char *propq)
+{
+    struct freeze_data_st data;
+
+    data.libctx = ctx;
+    data.propq = propq;
+
+    /* Add the legacy names now rather than on a later miss in the child */
+    ossl_namemap_load_legacy(ossl_namemap_stored(ctx));
+
+    /* Fetching everything also activates the fallback providers */
+    EVP_MD_do_all_provided(ctx, freeze_EVP_MD, &data);
+    EVP_CIPHER_do_all_provided(ctx, freeze_EVP_CIPHER, &data);
+    EVP_MAC_do_all_provided(ctx, freeze_EVP_MAC, &data);
+    EVP_KDF_do_all_provided(ctx, freeze_EVP_KDF, &data);
+    EVP_RAND_do_all_provided(ctx, freeze_EVP_RAND, &data);
+    EVP_KEYMGMT_do_all_provided(ctx, freeze_EVP_KEYMGMT, &data);
+    EVP_SIGNATURE_do_all_provided(ctx, freeze_EVP_SIGNATURE, &data);
+    EVP_ASYM_CIPHER_do_all_provided(ctx, freeze_EVP_ASYM_CIPHER, &data);
+    EVP_KEYEXCH_do_all_provided(ctx, freeze_EVP_KEYEXCH, &data);
+    EVP_KEM_do_all_provided(ctx, freeze_EVP_KEM, &data);
+    OSSL_ENCODER_do_all_provided(ctx, freeze_OSSL_ENCODER, NULL);
+    OSSL_DECODER_do_all_provided(ctx, freeze_OSSL_DECODER, NULL);
+    OSSL_STORE_LOADER_do_all_provided(ctx, freeze_OSSL_STORE_LOADER, NULL);
+
+    /* Instantiate the DRBGs, they are reseeded in the child after a fork */
+    return RAND_get0_primary(ctx) != NULL && RAND_get0_public(ctx) != NULL
+        && RAND_get0_private(ctx) != NULL;
+}
 #endif
 
 void OSSL_LIB_CTX_free(OSSL_LIB_CTX *ctx)
@@ -588,6 +699,14 @@ void *ossl_lib_ctx_get_data(OSSL_LIB_CTX *ctx, int index)
     case OSSL_LIB_CTX_THREAD_INDEX:
         return ctx->threads;
 #endif
+#ifndef OPENSSL_NO_DH
+    case OSSL_LIB_CTX_DH_COMB_INDEX:
+        return ctx->dh_combs;
+#endif
+#if !defined(OPENSSL_NO_EC) && !defined(FIPS_MODULE)
+    case OSSL_LIB_CTX_EC_COMB_INDEX:
+        return ctx->ec_combs;
+#endif
 
     case OSSL_LIB_CTX_RAND_CRNGT_INDEX: {
 
@@ -195,3 +195,29 @@ char *ossl_algorithm_get1_first_name(const OSSL_ALGORITHM *algo)
     ret = OPENSSL_strndup(algo->algorithm_names, first_name_len);
     return ret;
 }
+
+/*
+ * Call |fn| for each of the names |algo| lists, in order.  Unlike going
+ * through the namemap, the result does not depend on what other names have
+ * been registered for the same algorithm so far.
+ */
+int ossl_algorithm_names_do_all(const OSSL_ALGORITHM *algo,
+                                void (*fn)(const char *name, void *data),
+                                void *data)
+{
+    char *tmp, *p, *q;
+
+    if (algo->algorithm_names == NULL
+            || (tmp = OPENSSL_strdup(algo->algorithm_names)) == NULL)
+        return 0;
+
+    for (p = tmp; p != NULL; p = q) {
+        if ((q = strchr(p, ':')) != NULL)
+            *q++ = '\0';
+        if (*p != '\0')
+            fn(p, data);
+    }
+
+    OPENSSL_free(tmp);
+    return 1;
+}
@@ -36,6 +36,7 @@ struct ossl_namemap_st {
 
     CRYPTO_RWLOCK *lock;
     LHASH_OF(NAMENUM_ENTRY) *namenum;  /* Name->number mapping */
+    int legacy_loaded;                 /* Legacy names have been added */
 
     TSAN_QUALIFIER int max_number;     /* Current max number */
 };
@@ -140,6 +141,9 @@ int ossl_namemap_doall_names(const OSSL_NAMEMAP *namemap, int number,
     if (namemap == NULL)
         return 0;
 
+    /* The result must not depend on whether something loaded them already */
+    ossl_namemap_load_legacy(namemap);
+
     /*
      * We collect all the names first under a read lock. Subsequently we call
      * the user function, so that we're not holding the read lock when in user
@@ -182,7 +186,8 @@ static int namemap_name2num(const OSSL_NAMEMAP *namemap,
     return namenum_entry != NULL ? namenum_entry->number : 0;
 }
 
-int ossl_namemap_name2num(const OSSL_NAMEMAP *namemap, const char *name)
+int ossl_namemap_name2num_nolegacy(const OSSL_NAMEMAP *namemap,
+                                   const char *name)
 {
     int number;
 
@@ -202,6 +207,22 @@ int ossl_namemap_name2num(const OSSL_NAMEMAP *namemap, const char *name)
     return number;
 }
 
+int ossl_namemap_name2num(const OSSL_NAMEMAP *namemap, const char *name)
+{
+    int number;
+
+#ifndef FIPS_MODULE
+    if (namemap == NULL)
+        namemap = ossl_namemap_stored(NULL);
+#endif
+
+    number = ossl_namemap_name2num_nolegacy(namemap, name);
+    if (number == 0 && ossl_namemap_load_legacy(namemap))
+        number = ossl_namemap_name2num_nolegacy(namemap, name);
+
+    return number;
+}
+
 int ossl_namemap_name2num_n(const OSSL_NAMEMAP *namemap,
                             const char *name, size_t name_len)
 {
@@ -380,30 +401,62 @@ int ossl_namemap_add_names(OSSL_NAMEMAP *namemap, int number,
 #ifndef FIPS_MODULE
 #include <openssl/evp.h>
 
-/* Creates an initial namemap with names found in the legacy method db */
+/* Adds the names found in the legacy method db to the namemap */
 static void get_legacy_evp_names(int base_nid, int nid, const char *pem_name,
                                  void *arg)
 {
-    int num = 0;
+    OSSL_NAMEMAP *namemap = arg;
+    const char *names[6], *first = NULL;
+    char txtoid[OSSL_MAX_NAME_SIZE];
+    size_t n = 0, i;
+    int num = 0, this_num;
     ASN1_OBJECT *obj;
 
     if (base_nid != NID_undef) {
-        num = ossl_namemap_add_name(arg, num, OBJ_nid2sn(base_nid));
-        num = ossl_namemap_add_name(arg, num, OBJ_nid2ln(base_nid));
+        names[n++] = OBJ_nid2sn(base_nid);
+        names[n++] = OBJ_nid2ln(base_nid);
     }
 
     if (nid != NID_undef) {
-        num = ossl_namemap_add_name(arg, num, OBJ_nid2sn(nid));
-        num = ossl_namemap_add_name(arg, num, OBJ_nid2ln(nid));
-        if ((obj = OBJ_nid2obj(nid)) != NULL) {
-            char txtoid[OSSL_MAX_NAME_SIZE];
+        names[n++] = OBJ_nid2sn(nid);
+        names[n++] = OBJ_nid2ln(nid);
+        if ((obj = OBJ_nid2obj(nid)) != NULL
+                && OBJ_obj2txt(txtoid, sizeof(txtoid), obj, 1) > 0)
+            names[n++] = txtoid;
+    }
+    if (pem_name != NULL)
+        names[n++] = pem_name;
 
-            if (OBJ_obj2txt(txtoid, sizeof(txtoid), obj, 1) > 0)
-                num = ossl_namemap_add_name(arg, num, txtoid);
+    if (!CRYPTO_THREAD_write_lock(namemap->lock))
+        return;
+
+    /*
+     * Providers may already have registered some of these names, in which
+     * case the rest must join the same number rather than get a new one.
+     * If they registered them under different numbers, the names conflict
+     * the same way they would have if the legacy names had come first, and
+     * none of them are added.
+     */
+    for (i = 0; i < n; i++) {
+        if (names[i] == NULL
+                || (this_num = namemap_name2num(namemap, names[i])) == 0)
+            continue;
+        if (num == 0) {
+            num = this_num;
+            first = names[i];
+        } else if (this_num != num) {
+            ERR_raise_data(ERR_LIB_CRYPTO, CRYPTO_R_CONFLICTING_NAMES,
+                           "legacy name \"%s\" has identity %d, but \"%s\" has %d",
+                           names[i], this_num, first, num);
+            goto end;
         }
     }
-    if (pem_name != NULL)
-        num = ossl_namemap_add_name(arg, num, pem_name);
+
+    for (i = 0; i < n; i++)
+        if (names[i] != NULL)
+            num = namemap_add_name(namemap, num, names[i]);
+ end:
+    CRYPTO_THREAD_unlock(namemap->lock);
 }
 
 static void get_legacy_cipher_names(const OBJ_NAME *on, void *arg)
@@ -462,50 +515,67 @@ static void get_legacy_pkey_meth_names(const EVP_PKEY_ASN1_METHOD *ameth,
 }
 #endif
 
-/*-
- * Constructors / destructors
- * ==========================
+/*
+ * The names found in the legacy method db are added to a stored namemap the
+ * first time a name lookup misses, rather than when the namemap is first
+ * used.  Fetching an algorithm by one of its provider names never needs
+ * them, which saves copying several hundred names into every new library
+ * context at startup.
+ *
+ * Returns 1 if the legacy names were added by this call, 0 otherwise.
  */
-
-OSSL_NAMEMAP *ossl_namemap_stored(OSSL_LIB_CTX *libctx)
+int ossl_namemap_load_legacy(const OSSL_NAMEMAP *cnamemap)
 {
 #ifndef FIPS_MODULE
-    int nms;
-#endif
-    OSSL_NAMEMAP *namemap =
-        ossl_lib_ctx_get_data(libctx, OSSL_LIB_CTX_NAMEMAP_INDEX);
+    OSSL_NAMEMAP *namemap = (OSSL_NAMEMAP *)cnamemap;
+    int loaded, i, end;
 
-    if (namemap == NULL)
-        return NULL;
+    if (namemap == NULL || !namemap->stored)
+        return 0;
 
-#ifndef FIPS_MODULE
-    nms = ossl_namemap_empty(namemap);
-    if (nms < 0) {
-        /*
-         * Could not get lock to make the count, so maybe internal objects
-         * weren't added. This seems safest.
-         */
-        return NULL;
-    }
-    if (nms == 1) {
-        int i, end;
+    if (!CRYPTO_THREAD_read_lock(namemap->lock))
+        return 0;
+    loaded = namemap->legacy_loaded;
+    CRYPTO_THREAD_unlock(namemap->lock);
+    if (loaded)
+        return 0;
 
-        /* Before pilfering, we make sure the legacy database is populated */
-        OPENSSL_init_crypto(OPENSSL_INIT_ADD_ALL_CIPHERS
-                            | OPENSSL_INIT_ADD_ALL_DIGESTS, NULL);
+    /*
+     * Two threads may get here at the same time, which is harmless since
+     * adding a name that is already there does nothing.
+     */
 
-        OBJ_NAME_do_all(OBJ_NAME_TYPE_CIPHER_METH,
-                        get_legacy_cipher_names, namemap);
-        OBJ_NAME_do_all(OBJ_NAME_TYPE_MD_METH,
-                        get_legacy_md_names, namemap);
+    /* Before pilfering, we make sure the legacy database is populated */
+    OPENSSL_init_crypto(OPENSSL_INIT_ADD_ALL_CIPHERS
+                        | OPENSSL_INIT_ADD_ALL_DIGESTS, NULL);
 
-        /* We also pilfer data from the legacy EVP_PKEY_ASN1_METHODs */
-        for (i = 0, end = EVP_PKEY_asn1_get_count(); i < end; i++)
-            get_legacy_pkey_meth_names(EVP_PKEY_asn1_get0(i), namemap);
-    }
+    OBJ_NAME_do_all(OBJ_NAME_TYPE_CIPHER_METH,
+                    get_legacy_cipher_names, namemap);
+    OBJ_NAME_do_all(OBJ_NAME_TYPE_MD_METH,
+                    get_legacy_md_names, namemap);
+
+    /* We also pilfer data from the legacy EVP_PKEY_ASN1_METHODs */
+    for (i = 0, end = EVP_PKEY_asn1_get_count(); i < end; i++)
+        get_legacy_pkey_meth_names(EVP_PKEY_asn1_get0(i), namemap);
+
+    if (!CRYPTO_THREAD_write_lock(namemap->lock))
+        return 0;
+    namemap->legacy_loaded = 1;
+    CRYPTO_THREAD_unlock(namemap->lock);
+    return 1;
+#else
+    return 0;
 #endif
+}
 
-    return namemap;
+/*-
+ * Constructors / destructors
+ * ==========================
+ */
+
+OSSL_NAMEMAP *ossl_namemap_stored(OSSL_LIB_CTX *libctx)
+{
+    return ossl_lib_ctx_get_data(libctx, OSSL_LIB_CTX_NAMEMAP_INDEX);
 }
 
 OSSL_NAMEMAP *ossl_namemap_new(void)
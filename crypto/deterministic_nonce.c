@@ -7,10 +7,10 @@
  * https://www.openssl.org/source/license.html
  */
 
+#include <string.h>
 #include <openssl/bn.h>
 #include <openssl/evp.h>
 #include <openssl/core_names.h>
-#include <openssl/kdf.h>
 #include <internal/deterministic_nonce.h>
 
 /*
@@ -58,83 +58,118 @@ static int int2octets(unsigned char *out, const BIGNUM *num, int rlen)
  *
  * Params:
  *     out The returned octet string.
+ *     z A BIGNUM to work in
  *     q The modulus
  *     qlen_bits The length of q in bits
  *     rlen The value of qlen_bits rounded up to the nearest 8 bits.
  *     in, inlen The input bit string (in bytes)
  * Returns: 1 if successful, or  0 otherwise.
  */
-static int bits2octets(unsigned char *out, const BIGNUM *q, int qlen_bits,
-                       int rlen, const unsigned char *in, size_t inlen)
+static int bits2octets(unsigned char *out, BIGNUM *z, const BIGNUM *q,
+                       int qlen_bits, int rlen, const unsigned char *in,
+                       size_t inlen)
 {
-   int ret = 0;
-   BIGNUM *z = BN_new();
-
-   if (z == NULL
-           || !bits2int(z, qlen_bits, in, inlen))
-       goto err;
-
-   /* z2 = z1 mod q (Do a simple subtract, since z1 < 2^qlen_bits) */
-   if (BN_cmp(z, q) >= 0
-           && !BN_usub(z, z, q))
-       goto err;
-
-   ret = int2octets(out, z, rlen);
-err:
-   BN_free(z);
-   return ret;
+    if (!bits2int(z, qlen_bits, in, inlen))
+        return 0;
+
+    /* z2 = z1 mod q (Do a simple subtract, since z1 < 2^qlen_bits) */
+    if (BN_cmp(z, q) >= 0
+            && !BN_usub(z, z, q))
+        return 0;
+
+    return int2octets(out, z, rlen);
 }
 
 /*
- * Setup a KDF HMAC_DRBG object using fixed entropy and nonce data.
- *
- * Params:
- *     digestname The digest name for the HMAC
- *     entropy, entropylen A fixed input entropy buffer
- *     nonce, noncelen A fixed input nonce buffer
- *     libctx, propq Are used for fetching algorithms
- *
- * Returns: The created KDF HMAC_DRBG object if successful, or NULL otherwise.
+ * The HMAC_DRBG of RFC 6979 Section 3.2 for one digest.  The HMAC and its
+ * digest are fetched once, and |k0| keeps the HMAC keyed with the all-zero
+ * K that every nonce starts from, so a signing context that keeps one of
+ * these for its digest has no algorithm to fetch and no key schedule to
+ * compute for that first step.
  */
-static EVP_KDF_CTX *kdf_setup(const char *digestname,
-                              const unsigned char *entropy, size_t entropylen,
-                              const unsigned char *nonce, size_t noncelen,
-                              OSSL_LIB_CTX *libctx, const char *propq)
+struct ossl_rfc6979_ctx_st {
+    EVP_MAC_CTX *k0;        /* Keyed with K = 0x00 0x00 ... 0x00 */
+    EVP_MAC_CTX *mac;       /* Keyed with the current K */
+    size_t hlen;
+};
+
+/* RFC 6979 orders of up to this many bytes need no allocation */
+#define RFC6979_MAX_STACK_BYTES 128
+
+OSSL_RFC6979_CTX *ossl_rfc6979_ctx_new(const char *digestname,
+                                       OSSL_LIB_CTX *libctx,
+                                       const char *propq)
 {
-    EVP_KDF_CTX *ctx = NULL;
-    EVP_KDF *kdf = NULL;
-    OSSL_PARAM params[5], *p;
+    OSSL_RFC6979_CTX *ctx;
+    EVP_MAC *mac;
+    EVP_MD *md;
+    OSSL_PARAM params[3], *p = params;
+    unsigned char zero[EVP_MAX_MD_SIZE] = { 0 };
 
-    kdf = EVP_KDF_fetch(libctx, "HMAC-DRBG-KDF", propq);
-    ctx = EVP_KDF_CTX_new(kdf);
-    EVP_KDF_free(kdf);
-    if (ctx == NULL)
+    if ((ctx = OPENSSL_zalloc(sizeof(*ctx))) == NULL)
+        return NULL;
+    md = EVP_MD_fetch(libctx, digestname, propq);
+    if (md == NULL)
+        goto err;
+    if ((EVP_MD_get_flags(md) & EVP_MD_FLAG_XOF) == 0)
+        ctx->hlen = EVP_MD_get_size(md);
+    EVP_MD_free(md);
+
+    mac = EVP_MAC_fetch(libctx, "HMAC", propq);
+    ctx->mac = EVP_MAC_CTX_new(mac);
+    EVP_MAC_free(mac);
+    if (ctx->mac == NULL)
         goto err;
 
-    p = params;
-    *p++ = OSSL_PARAM_construct_utf8_string(OSSL_KDF_PARAM_DIGEST,
+    *p++ = OSSL_PARAM_construct_utf8_string(OSSL_MAC_PARAM_DIGEST,
                                             (char *)digestname, 0);
     if (propq != NULL)
-        *p++ = OSSL_PARAM_construct_utf8_string(OSSL_KDF_PARAM_PROPERTIES,
+        *p++ = OSSL_PARAM_construct_utf8_string(OSSL_MAC_PARAM_PROPERTIES,
                                                 (char *)propq, 0);
-    *p++ = OSSL_PARAM_construct_octet_string(OSSL_KDF_PARAM_HMACDRBG_ENTROPY,
-                                             (void *)entropy, entropylen);
-    *p++ = OSSL_PARAM_construct_octet_string(OSSL_KDF_PARAM_HMACDRBG_NONCE,
-                                             (void *)nonce, noncelen);
     *p = OSSL_PARAM_construct_end();
-
-    if (EVP_KDF_CTX_set_params(ctx, params) <= 0)
+    if (!EVP_MAC_CTX_set_params(ctx->mac, params))
+        goto err;
+    if (ctx->hlen == 0 || ctx->hlen > sizeof(zero)
+            || (ctx->k0 = EVP_MAC_CTX_dup(ctx->mac)) == NULL
+            || !EVP_MAC_init(ctx->k0, zero, ctx->hlen, NULL))
         goto err;
-
     return ctx;
-err:
-    EVP_KDF_CTX_free(ctx);
+ err:
+    ossl_rfc6979_ctx_free(ctx);
     return NULL;
 }
 
+void ossl_rfc6979_ctx_free(OSSL_RFC6979_CTX *ctx)
+{
+    if (ctx == NULL)
+        return;
+    EVP_MAC_CTX_free(ctx->k0);
+    EVP_MAC_CTX_free(ctx->mac);
+    OPENSSL_free(ctx);
+}
+
+/*
+ * out = HMAC_K(V || sep || seed), leaving out |sep| and |seed| if NULL.
+ * K is |key| if that is not NULL, or else the key |mac| already has.
+ */
+static int rfc6979_hmac(EVP_MAC_CTX *mac, const unsigned char *key,
+                        const unsigned char *v, size_t hlen,
+                        const unsigned char *sep,
+                        const unsigned char *seed, size_t seedlen,
+                        unsigned char *out)
+{
+    size_t outl;
+
+    return EVP_MAC_init(mac, key, key != NULL ? hlen : 0, NULL)
+           && EVP_MAC_update(mac, v, hlen)
+           && (sep == NULL || EVP_MAC_update(mac, sep, 1))
+           && (seed == NULL || EVP_MAC_update(mac, seed, seedlen))
+           && EVP_MAC_final(mac, out, &outl, hlen);
+}
+
 /*
  * Generate a Deterministic nonce 'k' for DSA/ECDSA as defined in
- * RFC 6979 Section 3.3.  "Alternate Description of the Generation of k"
+ * RFC 6979 Section 3.2, with the HMAC_DRBG steps written out.
  *
  * Params:
  *     out Returns the generated deterministic nonce 'k'
@@ -143,6 +178,8 @@ err:
  *     hm, hmlen The digested message buffer in bytes
  *     digestname The digest name used for signing. It is used as the HMAC digest.
  *     libctx, propq Used for fetching algorithms
+ *     ctx If not NULL, an OSSL_RFC6979_CTX made for |digestname| to use
+ *         instead of fetching the HMAC afresh
  *
  * Returns: 1 if successful, or  0 otherwise.
  */
@@ -151,12 +188,16 @@ int ossl_gen_deterministic_nonce_rfc6979(BIGNUM *out, const BIGNUM *q,
                                          const unsigned char *hm, size_t hmlen,
                                          const char *digestname,
                                          OSSL_LIB_CTX *libctx,
-                                         const char *propq)
+                                         const char *propq,
+                                         OSSL_RFC6979_CTX *ctx)
 {
-    EVP_KDF_CTX *kdfctx = NULL;
+    static const unsigned char sep0 = 0x00, sep1 = 0x01;
+    OSSL_RFC6979_CTX *tmpctx = NULL;
     int ret = 0, rlen = 0, qlen_bits = 0;
-    unsigned char *entropyx = NULL, *nonceh = NULL, *T = NULL;
-    size_t allocsz = 0;
+    unsigned char stackbuf[3 * RFC6979_MAX_STACK_BYTES];
+    unsigned char K[EVP_MAX_MD_SIZE], V[EVP_MAX_MD_SIZE];
+    unsigned char *entropyx = NULL, *T = NULL;
+    size_t allocsz = 0, hlen, tlen;
 
     if (out == NULL)
         return 0;
@@ -165,34 +206,62 @@ int ossl_gen_deterministic_nonce_rfc6979(BIGNUM *out, const BIGNUM *q,
     if (qlen_bits == 0)
         return 0;
 
+    if (ctx == NULL) {
+        ctx = tmpctx = ossl_rfc6979_ctx_new(digestname, libctx, propq);
+        if (ctx == NULL)
+            return 0;
+    }
+    hlen = ctx->hlen;
+
     /* Note rlen used here is in bytes since the input values are byte arrays */
     rlen = (qlen_bits + 7) / 8;
     allocsz = 3 * rlen;
 
-    /* Use a single alloc for the buffers T, nonceh and entropyx */
-    T = (unsigned char *)OPENSSL_zalloc(allocsz);
-    if (T == NULL)
-        return 0;
-    nonceh = T + rlen;
-    entropyx = nonceh + rlen;
+    /* Use a single buffer for entropyx, nonceh (which follows it) and T */
+    if (allocsz <= sizeof(stackbuf))
+        entropyx = stackbuf;
+    else if ((entropyx = OPENSSL_malloc(allocsz)) == NULL)
+        goto end;
+    T = entropyx + 2 * rlen;
 
     if (!int2octets(entropyx, priv, rlen)
-            || !bits2octets(nonceh, q, qlen_bits, rlen, hm, hmlen))
+            || !bits2octets(entropyx + rlen, out, q, qlen_bits, rlen,
+                            hm, hmlen))
         goto end;
 
-    kdfctx = kdf_setup(digestname, entropyx, rlen, nonceh, rlen, libctx, propq);
-    if (kdfctx == NULL)
+    /* Steps b to g, with the HMAC keyed with K = 0x00 ... 0x00 to hand */
+    memset(V, 0x01, hlen);
+    if (!rfc6979_hmac(ctx->k0, NULL, V, hlen, &sep0, entropyx, 2 * rlen, K)
+            || !rfc6979_hmac(ctx->mac, K, V, hlen, NULL, NULL, 0, V)
+            || !rfc6979_hmac(ctx->mac, NULL, V, hlen, &sep1,
+                             entropyx, 2 * rlen, K)
+            || !rfc6979_hmac(ctx->mac, K, V, hlen, NULL, NULL, 0, V))
         goto end;
 
-    do {
-        if (!EVP_KDF_derive(kdfctx, T, rlen, NULL)
-                || !bits2int(out, qlen_bits, T, rlen))
+    /* Step h */
+    for (;;) {
+        for (tlen = 0; tlen < (size_t)rlen; tlen += hlen) {
+            if (!rfc6979_hmac(ctx->mac, NULL, V, hlen, NULL, NULL, 0, V))
+                goto end;
+            memcpy(T + tlen, V, rlen - tlen < hlen ? rlen - tlen : hlen);
+        }
+        if (!bits2int(out, qlen_bits, T, rlen))
+            goto end;
+        if (!BN_is_zero(out) && !BN_is_one(out) && BN_cmp(out, q) < 0)
+            break;
+        if (!rfc6979_hmac(ctx->mac, NULL, V, hlen, &sep0, NULL, 0, K)
+                || !rfc6979_hmac(ctx->mac, K, V, hlen, NULL, NULL, 0, V))
             goto end;
-    } while (BN_is_zero(out) || BN_is_one(out) || BN_cmp(out, q) >= 0);
+    }
     ret = 1;
 
 end:
-    EVP_KDF_CTX_free(kdfctx);
-    OPENSSL_clear_free(T, allocsz);
+    ossl_rfc6979_ctx_free(tmpctx);
+    OPENSSL_cleanse(K, sizeof(K));
+    OPENSSL_cleanse(V, sizeof(V));
+    if (entropyx == stackbuf)
+        OPENSSL_cleanse(stackbuf, allocsz);
+    else
+        OPENSSL_clear_free(entropyx, allocsz);
     return ret;
 }
@@ -23,6 +23,7 @@
 #include <openssl/objects.h>
 #include <internal/nelem.h>
 #include <crypto/dh.h>
+#include <crypto/context.h>
 
 static DH *dh_param_init(OSSL_LIB_CTX *libctx, const DH_NAMED_GROUP *group)
 {
@@ -90,6 +91,116 @@ int ossl_dh_is_named_safe_prime_group(const DH *dh)
     return (id > 3);
 }
 
+/*
+ * Comb tables for fixed-base exponentiation in the named safe-prime groups.
+ * Each is made the first time a key is generated in its group and then kept
+ * with the library context, read-only, for every later key.
+ */
+#define DH_COMB_GROUPS 16     /* Room for each of the named safe-prime groups */
+
+typedef struct {
+    CRYPTO_RWLOCK *lock;
+    struct {
+        int nid;
+        BN_COMB *comb;
+    } group[DH_COMB_GROUPS];
+} DH_COMBS;
+
+void *ossl_dh_combs_new(OSSL_LIB_CTX *libctx)
+{
+    DH_COMBS *combs = OPENSSL_zalloc(sizeof(*combs));
+
+    if (combs == NULL)
+        return NULL;
+    if ((combs->lock = CRYPTO_THREAD_lock_new()) == NULL) {
+        OPENSSL_free(combs);
+        return NULL;
+    }
+    return combs;
+}
+
+void ossl_dh_combs_free(void *vcombs)
+{
+    DH_COMBS *combs = vcombs;
+    size_t i;
+
+    if (combs == NULL)
+        return;
+    for (i = 0; i < OSSL_NELEM(combs->group); i++)
+        ossl_bn_comb_free(combs->group[i].comb);
+    CRYPTO_THREAD_lock_free(combs->lock);
+    OPENSSL_free(combs);
+}
+
+static BN_COMB *dh_combs_find(DH_COMBS *combs, int nid)
+{
+    size_t i;
+
+    for (i = 0; i < OSSL_NELEM(combs->group); i++)
+        if (combs->group[i].nid == nid)
+            return combs->group[i].comb;
+    return NULL;
+}
+
+/*
+ * Returns the comb table for g = 2 in the named safe-prime group of |dh|,
+ * covering every private key of up to the group's default length, or
+ * NULL if |dh| is not in such a group or the table cannot be made.
+ */
+const BN_COMB *ossl_dh_get0_named_group_comb(const DH *dh, BN_CTX *ctx)
+{
+    const DH_NAMED_GROUP *group;
+    DH_COMBS *combs;
+    BN_COMB *comb, *made;
+    int nid = DH_get_nid(dh);
+    size_t i;
+
+    if (!ossl_dh_is_named_safe_prime_group(dh)
+            || (group = ossl_ffc_uid_to_dh_named_group(nid)) == NULL
+            || ossl_ffc_named_group_get_keylength(group) <= 0
+            || !BN_is_word(dh->params.g, DH_GENERATOR_2)
+            || BN_cmp(dh->params.p, ossl_ffc_named_group_get_p(group)) != 0)
+        return NULL;
+    combs = ossl_lib_ctx_get_data(dh->libctx, OSSL_LIB_CTX_DH_COMB_INDEX);
+    if (combs == NULL)
+        return NULL;
+
+    if (!CRYPTO_THREAD_read_lock(combs->lock))
+        return NULL;
+    comb = dh_combs_find(combs, nid);
+    CRYPTO_THREAD_unlock(combs->lock);
+    if (comb != NULL)
+        return comb;
+
+    /* Without a table the caller falls back to a plain exponentiation */
+    ERR_set_mark();
+    made = ossl_bn_comb_new(dh->params.g, dh->params.p,
+                            ossl_ffc_named_group_get_keylength(group) + 1,
+                            ctx);
+    ERR_pop_to_mark();
+    if (made == NULL)
+        return NULL;
+
+    if (!CRYPTO_THREAD_write_lock(combs->lock)) {
+        ossl_bn_comb_free(made);
+        return NULL;
+    }
+    /* Another thread may have made one meanwhile */
+    if ((comb = dh_combs_find(combs, nid)) == NULL) {
+        for (i = 0; i < OSSL_NELEM(combs->group); i++) {
+            if (combs->group[i].nid == NID_undef) {
+                combs->group[i].nid = nid;
+                combs->group[i].comb = comb = made;
+                made = NULL;
+                break;
+            }
+        }
+    }
+    CRYPTO_THREAD_unlock(combs->lock);
+    ossl_bn_comb_free(made);
+    return comb;
+}
+
 int DH_get_nid(const DH *dh)
 {
     if (dh == NULL)
@@ -226,12 +226,27 @@ int DH_generate_key(DH *dh)
 #endif
 }
 
+/*
+ * The most bits a private key made by generate_key() for the parameters of
+ * |dh| can have, or 0 if the parameters do not limit it.
+ * ossl_ffc_generate_private_key() returns a key in [1, 2^N], so that is one
+ * more than N.
+ */
+static int dh_max_priv_key_bits(const DH *dh)
+{
+    int n = dh->length != 0 ? dh->length : dh->params.keylength;
+
+    return n > 0 ? n + 1 : 0;
+}
+
 int ossl_dh_generate_public_key(BN_CTX *ctx, const DH *dh,
                                 const BIGNUM *priv_key, BIGNUM *pub_key)
 {
     int ret = 0;
     BIGNUM *prk = BN_new();
     BN_MONT_CTX *mont = NULL;
+    const BN_COMB *comb;
+    int bits;
 
     if (prk == NULL)
         return 0;
@@ -252,10 +267,25 @@ int ossl_dh_generate_public_key(BN_CTX *ctx, const DH *dh,
     }
     BN_with_flags(prk, priv_key, BN_FLG_CONSTTIME);
 
-    /* pub_key = g^priv_key mod p */
-    if (!dh->meth->bn_mod_exp(dh, pub_key, dh->params.g, prk, dh->params.p,
-                              ctx, mont))
+    /*
+     * pub_key = g^priv_key mod p, from a table of powers of g when p is a
+     * named group and the table covers every key the parameters allow.
+     * That is decided from the parameters alone, and the exponent is always
+     * padded to the width of the table.  Only a key longer than its
+     * parameters allow, which cannot have come from generate_key(), takes
+     * the plain exponentiation instead.
+     */
+    if (dh->meth->bn_mod_exp == dh_bn_mod_exp
+            && (bits = dh_max_priv_key_bits(dh)) > 0
+            && (comb = ossl_dh_get0_named_group_comb(dh, ctx)) != NULL
+            && bits <= ossl_bn_comb_bits(comb)
+            && BN_num_bits(prk) <= bits) {
+        if (!ossl_bn_mod_exp_comb(pub_key, prk, comb, ctx))
+            goto err;
+    } else if (!dh->meth->bn_mod_exp(dh, pub_key, dh->params.g, prk,
+                                     dh->params.p, ctx, mont)) {
         goto err;
+    }
     ret = 1;
 err:
     BN_clear_free(prk);
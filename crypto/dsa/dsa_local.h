@@ -10,6 +10,7 @@
 #include <openssl/dsa.h>
 #include <internal/refcount.h>
 #include <internal/ffc.h>
+#include <internal/deterministic_nonce.h>
 
 struct dsa_st {
     /*
@@ -71,4 +72,5 @@ struct dsa_method {
 
 DSA_SIG *ossl_dsa_do_sign_int(const unsigned char *dgst, int dlen, DSA *dsa,
                               unsigned int nonce_type, const char *digestname,
-                              OSSL_LIB_CTX *libctx, const char *propq);
+                              OSSL_LIB_CTX *libctx, const char *propq,
+                              OSSL_RFC6979_CTX *nonce_ctx);
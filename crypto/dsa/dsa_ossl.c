@@ -31,7 +31,8 @@ static int dsa_sign_setup_no_digest(DSA *dsa, BN_CTX *ctx_in, BIGNUM **kinvp,
 static int dsa_sign_setup(DSA *dsa, BN_CTX *ctx_in, BIGNUM **kinvp,
                           BIGNUM **rp, const unsigned char *dgst, int dlen,
                           unsigned int nonce_type, const char *digestname,
-                          OSSL_LIB_CTX *libctx, const char *propq);
+                          OSSL_LIB_CTX *libctx, const char *propq,
+                          OSSL_RFC6979_CTX *nonce_ctx);
 static int dsa_do_verify(const unsigned char *dgst, int dgst_len,
                          DSA_SIG *sig, DSA *dsa);
 static int dsa_init(DSA *dsa);
@@ -75,7 +76,8 @@ const DSA_METHOD *DSA_OpenSSL(void)
 
 DSA_SIG *ossl_dsa_do_sign_int(const unsigned char *dgst, int dlen, DSA *dsa,
                               unsigned int nonce_type, const char *digestname,
-                              OSSL_LIB_CTX *libctx, const char *propq)
+                              OSSL_LIB_CTX *libctx, const char *propq,
+                              OSSL_RFC6979_CTX *nonce_ctx)
 {
     BIGNUM *kinv = NULL;
     BIGNUM *m, *blind, *blindm, *tmp;
@@ -116,7 +118,7 @@ DSA_SIG *ossl_dsa_do_sign_int(const unsigned char *dgst, int dlen, DSA *dsa,
 
  redo:
     if (!dsa_sign_setup(dsa, ctx, &kinv, &ret->r, dgst, dlen,
-                        nonce_type, digestname, libctx, propq))
+                        nonce_type, digestname, libctx, propq, nonce_ctx))
         goto err;
 
     if (dlen > BN_num_bytes(dsa->params.q))
@@ -204,21 +206,22 @@ DSA_SIG *ossl_dsa_do_sign_int(const unsigned char *dgst, int dlen, DSA *dsa,
 static DSA_SIG *dsa_do_sign(const unsigned char *dgst, int dlen, DSA *dsa)
 {
     return ossl_dsa_do_sign_int(dgst, dlen, dsa,
-                                0, NULL, NULL, NULL);
+                                0, NULL, NULL, NULL, NULL);
 }
 
 static int dsa_sign_setup_no_digest(DSA *dsa, BN_CTX *ctx_in,
                                     BIGNUM **kinvp, BIGNUM **rp)
 {
     return dsa_sign_setup(dsa, ctx_in, kinvp, rp, NULL, 0,
-                          0, NULL, NULL, NULL);
+                          0, NULL, NULL, NULL, NULL);
 }
 
 static int dsa_sign_setup(DSA *dsa, BN_CTX *ctx_in,
                           BIGNUM **kinvp, BIGNUM **rp,
                           const unsigned char *dgst, int dlen,
                           unsigned int nonce_type, const char *digestname,
-                          OSSL_LIB_CTX *libctx, const char *propq)
+                          OSSL_LIB_CTX *libctx, const char *propq,
+                          OSSL_RFC6979_CTX *nonce_ctx)
 {
     BN_CTX *ctx = NULL;
     BIGNUM *k, *kinv = NULL, *r = *rp;
@@ -274,7 +277,8 @@ static int dsa_sign_setup(DSA *dsa, BN_CTX *ctx_in,
                                                           dsa->priv_key,
                                                           dgst, dlen,
                                                           digestname,
-                                                          libctx, propq))
+                                                          libctx, propq,
+                                                          nonce_ctx))
 #endif
                     goto err;
             } else {
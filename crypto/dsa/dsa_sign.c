@@ -153,7 +153,8 @@ int DSA_SIG_set0(DSA_SIG *sig, BIGNUM *r, BIGNUM *s)
 int ossl_dsa_sign_int(int type, const unsigned char *dgst, int dlen,
                       unsigned char *sig, unsigned int *siglen, DSA *dsa,
                       unsigned int nonce_type, const char *digestname,
-                      OSSL_LIB_CTX *libctx, const char *propq)
+                      OSSL_LIB_CTX *libctx, const char *propq,
+                      OSSL_RFC6979_CTX *nonce_ctx)
 {
     DSA_SIG *s;
 
@@ -167,7 +168,8 @@ int ossl_dsa_sign_int(int type, const unsigned char *dgst, int dlen,
         s = DSA_do_sign(dgst, dlen, dsa);
     else
         s = ossl_dsa_do_sign_int(dgst, dlen, dsa,
-                                 nonce_type, digestname, libctx, propq);
+                                 nonce_type, digestname, libctx, propq,
+                                 nonce_ctx);
     if (s == NULL) {
         *siglen = 0;
         return 0;
@@ -181,7 +183,7 @@ int DSA_sign(int type, const unsigned char *dgst, int dlen,
              unsigned char *sig, unsigned int *siglen, DSA *dsa)
 {
     return ossl_dsa_sign_int(type, dgst, dlen, sig, siglen, dsa,
-                             0, NULL, NULL, NULL);
+                             0, NULL, NULL, NULL, NULL);
 }
 
 /* data has already been hashed (probably with SHA or SHA-1). */
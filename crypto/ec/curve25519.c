@@ -18,6 +18,7 @@
 #include "ec_local.h"
 #include <openssl/evp.h>
 #include <openssl/sha.h>
+#include <openssl/rand.h>
 
 #include <internal/numbers.h>
 
@@ -5540,6 +5541,43 @@ err:
 
 static const char allzeroes[15];
 
+/*
+ * Check 0 <= s < L where L = 2^252 + 27742317777372353535851937790883648493
+ *
+ * If not the signature is publicly invalid. Since it's public we can do the
+ * check in variable time.
+ */
+static int sc_is_reduced(const uint8_t *s)
+{
+    int i;
+    /* 27742317777372353535851937790883648493 in little endian format */
+    const uint8_t l_low[16] = {
+        0xED, 0xD3, 0xF5, 0x5C, 0x1A, 0x63, 0x12, 0x58, 0xD6, 0x9C, 0xF7, 0xA2,
+        0xDE, 0xF9, 0xDE, 0x14
+    };
+
+    /* First check the most significant byte */
+    if (s[31] > 0x10)
+        return 0;
+    if (s[31] == 0x10) {
+        /*
+         * Most significant byte indicates a value close to 2^252 so check the
+         * rest
+         */
+        if (memcmp(s + 16, allzeroes, sizeof(allzeroes)) != 0)
+            return 0;
+        for (i = 15; i >= 0; i--) {
+            if (s[i] < l_low[i])
+                break;
+            if (s[i] > l_low[i])
+                return 0;
+        }
+        if (i < 0)
+            return 0;
+    }
+    return 1;
+}
+
 int
 ossl_ed25519_verify(const uint8_t *tbs, size_t tbs_len,
                     const uint8_t signature[64], const uint8_t public_key[32],
@@ -5547,7 +5585,6 @@ ossl_ed25519_verify(const uint8_t *tbs, size_t tbs_len,
                     const uint8_t *context, size_t context_len,
                     OSSL_LIB_CTX *libctx, const char *propq)
 {
-    int i;
     ge_p3 A;
     const uint8_t *r, *s;
     EVP_MD *sha512;
@@ -5557,11 +5594,6 @@ ossl_ed25519_verify(const uint8_t *tbs, size_t tbs_len,
     ge_p2 R;
     uint8_t rcheck[32];
     uint8_t h[SHA512_DIGEST_LENGTH];
-    /* 27742317777372353535851937790883648493 in little endian format */
-    const uint8_t l_low[16] = {
-        0xED, 0xD3, 0xF5, 0x5C, 0x1A, 0x63, 0x12, 0x58, 0xD6, 0x9C, 0xF7, 0xA2,
-        0xDE, 0xF9, 0xDE, 0x14
-    };
 
     if (context == NULL)
         context_len = 0;
@@ -5577,32 +5609,8 @@ ossl_ed25519_verify(const uint8_t *tbs, size_t tbs_len,
     r = signature;
     s = signature + 32;
 
-    /*
-     * Check 0 <= s < L where L = 2^252 + 27742317777372353535851937790883648493
-     *
-     * If not the signature is publicly invalid. Since it's public we can do the
-     * check in variable time.
-     *
-     * First check the most significant byte
-     */
-    if (s[31] > 0x10)
+    if (!sc_is_reduced(s))
         return 0;
-    if (s[31] == 0x10) {
-        /*
-         * Most significant byte indicates a value close to 2^252 so check the
-         * rest
-         */
-        if (memcmp(s + 16, allzeroes, sizeof(allzeroes)) != 0)
-            return 0;
-        for (i = 15; i >= 0; i--) {
-            if (s[i] < l_low[i])
-                break;
-            if (s[i] > l_low[i])
-                return 0;
-        }
-        if (i < 0)
-            return 0;
-    }
 
     if (ge_frombytes_vartime(&A, public_key) != 0) {
         return 0;
@@ -5646,6 +5654,371 @@ err:
     return res;
 }
 
+/*
+ * ossl_ed25519_verify() compares the encoding of the point it computes with R,
+ * so only a canonical encoding of R can be accepted: y < p, and the sign bit
+ * clear when x = 0.
+ */
+static int ge_frombytes_canonical_vartime(ge_p3 *h, const uint8_t *s)
+{
+    int i;
+
+    if ((s[31] & 0x7f) == 0x7f && s[0] >= 0xed) {
+        for (i = 30; i > 0 && s[i] == 0xff; i--)
+            continue;
+        if (i == 0)
+            return -1;
+    }
+    if (ge_frombytes_vartime(h, s) != 0)
+        return -1;
+    if ((s[31] >> 7) != 0 && !fe_isnonzero(h->X))
+        return -1;
+    return 0;
+}
+
+/* The largest window ge_multi_scalarmult_vartime() uses, in bits */
+#define MSM_MAX_WINDOW 10
+
+/*
+ * Recode the scalar |k| < 2^253 into |nwin| signed digits of |c| bits, each
+ * in the range [-2^(c-1) + 1, 2^(c-1)].
+ */
+static void sc_recode_signed(int16_t *digits, const uint8_t *k, int c,
+                             int nwin)
+{
+    int i, bit, carry = 0, digit;
+    uint32_t w;
+
+    for (i = 0; i < nwin; i++) {
+        bit = i * c;
+        w = 0;
+        if (bit < 256) {
+            w = k[bit >> 3];
+            if ((bit >> 3) + 1 < 32)
+                w |= (uint32_t)k[(bit >> 3) + 1] << 8;
+            if ((bit >> 3) + 2 < 32)
+                w |= (uint32_t)k[(bit >> 3) + 2] << 16;
+            w >>= bit & 7;
+        }
+        digit = (int)(w & ((1U << c) - 1)) + carry;
+        carry = digit > (1 << (c - 1));
+        if (carry)
+            digit -= 1 << c;
+        digits[i] = (int16_t)digit;
+    }
+}
+
+/*
+ * r = k[0] * P[0] + ... + k[n-1] * P[n-1] for scalars below 2^253, using
+ * Pippenger's bucket method.  Runs in variable time, so must only be used
+ * with public inputs.  Returns 0 on allocation failure.
+ */
+static int ge_multi_scalarmult_vartime(ge_p3 *r, const ge_p3 *P,
+                                       const uint8_t (*k)[32], size_t n)
+{
+    int c, best_c = 2, nwin, nbuckets, w, j, digit, started;
+    size_t i, cost, best_cost = SIZE_MAX;
+    int16_t *digits = NULL;
+    ge_cached *Pc = NULL;
+    ge_p3 *bucket = NULL;
+    unsigned char *used = NULL;
+    ge_p3 running, sum;
+    ge_cached tc;
+    ge_p1p1 t;
+    ge_p2 q;
+    int ret = 0;
+
+    /* Each window costs one addition per point and two per bucket */
+    for (c = 2; c <= MSM_MAX_WINDOW; c++) {
+        cost = (size_t)(253 / c + 1) * (n + ((size_t)1 << c));
+        if (cost < best_cost) {
+            best_cost = cost;
+            best_c = c;
+        }
+    }
+    c = best_c;
+    nwin = 253 / c + 1;
+    nbuckets = 1 << (c - 1);
+
+    if (n > SIZE_MAX / sizeof(*digits) / nwin || n > SIZE_MAX / sizeof(*Pc))
+        return 0;
+    digits = OPENSSL_malloc(n * nwin * sizeof(*digits));
+    Pc = OPENSSL_malloc(n * sizeof(*Pc));
+    bucket = OPENSSL_malloc(nbuckets * sizeof(*bucket));
+    used = OPENSSL_malloc(nbuckets);
+    if (digits == NULL || Pc == NULL || bucket == NULL || used == NULL)
+        goto err;
+
+    for (i = 0; i < n; i++) {
+        sc_recode_signed(digits + i * nwin, k[i], c, nwin);
+        ge_p3_to_cached(&Pc[i], &P[i]);
+    }
+
+    ge_p3_0(r);
+    for (w = nwin - 1; w >= 0; w--) {
+        if (w != nwin - 1) {
+            ge_p3_to_p2(&q, r);
+            for (j = 1; j < c; j++) {
+                ge_p2_dbl(&t, &q);
+                ge_p1p1_to_p2(&q, &t);
+            }
+            ge_p2_dbl(&t, &q);
+            ge_p1p1_to_p3(r, &t);
+        }
+
+        memset(used, 0, nbuckets);
+        for (i = 0; i < n; i++) {
+            digit = digits[i * nwin + w];
+            if (digit == 0)
+                continue;
+            j = (digit > 0 ? digit : -digit) - 1;
+            if (!used[j]) {
+                bucket[j] = P[i];
+                if (digit < 0) {
+                    fe_neg(bucket[j].X, bucket[j].X);
+                    fe_neg(bucket[j].T, bucket[j].T);
+                }
+                used[j] = 1;
+                continue;
+            }
+            if (digit > 0)
+                ge_add(&t, &bucket[j], &Pc[i]);
+            else
+                ge_sub(&t, &bucket[j], &Pc[i]);
+            ge_p1p1_to_p3(&bucket[j], &t);
+        }
+
+        /* sum = 1 * bucket[0] + 2 * bucket[1] + ... as a running sum */
+        started = 0;
+        for (j = nbuckets - 1; j >= 0; j--) {
+            if (used[j]) {
+                if (started) {
+                    ge_p3_to_cached(&tc, &bucket[j]);
+                    ge_add(&t, &running, &tc);
+                    ge_p1p1_to_p3(&running, &t);
+                } else {
+                    running = bucket[j];
+                    sum = bucket[j];
+                    started = 1;
+                    continue;
+                }
+            }
+            if (started) {
+                ge_p3_to_cached(&tc, &running);
+                ge_add(&t, &sum, &tc);
+                ge_p1p1_to_p3(&sum, &t);
+            }
+        }
+        if (started) {
+            ge_p3_to_cached(&tc, &sum);
+            ge_add(&t, r, &tc);
+            ge_p1p1_to_p3(r, &t);
+        }
+    }
+    ret = 1;
+ err:
+    OPENSSL_free(digits);
+    OPENSSL_free(Pc);
+    OPENSSL_free(bucket);
+    OPENSSL_free(used);
+    return ret;
+}
+
+typedef struct {
+    uint8_t h[32];      /* SHA512(dom2 || R || A || M) mod L */
+    size_t key;         /* index of A among the distinct keys */
+} ED25519_BATCH_ITEM;
+
+/*
+ * Verify |n| signatures at once.  A NULL entry in |signatures| counts as an
+ * invalid signature.
+ *
+ * The batch is checked with a random linear combination of the cofactored
+ * verification equations of RFC 8032, section 5.1.7:
+ *
+ *   [8]([z_0 * s_0 + ...]B - [z_0]R_0 - [z_0 * h_0]A_0 - ...) == 0
+ *
+ * using random 128 bit z_i and one multi-scalar multiplication, in which the
+ * terms for the same public key are merged.  If that fails, each signature is
+ * checked with the strict equation of ossl_ed25519_verify() to find the bad
+ * ones.
+ *
+ * An honestly generated signature is accepted or rejected exactly as
+ * ossl_ed25519_verify() would.  The two can only disagree about a signature
+ * or key that was crafted with a small order component, which the cofactored
+ * equation ignores.
+ *
+ * Returns 1 if every signature is valid and 0 otherwise, with the result for
+ * each signature in |results|.
+ */
+int
+ossl_ed25519_verify_batch(size_t n, const uint8_t *const *tbs,
+                          const size_t *tbs_len,
+                          const uint8_t *const *signatures,
+                          const uint8_t *const *public_keys, int *results,
+                          const uint8_t dom2flag, const uint8_t phflag,
+                          const uint8_t csflag, const uint8_t *context,
+                          size_t context_len, OSSL_LIB_CTX *libctx,
+                          const char *propq)
+{
+    ED25519_BATCH_ITEM *item = NULL;
+    ge_p3 *P = NULL;
+    uint8_t (*k)[32] = NULL;
+    uint8_t *z = NULL;
+    const uint8_t **keybytes = NULL;
+    size_t *slot = NULL;
+    size_t nslots, nvalid = 0, nkeys = 0, i, j, s;
+    const uint8_t *r, *sig;
+    uint8_t b[32], rcheck[32], h[SHA512_DIGEST_LENGTH];
+    ge_p3 Q, sB;
+    ge_p2 R;
+    ge_cached tc;
+    ge_p1p1 t;
+    fe check;
+    EVP_MD *sha512 = NULL;
+    EVP_MD_CTX *hash_ctx = NULL;
+    unsigned int sz;
+    int ok = 1;
+
+    if (context == NULL)
+        context_len = 0;
+
+    if ((csflag && context_len == 0) || (!dom2flag && context_len > 0)) {
+        for (i = 0; i < n; i++)
+            results[i] = 0;
+        return n == 0;
+    }
+    if (n == 0)
+        return 1;
+
+    /* P and k hold 2 * n entries, slot at most 4 * n */
+    if (n > SIZE_MAX / 4 / sizeof(*P))
+        goto fallback;
+    for (nslots = 16; nslots < 2 * n; nslots <<= 1)
+        continue;
+    item = OPENSSL_malloc(n * sizeof(*item));
+    P = OPENSSL_malloc(2 * n * sizeof(*P));
+    k = OPENSSL_malloc(2 * n * sizeof(*k));
+    z = OPENSSL_malloc(n * 16);
+    keybytes = OPENSSL_malloc(n * sizeof(*keybytes));
+    slot = OPENSSL_malloc(nslots * sizeof(*slot));
+    sha512 = EVP_MD_fetch(libctx, SN_sha512, propq);
+    hash_ctx = EVP_MD_CTX_new();
+    if (item == NULL || P == NULL || k == NULL || z == NULL
+            || keybytes == NULL || slot == NULL || sha512 == NULL
+            || hash_ctx == NULL)
+        goto fallback;
+    for (s = 0; s < nslots; s++)
+        slot[s] = SIZE_MAX;
+
+    /*
+     * Decode and hash everything.  The points -R_i are collected at the
+     * start of P, and the distinct -A from P[n] on, with their scalars at the
+     * same positions in k.
+     */
+    for (i = 0; i < n; i++) {
+        results[i] = 0;
+        sig = signatures[i];
+        if (sig == NULL || !sc_is_reduced(sig + 32)
+                || ge_frombytes_canonical_vartime(&P[nvalid], sig) != 0)
+            continue;
+
+        s = load_4(public_keys[i]) & (nslots - 1);
+        for (; slot[s] != SIZE_MAX; s = (s + 1) & (nslots - 1))
+            if (memcmp(keybytes[slot[s]], public_keys[i], 32) == 0)
+                break;
+        if (slot[s] == SIZE_MAX) {
+            if (ge_frombytes_vartime(&P[n + nkeys], public_keys[i]) != 0)
+                continue;
+            fe_neg(P[n + nkeys].X, P[n + nkeys].X);
+            fe_neg(P[n + nkeys].T, P[n + nkeys].T);
+            memset(k[n + nkeys], 0, sizeof(k[0]));
+            keybytes[nkeys] = public_keys[i];
+            slot[s] = nkeys++;
+        }
+        item[i].key = slot[s];
+
+        if (!hash_init_with_dom(hash_ctx, sha512, dom2flag, phflag, context,
+                                context_len)
+            || !EVP_DigestUpdate(hash_ctx, sig, 32)
+            || !EVP_DigestUpdate(hash_ctx, public_keys[i], 32)
+            || !EVP_DigestUpdate(hash_ctx, tbs[i], tbs_len[i])
+            || !EVP_DigestFinal_ex(hash_ctx, h, &sz))
+            goto fallback;
+        x25519_sc_reduce(h);
+        memcpy(item[i].h, h, sizeof(item[i].h));
+
+        fe_neg(P[nvalid].X, P[nvalid].X);
+        fe_neg(P[nvalid].T, P[nvalid].T);
+        nvalid++;
+        results[i] = 1;
+    }
+    if (nvalid == 0)
+        goto end;
+
+    if (RAND_bytes_ex(libctx, z, nvalid * 16, 0) <= 0)
+        goto fallback;
+
+    memset(b, 0, sizeof(b));
+    for (i = 0, j = 0; i < n; i++) {
+        if (!results[i])
+            continue;
+        memset(k[j], 0, sizeof(k[j]));
+        memcpy(k[j], z + 16 * j, 16);
+        sc_muladd(k[n + item[i].key], k[j], item[i].h, k[n + item[i].key]);
+        sc_muladd(b, k[j], signatures[i] + 32, b);
+        j++;
+    }
+    memmove(P + nvalid, P + n, nkeys * sizeof(*P));
+    memmove(k + nvalid, k + n, nkeys * sizeof(*k));
+
+    if (!ge_multi_scalarmult_vartime(&Q, P, (const uint8_t (*)[32])k,
+                                     nvalid + nkeys))
+        goto fallback;
+    ge_scalarmult_base(&sB, b);
+    ge_p3_to_cached(&tc, &sB);
+    ge_add(&t, &Q, &tc);
+    ge_p1p1_to_p2(&R, &t);
+    for (j = 0; j < 3; j++) {
+        ge_p2_dbl(&t, &R);
+        ge_p1p1_to_p2(&R, &t);
+    }
+    fe_sub(check, R.Y, R.Z);
+    if (!fe_isnonzero(R.X) && !fe_isnonzero(check))
+        goto end;
+
+    /* Something is wrong, find out what */
+    for (i = 0; i < n; i++) {
+        if (!results[i])
+            continue;
+        r = signatures[i];
+        ge_double_scalarmult_vartime(&R, item[i].h, &P[nvalid + item[i].key],
+                                     r + 32);
+        ge_tobytes(rcheck, &R);
+        results[i] = CRYPTO_memcmp(rcheck, r, sizeof(rcheck)) == 0;
+    }
+    goto end;
+
+ fallback:
+    for (i = 0; i < n; i++)
+        results[i] = signatures[i] != NULL
+            && ossl_ed25519_verify(tbs[i], tbs_len[i], signatures[i],
+                                   public_keys[i], dom2flag, phflag, csflag,
+                                   context, context_len, libctx, propq);
+ end:
+    for (i = 0; i < n; i++)
+        ok &= results[i];
+    OPENSSL_free(item);
+    OPENSSL_free(P);
+    OPENSSL_free(k);
+    OPENSSL_free(z);
+    OPENSSL_free(keybytes);
+    OPENSSL_free(slot);
+    EVP_MD_free(sha512);
+    EVP_MD_CTX_free(hash_ctx);
+    return ok;
+}
+
 int
 ossl_ed25519_public_from_private(OSSL_LIB_CTX *ctx, uint8_t out_public_key[32],
                                  const uint8_t private_key[32],
@@ -5715,3 +6088,71 @@ ossl_x25519_public_from_private(uint8_t out_public_value[32],
 
     OPENSSL_cleanse(e, sizeof(e));
 }
+
+#define X25519_BATCH_MAX 32
+
+/*
+ * Computes the public values of |n| private keys, as
+ * ossl_x25519_public_from_private() does for one.  The inversion that maps
+ * each point to its u-coordinate costs about a quarter as much as the fixed
+ * base multiplication, so up to X25519_BATCH_MAX keys share one inversion,
+ * using Montgomery's trick.
+ */
+void
+ossl_x25519_public_from_private_batch(size_t n,
+                                      uint8_t *const *out_public_values,
+                                      const uint8_t *const *private_keys)
+{
+    uint8_t e[32];
+    ge_p3 A;
+    fe zplusy[X25519_BATCH_MAX], zminusy[X25519_BATCH_MAX];
+    fe prod[X25519_BATCH_MAX], inv, t, zero_fe, one;
+    size_t i, j, m;
+    unsigned int zero;
+
+    fe_0(zero_fe);
+    fe_1(one);
+    for (i = 0; i < n; i += m) {
+        m = n - i < X25519_BATCH_MAX ? n - i : X25519_BATCH_MAX;
+
+        for (j = 0; j < m; j++) {
+            memcpy(e, private_keys[i + j], 32);
+            e[0] &= 248;
+            e[31] &= 127;
+            e[31] |= 64;
+
+            ge_scalarmult_base(&A, e);
+
+            /* u = (Z + Y) / (Z - Y), see ossl_x25519_public_from_private() */
+            fe_add(zplusy[j], A.Z, A.Y);
+            fe_sub(zminusy[j], A.Z, A.Y);
+
+            /*
+             * Z - Y is only zero for the identity, for which the single key
+             * version gets u = 0 because it inverts zero to zero.  Use 0 / 1
+             * instead, so as not to lose the other keys in the batch.
+             */
+            zero = (unsigned int)(fe_isnonzero(zminusy[j]) ^ 1);
+            fe_cmov(zminusy[j], one, zero);
+            fe_cmov(zplusy[j], zero_fe, zero);
+
+            if (j == 0)
+                fe_copy(prod[0], zminusy[0]);
+            else
+                fe_mul(prod[j], prod[j - 1], zminusy[j]);
+        }
+
+        fe_invert(inv, prod[m - 1]);
+        for (j = m - 1; j > 0; j--) {
+            /* inv is the inverse of prod[j] */
+            fe_mul(t, inv, prod[j - 1]);
+            fe_mul(inv, inv, zminusy[j]);
+            fe_mul(t, zplusy[j], t);
+            fe_tobytes(out_public_values[i + j], t);
+        }
+        fe_mul(t, zplusy[0], inv);
+        fe_tobytes(out_public_values[i], t);
+    }
+
+    OPENSSL_cleanse(e, sizeof(e));
+}
@@ -647,6 +647,8 @@ EC_KEY *ossl_ec_key_dup(const EC_KEY *src, int selection)
     if ((selection & OSSL_KEYMGMT_SELECT_OTHER_PARAMETERS) != 0) {
         ret->enc_flag = src->enc_flag;
         ret->conv_form = src->conv_form;
+        if (!ossl_ec_key_set_pub_precompute(ret, src->pub_precomp_after))
+            goto err;
     }
 
     ret->version = src->version;
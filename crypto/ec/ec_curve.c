@@ -1575,40 +1575,54 @@ static const ec_list_element curve_list[] = {
      "WTLS curve over a 224 bit prime field"},
 
     /* brainpool curves */
-    {NID_brainpoolP160r1, &_EC_brainpoolP160r1.h, 0,
+    {NID_brainpoolP160r1, &_EC_brainpoolP160r1.h,
+     ossl_ec_GFp_brainpool_method,
      "RFC 5639 curve over a 160 bit prime field"},
-    {NID_brainpoolP160t1, &_EC_brainpoolP160t1.h, 0,
+    {NID_brainpoolP160t1, &_EC_brainpoolP160t1.h,
+     ossl_ec_GFp_brainpool_method,
      "RFC 5639 curve over a 160 bit prime field"},
-    {NID_brainpoolP192r1, &_EC_brainpoolP192r1.h, 0,
+    {NID_brainpoolP192r1, &_EC_brainpoolP192r1.h,
+     ossl_ec_GFp_brainpool_method,
      "RFC 5639 curve over a 192 bit prime field"},
-    {NID_brainpoolP192t1, &_EC_brainpoolP192t1.h, 0,
+    {NID_brainpoolP192t1, &_EC_brainpoolP192t1.h,
+     ossl_ec_GFp_brainpool_method,
      "RFC 5639 curve over a 192 bit prime field"},
-    {NID_brainpoolP224r1, &_EC_brainpoolP224r1.h, 0,
+    {NID_brainpoolP224r1, &_EC_brainpoolP224r1.h,
+     ossl_ec_GFp_brainpool_method,
      "RFC 5639 curve over a 224 bit prime field"},
-    {NID_brainpoolP224t1, &_EC_brainpoolP224t1.h, 0,
+    {NID_brainpoolP224t1, &_EC_brainpoolP224t1.h,
+     ossl_ec_GFp_brainpool_method,
      "RFC 5639 curve over a 224 bit prime field"},
-    {NID_brainpoolP256r1, &_EC_brainpoolP256r1.h, 0,
+    {NID_brainpoolP256r1, &_EC_brainpoolP256r1.h,
+     ossl_ec_GFp_brainpool_method,
      "RFC 5639 curve over a 256 bit prime field"},
-    {NID_brainpoolP256t1, &_EC_brainpoolP256t1.h, 0,
+    {NID_brainpoolP256t1, &_EC_brainpoolP256t1.h,
+     ossl_ec_GFp_brainpool_method,
      "RFC 5639 curve over a 256 bit prime field"},
-    {NID_brainpoolP320r1, &_EC_brainpoolP320r1.h, 0,
+    {NID_brainpoolP320r1, &_EC_brainpoolP320r1.h,
+     ossl_ec_GFp_brainpool_method,
      "RFC 5639 curve over a 320 bit prime field"},
-    {NID_brainpoolP320t1, &_EC_brainpoolP320t1.h, 0,
+    {NID_brainpoolP320t1, &_EC_brainpoolP320t1.h,
+     ossl_ec_GFp_brainpool_method,
      "RFC 5639 curve over a 320 bit prime field"},
-    {NID_brainpoolP384r1, &_EC_brainpoolP384r1.h, 0,
+    {NID_brainpoolP384r1, &_EC_brainpoolP384r1.h,
+     ossl_ec_GFp_brainpool_method,
      "RFC 5639 curve over a 384 bit prime field"},
-    {NID_brainpoolP384t1, &_EC_brainpoolP384t1.h, 0,
+    {NID_brainpoolP384t1, &_EC_brainpoolP384t1.h,
+     ossl_ec_GFp_brainpool_method,
      "RFC 5639 curve over a 384 bit prime field"},
-    {NID_brainpoolP512r1, &_EC_brainpoolP512r1.h, 0,
+    {NID_brainpoolP512r1, &_EC_brainpoolP512r1.h,
+     ossl_ec_GFp_brainpool_method,
      "RFC 5639 curve over a 512 bit prime field"},
-    {NID_brainpoolP512t1, &_EC_brainpoolP512t1.h, 0,
+    {NID_brainpoolP512t1, &_EC_brainpoolP512t1.h,
+     ossl_ec_GFp_brainpool_method,
      "RFC 5639 curve over a 512 bit prime field"},
 #ifndef OPENSSL_NO_SM2
     {NID_sm2, &_EC_sm2p256v1.h,
 # ifdef ECP_SM2P256_ASM
      EC_GFp_sm2p256_method,
 # else
-     0,
+     ossl_ec_GFp_brainpool_method,
 # endif
      "SM2 curve over a 256 bit prime field"},
 # endif
@@ -95,6 +95,8 @@ void EC_KEY_free(EC_KEY *r)
     EC_POINT_free(r->pub_key);
     BN_clear_free(r->priv_key);
     OPENSSL_free(r->propq);
+    EC_GROUP_free(r->pub_precomp);
+    CRYPTO_THREAD_lock_free(r->pub_precomp_lock);
 
     OPENSSL_clear_free((void *)r, sizeof(EC_KEY));
 }
@@ -153,6 +155,8 @@ EC_KEY *EC_KEY_copy(EC_KEY *dest, const EC_KEY *src)
     dest->conv_form = src->conv_form;
     dest->version = src->version;
     dest->flags = src->flags;
+    if (!ossl_ec_key_set_pub_precompute(dest, src->pub_precomp_after))
+        return NULL;
 #ifndef FIPS_MODULE
     if (!CRYPTO_dup_ex_data(CRYPTO_EX_INDEX_EC_KEY,
                             &dest->ex_data, &src->ex_data))
@@ -879,6 +883,149 @@ int EC_KEY_set_public_key(EC_KEY *key, const EC_POINT *pub_key)
     return (key->pub_key == NULL) ? 0 : 1;
 }
 
+/*
+ * Asks for multiples of the public key to be precomputed once |key| has
+ * verified |after| signatures, or never if |after| is 0.
+ */
+int ossl_ec_key_set_pub_precompute(EC_KEY *key, int after)
+{
+    if (after < 0) {
+        ERR_raise(ERR_LIB_EC, ERR_R_PASSED_INVALID_ARGUMENT);
+        return 0;
+    }
+    if (!CRYPTO_THREAD_write_lock(key->pub_precomp_lock))
+        return 0;
+    EC_GROUP_free(key->pub_precomp);
+    key->pub_precomp = NULL;
+    key->pub_precomp_after = after;
+    key->pub_precomp_uses = 0;
+    CRYPTO_THREAD_unlock(key->pub_precomp_lock);
+    return 1;
+}
+
+int ossl_ec_key_get_pub_precompute(const EC_KEY *key)
+{
+    return key->pub_precomp_after;
+}
+
+/*
+ * Only named curves whose method keeps its own tables of generator multiples
+ * are worth it.  The others multiply the generator with a ladder regardless.
+ */
+static int ec_key_can_pub_precomp(const EC_KEY *key)
+{
+    return key->group != NULL
+           && key->pub_key != NULL
+           && key->group->meth->mul != NULL
+           && key->group->meth->precompute_mult != NULL
+           && EC_GROUP_get_curve_name(key->group) != NID_undef;
+}
+
+static EC_GROUP *ec_key_make_pub_precomp(const EC_KEY *key, BN_CTX *ctx)
+{
+    EC_GROUP *qgroup;
+
+    if ((qgroup = EC_GROUP_dup(key->group)) == NULL)
+        return NULL;
+    EC_pre_comp_free(qgroup);
+    if (!EC_GROUP_set_generator(qgroup, key->pub_key, key->group->order,
+                                key->group->cofactor)
+            || !qgroup->meth->precompute_mult(qgroup, ctx)) {
+        EC_GROUP_free(qgroup);
+        return NULL;
+    }
+    return qgroup;
+}
+
+/*
+ * Counts a verification with |key| and makes the multiples of its public key
+ * when the count is reached.  Only the verification that reaches it makes
+ * them, so if that fails, it is not tried again.
+ */
+static void ec_key_count_pub_precomp(EC_KEY *key, int after, BN_CTX *ctx)
+{
+    EC_GROUP *made;
+    int uses;
+
+    if (!CRYPTO_atomic_add(&key->pub_precomp_uses, 1, &uses,
+                           key->pub_precomp_lock)
+            || uses != after)
+        return;
+
+    ERR_set_mark();
+    made = ec_key_make_pub_precomp(key, ctx);
+    ERR_pop_to_mark();
+    if (made == NULL)
+        return;
+
+    if (!CRYPTO_THREAD_write_lock(key->pub_precomp_lock)) {
+        EC_GROUP_free(made);
+        return;
+    }
+    if (key->pub_precomp == NULL) {
+        key->pub_precomp = made;
+        made = NULL;
+    }
+    CRYPTO_THREAD_unlock(key->pub_precomp_lock);
+    EC_GROUP_free(made);
+}
+
+/* The public key has changed since |stale| was made, so start counting again */
+static void ec_key_reset_pub_precomp(EC_KEY *key, const EC_GROUP *stale)
+{
+    if (!CRYPTO_THREAD_write_lock(key->pub_precomp_lock))
+        return;
+    if (key->pub_precomp == stale) {
+        EC_GROUP_free(key->pub_precomp);
+        key->pub_precomp = NULL;
+        key->pub_precomp_uses = 0;
+    }
+    CRYPTO_THREAD_unlock(key->pub_precomp_lock);
+}
+
+/*
+ * Computes r = u1 * G + u2 * Q, Q being the public key of |key|.  With the
+ * multiples of Q precomputed, each product comes from a table and the two
+ * are added, otherwise it is a single EC_POINT_mul().
+ *
+ * The read lock is held for as long as the table is used, since it is only
+ * freed under the write lock.
+ */
+int ossl_ec_key_pub_mul(const EC_KEY *key, EC_POINT *r, const BIGNUM *u1,
+                        const BIGNUM *u2, BN_CTX *ctx)
+{
+    /* The precomputed multiples are a cache, so |key| is still constant */
+    EC_KEY *k = (EC_KEY *)key;
+    const EC_GROUP *qgroup;
+    EC_POINT *t;
+    int after, ret;
+
+    if (!ec_key_can_pub_precomp(key)
+            || !CRYPTO_THREAD_read_lock(key->pub_precomp_lock))
+        return EC_POINT_mul(key->group, r, u1, key->pub_key, u2, ctx);
+    qgroup = key->pub_precomp;
+    after = key->pub_precomp_after;
+
+    if (qgroup != NULL
+            && EC_POINT_cmp(key->group, key->pub_key,
+                            EC_GROUP_get0_generator(qgroup), ctx) == 0) {
+        ret = (t = EC_POINT_new(key->group)) != NULL
+              && EC_POINT_mul(key->group, r, u1, NULL, NULL, ctx)
+              && EC_POINT_mul(qgroup, t, u2, NULL, NULL, ctx)
+              && EC_POINT_add(key->group, r, r, t, ctx);
+        CRYPTO_THREAD_unlock(key->pub_precomp_lock);
+        EC_POINT_free(t);
+        return ret;
+    }
+    CRYPTO_THREAD_unlock(key->pub_precomp_lock);
+
+    if (qgroup != NULL)
+        ec_key_reset_pub_precomp(k, qgroup);
+    else if (after > 0)
+        ec_key_count_pub_precomp(k, after, ctx);
+    return EC_POINT_mul(key->group, r, u1, key->pub_key, u2, ctx);
+}
+
 unsigned int EC_KEY_get_enc_flags(const EC_KEY *key)
 {
     return key->enc_flag;
@@ -91,6 +91,12 @@ EC_KEY *ossl_ec_key_new_method_int(OSSL_LIB_CTX *libctx, const char *propq,
         return NULL;
     }
 
+    ret->pub_precomp_lock = CRYPTO_THREAD_lock_new();
+    if (ret->pub_precomp_lock == NULL) {
+        ERR_raise(ERR_LIB_EC, ERR_R_CRYPTO_LIB);
+        goto err;
+    }
+
     ret->libctx = libctx;
     if (propq != NULL) {
         ret->propq = OPENSSL_strdup(propq);
@@ -21,6 +21,7 @@
 #include <openssl/opensslv.h>
 #include <openssl/param_build.h>
 #include <crypto/ec.h>
+#include <crypto/bn.h>
 #include <internal/nelem.h>
 #include "ec_local.h"
 
@@ -1180,12 +1181,12 @@ int ossl_ec_group_simple_order_bits(const EC_GROUP *group)
 static int ec_field_inverse_mod_ord(const EC_GROUP *group, BIGNUM *r,
                                     const BIGNUM *x, BN_CTX *ctx)
 {
-    BIGNUM *e = NULL;
     int ret = 0;
 #ifndef FIPS_MODULE
     BN_CTX *new_ctx = NULL;
 #endif
 
+    /* There is only Montgomery data for an odd order */
     if (group->mont_data == NULL)
         return 0;
 
@@ -1196,29 +1197,9 @@ static int ec_field_inverse_mod_ord(const EC_GROUP *group, BIGNUM *r,
     if (ctx == NULL)
         return 0;
 
-    BN_CTX_start(ctx);
-    if ((e = BN_CTX_get(ctx)) == NULL)
-        goto err;
-
-    /*-
-     * We want inverse in constant time, therefore we utilize the fact
-     * order must be prime and use Fermats Little Theorem instead.
-     */
-    if (!BN_set_word(e, 2))
-        goto err;
-    if (!BN_sub(e, group->order, e))
-        goto err;
-    /*-
-     * Exponent e is public.
-     * No need for scatter-gather or BN_FLG_CONSTTIME.
-     */
-    if (!BN_mod_exp_mont(r, x, e, group->order, ctx, group->mont_data))
-        goto err;
+    /* The inverse must be in constant time, and safegcd is */
+    ret = ossl_bn_mod_inverse_consttime(r, x, group->order, ctx);
 
-    ret = 1;
-
- err:
-    BN_CTX_end(ctx);
 #ifndef FIPS_MODULE
     BN_CTX_free(new_ctx);
 #endif
@@ -15,6 +15,7 @@
 #include <openssl/bn.h>
 #include <internal/refcount.h>
 #include <crypto/ec.h>
+#include <crypto/bn.h>
 
 #if defined(__SUNPRO_C)
 # if __SUNPRO_C >= 0x520
@@ -270,6 +271,16 @@ struct ec_key_st {
 
     /* Provider data */
     size_t dirty_cnt; /* If any key material changes, increment this */
+
+    /*
+     * Precomputed multiples of pub_key for signature verification, kept as
+     * a copy of the group with pub_key as its generator.  They are made
+     * after pub_precomp_after verifications, or never if that is 0.
+     */
+    CRYPTO_RWLOCK *pub_precomp_lock;
+    EC_GROUP *pub_precomp;
+    int pub_precomp_after;
+    int pub_precomp_uses;
 };
 
 struct ec_point_st {
@@ -414,6 +425,54 @@ int ossl_ec_GFp_mont_field_encode(const EC_GROUP *, BIGNUM *r, const BIGNUM *a,
 int ossl_ec_GFp_mont_field_decode(const EC_GROUP *, BIGNUM *r, const BIGNUM *a,
                                   BN_CTX *);
 int ossl_ec_GFp_mont_field_set_to_one(const EC_GROUP *, BIGNUM *r, BN_CTX *);
+int ossl_ec_GFp_mont_add(const EC_GROUP *, EC_POINT *r, const EC_POINT *a,
+                         const EC_POINT *b, BN_CTX *);
+int ossl_ec_GFp_mont_dbl(const EC_GROUP *, EC_POINT *r, const EC_POINT *a,
+                         BN_CTX *);
+int ossl_ec_GFp_mont_ladder_step(const EC_GROUP *group,
+                                 EC_POINT *r, EC_POINT *s,
+                                 EC_POINT *p, BN_CTX *ctx);
+
+/*
+ * Field elements of a Montgomery method group as fixed-width word arrays,
+ * for the point arithmetic of ecp_mont.c and ecp_brainpool.c
+ */
+#define EC_FIXED_WORDS ((OPENSSL_ECC_MAX_FIELD_BITS + BN_BITS2 - 1) / BN_BITS2)
+
+static inline const BN_MONT_CTX *ec_fixed_mont(const EC_GROUP *group)
+{
+    const BN_MONT_CTX *mont = group->field_data1;
+    int num;
+
+    if (mont == NULL)
+        return NULL;
+    num = ossl_bn_fixed_words(mont);
+    return num > 0 && num <= EC_FIXED_WORDS ? mont : NULL;
+}
+
+static inline void ec_fe_mul(BN_ULONG *r, const BN_ULONG *a,
+                             const BN_ULONG *b, const BN_MONT_CTX *mont)
+{
+    ossl_bn_fixed_mont_mul(r, a, b, mont);
+}
+
+static inline void ec_fe_sqr(BN_ULONG *r, const BN_ULONG *a,
+                             const BN_MONT_CTX *mont)
+{
+    ossl_bn_fixed_mont_mul(r, a, a, mont);
+}
+
+static inline void ec_fe_add(BN_ULONG *r, const BN_ULONG *a,
+                             const BN_ULONG *b, const BN_MONT_CTX *mont)
+{
+    ossl_bn_fixed_mod_add(r, a, b, mont);
+}
+
+static inline void ec_fe_sub(BN_ULONG *r, const BN_ULONG *a,
+                             const BN_ULONG *b, const BN_MONT_CTX *mont)
+{
+    ossl_bn_fixed_mod_sub(r, a, b, mont);
+}
 
 /* method functions in ecp_nist.c */
 int ossl_ec_GFp_nist_group_copy(EC_GROUP *dest, const EC_GROUP *src);
@@ -535,6 +594,11 @@ void ossl_ec_GFp_nistp_recode_scalar_bits(unsigned char *sign,
 #endif
 int ossl_ec_group_simple_order_bits(const EC_GROUP *group);
 
+#ifndef FIPS_MODULE
+/* method functions in ecp_brainpool.c */
+const EC_METHOD *ossl_ec_GFp_brainpool_method(void);
+#endif
+
 /**
  *  Creates a new EC_GROUP object
  *  \param   libctx The associated library context or NULL for the default
@@ -393,6 +393,184 @@ int ossl_ec_scalar_mul_ladder(const EC_GROUP *group, EC_POINT *r,
                   (b) >=   20 ? 2 : \
                   1))
 
+/*
+ * With many points, Pippenger's bucket method needs fewer point additions
+ * than interleaving the wNAFs of the individual scalars: each window of c
+ * bits costs one addition per point plus two per bucket, however many
+ * points there are.
+ */
+#define EC_PIPPENGER_MIN_POINTS 64
+#define EC_PIPPENGER_MAX_WINDOW 15
+
+/* Bits |pos| to |pos| + |c| - 1 of the magnitude of |a| */
+static unsigned int bn_get_window(const BIGNUM *a, int pos, int c)
+{
+    const BN_ULONG *words = bn_get_words(a);
+    int top = bn_get_top(a), idx = pos / BN_BITS2, shift = pos % BN_BITS2;
+    BN_ULONG v;
+
+    if (idx >= top)
+        return 0;
+    v = words[idx] >> shift;
+    if (shift + c > BN_BITS2 && idx + 1 < top)
+        v |= words[idx + 1] << (BN_BITS2 - shift);
+    return (unsigned int)(v & (((BN_ULONG)1 << c) - 1));
+}
+
+/*-
+ * Compute
+ *      \sum scalars[i]*points[i] + scalar*generator
+ * with Pippenger's bucket method.  Each scalar is recoded into signed digits
+ * of c bits; for every window, the points are sorted into buckets by their
+ * digit, and the buckets are summed with a running sum so that bucket d is
+ * counted d times.  Like the wNAF code this is not constant time, and it is
+ * only used for public scalars.
+ */
+static int ec_pippenger_mul(const EC_GROUP *group, EC_POINT *r,
+                            const BIGNUM *scalar, size_t num,
+                            const EC_POINT *points[], const BIGNUM *scalars[],
+                            BN_CTX *ctx)
+{
+    size_t total = num + (scalar != NULL), i, cost, best_cost = SIZE_MAX;
+    const EC_POINT *generator = NULL;
+    const BIGNUM *k;
+    EC_POINT **p = NULL, **bucket = NULL, *running = NULL, *sum = NULL;
+    unsigned char *used = NULL;
+    short *digits = NULL;
+    int maxbits = 0, c, best_c = 1, nwin, nbuckets, w, j, d, carry, started;
+    int ret = 0;
+
+    if (scalar != NULL) {
+        generator = EC_GROUP_get0_generator(group);
+        if (generator == NULL) {
+            ERR_raise(ERR_LIB_EC, EC_R_UNDEFINED_GENERATOR);
+            return 0;
+        }
+    }
+
+    for (i = 0; i < total; i++) {
+        k = i < num ? scalars[i] : scalar;
+        if (BN_num_bits(k) > maxbits)
+            maxbits = BN_num_bits(k);
+    }
+    if (maxbits == 0)
+        return EC_POINT_set_to_infinity(group, r);
+
+    for (c = 1; c <= EC_PIPPENGER_MAX_WINDOW; c++) {
+        cost = (size_t)(maxbits / c + 1) * (total + ((size_t)1 << c));
+        if (cost < best_cost) {
+            best_cost = cost;
+            best_c = c;
+        }
+    }
+    c = best_c;
+    /* One more window than needed for the bits, for the final carry */
+    nwin = maxbits / c + 1;
+    nbuckets = 1 << (c - 1);
+
+    if (total > SIZE_MAX / sizeof(*digits) / nwin) {
+        ERR_raise(ERR_LIB_EC, ERR_R_PASSED_INVALID_ARGUMENT);
+        return 0;
+    }
+    p = OPENSSL_zalloc((total + 1) * sizeof(*p));
+    digits = OPENSSL_malloc(total * nwin * sizeof(*digits));
+    bucket = OPENSSL_zalloc((nbuckets + 1) * sizeof(*bucket));
+    used = OPENSSL_malloc(nbuckets);
+    if (p == NULL || digits == NULL || bucket == NULL || used == NULL
+            || (running = EC_POINT_new(group)) == NULL
+            || (sum = EC_POINT_new(group)) == NULL)
+        goto err;
+    for (j = 0; j < nbuckets; j++)
+        if ((bucket[j] = EC_POINT_new(group)) == NULL)
+            goto err;
+
+    /* Recode the scalars into digits in [-2^(c-1) + 1, 2^(c-1)] */
+    for (i = 0; i < total; i++) {
+        k = i < num ? scalars[i] : scalar;
+        if ((p[i] = EC_POINT_dup(i < num ? points[i] : generator,
+                                 group)) == NULL)
+            goto err;
+        if (BN_is_negative(k) && !EC_POINT_invert(group, p[i], ctx))
+            goto err;
+        for (w = 0, carry = 0; w < nwin; w++) {
+            d = (int)bn_get_window(k, w * c, c) + carry;
+            carry = d > nbuckets;
+            if (carry)
+                d -= 1 << c;
+            digits[i * nwin + w] = (short)d;
+        }
+    }
+
+    if (group->meth->points_make_affine == NULL
+        || !group->meth->points_make_affine(group, total, p, ctx))
+        goto err;
+
+    if (!EC_POINT_set_to_infinity(group, r))
+        goto err;
+    for (w = nwin - 1; w >= 0; w--) {
+        for (j = 0; j < c && w != nwin - 1; j++)
+            if (!EC_POINT_dbl(group, r, r, ctx))
+                goto err;
+
+        memset(used, 0, nbuckets);
+        for (i = 0; i < total; i++) {
+            d = digits[i * nwin + w];
+            if (d == 0)
+                continue;
+            j = (d > 0 ? d : -d) - 1;
+            if (d < 0 && !EC_POINT_invert(group, p[i], ctx))
+                goto err;
+            if (!used[j]) {
+                if (!EC_POINT_copy(bucket[j], p[i]))
+                    goto err;
+                used[j] = 1;
+            } else if (!EC_POINT_add(group, bucket[j], bucket[j], p[i], ctx)) {
+                goto err;
+            }
+            if (d < 0 && !EC_POINT_invert(group, p[i], ctx))
+                goto err;
+        }
+
+        /* sum = 1 * bucket[0] + 2 * bucket[1] + ... */
+        for (j = nbuckets - 1, started = 0; j >= 0; j--) {
+            if (used[j]) {
+                if (!started) {
+                    if (!EC_POINT_copy(running, bucket[j])
+                            || !EC_POINT_copy(sum, bucket[j]))
+                        goto err;
+                    started = 1;
+                    continue;
+                }
+                if (!EC_POINT_add(group, running, running, bucket[j], ctx))
+                    goto err;
+            }
+            if (started && !EC_POINT_add(group, sum, sum, running, ctx))
+                goto err;
+        }
+        if (started && !EC_POINT_add(group, r, r, sum, ctx))
+            goto err;
+    }
+
+    ret = 1;
+
+ err:
+    if (p != NULL) {
+        for (i = 0; p[i] != NULL; i++)
+            EC_POINT_free(p[i]);
+        OPENSSL_free(p);
+    }
+    if (bucket != NULL) {
+        for (j = 0; bucket[j] != NULL; j++)
+            EC_POINT_free(bucket[j]);
+        OPENSSL_free(bucket);
+    }
+    EC_POINT_free(running);
+    EC_POINT_free(sum);
+    OPENSSL_free(used);
+    OPENSSL_free(digits);
+    return ret;
+}
+
 /*-
  * Compute
  *      \sum scalars[i]*points[i],
@@ -458,6 +636,9 @@ int ossl_ec_wNAF_mul(const EC_GROUP *group, EC_POINT *r, const BIGNUM *scalar,
         }
     }
 
+    if (num + (scalar != NULL) >= EC_PIPPENGER_MIN_POINTS)
+        return ec_pippenger_mul(group, r, scalar, num, points, scalars, ctx);
+
     if (scalar != NULL) {
         generator = EC_GROUP_get0_generator(group);
         if (generator == NULL) {
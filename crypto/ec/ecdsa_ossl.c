@@ -34,7 +34,8 @@ static int ecdsa_sign_setup(EC_KEY *eckey, BN_CTX *ctx_in,
                             BIGNUM **kinvp, BIGNUM **rp,
                             const unsigned char *dgst, int dlen,
                             unsigned int nonce_type, const char *digestname,
-                            OSSL_LIB_CTX *libctx, const char *propq);
+                            OSSL_LIB_CTX *libctx, const char *propq,
+                            OSSL_RFC6979_CTX *nonce_ctx);
 
 int ossl_ecdsa_sign_setup(EC_KEY *eckey, BN_CTX *ctx_in, BIGNUM **kinvp,
                           BIGNUM **rp)
@@ -96,7 +97,8 @@ int ossl_ecdsa_deterministic_sign(const unsigned char *dgst, int dlen,
                                   unsigned char *sig, unsigned int *siglen,
                                   EC_KEY *eckey, unsigned int nonce_type,
                                   const char *digestname,
-                                  OSSL_LIB_CTX *libctx, const char *propq)
+                                  OSSL_LIB_CTX *libctx, const char *propq,
+                                  OSSL_RFC6979_CTX *nonce_ctx)
 {
     ECDSA_SIG *s;
     BIGNUM *kinv = NULL, *r = NULL;
@@ -109,7 +111,7 @@ int ossl_ecdsa_deterministic_sign(const unsigned char *dgst, int dlen,
 
     *siglen = 0;
     if (!ecdsa_sign_setup(eckey, NULL, &kinv, &r, dgst, dlen,
-                          nonce_type, digestname, libctx, propq))
+                          nonce_type, digestname, libctx, propq, nonce_ctx))
         return 0;
 
     s = ECDSA_do_sign_ex(dgst, dlen, kinv, r, eckey);
@@ -129,7 +131,8 @@ static int ecdsa_sign_setup(EC_KEY *eckey, BN_CTX *ctx_in,
                             BIGNUM **kinvp, BIGNUM **rp,
                             const unsigned char *dgst, int dlen,
                             unsigned int nonce_type, const char *digestname,
-                            OSSL_LIB_CTX *libctx, const char *propq)
+                            OSSL_LIB_CTX *libctx, const char *propq,
+                            OSSL_RFC6979_CTX *nonce_ctx)
 {
     BN_CTX *ctx = NULL;
     BIGNUM *k = NULL, *r = NULL, *X = NULL;
@@ -195,7 +198,8 @@ static int ecdsa_sign_setup(EC_KEY *eckey, BN_CTX *ctx_in,
                                                                priv_key,
                                                                dgst, dlen,
                                                                digestname,
-                                                               libctx, propq);
+                                                               libctx, propq,
+                                                               nonce_ctx);
 #endif
                 } else {
                     res = BN_generate_dsa_nonce(k, order, priv_key, dgst, dlen,
@@ -256,7 +260,7 @@ int ossl_ecdsa_simple_sign_setup(EC_KEY *eckey, BN_CTX *ctx_in, BIGNUM **kinvp,
                                  BIGNUM **rp)
 {
     return ecdsa_sign_setup(eckey, ctx_in, kinvp, rp, NULL, 0,
-                            0, NULL, NULL, NULL);
+                            0, NULL, NULL, NULL, NULL);
 }
 
 ECDSA_SIG *ossl_ecdsa_simple_sign_sig(const unsigned char *dgst, int dgst_len,
@@ -327,7 +331,7 @@ ECDSA_SIG *ossl_ecdsa_simple_sign_sig(const unsigned char *dgst, int dgst_len,
     do {
         if (in_kinv == NULL || in_r == NULL) {
             if (!ecdsa_sign_setup(eckey, ctx, &kinv, &ret->r, dgst, dgst_len,
-                                  0, NULL, NULL, NULL)) {
+                                  0, NULL, NULL, NULL, NULL)) {
                 ERR_raise(ERR_LIB_EC, ERR_R_ECDSA_LIB);
                 goto err;
             }
@@ -516,7 +520,7 @@ int ossl_ecdsa_simple_verify_sig(const unsigned char *dgst, int dgst_len,
         ERR_raise(ERR_LIB_EC, ERR_R_EC_LIB);
         goto err;
     }
-    if (!EC_POINT_mul(group, point, u1, pub_key, u2, ctx)) {
+    if (!ossl_ec_key_pub_mul(eckey, point, u1, u2, ctx)) {
         ERR_raise(ERR_LIB_EC, ERR_R_EC_LIB);
         goto err;
     }
@@ -0,0 +1,773 @@
+/*
+ * Copyright 2024 The OpenSSL Project Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License 2.0 (the "License").  You may not use
+ * this file except in compliance with the License.  You can obtain a copy
+ * in the file LICENSE in the source distribution or at
+ * https://www.openssl.org/source/license.html
+ */
+
+/*
+ * Scalar multiplication for the brainpool curves, and for SM2 where
+ * ecp_sm2p256.c does not cover the platform.  The field arithmetic is
+ * that of EC_GFp_mont_method(), on fixed-width word arrays so that nothing
+ * in the inner loops touches a BIGNUM or a BN_CTX, with bn_mul_mont()
+ * wherever the platform has it in assembler.  Multiples of the generator
+ * come from a comb table kept with the library context; multiples of any
+ * other point from a Booth-recoded fixed window.  Both take the same
+ * sequence of operations and read every table entry whatever the scalar,
+ * and both randomise the projective coordinates they start from, as the
+ * ladder of ossl_ec_scalar_mul_ladder() does.
+ *
+ * Multiplications with more than one point, which only verification needs
+ * and where the scalars are public, are left to ossl_ec_wNAF_mul().
+ */
+
+/*
+ * ECDSA low-level APIs are deprecated for public use, but still ok for
+ * internal use.
+ */
+#include <internal/deprecated.h>
+
+#include <string.h>
+#include <openssl/err.h>
+#include "internal/cryptlib.h"
+#include "internal/constant_time.h"
+#include "crypto/context.h"
+#include "ec_local.h"
+
+#define BP_WINDOW       5
+#define BP_TABLE        (1 << (BP_WINDOW - 1))  /* 1 * P to 16 * P */
+#define BP_COMB_TEETH   5
+#define BP_COMB_ENTRIES (1 << BP_COMB_TEETH)
+#define BP_COMB_CURVES  16    /* Room for each of the brainpool curves */
+
+/* Order bytes, with a spare one for the window that reaches past the top */
+#define BP_SCALAR_BYTES (EC_FIXED_WORDS * BN_BYTES + 2)
+
+typedef struct {
+    BN_ULONG X[EC_FIXED_WORDS];
+    BN_ULONG Y[EC_FIXED_WORDS];
+    BN_ULONG Z[EC_FIXED_WORDS];     /* Zero for the point at infinity */
+} BP_POINT;
+
+typedef struct {
+    const BN_MONT_CTX *mont;
+    int num;
+    int a_is_minus3;
+    BN_ULONG a[EC_FIXED_WORDS];     /* In Montgomery form, as is the rest */
+    BN_ULONG one[EC_FIXED_WORDS];
+} BP_CURVE;
+
+typedef struct {
+    BIGNUM *p, *a, *gx, *gy;        /* What the table was made for */
+    int bits;                       /* Scalar bits covered */
+    int d;                          /* Number of columns */
+    BN_ULONG *table;                /* Affine x and y of each entry */
+} BP_COMB;
+
+typedef struct {
+    CRYPTO_RWLOCK *lock;
+    struct {
+        int nid;
+        BP_COMB *comb;
+    } curve[BP_COMB_CURVES];
+} EC_COMBS;
+
+/* All ones if the |num| words at |a| are zero, else zero */
+static BN_ULONG bp_is_zero(const BN_ULONG *a, int num)
+{
+    BN_ULONG acc = 0;
+    int i;
+
+    for (i = 0; i < num; i++)
+        acc |= a[i];
+    return (BN_ULONG)0 - ((~acc & (acc - 1)) >> (BN_BITS2 - 1));
+}
+
+static BN_ULONG bp_mask(unsigned int cond)
+{
+    return (BN_ULONG)0 - (BN_ULONG)(cond & 1);
+}
+
+/* r = a where |mask| is all ones, else r is left alone */
+static void bp_cmov(BN_ULONG *r, const BN_ULONG *a, BN_ULONG mask, int num)
+{
+    int i;
+
+    for (i = 0; i < num; i++)
+        r[i] = (a[i] & mask) | (r[i] & ~mask);
+}
+
+static void bp_point_cmov(BP_POINT *r, const BP_POINT *a, BN_ULONG mask,
+                          int num)
+{
+    bp_cmov(r->X, a->X, mask, num);
+    bp_cmov(r->Y, a->Y, mask, num);
+    bp_cmov(r->Z, a->Z, mask, num);
+}
+
+static void bp_point_copy(BP_POINT *r, const BP_POINT *a, int num)
+{
+    size_t len = sizeof(BN_ULONG) * num;
+
+    memcpy(r->X, a->X, len);
+    memcpy(r->Y, a->Y, len);
+    memcpy(r->Z, a->Z, len);
+}
+
+/* Jacobian doubling, as ossl_ec_GFp_simple_dbl(); |r| may be |a| */
+static void bp_dbl(BP_POINT *r, const BP_POINT *a, const BP_CURVE *c)
+{
+    const BN_MONT_CTX *mont = c->mont;
+    BN_ULONG n0[EC_FIXED_WORDS], n1[EC_FIXED_WORDS];
+    BN_ULONG n2[EC_FIXED_WORDS], n3[EC_FIXED_WORDS];
+
+    /* n1 = 3 * X_a^2 + a_curve * Z_a^4 */
+    if (c->a_is_minus3) {
+        ec_fe_sqr(n1, a->Z, mont);
+        ec_fe_add(n0, a->X, n1, mont);
+        ec_fe_sub(n2, a->X, n1, mont);
+        ec_fe_mul(n1, n0, n2, mont);
+        ec_fe_add(n0, n1, n1, mont);
+        ec_fe_add(n1, n0, n1, mont);
+    } else {
+        ec_fe_sqr(n0, a->X, mont);
+        ec_fe_add(n1, n0, n0, mont);
+        ec_fe_add(n0, n0, n1, mont);
+        ec_fe_sqr(n1, a->Z, mont);
+        ec_fe_sqr(n1, n1, mont);
+        ec_fe_mul(n1, n1, c->a, mont);
+        ec_fe_add(n1, n1, n0, mont);
+    }
+
+    /* Z_r = 2 * Y_a * Z_a */
+    ec_fe_mul(n0, a->Y, a->Z, mont);
+    ec_fe_add(r->Z, n0, n0, mont);
+
+    /* n2 = 4 * X_a * Y_a^2 */
+    ec_fe_sqr(n3, a->Y, mont);
+    ec_fe_mul(n2, a->X, n3, mont);
+    ec_fe_add(n2, n2, n2, mont);
+    ec_fe_add(n2, n2, n2, mont);
+
+    /* X_r = n1^2 - 2 * n2 */
+    ec_fe_add(n0, n2, n2, mont);
+    ec_fe_sqr(r->X, n1, mont);
+    ec_fe_sub(r->X, r->X, n0, mont);
+
+    /* n3 = 8 * Y_a^4 */
+    ec_fe_sqr(n0, n3, mont);
+    ec_fe_add(n3, n0, n0, mont);
+    ec_fe_add(n3, n3, n3, mont);
+    ec_fe_add(n3, n3, n3, mont);
+
+    /* Y_r = n1 * (n2 - X_r) - n3 */
+    ec_fe_sub(n0, n2, r->X, mont);
+    ec_fe_mul(n0, n1, n0, mont);
+    ec_fe_sub(r->Y, n0, n3, mont);
+}
+
+/*
+ * r = a + b in Jacobian coordinates, where either may be the point at
+ * infinity.  The formulas do not hold for a == b, which the multiplications
+ * below only meet with negligible probability; that case goes to bp_dbl().
+ */
+static void bp_add(BP_POINT *r, const BP_POINT *a, const BP_POINT *b,
+                   const BP_CURVE *c)
+{
+    const BN_MONT_CTX *mont = c->mont;
+    BN_ULONG u1[EC_FIXED_WORDS], u2[EC_FIXED_WORDS], s1[EC_FIXED_WORDS];
+    BN_ULONG s2[EC_FIXED_WORDS], h[EC_FIXED_WORDS], rr[EC_FIXED_WORDS];
+    BN_ULONG t[EC_FIXED_WORDS], a_inf, b_inf;
+    BP_POINT res;
+
+    a_inf = bp_is_zero(a->Z, c->num);
+    b_inf = bp_is_zero(b->Z, c->num);
+
+    /* u1 = X_a * Z_b^2, s1 = Y_a * Z_b^3 */
+    ec_fe_sqr(t, b->Z, mont);
+    ec_fe_mul(u1, a->X, t, mont);
+    ec_fe_mul(t, t, b->Z, mont);
+    ec_fe_mul(s1, a->Y, t, mont);
+
+    /* u2 = X_b * Z_a^2, s2 = Y_b * Z_a^3 */
+    ec_fe_sqr(t, a->Z, mont);
+    ec_fe_mul(u2, b->X, t, mont);
+    ec_fe_mul(t, t, a->Z, mont);
+    ec_fe_mul(s2, b->Y, t, mont);
+
+    /* h = u2 - u1, rr = s2 - s1 */
+    ec_fe_sub(h, u2, u1, mont);
+    ec_fe_sub(rr, s2, s1, mont);
+    if ((bp_is_zero(h, c->num) & bp_is_zero(rr, c->num) & ~a_inf & ~b_inf)
+            != 0) {
+        bp_dbl(r, a, c);
+        return;
+    }
+
+    /* Z_r = Z_a * Z_b * h */
+    ec_fe_mul(t, a->Z, b->Z, mont);
+    ec_fe_mul(res.Z, t, h, mont);
+
+    /* X_r = rr^2 - h^3 - 2 * u1 * h^2 */
+    ec_fe_sqr(t, h, mont);
+    ec_fe_mul(u1, u1, t, mont);
+    ec_fe_mul(t, t, h, mont);
+    ec_fe_sqr(res.X, rr, mont);
+    ec_fe_sub(res.X, res.X, t, mont);
+    ec_fe_sub(res.X, res.X, u1, mont);
+    ec_fe_sub(res.X, res.X, u1, mont);
+
+    /* Y_r = rr * (u1 * h^2 - X_r) - s1 * h^3 */
+    ec_fe_sub(u2, u1, res.X, mont);
+    ec_fe_mul(u2, u2, rr, mont);
+    ec_fe_mul(s1, s1, t, mont);
+    ec_fe_sub(res.Y, u2, s1, mont);
+
+    bp_point_cmov(&res, b, a_inf, c->num);
+    bp_point_cmov(&res, a, b_inf, c->num);
+    bp_point_copy(r, &res, c->num);
+}
+
+/*
+ * r = a + (x, y) for an affine (x, y), or a itself if |b_inf| is all ones.
+ * As bp_add(), but with Z_b one.
+ */
+static void bp_add_affine(BP_POINT *r, const BP_POINT *a, const BN_ULONG *x,
+                          const BN_ULONG *y, BN_ULONG b_inf,
+                          const BP_CURVE *c)
+{
+    const BN_MONT_CTX *mont = c->mont;
+    BN_ULONG u1[EC_FIXED_WORDS], u2[EC_FIXED_WORDS], s2[EC_FIXED_WORDS];
+    BN_ULONG h[EC_FIXED_WORDS], rr[EC_FIXED_WORDS], t[EC_FIXED_WORDS];
+    BN_ULONG a_inf;
+    BP_POINT res;
+
+    a_inf = bp_is_zero(a->Z, c->num);
+
+    /* u2 = x * Z_a^2, s2 = y * Z_a^3 */
+    ec_fe_sqr(t, a->Z, mont);
+    ec_fe_mul(u2, x, t, mont);
+    ec_fe_mul(t, t, a->Z, mont);
+    ec_fe_mul(s2, y, t, mont);
+
+    /* h = u2 - X_a, rr = s2 - Y_a */
+    ec_fe_sub(h, u2, a->X, mont);
+    ec_fe_sub(rr, s2, a->Y, mont);
+    if ((bp_is_zero(h, c->num) & bp_is_zero(rr, c->num) & ~a_inf & ~b_inf)
+            != 0) {
+        bp_dbl(r, a, c);
+        return;
+    }
+
+    /* Z_r = Z_a * h */
+    ec_fe_mul(res.Z, a->Z, h, mont);
+
+    /* X_r = rr^2 - h^3 - 2 * X_a * h^2 */
+    ec_fe_sqr(t, h, mont);
+    ec_fe_mul(u1, a->X, t, mont);
+    ec_fe_mul(t, t, h, mont);
+    ec_fe_sqr(res.X, rr, mont);
+    ec_fe_sub(res.X, res.X, t, mont);
+    ec_fe_sub(res.X, res.X, u1, mont);
+    ec_fe_sub(res.X, res.X, u1, mont);
+
+    /* Y_r = rr * (X_a * h^2 - X_r) - Y_a * h^3 */
+    ec_fe_sub(u2, u1, res.X, mont);
+    ec_fe_mul(u2, u2, rr, mont);
+    ec_fe_mul(t, a->Y, t, mont);
+    ec_fe_sub(res.Y, u2, t, mont);
+
+    bp_cmov(res.X, x, a_inf, c->num);
+    bp_cmov(res.Y, y, a_inf, c->num);
+    bp_cmov(res.Z, c->one, a_inf, c->num);
+    bp_point_cmov(&res, a, b_inf, c->num);
+    bp_point_copy(r, &res, c->num);
+}
+
+/*
+ * Scales the Jacobian coordinates of |p| by |lambda|, which leaves the
+ * point unchanged but randomises every value computed from it
+ */
+static void bp_blind(BP_POINT *p, const BN_ULONG *lambda, const BP_CURVE *c)
+{
+    const BN_MONT_CTX *mont = c->mont;
+    BN_ULONG t[EC_FIXED_WORDS];
+
+    ec_fe_mul(p->Z, p->Z, lambda, mont);
+    ec_fe_sqr(t, lambda, mont);
+    ec_fe_mul(p->X, p->X, t, mont);
+    ec_fe_mul(t, t, lambda, mont);
+    ec_fe_mul(p->Y, p->Y, t, mont);
+    OPENSSL_cleanse(t, sizeof(t));
+}
+
+/* Bit |i| of the little-endian |k|, where bits out of range are zero */
+static unsigned int bp_bit(const unsigned char *k, int len, int i)
+{
+    if (i < 0 || i >= 8 * len)
+        return 0;
+    return (k[i >> 3] >> (i & 7)) & 1;
+}
+
+/* As _booth_recode_w5() in ecp_nistz256.c: |digit| << 1 | sign */
+static unsigned int bp_booth_recode(unsigned int in)
+{
+    unsigned int s, d;
+
+    s = ~((in >> BP_WINDOW) - 1);
+    d = (1 << (BP_WINDOW + 1)) - in - 1;
+    d = (d & s) | (in & ~s);
+    d = (d >> 1) + (d & 1);
+
+    return (d << 1) + (s & 1);
+}
+
+/*
+ * r = k * p, with |k| the |bits| low bits of the little-endian |len| bytes
+ * at |k|.  Each window of BP_WINDOW bits is recoded into a digit of -16 to
+ * 16, so that the table needs only 1 * P to 16 * P.
+ */
+static void bp_window_mul(BP_POINT *r, const unsigned char *k, int len,
+                          int bits, const BP_POINT *p, const BP_CURVE *c)
+{
+    const BN_MONT_CTX *mont = c->mont;
+    BP_POINT table[BP_TABLE], t;
+    BN_ULONG zero[EC_FIXED_WORDS] = { 0 }, neg[EC_FIXED_WORDS];
+    unsigned int wvalue, digit;
+    int i, j, w, windows = (bits + BP_WINDOW) / BP_WINDOW;
+
+    bp_point_copy(&table[0], p, c->num);
+    for (i = 1; i < BP_TABLE; i++) {
+        if ((i & 1) != 0)
+            bp_dbl(&table[i], &table[i / 2], c);
+        else
+            bp_add(&table[i], &table[i - 1], p, c);
+    }
+
+    for (w = windows - 1; w >= 0; w--) {
+        wvalue = 0;
+        for (j = 0; j <= BP_WINDOW; j++)
+            wvalue |= bp_bit(k, len, w * BP_WINDOW - 1 + j) << j;
+        digit = bp_booth_recode(wvalue);
+
+        memset(&t, 0, sizeof(t));
+        for (i = 0; i < BP_TABLE; i++)
+            bp_point_cmov(&t, &table[i],
+                          bp_mask(constant_time_eq(i + 1, digit >> 1)),
+                          c->num);
+        ec_fe_sub(neg, zero, t.Y, mont);
+        bp_cmov(t.Y, neg, bp_mask(digit), c->num);
+
+        if (w == windows - 1) {
+            bp_point_copy(r, &t, c->num);
+            continue;
+        }
+        for (i = 0; i < BP_WINDOW; i++)
+            bp_dbl(r, r, c);
+        bp_add(r, r, &t, c);
+    }
+    OPENSSL_cleanse(&t, sizeof(t));
+    OPENSSL_cleanse(table, sizeof(table));
+}
+
+/*
+ * r = k * G, with |k| covering comb->bits bits.  The accumulator is blinded
+ * with |lambda|, if not NULL, once the first column is added.  Should that
+ * column's entry be zero, which happens for one scalar in 32, the
+ * accumulator is still the point at infinity and the entry the next column
+ * loads goes unblinded; blinding every column would cost a quarter more.
+ */
+static void bp_comb_mul(BP_POINT *r, const unsigned char *k, int len,
+                        const BP_COMB *comb, const BN_ULONG *lambda,
+                        const BP_CURVE *c)
+{
+    BN_ULONG xy[2 * EC_FIXED_WORDS];
+    const BN_ULONG *p;
+    unsigned int idx, i;
+    int j, col, width = 2 * c->num;
+
+    memset(r, 0, sizeof(*r));
+    for (col = comb->d - 1; col >= 0; col--) {
+        idx = 0;
+        for (j = 0; j < BP_COMB_TEETH; j++)
+            idx |= bp_bit(k, len, j * comb->d + col) << j;
+
+        memset(xy, 0, sizeof(xy));
+        for (i = 0, p = comb->table; i < BP_COMB_ENTRIES; i++, p += width)
+            bp_cmov(xy, p, bp_mask(constant_time_eq(i, idx)), width);
+
+        if (col != comb->d - 1)
+            bp_dbl(r, r, c);
+        bp_add_affine(r, r, xy, xy + c->num,
+                      bp_mask(constant_time_is_zero(idx)), c);
+        if (col == comb->d - 1 && lambda != NULL)
+            bp_blind(r, lambda, c);
+    }
+    OPENSSL_cleanse(xy, sizeof(xy));
+}
+
+/*
+ * Sets |lambda| to a random non-zero field element.  As in
+ * ossl_ec_GFp_simple_blind_coordinates(), a failing RNG means going on
+ * without blinding rather than failing, so this returns 0 then with the
+ * error stack untouched.  Any non-zero value will do, so it is used as
+ * the Montgomery form of whatever it encodes.
+ */
+static int bp_blind_factor(BN_ULONG *lambda, const EC_GROUP *group,
+                           const BP_CURVE *c, BN_CTX *ctx)
+{
+    BIGNUM *t;
+    int ok;
+
+    BN_CTX_start(ctx);
+    if ((t = BN_CTX_get(ctx)) == NULL) {
+        BN_CTX_end(ctx);
+        return 0;
+    }
+    do {
+        ERR_set_mark();
+        ok = BN_priv_rand_range_ex(t, group->field, 0, ctx);
+        ERR_pop_to_mark();
+    } while (ok && BN_is_zero(t));
+    ok = ok && ossl_bn_fixed_load(lambda, t, c->mont);
+    BN_clear(t);
+    BN_CTX_end(ctx);
+    return ok;
+}
+
+static int bp_curve_init(BP_CURVE *c, const EC_GROUP *group)
+{
+    if ((c->mont = ec_fixed_mont(group)) == NULL
+            || group->field_data2 == NULL)
+        return 0;
+    c->num = ossl_bn_fixed_words(c->mont);
+    c->a_is_minus3 = group->a_is_minus3;
+    return ossl_bn_fixed_load(c->a, group->a, c->mont)
+           && ossl_bn_fixed_load(c->one, group->field_data2, c->mont);
+}
+
+static int bp_point_load(BP_POINT *r, const EC_POINT *p, const BP_CURVE *c)
+{
+    return ossl_bn_fixed_load(r->X, p->X, c->mont)
+           && ossl_bn_fixed_load(r->Y, p->Y, c->mont)
+           && ossl_bn_fixed_load(r->Z, p->Z, c->mont);
+}
+
+static int bp_point_store(EC_POINT *r, const BP_POINT *p, const BP_CURVE *c)
+{
+    if (!ossl_bn_fixed_store(r->X, p->X, c->mont)
+            || !ossl_bn_fixed_store(r->Y, p->Y, c->mont)
+            || !ossl_bn_fixed_store(r->Z, p->Z, c->mont))
+        return 0;
+    r->Z_is_one = 0;
+    return 1;
+}
+
+static void bp_comb_free(BP_COMB *comb)
+{
+    if (comb == NULL)
+        return;
+    BN_free(comb->p);
+    BN_free(comb->a);
+    BN_free(comb->gx);
+    BN_free(comb->gy);
+    OPENSSL_free(comb->table);
+    OPENSSL_free(comb);
+}
+
+/*
+ * Entry i of the table is the sum of 2^(j * d) * G over the bits j set in
+ * i, made affine.  Entry 0, the point at infinity, is never read as such.
+ */
+static BP_COMB *bp_comb_new(const EC_GROUP *group, BN_CTX *ctx)
+{
+    const BN_MONT_CTX *mont = ec_fixed_mont(group);
+    EC_POINT *points[BP_COMB_ENTRIES] = { NULL };
+    BP_COMB *comb;
+    int i, j, num, ok = 0;
+
+    if (mont == NULL || group->generator == NULL)
+        return NULL;
+    if ((comb = OPENSSL_zalloc(sizeof(*comb))) == NULL)
+        return NULL;
+    num = ossl_bn_fixed_words(mont);
+    comb->d = (BN_num_bits(group->order) + BP_COMB_TEETH - 1) / BP_COMB_TEETH;
+    comb->bits = comb->d * BP_COMB_TEETH;
+    comb->table = OPENSSL_zalloc(sizeof(*comb->table) * 2 * num
+                                 * BP_COMB_ENTRIES);
+    if (comb->table == NULL
+            || (comb->p = BN_dup(group->field)) == NULL
+            || (comb->a = BN_dup(group->a)) == NULL
+            || (comb->gx = BN_dup(group->generator->X)) == NULL
+            || (comb->gy = BN_dup(group->generator->Y)) == NULL)
+        goto err;
+
+    for (i = 1; i < BP_COMB_ENTRIES; i++)
+        if ((points[i] = EC_POINT_new(group)) == NULL)
+            goto err;
+    if (!EC_POINT_copy(points[1], group->generator))
+        goto err;
+    for (j = 1; j < BP_COMB_TEETH; j++) {
+        if (!EC_POINT_copy(points[1 << j], points[1 << (j - 1)]))
+            goto err;
+        for (i = 0; i < comb->d; i++)
+            if (!EC_POINT_dbl(group, points[1 << j], points[1 << j], ctx))
+                goto err;
+    }
+    for (i = 3; i < BP_COMB_ENTRIES; i++) {
+        int top = 1;
+
+        if ((i & (i - 1)) == 0)
+            continue;
+        while (top * 2 < i)
+            top *= 2;
+        if (!EC_POINT_add(group, points[i], points[i - top], points[top], ctx))
+            goto err;
+    }
+    if (!EC_POINTs_make_affine(group, BP_COMB_ENTRIES - 1, points + 1, ctx))
+        goto err;
+    for (i = 1; i < BP_COMB_ENTRIES; i++)
+        if (!ossl_bn_fixed_load(comb->table + 2 * num * i, points[i]->X, mont)
+                || !ossl_bn_fixed_load(comb->table + 2 * num * i + num,
+                                       points[i]->Y, mont))
+            goto err;
+    ok = 1;
+ err:
+    for (i = 1; i < BP_COMB_ENTRIES; i++)
+        EC_POINT_free(points[i]);
+    if (!ok) {
+        bp_comb_free(comb);
+        comb = NULL;
+    }
+    return comb;
+}
+
+void *ossl_ec_combs_new(OSSL_LIB_CTX *libctx)
+{
+    EC_COMBS *combs = OPENSSL_zalloc(sizeof(*combs));
+
+    if (combs == NULL)
+        return NULL;
+    if ((combs->lock = CRYPTO_THREAD_lock_new()) == NULL) {
+        OPENSSL_free(combs);
+        return NULL;
+    }
+    return combs;
+}
+
+void ossl_ec_combs_free(void *vcombs)
+{
+    EC_COMBS *combs = vcombs;
+    size_t i;
+
+    if (combs == NULL)
+        return;
+    for (i = 0; i < OSSL_NELEM(combs->curve); i++)
+        bp_comb_free(combs->curve[i].comb);
+    CRYPTO_THREAD_lock_free(combs->lock);
+    OPENSSL_free(combs);
+}
+
+static BP_COMB *ec_combs_find(EC_COMBS *combs, int nid)
+{
+    size_t i;
+
+    for (i = 0; i < OSSL_NELEM(combs->curve); i++)
+        if (combs->curve[i].nid == nid)
+            return combs->curve[i].comb;
+    return NULL;
+}
+
+/*
+ * Returns the comb table for the generator of |group|, made from the named
+ * curve's own parameters the first time it is needed and then kept with the
+ * library context, read-only.  NULL if |group| is not that curve with that
+ * generator, or if the table cannot be made.
+ */
+static const BP_COMB *bp_get0_comb(const EC_GROUP *group, BN_CTX *ctx)
+{
+    const EC_POINT *g = group->generator;
+    EC_GROUP *named;
+    EC_COMBS *combs;
+    BP_COMB *comb, *made = NULL;
+    int nid = EC_GROUP_get_curve_name(group);
+    size_t i;
+
+    if (nid == NID_undef || g == NULL || !g->Z_is_one)
+        return NULL;
+    combs = ossl_lib_ctx_get_data(group->libctx, OSSL_LIB_CTX_EC_COMB_INDEX);
+    if (combs == NULL)
+        return NULL;
+
+    if (!CRYPTO_THREAD_read_lock(combs->lock))
+        return NULL;
+    comb = ec_combs_find(combs, nid);
+    CRYPTO_THREAD_unlock(combs->lock);
+
+    if (comb == NULL) {
+        /* Without a table the caller falls back to the window */
+        ERR_set_mark();
+        named = EC_GROUP_new_by_curve_name_ex(group->libctx, NULL, nid);
+        if (named != NULL && named->meth == group->meth)
+            made = bp_comb_new(named, ctx);
+        EC_GROUP_free(named);
+        ERR_pop_to_mark();
+        if (made == NULL)
+            return NULL;
+
+        if (!CRYPTO_THREAD_write_lock(combs->lock)) {
+            bp_comb_free(made);
+            return NULL;
+        }
+        /* Another thread may have made one meanwhile */
+        if ((comb = ec_combs_find(combs, nid)) == NULL) {
+            for (i = 0; i < OSSL_NELEM(combs->curve); i++) {
+                if (combs->curve[i].nid == NID_undef) {
+                    combs->curve[i].nid = nid;
+                    combs->curve[i].comb = comb = made;
+                    made = NULL;
+                    break;
+                }
+            }
+        }
+        CRYPTO_THREAD_unlock(combs->lock);
+        bp_comb_free(made);
+        if (comb == NULL)
+            return NULL;
+    }
+
+    /* A group can carry a curve name with parameters of its own */
+    if (BN_num_bits(group->order) > comb->bits
+            || BN_cmp(group->field, comb->p) != 0
+            || BN_cmp(group->a, comb->a) != 0
+            || BN_cmp(g->X, comb->gx) != 0
+            || BN_cmp(g->Y, comb->gy) != 0)
+        return NULL;
+    return comb;
+}
+
+static int ecp_brainpool_points_mul(const EC_GROUP *group, EC_POINT *r,
+                                    const BIGNUM *scalar, size_t num,
+                                    const EC_POINT *points[],
+                                    const BIGNUM *scalars[], BN_CTX *ctx)
+{
+    const BIGNUM *k;
+    const BP_COMB *comb;
+    BP_CURVE c;
+    BP_POINT p, res;
+    BIGNUM *tmp;
+    BN_ULONG lambda[EC_FIXED_WORDS];
+    int blind;
+    unsigned char kbuf[BP_SCALAR_BYTES];
+    int bits, len, ret = 0;
+
+    /*
+     * As in ossl_ec_wNAF_mul(), multiplications by the order, as when
+     * checking a point, need not be constant time.
+     */
+    if ((scalar != NULL) + num != 1
+            || (scalar != NULL
+                && (scalar == group->order || group->generator == NULL))
+            || (scalar == NULL && scalars[0] == group->order)
+            || BN_is_zero(group->order)
+            || !bp_curve_init(&c, group))
+        return ossl_ec_wNAF_mul(group, r, scalar, num, points, scalars, ctx);
+
+    bits = BN_num_bits(group->order);
+    len = (bits + BP_WINDOW + 7) / 8;
+    if (len > (int)sizeof(kbuf))
+        return ossl_ec_wNAF_mul(group, r, scalar, num, points, scalars, ctx);
+    k = scalar != NULL ? scalar : scalars[0];
+    if (scalar == NULL && EC_POINT_is_at_infinity(group, points[0]))
+        return EC_POINT_set_to_infinity(group, r);
+
+    BN_CTX_start(ctx);
+    if ((tmp = BN_CTX_get(ctx)) == NULL)
+        goto err;
+    if (BN_is_negative(k) || BN_num_bits(k) > bits) {
+        if (!BN_nnmod(tmp, k, group->order, ctx))
+            goto err;
+        k = tmp;
+    }
+    if (BN_bn2lebinpad(k, kbuf, len) < 0)
+        goto err;
+    blind = bp_blind_factor(lambda, group, &c, ctx);
+
+    if (scalar != NULL && (comb = bp_get0_comb(group, ctx)) != NULL) {
+        bp_comb_mul(&res, kbuf, len, comb, blind ? lambda : NULL, &c);
+    } else {
+        if (!bp_point_load(&p, scalar != NULL ? group->generator : points[0],
+                           &c))
+            goto err;
+        if (blind)
+            bp_blind(&p, lambda, &c);
+        bp_window_mul(&res, kbuf, len, bits, &p, &c);
+    }
+    ret = bp_point_store(r, &res, &c);
+ err:
+    BN_CTX_end(ctx);
+    OPENSSL_cleanse(kbuf, sizeof(kbuf));
+    OPENSSL_cleanse(&res, sizeof(res));
+    OPENSSL_cleanse(lambda, sizeof(lambda));
+    return ret;
+}
+
+const EC_METHOD *ossl_ec_GFp_brainpool_method(void)
+{
+    static const EC_METHOD ret = {
+        .field_type = NID_X9_62_prime_field,
+        .group_init = ossl_ec_GFp_mont_group_init,
+        .group_finish = ossl_ec_GFp_mont_group_finish,
+        .group_clear_finish = ossl_ec_GFp_mont_group_clear_finish,
+        .group_copy = ossl_ec_GFp_mont_group_copy,
+        .group_set_curve = ossl_ec_GFp_mont_group_set_curve,
+        .group_get_curve = ossl_ec_GFp_simple_group_get_curve,
+        .group_get_degree = ossl_ec_GFp_simple_group_get_degree,
+        .group_order_bits = ossl_ec_group_simple_order_bits,
+        .group_check_discriminant = ossl_ec_GFp_simple_group_check_discriminant,
+        .point_init = ossl_ec_GFp_simple_point_init,
+        .point_finish = ossl_ec_GFp_simple_point_finish,
+        .point_clear_finish = ossl_ec_GFp_simple_point_clear_finish,
+        .point_copy = ossl_ec_GFp_simple_point_copy,
+        .point_set_to_infinity = ossl_ec_GFp_simple_point_set_to_infinity,
+        .point_set_affine_coordinates =
+            ossl_ec_GFp_simple_point_set_affine_coordinates,
+        .point_get_affine_coordinates =
+            ossl_ec_GFp_simple_point_get_affine_coordinates,
+        .add = ossl_ec_GFp_mont_add,
+        .dbl = ossl_ec_GFp_mont_dbl,
+        .invert = ossl_ec_GFp_simple_invert,
+        .is_at_infinity = ossl_ec_GFp_simple_is_at_infinity,
+        .is_on_curve = ossl_ec_GFp_simple_is_on_curve,
+        .point_cmp = ossl_ec_GFp_simple_cmp,
+        .make_affine = ossl_ec_GFp_simple_make_affine,
+        .points_make_affine = ossl_ec_GFp_simple_points_make_affine,
+        .mul = ecp_brainpool_points_mul,
+        .precompute_mult = NULL,
+        .have_precompute_mult = NULL,
+        .field_mul = ossl_ec_GFp_mont_field_mul,
+        .field_sqr = ossl_ec_GFp_mont_field_sqr,
+        .field_inv = ossl_ec_GFp_mont_field_inv,
+        .field_encode = ossl_ec_GFp_mont_field_encode,
+        .field_decode = ossl_ec_GFp_mont_field_decode,
+        .field_set_to_one = ossl_ec_GFp_mont_field_set_to_one,
+        .priv2oct = ossl_ec_key_simple_priv2oct,
+        .oct2priv = ossl_ec_key_simple_oct2priv,
+        .keygen = ossl_ec_key_simple_generate_key,
+        .keycheck = ossl_ec_key_simple_check_key,
+        .keygenpub = ossl_ec_key_simple_generate_public_key,
+        .ecdh_compute_key = ossl_ecdh_simple_compute_key,
+        .ecdsa_sign_setup = ossl_ecdsa_simple_sign_setup,
+        .ecdsa_sign_sig = ossl_ecdsa_simple_sign_sig,
+        .ecdsa_verify_sig = ossl_ecdsa_simple_verify_sig,
+        .field_inverse_mod_ord = NULL,
+        .blind_coordinates = ossl_ec_GFp_simple_blind_coordinates,
+        .ladder_pre = ossl_ec_GFp_simple_ladder_pre,
+        .ladder_step = ossl_ec_GFp_mont_ladder_step,
+        .ladder_post = ossl_ec_GFp_simple_ladder_post,
+    };
+
+    return &ret;
+}
@@ -15,6 +15,7 @@
 #include <internal/deprecated.h>
 
 #include <openssl/err.h>
+#include <crypto/bn.h>
 
 #include "ec_local.h"
 
@@ -40,8 +41,8 @@ const EC_METHOD *EC_GFp_mont_method(void)
             ossl_ec_GFp_simple_point_set_affine_coordinates,
         .point_get_affine_coordinates =
             ossl_ec_GFp_simple_point_get_affine_coordinates,
-        .add = ossl_ec_GFp_simple_add,
-        .dbl = ossl_ec_GFp_simple_dbl,
+        .add = ossl_ec_GFp_mont_add,
+        .dbl = ossl_ec_GFp_mont_dbl,
         .invert = ossl_ec_GFp_simple_invert,
         .is_at_infinity = ossl_ec_GFp_simple_is_at_infinity,
         .is_on_curve = ossl_ec_GFp_simple_is_on_curve,
@@ -69,7 +70,7 @@ const EC_METHOD *EC_GFp_mont_method(void)
         .field_inverse_mod_ord = NULL,
         .blind_coordinates = ossl_ec_GFp_simple_blind_coordinates,
         .ladder_pre = ossl_ec_GFp_simple_ladder_pre,
-        .ladder_step = ossl_ec_GFp_simple_ladder_step,
+        .ladder_step = ossl_ec_GFp_mont_ladder_step,
         .ladder_post = ossl_ec_GFp_simple_ladder_post,
     };
 
@@ -214,12 +215,11 @@ int ossl_ec_GFp_mont_field_sqr(const EC_GROUP *group, BIGNUM *r, const BIGNUM *a
 /*-
  * Computes the multiplicative inverse of a in GF(p), storing the result in r.
  * If a is zero (or equivalent), you'll get an EC_R_CANNOT_INVERT error.
- * We have a Mont structure, so SCA hardening is FLT inversion.
+ * Inverse in constant time with safegcd.
  */
 int ossl_ec_GFp_mont_field_inv(const EC_GROUP *group, BIGNUM *r, const BIGNUM *a,
                                BN_CTX *ctx)
 {
-    BIGNUM *e = NULL;
     BN_CTX *new_ctx = NULL;
     int ret = 0;
 
@@ -230,24 +230,7 @@ int ossl_ec_GFp_mont_field_inv(const EC_GROUP *group, BIGNUM *r, const BIGNUM *a
             && (ctx = new_ctx = BN_CTX_secure_new_ex(group->libctx)) == NULL)
         return 0;
 
-    BN_CTX_start(ctx);
-    if ((e = BN_CTX_get(ctx)) == NULL)
-        goto err;
-
-    /* Inverse in constant time with Fermats Little Theorem */
-    if (!BN_set_word(e, 2))
-        goto err;
-    if (!BN_sub(e, group->field, e))
-        goto err;
-    /*-
-     * Exponent e is public.
-     * No need for scatter-gather or BN_FLG_CONSTTIME.
-     */
-    if (!BN_mod_exp_mont(r, a, e, group->field, ctx, group->field_data1))
-        goto err;
-
-    /* throw an error on zero */
-    if (BN_is_zero(r)) {
+    if (!ossl_bn_mod_inverse_consttime(r, a, group->field, ctx)) {
         ERR_raise(ERR_LIB_EC, EC_R_CANNOT_INVERT);
         goto err;
     }
@@ -255,7 +238,6 @@ int ossl_ec_GFp_mont_field_inv(const EC_GROUP *group, BIGNUM *r, const BIGNUM *a
     ret = 1;
 
   err:
-    BN_CTX_end(ctx);
     BN_CTX_free(new_ctx);
     return ret;
 }
@@ -294,3 +276,276 @@ int ossl_ec_GFp_mont_field_set_to_one(const EC_GROUP *group, BIGNUM *r,
         return 0;
     return 1;
 }
+
+/*
+ * Point arithmetic on field elements held in fixed-width word arrays on the
+ * stack, see ossl_bn_fixed_words().  The formulas are those of the
+ * ossl_ec_GFp_simple_ functions of the same names, which are used instead
+ * if the field is wider than OPENSSL_ECC_MAX_FIELD_BITS.
+ */
+
+int ossl_ec_GFp_mont_add(const EC_GROUP *group, EC_POINT *r, const EC_POINT *a,
+                         const EC_POINT *b, BN_CTX *ctx)
+{
+    const BN_MONT_CTX *mont = ec_fixed_mont(group);
+    BN_ULONG ax[EC_FIXED_WORDS], ay[EC_FIXED_WORDS], az[EC_FIXED_WORDS];
+    BN_ULONG bx[EC_FIXED_WORDS], by[EC_FIXED_WORDS], bz[EC_FIXED_WORDS];
+    BN_ULONG n0[EC_FIXED_WORDS], n1[EC_FIXED_WORDS], n2[EC_FIXED_WORDS];
+    BN_ULONG n3[EC_FIXED_WORDS], n4[EC_FIXED_WORDS], n5[EC_FIXED_WORDS];
+    BN_ULONG n6[EC_FIXED_WORDS];
+    size_t len;
+
+    if (mont == NULL)
+        return ossl_ec_GFp_simple_add(group, r, a, b, ctx);
+
+    if (a == b)
+        return EC_POINT_dbl(group, r, a, ctx);
+    if (EC_POINT_is_at_infinity(group, a))
+        return EC_POINT_copy(r, b);
+    if (EC_POINT_is_at_infinity(group, b))
+        return EC_POINT_copy(r, a);
+
+    len = sizeof(n0[0]) * ossl_bn_fixed_words(mont);
+    if (!ossl_bn_fixed_load(ax, a->X, mont)
+            || !ossl_bn_fixed_load(ay, a->Y, mont)
+            || !ossl_bn_fixed_load(az, a->Z, mont)
+            || !ossl_bn_fixed_load(bx, b->X, mont)
+            || !ossl_bn_fixed_load(by, b->Y, mont)
+            || !ossl_bn_fixed_load(bz, b->Z, mont))
+        return 0;
+
+    /* n1 = X_a * Z_b^2, n2 = Y_a * Z_b^3 */
+    if (b->Z_is_one) {
+        memcpy(n1, ax, len);
+        memcpy(n2, ay, len);
+    } else {
+        ec_fe_sqr(n0, bz, mont);
+        ec_fe_mul(n1, ax, n0, mont);
+        ec_fe_mul(n0, n0, bz, mont);
+        ec_fe_mul(n2, ay, n0, mont);
+    }
+
+    /* n3 = X_b * Z_a^2, n4 = Y_b * Z_a^3 */
+    if (a->Z_is_one) {
+        memcpy(n3, bx, len);
+        memcpy(n4, by, len);
+    } else {
+        ec_fe_sqr(n0, az, mont);
+        ec_fe_mul(n3, bx, n0, mont);
+        ec_fe_mul(n0, n0, az, mont);
+        ec_fe_mul(n4, by, n0, mont);
+    }
+
+    /* n5 = n1 - n3, n6 = n2 - n4 */
+    ec_fe_sub(n5, n1, n3, mont);
+    ec_fe_sub(n6, n2, n4, mont);
+
+    if (ossl_bn_fixed_is_zero(n5, mont)) {
+        if (ossl_bn_fixed_is_zero(n6, mont))
+            /* a is the same point as b */
+            return EC_POINT_dbl(group, r, a, ctx);
+        /* a is the inverse of b */
+        BN_zero(r->Z);
+        r->Z_is_one = 0;
+        return 1;
+    }
+
+    /* 'n7' = n1 + n3, 'n8' = n2 + n4 */
+    ec_fe_add(n1, n1, n3, mont);
+    ec_fe_add(n2, n2, n4, mont);
+
+    /* Z_r = Z_a * Z_b * n5 */
+    if (a->Z_is_one && b->Z_is_one) {
+        memcpy(bz, n5, len);
+    } else {
+        if (a->Z_is_one)
+            memcpy(n0, bz, len);
+        else if (b->Z_is_one)
+            memcpy(n0, az, len);
+        else
+            ec_fe_mul(n0, az, bz, mont);
+        ec_fe_mul(bz, n0, n5, mont);
+    }
+
+    /* X_r = n6^2 - n5^2 * 'n7' */
+    ec_fe_sqr(n0, n6, mont);
+    ec_fe_sqr(n4, n5, mont);
+    ec_fe_mul(n3, n1, n4, mont);
+    ec_fe_sub(ax, n0, n3, mont);
+
+    /* 'n9' = n5^2 * 'n7' - 2 * X_r */
+    ec_fe_add(n0, ax, ax, mont);
+    ec_fe_sub(n0, n3, n0, mont);
+
+    /* Y_r = (n6 * 'n9' - 'n8' * 'n5^3') / 2 */
+    ec_fe_mul(n0, n0, n6, mont);
+    ec_fe_mul(n5, n4, n5, mont);
+    ec_fe_mul(n1, n2, n5, mont);
+    ec_fe_sub(n0, n0, n1, mont);
+    ossl_bn_fixed_mod_half(ay, n0, mont);
+
+    if (!ossl_bn_fixed_store(r->X, ax, mont)
+            || !ossl_bn_fixed_store(r->Y, ay, mont)
+            || !ossl_bn_fixed_store(r->Z, bz, mont))
+        return 0;
+    r->Z_is_one = 0;
+    return 1;
+}
+
+int ossl_ec_GFp_mont_dbl(const EC_GROUP *group, EC_POINT *r, const EC_POINT *a,
+                         BN_CTX *ctx)
+{
+    const BN_MONT_CTX *mont = ec_fixed_mont(group);
+    BN_ULONG ax[EC_FIXED_WORDS], ay[EC_FIXED_WORDS], az[EC_FIXED_WORDS];
+    BN_ULONG ca[EC_FIXED_WORDS];
+    BN_ULONG n0[EC_FIXED_WORDS], n1[EC_FIXED_WORDS], n2[EC_FIXED_WORDS];
+    BN_ULONG n3[EC_FIXED_WORDS];
+
+    if (mont == NULL)
+        return ossl_ec_GFp_simple_dbl(group, r, a, ctx);
+
+    if (EC_POINT_is_at_infinity(group, a)) {
+        BN_zero(r->Z);
+        r->Z_is_one = 0;
+        return 1;
+    }
+
+    if (!ossl_bn_fixed_load(ax, a->X, mont)
+            || !ossl_bn_fixed_load(ay, a->Y, mont)
+            || !ossl_bn_fixed_load(az, a->Z, mont)
+            || !ossl_bn_fixed_load(ca, group->a, mont))
+        return 0;
+
+    if (a->Z_is_one) {
+        /* n1 = 3 * X_a^2 + a_curve */
+        ec_fe_sqr(n0, ax, mont);
+        ec_fe_add(n1, n0, n0, mont);
+        ec_fe_add(n0, n0, n1, mont);
+        ec_fe_add(n1, n0, ca, mont);
+    } else if (group->a_is_minus3) {
+        /* n1 = 3 * (X_a + Z_a^2) * (X_a - Z_a^2) */
+        ec_fe_sqr(n1, az, mont);
+        ec_fe_add(n0, ax, n1, mont);
+        ec_fe_sub(n2, ax, n1, mont);
+        ec_fe_mul(n1, n0, n2, mont);
+        ec_fe_add(n0, n1, n1, mont);
+        ec_fe_add(n1, n0, n1, mont);
+    } else {
+        /* n1 = 3 * X_a^2 + a_curve * Z_a^4 */
+        ec_fe_sqr(n0, ax, mont);
+        ec_fe_add(n1, n0, n0, mont);
+        ec_fe_add(n0, n0, n1, mont);
+        ec_fe_sqr(n1, az, mont);
+        ec_fe_sqr(n1, n1, mont);
+        ec_fe_mul(n1, n1, ca, mont);
+        ec_fe_add(n1, n1, n0, mont);
+    }
+
+    /* Z_r = 2 * Y_a * Z_a */
+    if (a->Z_is_one)
+        ec_fe_add(az, ay, ay, mont);
+    else {
+        ec_fe_mul(n0, ay, az, mont);
+        ec_fe_add(az, n0, n0, mont);
+    }
+
+    /* n2 = 4 * X_a * Y_a^2 */
+    ec_fe_sqr(n3, ay, mont);
+    ec_fe_mul(n2, ax, n3, mont);
+    ec_fe_add(n2, n2, n2, mont);
+    ec_fe_add(n2, n2, n2, mont);
+
+    /* X_r = n1^2 - 2 * n2 */
+    ec_fe_add(n0, n2, n2, mont);
+    ec_fe_sqr(ax, n1, mont);
+    ec_fe_sub(ax, ax, n0, mont);
+
+    /* n3 = 8 * Y_a^4 */
+    ec_fe_sqr(n0, n3, mont);
+    ec_fe_add(n3, n0, n0, mont);
+    ec_fe_add(n3, n3, n3, mont);
+    ec_fe_add(n3, n3, n3, mont);
+
+    /* Y_r = n1 * (n2 - X_r) - n3 */
+    ec_fe_sub(n0, n2, ax, mont);
+    ec_fe_mul(n0, n1, n0, mont);
+    ec_fe_sub(ay, n0, n3, mont);
+
+    if (!ossl_bn_fixed_store(r->X, ax, mont)
+            || !ossl_bn_fixed_store(r->Y, ay, mont)
+            || !ossl_bn_fixed_store(r->Z, az, mont))
+        return 0;
+    r->Z_is_one = 0;
+    return 1;
+}
+
+int ossl_ec_GFp_mont_ladder_step(const EC_GROUP *group,
+                                 EC_POINT *r, EC_POINT *s,
+                                 EC_POINT *p, BN_CTX *ctx)
+{
+    const BN_MONT_CTX *mont = ec_fixed_mont(group);
+    BN_ULONG rx[EC_FIXED_WORDS], rz[EC_FIXED_WORDS];
+    BN_ULONG sx[EC_FIXED_WORDS], sz[EC_FIXED_WORDS];
+    BN_ULONG px[EC_FIXED_WORDS], ca[EC_FIXED_WORDS];
+    BN_ULONG t0[EC_FIXED_WORDS], t1[EC_FIXED_WORDS], t2[EC_FIXED_WORDS];
+    BN_ULONG t3[EC_FIXED_WORDS], t4[EC_FIXED_WORDS], t5[EC_FIXED_WORDS];
+    BN_ULONG t6[EC_FIXED_WORDS];
+
+    if (mont == NULL)
+        return ossl_ec_GFp_simple_ladder_step(group, r, s, p, ctx);
+
+    if (!ossl_bn_fixed_load(rx, r->X, mont)
+            || !ossl_bn_fixed_load(rz, r->Z, mont)
+            || !ossl_bn_fixed_load(sx, s->X, mont)
+            || !ossl_bn_fixed_load(sz, s->Z, mont)
+            || !ossl_bn_fixed_load(px, p->X, mont)
+            || !ossl_bn_fixed_load(ca, group->a, mont)
+            || !ossl_bn_fixed_load(t2, group->b, mont))
+        return 0;
+
+    ec_fe_mul(t6, rx, sx, mont);
+    ec_fe_mul(t0, rz, sz, mont);
+    ec_fe_mul(t4, rx, sz, mont);
+    ec_fe_mul(t3, rz, sx, mont);
+    ec_fe_mul(t5, ca, t0, mont);
+    ec_fe_add(t5, t6, t5, mont);
+    ec_fe_add(t6, t3, t4, mont);
+    ec_fe_mul(t5, t6, t5, mont);
+    ec_fe_sqr(t0, t0, mont);
+    ec_fe_add(t2, t2, t2, mont);
+    ec_fe_add(t2, t2, t2, mont);
+    ec_fe_mul(t0, t2, t0, mont);
+    ec_fe_add(t5, t5, t5, mont);
+    ec_fe_sub(t3, t4, t3, mont);
+    /* s->Z coord output */
+    ec_fe_sqr(sz, t3, mont);
+    ec_fe_mul(t4, sz, px, mont);
+    ec_fe_add(t0, t0, t5, mont);
+    /* s->X coord output */
+    ec_fe_sub(sx, t0, t4, mont);
+    ec_fe_sqr(t4, rx, mont);
+    ec_fe_sqr(t5, rz, mont);
+    ec_fe_mul(t6, t5, ca, mont);
+    ec_fe_add(t1, rx, rz, mont);
+    ec_fe_sqr(t1, t1, mont);
+    ec_fe_sub(t1, t1, t4, mont);
+    ec_fe_sub(t1, t1, t5, mont);
+    ec_fe_sub(t3, t4, t6, mont);
+    ec_fe_sqr(t3, t3, mont);
+    ec_fe_mul(t0, t5, t1, mont);
+    ec_fe_mul(t0, t2, t0, mont);
+    /* r->X coord output */
+    ec_fe_sub(rx, t3, t0, mont);
+    ec_fe_add(t3, t4, t6, mont);
+    ec_fe_sqr(t4, t5, mont);
+    ec_fe_mul(t4, t4, t2, mont);
+    ec_fe_mul(t1, t1, t3, mont);
+    ec_fe_add(t1, t1, t1, mont);
+    /* r->Z coord output */
+    ec_fe_add(rz, t4, t1, mont);
+
+    return ossl_bn_fixed_store(r->X, rx, mont)
+        && ossl_bn_fixed_store(r->Z, rz, mont)
+        && ossl_bn_fixed_store(s->X, sx, mont)
+        && ossl_bn_fixed_store(s->Z, sz, mont);
+}
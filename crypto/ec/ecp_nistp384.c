@@ -217,41 +217,6 @@ static void felem_scalar128(widefelem out, limb scalar)
         out[i] *= scalar;
 }
 
-/*-
- * felem_neg sets |out| to |-in|
- * On entry:
- *   in[i] < 2^60 - 2^29
- * On exit:
- *   out[i] < 2^60
- */
-static void felem_neg(felem out, const felem in)
-{
-    /*
-     * In order to prevent underflow, we add a multiple of p before subtracting.
-     * Use telescopic sums to represent 2^12 * p redundantly with each limb
-     * of the form 2^60 + ...
-     */
-    static const limb two60m52m4 = (((limb) 1) << 60)
-                                 - (((limb) 1) << 52)
-                                 - (((limb) 1) << 4);
-    static const limb two60p44m12 = (((limb) 1) << 60)
-                                  + (((limb) 1) << 44)
-                                  - (((limb) 1) << 12);
-    static const limb two60m28m4 = (((limb) 1) << 60)
-                                 - (((limb) 1) << 28)
-                                 - (((limb) 1) << 4);
-    static const limb two60m4 = (((limb) 1) << 60)
-                              - (((limb) 1) << 4);
-
-    out[0] = two60p44m12 - in[0];
-    out[1] = two60m52m4 - in[1];
-    out[2] = two60m28m4 - in[2];
-    out[3] = two60m4 - in[3];
-    out[4] = two60m4 - in[4];
-    out[5] = two60m4 - in[5];
-    out[6] = two60m4 - in[6];
-}
-
 /*-
  * felem_diff64 subtracts |in| from |out|
  * On entry:
@@ -673,6 +638,26 @@ static void felem_reduce(felem out, const widefelem in)
         out[i] = acc[i];
 }
 
+/*-
+ * felem_neg sets |out| to |-in|
+ * On entry:
+ *   in[i] < 2^63
+ * On exit:
+ *   out[i] < 2^56, i < 6
+ *   out[6] <= 2^48
+ *
+ * The result is reduced so that it can be used anywhere a point coordinate
+ * can; batch_mul() may copy it straight into its output.
+ */
+static void felem_neg(felem out, const felem in)
+{
+    widefelem tmp;
+
+    memset(tmp, 0, sizeof(tmp));
+    felem_diff_128_64(tmp, in);
+    felem_reduce(out, tmp);
+}
+
 #if defined(ECP_NISTP384_ASM)
 static void felem_square_wrapper(widefelem out, const felem in);
 static void felem_mul_wrapper(widefelem out, const felem in1, const felem in2);
@@ -1219,112 +1204,350 @@ static void point_add(felem x3, felem y3, felem z3,
  * elements (x, y, z).
  *
  * For the base point table, z is usually 1 (0 for the point at infinity).
- * This table has 16 elements:
+ * This table has 4 * 16 elements, starting with the following:
  * index | bits    | point
  * ------+---------+------------------------------
  *     0 | 0 0 0 0 | 0G
  *     1 | 0 0 0 1 | 1G
- *     2 | 0 0 1 0 | 2^95G
- *     3 | 0 0 1 1 | (2^95 + 1)G
- *     4 | 0 1 0 0 | 2^190G
- *     5 | 0 1 0 1 | (2^190 + 1)G
- *     6 | 0 1 1 0 | (2^190 + 2^95)G
- *     7 | 0 1 1 1 | (2^190 + 2^95 + 1)G
- *     8 | 1 0 0 0 | 2^285G
- *     9 | 1 0 0 1 | (2^285 + 1)G
- *    10 | 1 0 1 0 | (2^285 + 2^95)G
- *    11 | 1 0 1 1 | (2^285 + 2^95 + 1)G
- *    12 | 1 1 0 0 | (2^285 + 2^190)G
- *    13 | 1 1 0 1 | (2^285 + 2^190 + 1)G
- *    14 | 1 1 1 0 | (2^285 + 2^190 + 2^95)G
- *    15 | 1 1 1 1 | (2^285 + 2^190 + 2^95 + 1)G
+ *     2 | 0 0 1 0 | 2^96G
+ *     3 | 0 0 1 1 | (2^96 + 1)G
+ *     4 | 0 1 0 0 | 2^192G
+ *     5 | 0 1 0 1 | (2^192 + 1)G
+ *     6 | 0 1 1 0 | (2^192 + 2^96)G
+ *     7 | 0 1 1 1 | (2^192 + 2^96 + 1)G
+ *     8 | 1 0 0 0 | 2^288G
+ *     9 | 1 0 0 1 | (2^288 + 1)G
+ *    10 | 1 0 1 0 | (2^288 + 2^96)G
+ *    11 | 1 0 1 1 | (2^288 + 2^96 + 1)G
+ *    12 | 1 1 0 0 | (2^288 + 2^192)G
+ *    13 | 1 1 0 1 | (2^288 + 2^192 + 1)G
+ *    14 | 1 1 1 0 | (2^288 + 2^192 + 2^96)G
+ *    15 | 1 1 1 1 | (2^288 + 2^192 + 2^96 + 1)G
+ * followed by three copies of this with each element multiplied by 2^24,
+ * 2^48 and 2^72 respectively.
  *
- * The reason for this is so that we can clock bits into four different
- * locations when doing simple scalar multiplies against the base point.
+ * The reason for this is so that we can clock bits into sixteen different
+ * locations when doing simple scalar multiplies against the base point,
+ * four for each of the tables, which leaves 23 doublings per
+ * multiplication.
  *
  * Tables for other points have table[i] = iG for i in 0 .. 16.
  */
 
 /* gmul is the table of precomputed base points */
-static const felem gmul[16][3] = {
-{{0, 0, 0, 0, 0, 0, 0},
- {0, 0, 0, 0, 0, 0, 0},
- {0, 0, 0, 0, 0, 0, 0}},
-{{0x00545e3872760ab7, 0x00f25dbf55296c3a, 0x00e082542a385502, 0x008ba79b9859f741,
-  0x0020ad746e1d3b62, 0x0005378eb1c71ef3, 0x0000aa87ca22be8b},
- {0x00431d7c90ea0e5f, 0x00b1ce1d7e819d7a, 0x0013b5f0b8c00a60, 0x00289a147ce9da31,
-  0x0092dc29f8f41dbd, 0x002c6f5d9e98bf92, 0x00003617de4a9626},
- {1, 0, 0, 0, 0, 0, 0}},
-{{0x00024711cc902a90, 0x00acb2e579ab4fe1, 0x00af818a4b4d57b1, 0x00a17c7bec49c3de,
-  0x004280482d726a8b, 0x00128dd0f0a90f3b, 0x00004387c1c3fa3c},
- {0x002ce76543cf5c3a, 0x00de6cee5ef58f0a, 0x00403e42fa561ca6, 0x00bc54d6f9cb9731,
-  0x007155f925fb4ff1, 0x004a9ce731b7b9bc, 0x00002609076bd7b2},
- {1, 0, 0, 0, 0, 0, 0}},
-{{0x00e74c9182f0251d, 0x0039bf54bb111974, 0x00b9d2f2eec511d2, 0x0036b1594eb3a6a4,
-  0x00ac3bb82d9d564b, 0x00f9313f4615a100, 0x00006716a9a91b10},
- {0x0046698116e2f15c, 0x00f34347067d3d33, 0x008de4ccfdebd002, 0x00e838c6b8e8c97b,
-  0x006faf0798def346, 0x007349794a57563c, 0x00002629e7e6ad84},
- {1, 0, 0, 0, 0, 0, 0}},
-{{0x0075300e34fd163b, 0x0092e9db4e8d0ad3, 0x00254be9f625f760, 0x00512c518c72ae68,
-  0x009bfcf162bede5a, 0x00bf9341566ce311, 0x0000cd6175bd41cf},
- {0x007dfe52af4ac70f, 0x0002159d2d5c4880, 0x00b504d16f0af8d0, 0x0014585e11f5e64c,
-  0x0089c6388e030967, 0x00ffb270cbfa5f71, 0x00009a15d92c3947},
- {1, 0, 0, 0, 0, 0, 0}},
-{{0x0033fc1278dc4fe5, 0x00d53088c2caa043, 0x0085558827e2db66, 0x00c192bef387b736,
-  0x00df6405a2225f2c, 0x0075205aa90fd91a, 0x0000137e3f12349d},
- {0x00ce5b115efcb07e, 0x00abc3308410deeb, 0x005dc6fc1de39904, 0x00907c1c496f36b4,
-  0x0008e6ad3926cbe1, 0x00110747b787928c, 0x0000021b9162eb7e},
- {1, 0, 0, 0, 0, 0, 0}},
-{{0x008180042cfa26e1, 0x007b826a96254967, 0x0082473694d6b194, 0x007bd6880a45b589,
-  0x00c0a5097072d1a3, 0x0019186555e18b4e, 0x000020278190e5ca},
- {0x00b4bef17de61ac0, 0x009535e3c38ed348, 0x002d4aa8e468ceab, 0x00ef40b431036ad3,
-  0x00defd52f4542857, 0x0086edbf98234266, 0x00002025b3a7814d},
- {1, 0, 0, 0, 0, 0, 0}},
-{{0x00b238aa97b886be, 0x00ef3192d6dd3a32, 0x0079f9e01fd62df8, 0x00742e890daba6c5,
-  0x008e5289144408ce, 0x0073bbcc8e0171a5, 0x0000c4fd329d3b52},
- {0x00c6f64a15ee23e7, 0x00dcfb7b171cad8b, 0x00039f6cbd805867, 0x00de024e428d4562,
-  0x00be6a594d7c64c5, 0x0078467b70dbcd64, 0x0000251f2ed7079b},
- {1, 0, 0, 0, 0, 0, 0}},
-{{0x000e5cc25fc4b872, 0x005ebf10d31ef4e1, 0x0061e0ebd11e8256, 0x0076e026096f5a27,
-  0x0013e6fc44662e9a, 0x0042b00289d3597e, 0x000024f089170d88},
- {0x001604d7e0effbe6, 0x0048d77cba64ec2c, 0x008166b16da19e36, 0x006b0d1a0f28c088,
-  0x000259fcd47754fd, 0x00cc643e4d725f9a, 0x00007b10f3c79c14},
- {1, 0, 0, 0, 0, 0, 0}},
-{{0x00430155e3b908af, 0x00b801e4fec25226, 0x00b0d4bcfe806d26, 0x009fc4014eb13d37,
-  0x0066c94e44ec07e8, 0x00d16adc03874ba2, 0x000030c917a0d2a7},
- {0x00edac9e21eb891c, 0x00ef0fb768102eff, 0x00c088cef272a5f3, 0x00cbf782134e2964,
-  0x0001044a7ba9a0e3, 0x00e363f5b194cf3c, 0x00009ce85249e372},
- {1, 0, 0, 0, 0, 0, 0}},
-{{0x001dd492dda5a7eb, 0x008fd577be539fd1, 0x002ff4b25a5fc3f1, 0x0074a8a1b64df72f,
-  0x002ba3d8c204a76c, 0x009d5cff95c8235a, 0x0000e014b9406e0f},
- {0x008c2e4dbfc98aba, 0x00f30bb89f1a1436, 0x00b46f7aea3e259c, 0x009224454ac02f54,
-  0x00906401f5645fa2, 0x003a1d1940eabc77, 0x00007c9351d680e6},
- {1, 0, 0, 0, 0, 0, 0}},
-{{0x005a35d872ef967c, 0x0049f1b7884e1987, 0x0059d46d7e31f552, 0x00ceb4869d2d0fb6,
-  0x00e8e89eee56802a, 0x0049d806a774aaf2, 0x0000147e2af0ae24},
- {0x005fd1bd852c6e5e, 0x00b674b7b3de6885, 0x003b9ea5eb9b6c08, 0x005c9f03babf3ef7,
-  0x00605337fecab3c7, 0x009a3f85b11bbcc8, 0x0000455470f330ec},
- {1, 0, 0, 0, 0, 0, 0}},
-{{0x002197ff4d55498d, 0x00383e8916c2d8af, 0x00eb203f34d1c6d2, 0x0080367cbd11b542,
-  0x00769b3be864e4f5, 0x0081a8458521c7bb, 0x0000c531b34d3539},
- {0x00e2a3d775fa2e13, 0x00534fc379573844, 0x00ff237d2a8db54a, 0x00d301b2335a8882,
-  0x000f75ea96103a80, 0x0018fecb3cdd96fa, 0x0000304bf61e94eb},
- {1, 0, 0, 0, 0, 0, 0}},
-{{0x00b2afc332a73dbd, 0x0029a0d5bb007bc5, 0x002d628eb210f577, 0x009f59a36dd05f50,
-  0x006d339de4eca613, 0x00c75a71addc86bc, 0x000060384c5ea93c},
- {0x00aa9641c32a30b4, 0x00cc73ae8cce565d, 0x00ec911a4df07f61, 0x00aa4b762ea4b264,
-  0x0096d395bb393629, 0x004efacfb7632fe0, 0x00006f252f46fa3f},
- {1, 0, 0, 0, 0, 0, 0}},
-{{0x00567eec597c7af6, 0x0059ba6795204413, 0x00816d4e6f01196f, 0x004ae6b3eb57951d,
-  0x00420f5abdda2108, 0x003401d1f57ca9d9, 0x0000cf5837b0b67a},
- {0x00eaa64b8aeeabf9, 0x00246ddf16bcb4de, 0x000e7e3c3aecd751, 0x0008449f04fed72e,
-  0x00307b67ccf09183, 0x0017108c3556b7b1, 0x0000229b2483b3bf},
- {1, 0, 0, 0, 0, 0, 0}},
-{{0x00e7c491a7bb78a1, 0x00eafddd1d3049ab, 0x00352c05e2bc7c98, 0x003d6880c165fa5c,
-  0x00b6ac61cc11c97d, 0x00beeb54fcf90ce5, 0x0000dc1f0b455edc},
- {0x002db2e7aee34d60, 0x0073b5f415a2d8c0, 0x00dd84e4193e9a0c, 0x00d02d873467c572,
-  0x0018baaeda60aee5, 0x0013fb11d697c61e, 0x000083aafcc3a973},
- {1, 0, 0, 0, 0, 0, 0}}
+static const felem gmul[4][16][3] = {
+{{{0, 0, 0, 0, 0, 0, 0},
+  {0, 0, 0, 0, 0, 0, 0},
+  {0, 0, 0, 0, 0, 0, 0}},
+ {{0x00545e3872760ab7, 0x00f25dbf55296c3a, 0x00e082542a385502, 0x008ba79b9859f741,
+   0x0020ad746e1d3b62, 0x0005378eb1c71ef3, 0x0000aa87ca22be8b},
+  {0x00431d7c90ea0e5f, 0x00b1ce1d7e819d7a, 0x0013b5f0b8c00a60, 0x00289a147ce9da31,
+   0x0092dc29f8f41dbd, 0x002c6f5d9e98bf92, 0x00003617de4a9626},
+  {1, 0, 0, 0, 0, 0, 0}},
+ {{0x00c1b328d8ee21c9, 0x000c91558717db39, 0x008b3f8686a92c3e, 0x0018141b1a4b5880,
+   0x00ca7abc43603909, 0x00bd1bd6e98b0d37, 0x0000f532389a060c},
+  {0x007e183923d86ecd, 0x0031b1085a4e9a7a, 0x005abe64360331ea, 0x00a2124163bc40ce,
+   0x003a82babd22cfb2, 0x008e696f04caa2de, 0x0000b9d2852cc3b3},
+  {1, 0, 0, 0, 0, 0, 0}},
+ {{0x004e5246eb09a0e5, 0x00be1132cdf03c26, 0x00835faefa4ff8f4, 0x0017a31b22da9d54,
+   0x00f06145bbbc4fd0, 0x002cabc3decd0c86, 0x0000528ef1670a5f},
+  {0x001e9858c14f0dd6, 0x0038a809cb75248a, 0x00b4c87fed225505, 0x00631d058dbd60ca,
+   0x001dcf14f8b76fdd, 0x00f56c5803eaa11a, 0x00007b9b1fbe7bcc},
+  {1, 0, 0, 0, 0, 0, 0}},
+ {{0x0028b09aaa03bd53, 0x005458a4f52d78a6, 0x00894d10ddeaba06, 0x008a3e297ddb2987,
+   0x00421279b42a31af, 0x0019c440f7f9e706, 0x0000c19e0b4c8001},
+  {0x002d0fc5e6c88c41, 0x00aa6de639d85882, 0x00d135f6ebf2af68, 0x00e3567af9c1c7ca,
+   0x005b77f6577a30ea, 0x00b301e5a0191d1f, 0x000016f3fdbf0356},
+  {1, 0, 0, 0, 0, 0, 0}},
+ {{0x00991560aa133909, 0x00dbb1c6cb001730, 0x0024b860fae69097, 0x0070b375ddd37de4,
+   0x006ce3a39bb183b2, 0x003088567a6233cd, 0x0000aab8bb9f0fdc},
+  {0x00c5b981600ad5a6, 0x0073f2d62faa4416, 0x00b3c9747bf3ebdf, 0x0015eb04ac6d955b,
+   0x002050b5f6005fc8, 0x006d28f0af01d128, 0x000048942f81314f},
+  {1, 0, 0, 0, 0, 0, 0}},
+ {{0x002211217716605e, 0x00d2c89ef281c820, 0x0099567d63422347, 0x0077c0f03f54ba45,
+   0x00367444ce0fba30, 0x00a0527022f802cb, 0x00007334a936a9a6},
+  {0x00461f68d658a01a, 0x00d519c2bd0efab5, 0x008f697a92800a64, 0x007d0e017a9e2eee,
+   0x00bd4ccd8e5d9b89, 0x00c9261f7c5c367c, 0x00007ffceff7f632},
+  {1, 0, 0, 0, 0, 0, 0}},
+ {{0x000ae2e60e758344, 0x00707a371a2ca530, 0x00105052dd32451c, 0x004862b95425651d,
+   0x0081ef13bf88de7f, 0x00090efafce26e03, 0x0000dc916c17960e},
+  {0x0017cc44026b0889, 0x001ff19b42441bed, 0x0078cc16069795c0, 0x000ba04a35408964,
+   0x001c295252d154b8, 0x00ca0ab3d92ea470, 0x0000266e8a40d69e},
+  {1, 0, 0, 0, 0, 0, 0}},
+ {{0x00bfc2c04905ca71, 0x00450ad156f761e4, 0x00dbd08848c2f33a, 0x00a23096863d8b29,
+   0x004972d7097da395, 0x00aa12211905035f, 0x0000b2d1055817cb},
+  {0x00cebb55753ee324, 0x00b07c6924666fdd, 0x00744ecf1a68e87a, 0x002e6236c09b475d,
+   0x00fd056bf82be8f5, 0x00cbd2237c0dba3c, 0x0000354cd872c3c6},
+  {1, 0, 0, 0, 0, 0, 0}},
+ {{0x00104d24708d4cee, 0x006958819cf0438d, 0x00faf0712210197d, 0x005c20155847fc87,
+   0x001ef638103df785, 0x00bfec30b0a9e861, 0x000000b19ac8fdfe},
+  {0x000e8d6fd201e03e, 0x00969c2228ff5fd4, 0x0082636164c5bb7c, 0x00e754220d688102,
+   0x00f6edc4cdbb3cd2, 0x0060311418fe25e9, 0x0000a72f91059ee3},
+  {1, 0, 0, 0, 0, 0, 0}},
+ {{0x00d2c273b769737a, 0x00245197d53ffd64, 0x004be86c46bd2cc0, 0x00685e926dc3b6ac,
+   0x00203a3617e9411f, 0x00b27e136df36b75, 0x00003f9561e08bf0},
+  {0x006ff8d527e990a7, 0x00e586f9867a60dd, 0x00478554e014c34b, 0x006f52e4cbea0887,
+   0x002ab641cfced664, 0x0095874b1a5a2041, 0x00000b06f0063962},
+  {1, 0, 0, 0, 0, 0, 0}},
+ {{0x004c0dd285651f82, 0x0051e7785d3ef704, 0x006188e95532325c, 0x00522c2931b83a18,
+   0x0080f137539f94ad, 0x0066d715274e5b89, 0x00009fd7b010df0f},
+  {0x00a7b94a4064e4c0, 0x00ba4525d7d211e4, 0x0054be8a04e3d44e, 0x00149033de0a806b,
+   0x00739246929226bd, 0x000225795f6fa3c9, 0x0000321aa9a3b926},
+  {1, 0, 0, 0, 0, 0, 0}},
+ {{0x00bcc2f58b707b8e, 0x00b5191d92898349, 0x00567d49c7802901, 0x004c6a99642e4c29,
+   0x00ee3e13ebd1cff8, 0x0068f72caebbd316, 0x000036a543eea87a},
+  {0x00b41c29b569946d, 0x00e7d43ef2267e75, 0x0072d4b3394d1510, 0x008fbd85d1912350,
+   0x00a6784758eaff04, 0x00e41cd349ab0378, 0x0000f277bacda50e},
+  {1, 0, 0, 0, 0, 0, 0}},
+ {{0x00b056585f863bbd, 0x00dc5ab483283d10, 0x0009dc7c421de92c, 0x006d01a5a8ebb312,
+   0x008b6a513afcbd79, 0x007aebe2b067caa0, 0x0000026e0dc2e8cb},
+  {0x00c3502902dde18a, 0x005facd8c6cf36d8, 0x000110781e4564c1, 0x001f3443d817ea27,
+   0x007461a5d68d1ffc, 0x0024e14be256378c, 0x0000ae8866bad8ef},
+  {1, 0, 0, 0, 0, 0, 0}},
+ {{0x003a78d0d265a91c, 0x00f8ef6c8f83d3ac, 0x00de8fd8d8171a29, 0x00c42bf748ef98fd,
+   0x00a73dc7df459ea1, 0x00fa2d14dafc3981, 0x0000b03dfa54c52a},
+  {0x00406f6e6c0d2ce7, 0x000b2b41fd72cacc, 0x000678f602ddcd12, 0x008accf229ef5d90,
+   0x006d908af5f8a2d1, 0x0085f2aafd1fcfce, 0x00002ce2885a0e6d},
+  {1, 0, 0, 0, 0, 0, 0}},
+ {{0x00109a0ec62666de, 0x002e757ffcd01e89, 0x0069c48b5ab0c8c1, 0x00f983ac6ca82061,
+   0x00977d234bc2fdcf, 0x00c96a59cfca7155, 0x00001264cb335766},
+  {0x006913812e014b4b, 0x008707e4483ec56b, 0x000cffb1975831d2, 0x0065a5f248cbf719,
+   0x003b4f69b66717a0, 0x00a376d94ad8fac5, 0x0000119ebeeea1a1},
+  {1, 0, 0, 0, 0, 0, 0}}},
+{{{0, 0, 0, 0, 0, 0, 0},
+  {0, 0, 0, 0, 0, 0, 0},
+  {0, 0, 0, 0, 0, 0, 0}},
+ {{0x00043ffbbb5ef8a6, 0x003c62ccd4759025, 0x00a560f5afd2e219, 0x00f776ee76c96307,
+   0x0019b09636a26654, 0x00128daaaa4f9faa, 0x00003e9c2dd27f00},
+  {0x00b681bea912e417, 0x003bfa205d7508b9, 0x00c3aba26b122df3, 0x0087023f04685d8c,
+   0x002de357bc005209, 0x004f6bad380091b0, 0x00008e3337f55d67},
+  {1, 0, 0, 0, 0, 0, 0}},
+ {{0x00f057aeeb02d061, 0x007f0b2f3bc02ea4, 0x0032f86e089a05b6, 0x003031e72056aead,
+   0x00b8e23736ee2eea, 0x00b5395b51b855b1, 0x0000873893319b8b},
+  {0x0041ee49205e62e9, 0x00905ac40ea26258, 0x00b6506a5c3696ed, 0x00a4aef7d82c97da,
+   0x002c8acc0f317f1b, 0x001b20aec182bc95, 0x0000509e270d600a},
+  {1, 0, 0, 0, 0, 0, 0}},
+ {{0x0035f2d615a8fd28, 0x00a5511d83f1a64e, 0x00d0744339c5f60b, 0x00ff8c4ced5c5bae,
+   0x006d59b95b3df56c, 0x00d2fa6e20110cdf, 0x0000cdb6e78459ae},
+  {0x00f2d924742a15f4, 0x00257608726d45bf, 0x00771285aeae55e0, 0x006b0b353446eb91,
+   0x00ea9b73fd04559e, 0x00ee7fc47eba7812, 0x0000ea6986ae61f5},
+  {1, 0, 0, 0, 0, 0, 0}},
+ {{0x0039babfea22e778, 0x0084acdf3cf2e101, 0x00d804c9e381ec62, 0x009e1e75ca802e7e,
+   0x00470675efb3591a, 0x00b5b5d2f9c128cd, 0x0000f59328c85bc0},
+  {0x00d17b7a18aac609, 0x006b59050839cf70, 0x000c7438e95ee4c1, 0x008dcdf8e3d51d3e,
+   0x0092ab4e682cd98a, 0x0013aaca1499c825, 0x0000850a3c8a8256},
+  {1, 0, 0, 0, 0, 0, 0}},
+ {{0x007fab83837baa0e, 0x003f439b71ae1d77, 0x0061bad6e71985f7, 0x004cea8b57234bf4,
+   0x0029d905959b8d10, 0x00efd1af919ff437, 0x00007b30bf5f503f},
+  {0x00e0d48199f37bcb, 0x0058309cb177bf24, 0x00b536fa39ba2d7e, 0x006687046b2d1187,
+   0x0078fddce1efb1a9, 0x0065e57760083604, 0x000058a05dce5ca0},
+  {1, 0, 0, 0, 0, 0, 0}},
+ {{0x0020c6567be3dad0, 0x004540d21a6e668f, 0x00473f18f83e99d9, 0x00c57afb55b9fc59,
+   0x00b8c286c6320d14, 0x00a1f826ddbd136c, 0x0000a72c79cae13f},
+  {0x00dd7b455f9fba19, 0x0023a64467b8b7a5, 0x003ea7490509e091, 0x005001543f8d7a25,
+   0x005f6bfb2d6805c8, 0x006691d757ee4fb1, 0x0000352a96a40d0f},
+  {1, 0, 0, 0, 0, 0, 0}},
+ {{0x0036f92b911af837, 0x00c478110b9f9501, 0x0016fb51ef1e6b8b, 0x00113cd2959f04cc,
+   0x00dd98fab5b221b8, 0x004bbff1806955cc, 0x00009ae9e851bdf0},
+  {0x009a9403032dac29, 0x00b740d53fc4aaef, 0x0032ea4ad77635df, 0x0020824d729e1cc0,
+   0x002f6c262567113d, 0x0069848337b5202d, 0x0000412ac0570854},
+  {1, 0, 0, 0, 0, 0, 0}},
+ {{0x00da59b0d9a0d716, 0x0022663ba5812809, 0x0085f30671a0e90f, 0x00aba22d8ce867df,
+   0x00406ee84bf10cfb, 0x000053017faf5418, 0x00004cbf6414b97c},
+  {0x006090d9b0228bd2, 0x00843f8074509551, 0x000728a501be2599, 0x00fea4fa162fe052,
+   0x003baebbbffe106a, 0x006837f83a3767e0, 0x000071b00e3d8ec6},
+  {1, 0, 0, 0, 0, 0, 0}},
+ {{0x00b028ec9d72438d, 0x004449be8c08c8de, 0x00e8509dc0ff2896, 0x009e8570e5a0c7fd,
+   0x0054595ef1e36cad, 0x00d3e06622706e84, 0x0000d28981da4f47},
+  {0x000d3f94b2d0ec2a, 0x00226111f2a3ac38, 0x00188243d84cc8ab, 0x001143dcb340f033,
+   0x00b10715bb0412cb, 0x005cda9f2769308f, 0x000051a2ca7cb932},
+  {1, 0, 0, 0, 0, 0, 0}},
+ {{0x00ea9b8956d86038, 0x000c1ac67982b4f6, 0x0043ed797db84781, 0x0085653779fa6af1,
+   0x00b5891032c7c267, 0x00742637da44194c, 0x000033d3be0e3ba8},
+  {0x0075c34668603c49, 0x00a2754f880fca87, 0x0072ffa76579c76c, 0x003ac45fa6a3280c,
+   0x005c678ce4f6c97d, 0x00d25dc45e0bb013, 0x000098e8f1b7e760},
+  {1, 0, 0, 0, 0, 0, 0}},
+ {{0x00f6493e69ffb874, 0x00f46bbb2985573a, 0x00ccbd09a513db14, 0x0049190e138b1031,
+   0x008e842f382aeca3, 0x00394fa6143b681e, 0x00007cf1d6bdf681},
+  {0x001c8f4b8e898943, 0x0008c9e988c21ef8, 0x003685d51daa3a9e, 0x002a09eb90b7ec0f,
+   0x00dd0cf82f8654f8, 0x00875a8540bafdfa, 0x00004f3edc0c07bf},
+  {1, 0, 0, 0, 0, 0, 0}},
+ {{0x008aa44b3d72b7de, 0x0022150016e89320, 0x003c5391dcb6a576, 0x00ba5f2def4f9324,
+   0x003c9f86b04296d4, 0x0021d24788fd57a8, 0x00009874d9aa6665},
+  {0x0097ddbeb822643d, 0x00a0cffa7619252c, 0x00595e518032ddc1, 0x0018e15e0e8cc5b8,
+   0x0021625a5bedfd33, 0x00f48d711d7b8180, 0x00009250e33bd28e},
+  {1, 0, 0, 0, 0, 0, 0}},
+ {{0x00dcb7395a785c13, 0x0049c62491c3e98a, 0x009665011fe00abc, 0x00d3ab7548fe021a,
+   0x0010bcf884357125, 0x0063411826898c37, 0x0000cef4303c5423},
+  {0x004db5d16114a28f, 0x00ed8cab97722071, 0x0050d9f2eb5e9288, 0x0026b8d2423a12fc,
+   0x00f4d2bb7e4158fd, 0x002b14e15d1d38df, 0x00002174a900bd47},
+  {1, 0, 0, 0, 0, 0, 0}},
+ {{0x00fe3c585c20c05f, 0x008d8b949efdf0ab, 0x007a8ca5fcf85950, 0x00a2e890c3994984,
+   0x006e1ef8f3128696, 0x0034eb7ebd4b4592, 0x000085e47f789b0f},
+  {0x00982862a7629c07, 0x0088b5407979385e, 0x00fd4b042890be8c, 0x00019dc51d96a64b,
+   0x000f3a3da4f85b35, 0x007f71190bd9a35f, 0x0000bfbb65720774},
+  {1, 0, 0, 0, 0, 0, 0}},
+ {{0x00922b3e89dbe279, 0x0011a5f460658099, 0x0025621ce4282d9f, 0x00a26b588bbb4337,
+   0x007aa272054b80a2, 0x00556a512151d90d, 0x0000019aa20ff6a9},
+  {0x008f8f8f2bed9ea7, 0x00561d81d066a60e, 0x00bbeea096822db8, 0x000b33a214ccef2b,
+   0x00bd5a0e172569e7, 0x00f288b131a4d7a8, 0x000085336931f6c6},
+  {1, 0, 0, 0, 0, 0, 0}}},
+{{{0, 0, 0, 0, 0, 0, 0},
+  {0, 0, 0, 0, 0, 0, 0},
+  {0, 0, 0, 0, 0, 0, 0}},
+ {{0x0012e340f47168ac, 0x00d3a09008070591, 0x00a1cc7fdedf3917, 0x008512e48ab6971d,
+   0x00f6297ecbd8aa25, 0x00b6a3804100caa7, 0x0000f19c3f9b433e},
+  {0x00e0b1762d8b523f, 0x0078cb39d2cf6c45, 0x008bee4928be1b70, 0x005a620149af40b6,
+   0x0038904565d24d48, 0x00090c4a1e9b515d, 0x0000ae61a171f610},
+  {1, 0, 0, 0, 0, 0, 0}},
+ {{0x005e0f5d2805e596, 0x00a01d262810506f, 0x0053ee0d124b89bb, 0x00badc49fb712e12,
+   0x00f0c000d214b583, 0x00c3ef049f9294aa, 0x00004e5a9dfe6ac2},
+  {0x005622c691013e25, 0x00321bced6e71496, 0x003d0051e0574b8f, 0x007a5e5a25b5a060,
+   0x006b571281a2b658, 0x00f1717bdd7fa630, 0x0000526f1b07f6ac},
+  {1, 0, 0, 0, 0, 0, 0}},
+ {{0x00ff5ece88f05154, 0x00be4f62091c2c9b, 0x00b4fc1b7102b008, 0x00bf37e0c6bc5cd1,
+   0x0012eb0e1eadfda0, 0x004fcf1c4a42aae9, 0x0000aef19fb9e788},
+  {0x001276425b94e7af, 0x00a2a398102462b8, 0x005834e2fa7ae591, 0x00e9413a45ca4d2b,
+   0x00783cd6fe84fc47, 0x00532f7814995822, 0x000023d1ed959bb5},
+  {1, 0, 0, 0, 0, 0, 0}},
+ {{0x00de52c7a213e83b, 0x0092d055db2392b3, 0x007fa76f70c9464a, 0x00455c1c820f5490,
+   0x001bfebcf03811a5, 0x00fa7fdbc082aba7, 0x0000c6b405288edf},
+  {0x007bb07de3636016, 0x009e9a4c00333ac0, 0x000753eec12112b2, 0x00640707c9888e19,
+   0x00519fa164acc0d1, 0x00eafbb78ca0ff03, 0x00005c88fb72c6c4},
+  {1, 0, 0, 0, 0, 0, 0}},
+ {{0x00bd2b8ef75508fc, 0x00f29262bfd0c558, 0x0030142ab328a91b, 0x00632c89cf88d90e,
+   0x002d6788729f12b6, 0x004dc6c892750221, 0x0000e5003a3f2915},
+  {0x0090953325010799, 0x008d422bb5ff4b0c, 0x003576aa7b5fe70c, 0x00a1c6f02e1c1a2a,
+   0x000ab45f38569944, 0x00d7abb580ce6abc, 0x000064aa8ae383c9},
+  {1, 0, 0, 0, 0, 0, 0}},
+ {{0x006f396e7c41cec4, 0x00cf56bdb3029a58, 0x00ffdc28f3ff6273, 0x00adcbfafc3e31b2,
+   0x000a9a632084e14d, 0x00e1dff39aa51ad4, 0x0000d1af43828307},
+  {0x00285854d1474980, 0x00b3be7bd30cbff4, 0x0016bdb54eeb6f9c, 0x004202560e69efed,
+   0x00181994b6456f62, 0x007bc3726ea875f8, 0x0000a922c4508358},
+  {1, 0, 0, 0, 0, 0, 0}},
+ {{0x000829822360374b, 0x0095a7bae9408424, 0x001074a33f398368, 0x004266b4fd8631b5,
+   0x00a51be58e09378b, 0x005e12e75930f90f, 0x0000a06ea7d1fd03},
+  {0x0020ab1e5cb6a429, 0x004118cb96b0e94f, 0x008963edba69630c, 0x00b2dc37cba862b0,
+   0x0077b186a7a42760, 0x00c396405292fe38, 0x0000abc08adc6dd6},
+  {1, 0, 0, 0, 0, 0, 0}},
+ {{0x00b2e4383f385d2b, 0x008ac4932b516d35, 0x00fe51a3599f6e66, 0x00d12c0f3a8a1646,
+   0x006da385aee309ab, 0x00e9430231423bc4, 0x0000f23c10b4637e},
+  {0x00bc215d22248e00, 0x0047e3d45f6553c0, 0x0071daad7d1d9ed4, 0x001f2d8179af0847,
+   0x007bb3fdee94bf70, 0x00ac781e8c72ad26, 0x0000c425de168de7},
+  {1, 0, 0, 0, 0, 0, 0}},
+ {{0x00a51c99470f3a77, 0x00228125d95dd3d8, 0x003e2a5fab8d8d6a, 0x005ac2cb2b57fa04,
+   0x00628e690677506d, 0x00fe6d134c04ee53, 0x000089d95ca20ecc},
+  {0x00c443936ee36b40, 0x006703663f07f9c4, 0x001eeb5d4d0bddba, 0x0094b962cc03e7dd,
+   0x0013cdb6f9d5c477, 0x0047a5eb8ffdb312, 0x00009d9927dab768},
+  {1, 0, 0, 0, 0, 0, 0}},
+ {{0x00ad4eb3c058ec50, 0x003e243165e00596, 0x00abc2c17c13243b, 0x0010135494b483ca,
+   0x00cc3b8e97a8dc97, 0x0069f824f2c4750d, 0x000057d89c1ff7e7},
+  {0x00da442a7bc53acb, 0x001e5a7fb230cd3d, 0x004137b0654b143b, 0x00506caa55e86618,
+   0x002efddfae713a85, 0x0071ca4c177b58ee, 0x0000b3ad81083541},
+  {1, 0, 0, 0, 0, 0, 0}},
+ {{0x00db76932d4575b7, 0x0073dfc259599ab6, 0x00bbdc10b088830d, 0x00d4ace4b2d93c90,
+   0x000b8d5bcec529b5, 0x001953db269d5d57, 0x00001ac4c02a73b1},
+  {0x004d4a8e642fd505, 0x004f3d58d2377703, 0x003eaefe54c00b1d, 0x004d8743d300d28d,
+   0x0082d9cf31b3a326, 0x0062048ac60d5abf, 0x0000ebc5abc0e494},
+  {1, 0, 0, 0, 0, 0, 0}},
+ {{0x00d0739bc0539803, 0x006bd6cbbec2f6d3, 0x00554f8e076ba512, 0x00a5ef3a9a014976,
+   0x00a01bd3fd7bdc2b, 0x0090ee0d2ee2a8ef, 0x0000a905806485a3},
+  {0x00aa5cc6f93f855d, 0x0063117347e35a32, 0x00673141361c0a58, 0x000c0cc8b191209b,
+   0x00f4841d38f98f25, 0x006edf8de6ffdd57, 0x0000f5af1a9ac251},
+  {1, 0, 0, 0, 0, 0, 0}},
+ {{0x00bd9de80856efa9, 0x0027c03c66ad4cbd, 0x0086aa0dd7a0a36f, 0x001314a5c1408ca4,
+   0x00c4c80f3e877b51, 0x00642956fec23eee, 0x0000217186f9324d},
+  {0x00d788ad470678f0, 0x005c3555f895260b, 0x00358fdae64162b9, 0x0054304321ef9454,
+   0x00e02dc8f8e08661, 0x0097edfa9ccf772b, 0x0000d419dae5f120},
+  {1, 0, 0, 0, 0, 0, 0}},
+ {{0x009366612dc6971d, 0x002082d99b377eb9, 0x007bee5f6ee7b09d, 0x00e8826c629f3759,
+   0x00cabf536e23d920, 0x003ff4bea835af08, 0x00003d245181ea77},
+  {0x0068abef0506d4c9, 0x002a29c53f53e148, 0x00cc5817bdbc91a3, 0x0048d6b592c1ed17,
+   0x009a972a20f09153, 0x00a6a5459978de71, 0x0000701432ee05a1},
+  {1, 0, 0, 0, 0, 0, 0}},
+ {{0x00306c550ef05a18, 0x00c94dff356193fa, 0x002d27730e609791, 0x0070831c35c0c6a1,
+   0x00449c11f5b0702a, 0x00111645872e8c32, 0x000006c21a5723a4},
+  {0x00704be004e4de38, 0x00e051aab21335ce, 0x00eac9d2f3c924c3, 0x0092b962d5bf3fc7,
+   0x00a8e06c5fffb892, 0x000e750660f04217, 0x0000b00515a9c0bf},
+  {1, 0, 0, 0, 0, 0, 0}}},
+{{{0, 0, 0, 0, 0, 0, 0},
+  {0, 0, 0, 0, 0, 0, 0},
+  {0, 0, 0, 0, 0, 0, 0}},
+ {{0x0045111a9211fa73, 0x000ad306a39bd4ac, 0x007ddaf57c5ece69, 0x005831213c1cf687,
+   0x0058221b7707a815, 0x004c2a85c3003bb6, 0x000059de5a56e034},
+  {0x008ac4c7a45d9e35, 0x00059cf49c0bee46, 0x00518ef2acbb02e3, 0x008199fac336089f,
+   0x008f5c25a41ca1e0, 0x00513afeb4cd34a0, 0x0000411d2298d916},
+  {1, 0, 0, 0, 0, 0, 0}},
+ {{0x0022f743057a5682, 0x00cf2c51f721aedb, 0x004cc951c5d9212d, 0x00182a49cc66b627,
+   0x00d6582cc05cfe04, 0x005f3cb031da3eff, 0x0000b3d99da97ebd},
+  {0x007e446d7a3d1084, 0x00cb72c720a95e4d, 0x00ca96fb58228d37, 0x006301c209f411e7,
+   0x00203595f5bee88d, 0x00d1d35337672bf5, 0x000075b71e1bd554},
+  {1, 0, 0, 0, 0, 0, 0}},
+ {{0x0099909ae4f07918, 0x00f893b82f57408a, 0x007e7419c9cfa6ab, 0x00ef2bc099bb7c6d,
+   0x005f3dfd4eb3734b, 0x007ec221c7678dae, 0x00003ff77b969098},
+  {0x005195185859157a, 0x00e31a2215e1c680, 0x00fb7429a54b56b2, 0x00d10e923766a8de,
+   0x005b4ad42bd95af4, 0x0000cef0d729aab0, 0x0000edd047cf5793},
+  {1, 0, 0, 0, 0, 0, 0}},
+ {{0x0008a95b5992b108, 0x0018d62834f98207, 0x00bbdfae696e000a, 0x004351358e8b42b3,
+   0x0021adae630527b7, 0x00f5960f74aa5d37, 0x00005b96e58d3f5e},
+  {0x00cd5292aa644979, 0x008246bf5f18aca3, 0x00a779b30f096702, 0x006809871a855ff5,
+   0x00fc05b194468255, 0x00ced70816d773f0, 0x0000f5132490c424},
+  {1, 0, 0, 0, 0, 0, 0}},
+ {{0x0038729c37a12d7e, 0x00c60ed7fa4f058a, 0x0050d8419e40f91d, 0x00e46efd58da2f3b,
+   0x00f38e6d3a309100, 0x00a9b11e4a2c77b4, 0x0000a2cc00e2d76e},
+  {0x00d24aea13e94d94, 0x00d4a29a209dd295, 0x00651287a0d98d39, 0x001543b0cd358156,
+   0x00a198fea9d90461, 0x00ec75a9fac91fc3, 0x0000a2a55b9e0cb2},
+  {1, 0, 0, 0, 0, 0, 0}},
+ {{0x0059ae5ddbe8ac89, 0x00120a3fffa7af20, 0x0040dc379e67ebb3, 0x00bf6f28a60da0fa,
+   0x00e287415775c4ba, 0x0065f311900c1b05, 0x0000314f84a807a6},
+  {0x008ce175ceaafe18, 0x001d5ec361748998, 0x006d6166464b482e, 0x00672447a08e9865,
+   0x00aaa78a4a03433e, 0x00f7f2f572ca8c0d, 0x00007599ea356f8f},
+  {1, 0, 0, 0, 0, 0, 0}},
+ {{0x00629ac87b33d4bb, 0x00d43a950cd70f4e, 0x0078a43e769fd8f2, 0x00713ce6e98c4e11,
+   0x0037729eccd69ee4, 0x00b1d2d205ff7d2b, 0x0000752df1aba6c3},
+  {0x00bc769dea6badbc, 0x00fd0d37adb7e852, 0x001a373be3e72382, 0x002eb443adc59010,
+   0x007ad2cbfe799adf, 0x00cf15229e991c72, 0x00004f267b6f40dd},
+  {1, 0, 0, 0, 0, 0, 0}},
+ {{0x009eb4f3550e2f47, 0x00dc9d712138f712, 0x007f13e54a9c6337, 0x00fd9784aa3e2a1f,
+   0x00743f41ddcc51e7, 0x007ae28c33d591ea, 0x0000eea16f9d0169},
+  {0x009e13c5a97eeec2, 0x0003b234631a1b77, 0x00f9375f64064c8c, 0x00243c87bf6dc880,
+   0x00fe48a55deb5178, 0x00a99f8ba028f01f, 0x00007990c82eb253},
+  {1, 0, 0, 0, 0, 0, 0}},
+ {{0x00fcb8e58737e342, 0x00a0bafdaf0cf4bd, 0x00ce8b21b68318dd, 0x00ab0538fa37a40e,
+   0x0071d378f29fbbc3, 0x0061bbe7287dc2a3, 0x0000d6389c912319},
+  {0x008ded26b842d7fd, 0x00a3e33b11a5856a, 0x00bd7aec29cc75b5, 0x0030470e0442bd2d,
+   0x00ccbdbde0827fbf, 0x0045ef7a1b9a30ed, 0x0000f9ebb1a66167},
+  {1, 0, 0, 0, 0, 0, 0}},
+ {{0x0065e4731d88ac45, 0x00b707fec0347be7, 0x00eaab959f270ab2, 0x00e48a8ddb8b4022,
+   0x008bf971b2e3fdb7, 0x00413b926d1ddc54, 0x0000bb51e391aff8},
+  {0x0049cee740023ff9, 0x00bcaccfb4f4e777, 0x00912829020b8326, 0x008f579fcf46a1fc,
+   0x008653d5284ea81a, 0x00037aa39ec4ae6f, 0x000036fc19bd81c2},
+  {1, 0, 0, 0, 0, 0, 0}},
+ {{0x004dd149d17cb1b0, 0x005bf017020a2eff, 0x00c960daea696bec, 0x00ebecee2f66a042,
+   0x006c74391ba6680d, 0x00695eb85011af99, 0x000005a3c4d5a976},
+  {0x004c4c19e77e7508, 0x006714151ef38ea5, 0x0095890ada814074, 0x00d4dda2a2c98416,
+   0x00bc3263056024e6, 0x008ab935ec1adbcd, 0x0000f3508a87eb4b},
+  {1, 0, 0, 0, 0, 0, 0}},
+ {{0x000f42acb6e1d5d9, 0x00682166d39ff05a, 0x00714d191ee5ad90, 0x0039b7edb6ead0a9,
+   0x00d892fc5e0eafb5, 0x00b02ca800025c84, 0x000098946224abee},
+  {0x000df08fc1693796, 0x00440ca3deb41ec9, 0x0035c90d33e4ee46, 0x007d20ec7395863d,
+   0x00a1f2558f95a193, 0x00be2d92da3be042, 0x000084564a961c98},
+  {1, 0, 0, 0, 0, 0, 0}},
+ {{0x00bbc56600f77df7, 0x00e3db4536919744, 0x0051d84576817cd7, 0x00e1b1b30cd0fba3,
+   0x00ea691b9bea4f12, 0x0024c4c3e9b2531e, 0x00006cc6ed179326},
+  {0x00b45355539aff2e, 0x00351c7b63d98a84, 0x008b46b0fca41cf8, 0x009ab99fca2fb6d0,
+   0x00e45c80ddf9dd49, 0x004d47c8d8b3af3c, 0x0000a1bbf2c44cc5},
+  {1, 0, 0, 0, 0, 0, 0}},
+ {{0x0099fc73babb13fb, 0x005e22e8cf27efc9, 0x000b3a7c04847aa5, 0x00f717fa92cc30ed,
+   0x00d341bb10cb9579, 0x008707d9bb454a90, 0x00002b927968c023},
+  {0x00dd6f4c7a306b16, 0x005852cb087a186f, 0x0072c9c5f547eabe, 0x007a6b862d37713a,
+   0x00e6111368ca31e8, 0x00873ce708e278ad, 0x00004c939f82fa04},
+  {1, 0, 0, 0, 0, 0, 0}},
+ {{0x00c4870008fbdb25, 0x000a5ad8102d8f84, 0x00572296500cd4e8, 0x00d5a32a0c23b550,
+   0x00df1e1387e60329, 0x004881bd5b38e35a, 0x000009e2e1882a1b},
+  {0x0045b628c5b2673b, 0x00533164e7fe3f8b, 0x00fce3b2ef7fd5f2, 0x00588fa448ee35ab,
+   0x00fe64f02cefdac4, 0x003eb3fdf8801ce4, 0x00005ddc49dd5455},
+  {1, 0, 0, 0, 0, 0, 0}}}
 };
 
 /*
@@ -1374,9 +1597,9 @@ static void batch_mul(felem x_out, felem y_out, felem z_out,
                       const felem_bytearray scalars[],
                       const unsigned int num_points, const u8 *g_scalar,
                       const int mixed, const felem pre_comp[][17][3],
-                      const felem g_pre_comp[16][3])
+                      const felem g_pre_comp[4][16][3])
 {
-    int i, skip;
+    int i, j, skip;
     unsigned int num, gen_mul = (g_scalar != NULL);
     felem nq[3], tmp[4];
     limb bits;
@@ -1387,34 +1610,34 @@ static void batch_mul(felem x_out, felem y_out, felem z_out,
 
     /*
      * Loop over all scalars msb-to-lsb, interleaving additions of multiples
-     * of the generator (last quarter of rounds) and additions of other
-     * points multiples (every 5th round).
+     * of the generator (four in each of the last 24 rounds) and additions of
+     * other points multiples (every 5th round).
      */
     skip = 1;                   /* save two point operations in the first
                                  * round */
-    for (i = (num_points ? 380 : 98); i >= 0; --i) {
+    for (i = (num_points ? 380 : 23); i >= 0; --i) {
         /* double */
         if (!skip)
             point_double(nq[0], nq[1], nq[2], nq[0], nq[1], nq[2]);
 
         /* add multiples of the generator */
-        if (gen_mul && (i <= 98)) {
-            bits = get_bit(g_scalar, i + 285) << 3;
-            if (i < 95) {
-                bits |= get_bit(g_scalar, i + 190) << 2;
-                bits |= get_bit(g_scalar, i + 95) << 1;
-                bits |= get_bit(g_scalar, i);
-            }
-            /* select the point to add, in constant time */
-            select_point(bits, 16, g_pre_comp, tmp);
-            if (!skip) {
-                /* The 1 argument below is for "mixed" */
-                point_add(nq[0],  nq[1],  nq[2],
-                          nq[0],  nq[1],  nq[2], 1,
-                          tmp[0], tmp[1], tmp[2]);
-            } else {
-                memcpy(nq, tmp, 3 * sizeof(felem));
-                skip = 0;
+        if (gen_mul && (i <= 23)) {
+            for (j = 3; j >= 0; --j) {
+                bits = get_bit(g_scalar, i + 24 * j + 288) << 3;
+                bits |= get_bit(g_scalar, i + 24 * j + 192) << 2;
+                bits |= get_bit(g_scalar, i + 24 * j + 96) << 1;
+                bits |= get_bit(g_scalar, i + 24 * j);
+                /* select the point to add, in constant time */
+                select_point(bits, 16, g_pre_comp[j], tmp);
+                if (!skip) {
+                    /* The 1 argument below is for "mixed" */
+                    point_add(nq[0],  nq[1],  nq[2],
+                              nq[0],  nq[1],  nq[2], 1,
+                              tmp[0], tmp[1], tmp[2]);
+                } else {
+                    memcpy(nq, tmp, 3 * sizeof(felem));
+                    skip = 0;
+                }
             }
         }
 
@@ -1456,7 +1679,7 @@ static void batch_mul(felem x_out, felem y_out, felem z_out,
 
 /* Precomputation for the group generator. */
 struct nistp384_pre_comp_st {
-    felem g_pre_comp[16][3];
+    felem g_pre_comp[4][16][3];
     CRYPTO_REF_COUNT references;
 };
 
@@ -1686,6 +1909,161 @@ static void make_points_affine(size_t num, felem points[][3],
                                                   felem_contract);
 }
 
+/*
+ * With many points, Pippenger's bucket method beats batch_mul(): every
+ * window of c bits costs one mixed addition per point plus two additions per
+ * bucket, so that it pulls ahead from about a hundred points.  It is not
+ * constant time, so like the wNAF code for several points in
+ * ossl_ec_wNAF_mul(), it is only used where the scalars are public: for 128
+ * or more points and no multiple of the generator, as in batch verification.
+ * Secret scalars come one at a time, on their own or with the generator.
+ */
+#define NISTP384_PIPPENGER_MIN_POINTS 128
+#define NISTP384_PIPPENGER_MAX_WINDOW 15
+
+/* r = \sum scalars[i]*points[i], ignoring NULL values */
+static int nistp384_pippenger_mul(const EC_GROUP *group, EC_POINT *r,
+                                  size_t num, const EC_POINT *points[],
+                                  const BIGNUM *scalars[], BN_CTX *ctx)
+{
+    size_t i, n, cost, best_cost = SIZE_MAX;
+    int c, best_c = 1, nwin, nbuckets, w, j, d, carry, b, ret = 0;
+    felem (*table)[3] = NULL, (*bucket)[3] = NULL, *tmp_felems = NULL;
+    felem x_out, y_out, z_out, x_run, y_run, z_run, x_sum, y_sum, z_sum;
+    felem y_neg;
+    felem_bytearray secret;
+    const BIGNUM *s;
+    BIGNUM *x, *y, *z, *tmp_scalar;
+    short *digits = NULL;
+
+    for (c = 1; c <= NISTP384_PIPPENGER_MAX_WINDOW; c++) {
+        cost = (size_t)(384 / c + 1) * (num + ((size_t)1 << c));
+        if (cost < best_cost) {
+            best_cost = cost;
+            best_c = c;
+        }
+    }
+    c = best_c;
+    /* One more window than needed for the bits, for the final carry */
+    nwin = 384 / c + 1;
+    nbuckets = 1 << (c - 1);
+
+    BN_CTX_start(ctx);
+    x = BN_CTX_get(ctx);
+    y = BN_CTX_get(ctx);
+    z = BN_CTX_get(ctx);
+    tmp_scalar = BN_CTX_get(ctx);
+    if (tmp_scalar == NULL)
+        goto err;
+
+    if (num > SIZE_MAX / sizeof(*digits) / nwin
+        || num > OPENSSL_MALLOC_MAX_NELEMS(*table)
+        || (table = OPENSSL_malloc(num * sizeof(*table))) == NULL
+        || (tmp_felems = OPENSSL_malloc((num + 1) * sizeof(*tmp_felems))) == NULL
+        || (digits = OPENSSL_malloc(num * nwin * sizeof(*digits))) == NULL
+        || (bucket = OPENSSL_malloc(nbuckets * sizeof(*bucket))) == NULL)
+        goto err;
+
+    /* Points at infinity and zero scalars contribute nothing */
+    for (i = 0, n = 0; i < num; i++) {
+        if (points[i] == NULL || scalars[i] == NULL
+            || EC_POINT_is_at_infinity(group, points[i])
+            || BN_is_zero(scalars[i]))
+            continue;
+        if (!BN_to_felem(table[n][0], points[i]->X)
+            || !BN_to_felem(table[n][1], points[i]->Y)
+            || !BN_to_felem(table[n][2], points[i]->Z))
+            goto err;
+
+        s = scalars[i];
+        if (BN_num_bits(s) > 384 || BN_is_negative(s)) {
+            if (!BN_nnmod(tmp_scalar, s, group->order, ctx)) {
+                ERR_raise(ERR_LIB_EC, ERR_R_BN_LIB);
+                goto err;
+            }
+            s = tmp_scalar;
+        }
+        if (BN_bn2lebinpad(s, secret, sizeof(secret)) < 0) {
+            ERR_raise(ERR_LIB_EC, ERR_R_BN_LIB);
+            goto err;
+        }
+
+        /* Recode the scalar into digits in [-2^(c-1) + 1, 2^(c-1)] */
+        for (w = 0, carry = 0; w < nwin; w++) {
+            for (b = 0, d = 0; b < c; b++)
+                d |= get_bit(secret, w * c + b) << b;
+            d += carry;
+            carry = d > nbuckets;
+            if (carry)
+                d -= 1 << c;
+            digits[n * nwin + w] = (short)d;
+        }
+        n++;
+    }
+
+    /* Convert the points to affine, so that the additions can be mixed */
+    if (n > 0)
+        make_points_affine(n, table, tmp_felems);
+
+    memset(x_out, 0, sizeof(x_out));
+    memset(y_out, 0, sizeof(y_out));
+    memset(z_out, 0, sizeof(z_out));
+    for (w = nwin - 1; w >= 0; w--) {
+        for (j = 0; j < c && w != nwin - 1; j++)
+            point_double(x_out, y_out, z_out, x_out, y_out, z_out);
+
+        memset(bucket, 0, nbuckets * sizeof(*bucket));
+        for (i = 0; i < n; i++) {
+            d = digits[i * nwin + w];
+            if (d == 0)
+                continue;
+            j = (d > 0 ? d : -d) - 1;
+            if (d < 0)
+                felem_neg(y_neg, table[i][1]);
+            /* point_add() doubles when the bucket holds the point itself */
+            point_add(bucket[j][0], bucket[j][1], bucket[j][2],
+                      bucket[j][0], bucket[j][1], bucket[j][2], 1,
+                      table[i][0], d > 0 ? table[i][1] : y_neg, table[i][2]);
+        }
+
+        /* sum = 1 * bucket[0] + 2 * bucket[1] + ... */
+        memset(x_run, 0, sizeof(x_run));
+        memset(y_run, 0, sizeof(y_run));
+        memset(z_run, 0, sizeof(z_run));
+        memset(x_sum, 0, sizeof(x_sum));
+        memset(y_sum, 0, sizeof(y_sum));
+        memset(z_sum, 0, sizeof(z_sum));
+        for (j = nbuckets - 1; j >= 0; j--) {
+            point_add(x_run, y_run, z_run, x_run, y_run, z_run, 0,
+                      bucket[j][0], bucket[j][1], bucket[j][2]);
+            point_add(x_sum, y_sum, z_sum, x_sum, y_sum, z_sum, 0,
+                      x_run, y_run, z_run);
+        }
+        point_add(x_out, y_out, z_out, x_out, y_out, z_out, 0,
+                  x_sum, y_sum, z_sum);
+    }
+
+    /* reduce the output to its unique minimal representation */
+    felem_contract(x_run, x_out);
+    felem_contract(y_run, y_out);
+    felem_contract(z_run, z_out);
+    if (!felem_to_BN(x, x_run) || !felem_to_BN(y, y_run)
+        || !felem_to_BN(z, z_run)) {
+        ERR_raise(ERR_LIB_EC, ERR_R_BN_LIB);
+        goto err;
+    }
+    ret = ossl_ec_GFp_simple_set_Jprojective_coordinates_GFp(group, r, x, y, z,
+                                                             ctx);
+
+ err:
+    BN_CTX_end(ctx);
+    OPENSSL_free(table);
+    OPENSSL_free(tmp_felems);
+    OPENSSL_free(digits);
+    OPENSSL_free(bucket);
+    return ret;
+}
+
 /*
  * Computes scalar*generator + \sum scalars[i]*points[i], ignoring NULL
  * values Result is stored in r (r can equal one of the inputs).
@@ -1709,11 +2087,14 @@ int ossl_ec_GFp_nistp384_points_mul(const EC_GROUP *group, EC_POINT *r,
     size_t num_points = num;
     felem x_in, y_in, z_in, x_out, y_out, z_out;
     NISTP384_PRE_COMP *pre = NULL;
-    felem(*g_pre_comp)[3] = NULL;
+    felem(*g_pre_comp)[16][3] = NULL;
     EC_POINT *generator = NULL;
     const EC_POINT *p = NULL;
     const BIGNUM *p_scalar = NULL;
 
+    if (scalar == NULL && num >= NISTP384_PIPPENGER_MIN_POINTS)
+        return nistp384_pippenger_mul(group, r, num, points, scalars, ctx);
+
     BN_CTX_start(ctx);
     x = BN_CTX_get(ctx);
     y = BN_CTX_get(ctx);
@@ -1729,14 +2110,14 @@ int ossl_ec_GFp_nistp384_points_mul(const EC_GROUP *group, EC_POINT *r,
             g_pre_comp = &pre->g_pre_comp[0];
         else
             /* try to use the standard precomputation */
-            g_pre_comp = (felem(*)[3]) gmul;
+            g_pre_comp = (felem(*)[16][3]) gmul;
         generator = EC_POINT_new(group);
         if (generator == NULL)
             goto err;
         /* get the generator from precomputation */
-        if (!felem_to_BN(x, g_pre_comp[1][0]) ||
-            !felem_to_BN(y, g_pre_comp[1][1]) ||
-            !felem_to_BN(z, g_pre_comp[1][2])) {
+        if (!felem_to_BN(x, g_pre_comp[0][1][0]) ||
+            !felem_to_BN(y, g_pre_comp[0][1][1]) ||
+            !felem_to_BN(z, g_pre_comp[0][1][2])) {
             ERR_raise(ERR_LIB_EC, ERR_R_BN_LIB);
             goto err;
         }
@@ -1857,7 +2238,7 @@ int ossl_ec_GFp_nistp384_points_mul(const EC_GROUP *group, EC_POINT *r,
                   (const felem_bytearray(*))secrets, num_points,
                   g_secret,
                   mixed, (const felem(*)[17][3])pre_comp,
-                  (const felem(*)[3])g_pre_comp);
+                  (const felem(*)[16][3])g_pre_comp);
     } else {
         /* do the multiplication without generator precomputation */
         batch_mul(x_out, y_out, z_out,
@@ -1931,45 +2312,40 @@ int ossl_ec_GFp_nistp384_precompute_mult(EC_GROUP *group, BN_CTX *ctx)
         memcpy(pre->g_pre_comp, gmul, sizeof(pre->g_pre_comp));
         goto done;
     }
-    if ((!BN_to_felem(pre->g_pre_comp[1][0], group->generator->X)) ||
-        (!BN_to_felem(pre->g_pre_comp[1][1], group->generator->Y)) ||
-        (!BN_to_felem(pre->g_pre_comp[1][2], group->generator->Z)))
+    if ((!BN_to_felem(pre->g_pre_comp[0][1][0], group->generator->X)) ||
+        (!BN_to_felem(pre->g_pre_comp[0][1][1], group->generator->Y)) ||
+        (!BN_to_felem(pre->g_pre_comp[0][1][2], group->generator->Z)))
         goto err;
-    /* compute 2^95*G, 2^190*G, 2^285*G */
-    for (i = 1; i <= 4; i <<= 1) {
-        point_double(pre->g_pre_comp[2 * i][0], pre->g_pre_comp[2 * i][1], pre->g_pre_comp[2 * i][2],
-                     pre->g_pre_comp[i][0],  pre->g_pre_comp[i][1],    pre->g_pre_comp[i][2]);
-        for (j = 0; j < 94; ++j) {
-            point_double(pre->g_pre_comp[2 * i][0], pre->g_pre_comp[2 * i][1], pre->g_pre_comp[2 * i][2],
-                         pre->g_pre_comp[2 * i][0], pre->g_pre_comp[2 * i][1], pre->g_pre_comp[2 * i][2]);
-        }
+    /*
+     * compute 2^(24*(4*b + i))*G for table i, index 2^b, each one from the
+     * previous one by 24 doublings
+     */
+    for (i = 1; i < 16; ++i) {
+        felem *prev = pre->g_pre_comp[(i - 1) % 4][1 << ((i - 1) / 4)];
+        felem *next = pre->g_pre_comp[i % 4][1 << (i / 4)];
+
+        point_double(next[0], next[1], next[2], prev[0], prev[1], prev[2]);
+        for (j = 1; j < 24; ++j)
+            point_double(next[0], next[1], next[2], next[0], next[1], next[2]);
     }
-    /* g_pre_comp[0] is the point at infinity */
-    memset(pre->g_pre_comp[0], 0, sizeof(pre->g_pre_comp[0]));
-    /* the remaining multiples */
-    /* 2^95*G + 2^190*G */
-    point_add(pre->g_pre_comp[6][0],  pre->g_pre_comp[6][1],  pre->g_pre_comp[6][2],
-              pre->g_pre_comp[4][0],  pre->g_pre_comp[4][1],  pre->g_pre_comp[4][2], 0,
-              pre->g_pre_comp[2][0],  pre->g_pre_comp[2][1],  pre->g_pre_comp[2][2]);
-    /* 2^95*G + 2^285*G */
-    point_add(pre->g_pre_comp[10][0], pre->g_pre_comp[10][1], pre->g_pre_comp[10][2],
-              pre->g_pre_comp[8][0],  pre->g_pre_comp[8][1],  pre->g_pre_comp[8][2], 0,
-              pre->g_pre_comp[2][0],  pre->g_pre_comp[2][1],  pre->g_pre_comp[2][2]);
-    /* 2^190*G + 2^285*G */
-    point_add(pre->g_pre_comp[12][0], pre->g_pre_comp[12][1], pre->g_pre_comp[12][2],
-              pre->g_pre_comp[8][0],  pre->g_pre_comp[8][1],  pre->g_pre_comp[8][2], 0,
-              pre->g_pre_comp[4][0],  pre->g_pre_comp[4][1],  pre->g_pre_comp[4][2]);
-    /* 2^95*G + 2^190*G + 2^285*G */
-    point_add(pre->g_pre_comp[14][0], pre->g_pre_comp[14][1], pre->g_pre_comp[14][2],
-              pre->g_pre_comp[12][0], pre->g_pre_comp[12][1], pre->g_pre_comp[12][2], 0,
-              pre->g_pre_comp[2][0],  pre->g_pre_comp[2][1],  pre->g_pre_comp[2][2]);
-    for (i = 1; i < 8; ++i) {
-        /* odd multiples: add G */
-        point_add(pre->g_pre_comp[2 * i + 1][0], pre->g_pre_comp[2 * i + 1][1], pre->g_pre_comp[2 * i + 1][2],
-                  pre->g_pre_comp[2 * i][0],     pre->g_pre_comp[2 * i][1],     pre->g_pre_comp[2 * i][2], 0,
-                  pre->g_pre_comp[1][0],         pre->g_pre_comp[1][1],         pre->g_pre_comp[1][2]);
+    for (i = 0; i < 4; ++i) {
+        /* g_pre_comp[i][0] is the point at infinity */
+        memset(pre->g_pre_comp[i][0], 0, sizeof(pre->g_pre_comp[i][0]));
+        /* the remaining multiples are sums of the ones computed above */
+        for (j = 3; j < 16; ++j) {
+            int low = j & -j;
+
+            if (j == low)
+                continue;
+            point_add(pre->g_pre_comp[i][j][0], pre->g_pre_comp[i][j][1],
+                      pre->g_pre_comp[i][j][2], pre->g_pre_comp[i][j - low][0],
+                      pre->g_pre_comp[i][j - low][1],
+                      pre->g_pre_comp[i][j - low][2], 0,
+                      pre->g_pre_comp[i][low][0], pre->g_pre_comp[i][low][1],
+                      pre->g_pre_comp[i][low][2]);
+        }
+        make_points_affine(15, &(pre->g_pre_comp[i][1]), tmp_felems);
     }
-    make_points_affine(15, &(pre->g_pre_comp[1]), tmp_felems);
 
  done:
     SETPRECOMP(group, nistp384, pre);
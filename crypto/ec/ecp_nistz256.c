@@ -775,6 +775,181 @@ __owur static int ecp_nistz256_windowed_mul(const EC_GROUP *group,
     return ret;
 }
 
+/*
+ * With many points, Pippenger's bucket method beats the windowed
+ * multiplication above: every window of c bits costs one affine addition
+ * per point plus two additions per bucket.  It is not constant time, so
+ * like the wNAF code for several points in ossl_ec_wNAF_mul(), it is only
+ * used where the scalars are public: for 64 or more points and no multiple
+ * of the generator, as in batch verification.  Secret scalars come one at a
+ * time, on their own or with the generator.
+ */
+#define NISTZ256_PIPPENGER_MIN_POINTS 64
+#define NISTZ256_PIPPENGER_MAX_WINDOW 15
+
+static int p256_is_infinity(const BN_ULONG z[P256_LIMBS])
+{
+    BN_ULONG acc = 0;
+    int i;
+
+    for (i = 0; i < P256_LIMBS; i++)
+        acc |= z[i];
+    return acc == 0;
+}
+
+/* r = sum(scalar[i]*point[i]) */
+__owur static int ecp_nistz256_pippenger_mul(const EC_GROUP *group,
+                                             P256_POINT *r,
+                                             const BIGNUM **scalar,
+                                             const EC_POINT **point,
+                                             size_t num, BN_CTX *ctx)
+{
+    size_t i, n, cost, best_cost = SIZE_MAX;
+    int c, best_c = 1, nwin, nbuckets, w, j, d, carry, ret = 0;
+    P256_POINT_AFFINE *table = NULL, a;
+    P256_POINT *bucket = NULL, running, sum, t;
+    BN_ULONG (*z)[P256_LIMBS] = NULL, (*prod)[P256_LIMBS] = NULL;
+    BN_ULONG k[P256_LIMBS], inv[P256_LIMBS], zinv[P256_LIMBS];
+    const BIGNUM *s;
+    BIGNUM *mod;
+    short *digits = NULL;
+
+    for (c = 1; c <= NISTZ256_PIPPENGER_MAX_WINDOW; c++) {
+        cost = (size_t)(256 / c + 1) * (num + ((size_t)1 << c));
+        if (cost < best_cost) {
+            best_cost = cost;
+            best_c = c;
+        }
+    }
+    c = best_c;
+    /* One more window than needed for the bits, for the final carry */
+    nwin = 256 / c + 1;
+    nbuckets = 1 << (c - 1);
+
+    if (num > SIZE_MAX / sizeof(*digits) / nwin
+        || num > OPENSSL_MALLOC_MAX_NELEMS(P256_POINT_AFFINE)
+        || (table = OPENSSL_malloc(num * sizeof(*table))) == NULL
+        || (z = OPENSSL_malloc(num * sizeof(*z))) == NULL
+        || (prod = OPENSSL_malloc(num * sizeof(*prod))) == NULL
+        || (digits = OPENSSL_malloc(num * nwin * sizeof(*digits))) == NULL
+        || (bucket = OPENSSL_malloc(nbuckets * sizeof(*bucket))) == NULL)
+        goto err;
+
+    /* Points at infinity contribute nothing and are left out */
+    for (i = 0, n = 0; i < num; i++) {
+        if (!ecp_nistz256_bignum_to_field_elem(table[n].X, point[i]->X)
+            || !ecp_nistz256_bignum_to_field_elem(table[n].Y, point[i]->Y)
+            || !ecp_nistz256_bignum_to_field_elem(z[n], point[i]->Z)) {
+            ERR_raise(ERR_LIB_EC, EC_R_COORDINATES_OUT_OF_RANGE);
+            goto err;
+        }
+        if (p256_is_infinity(z[n]))
+            continue;
+
+        s = scalar[i];
+        if ((BN_num_bits(s) > 256) || BN_is_negative(s)) {
+            if ((mod = BN_CTX_get(ctx)) == NULL)
+                goto err;
+            if (!BN_nnmod(mod, s, group->order, ctx)) {
+                ERR_raise(ERR_LIB_EC, ERR_R_BN_LIB);
+                goto err;
+            }
+            s = mod;
+        }
+        if (!bn_copy_words(k, s, P256_LIMBS))
+            goto err;
+
+        /* Recode the scalar into digits in [-2^(c-1) + 1, 2^(c-1)] */
+        for (w = 0, carry = 0; w < nwin; w++) {
+            int pos = w * c, idx = pos / BN_BITS2, shift = pos % BN_BITS2;
+            BN_ULONG v = 0;
+
+            if (idx < P256_LIMBS) {
+                v = k[idx] >> shift;
+                if (shift + c > BN_BITS2 && idx + 1 < P256_LIMBS)
+                    v |= k[idx + 1] << (BN_BITS2 - shift);
+            }
+            d = (int)(v & (((BN_ULONG)1 << c) - 1)) + carry;
+            carry = d > nbuckets;
+            if (carry)
+                d -= 1 << c;
+            digits[n * nwin + w] = (short)d;
+        }
+
+        if (n == 0)
+            memcpy(prod[0], z[0], sizeof(prod[0]));
+        else
+            ecp_nistz256_mul_mont(prod[n], prod[n - 1], z[n]);
+        n++;
+    }
+
+    /* Convert the points to affine with a single inversion */
+    if (n > 0)
+        ecp_nistz256_mod_inverse(inv, prod[n - 1]);
+    for (i = n; i-- > 0;) {
+        if (i > 0) {
+            ecp_nistz256_mul_mont(zinv, inv, prod[i - 1]);
+            ecp_nistz256_mul_mont(inv, inv, z[i]);
+        } else {
+            memcpy(zinv, inv, sizeof(zinv));
+        }
+        ecp_nistz256_sqr_mont(k, zinv);
+        ecp_nistz256_mul_mont(table[i].X, table[i].X, k);
+        ecp_nistz256_mul_mont(k, k, zinv);
+        ecp_nistz256_mul_mont(table[i].Y, table[i].Y, k);
+    }
+
+    memset(r, 0, sizeof(*r));
+    for (w = nwin - 1; w >= 0; w--) {
+        for (j = 0; j < c && w != nwin - 1; j++)
+            ecp_nistz256_point_double(r, r);
+
+        memset(bucket, 0, nbuckets * sizeof(*bucket));
+        for (i = 0; i < n; i++) {
+            d = digits[i * nwin + w];
+            if (d == 0)
+                continue;
+            j = (d > 0 ? d : -d) - 1;
+            memcpy(a.X, table[i].X, sizeof(a.X));
+            if (d > 0)
+                memcpy(a.Y, table[i].Y, sizeof(a.Y));
+            else
+                ecp_nistz256_neg(a.Y, table[i].Y);
+
+            ecp_nistz256_point_add_affine(&t, &bucket[j], &a);
+            if (p256_is_infinity(t.Z) && !p256_is_infinity(bucket[j].Z)) {
+                /*
+                 * The bucket was a or -a.  The affine addition doesn't
+                 * handle doubling, so repeat it with the general one.
+                 */
+                memcpy(t.X, a.X, sizeof(t.X));
+                memcpy(t.Y, a.Y, sizeof(t.Y));
+                memcpy(t.Z, ONE, sizeof(t.Z));
+                ecp_nistz256_point_add(&t, &bucket[j], &t);
+            }
+            memcpy(&bucket[j], &t, sizeof(t));
+        }
+
+        /* sum = 1 * bucket[0] + 2 * bucket[1] + ... */
+        memset(&running, 0, sizeof(running));
+        memset(&sum, 0, sizeof(sum));
+        for (j = nbuckets - 1; j >= 0; j--) {
+            ecp_nistz256_point_add(&running, &running, &bucket[j]);
+            ecp_nistz256_point_add(&sum, &sum, &running);
+        }
+        ecp_nistz256_point_add(r, r, &sum);
+    }
+
+    ret = 1;
+ err:
+    OPENSSL_free(table);
+    OPENSSL_free(z);
+    OPENSSL_free(prod);
+    OPENSSL_free(digits);
+    OPENSSL_free(bucket);
+    return ret;
+}
+
 /* Coordinates of G, for which we have precomputed tables */
 static const BN_ULONG def_xG[P256_LIMBS] = {
     TOBN(0x79e730d4, 0x18a9143c), TOBN(0x75ba95fc, 0x5fedb601),
@@ -1132,8 +1307,14 @@ __owur static int ecp_nistz256_points_mul(const EC_GROUP *group,
         if (p_is_infinity)
             out = &p.p;
 
-        if (!ecp_nistz256_windowed_mul(group, out, scalars, points, num, ctx))
+        if (scalar == NULL && num >= NISTZ256_PIPPENGER_MIN_POINTS) {
+            if (!ecp_nistz256_pippenger_mul(group, out, scalars, points, num,
+                                            ctx))
+                goto err;
+        } else if (!ecp_nistz256_windowed_mul(group, out, scalars, points,
+                                              num, ctx)) {
             goto err;
+        }
 
         if (!p_is_infinity)
             ecp_nistz256_point_add(&p.p, &p.p, out);
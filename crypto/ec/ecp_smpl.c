@@ -15,6 +15,7 @@
 #include <internal/deprecated.h>
 
 #include <openssl/err.h>
+#include <crypto/bn.h>
 
 #include "ec_local.h"
 
@@ -1372,13 +1373,12 @@ int ossl_ec_GFp_simple_field_sqr(const EC_GROUP *group, BIGNUM *r, const BIGNUM
 /*-
  * Computes the multiplicative inverse of a in GF(p), storing the result in r.
  * If a is zero (or equivalent), you'll get an EC_R_CANNOT_INVERT error.
- * Since we don't have a Mont structure here, SCA hardening is with blinding.
+ * The inversion runs in constant time, so there is no need to blind "a".
  * NB: "a" must be in _decoded_ form. (i.e. field_decode must precede.)
  */
 int ossl_ec_GFp_simple_field_inv(const EC_GROUP *group, BIGNUM *r,
                                  const BIGNUM *a, BN_CTX *ctx)
 {
-    BIGNUM *e = NULL;
     BN_CTX *new_ctx = NULL;
     int ret = 0;
 
@@ -1386,31 +1386,14 @@ int ossl_ec_GFp_simple_field_inv(const EC_GROUP *group, BIGNUM *r,
             && (ctx = new_ctx = BN_CTX_secure_new_ex(group->libctx)) == NULL)
         return 0;
 
-    BN_CTX_start(ctx);
-    if ((e = BN_CTX_get(ctx)) == NULL)
-        goto err;
-
-    do {
-        if (!BN_priv_rand_range_ex(e, group->field, 0, ctx))
-        goto err;
-    } while (BN_is_zero(e));
-
-    /* r := a * e */
-    if (!group->meth->field_mul(group, r, a, e, ctx))
-        goto err;
-    /* r := 1/(a * e) */
-    if (!BN_mod_inverse(r, r, group->field, ctx)) {
+    if (!ossl_bn_mod_inverse_consttime(r, a, group->field, ctx)) {
         ERR_raise(ERR_LIB_EC, EC_R_CANNOT_INVERT);
         goto err;
     }
-    /* r := e/(a * e) = 1/a */
-    if (!group->meth->field_mul(group, r, r, e, ctx))
-        goto err;
 
     ret = 1;
 
  err:
-    BN_CTX_end(ctx);
     BN_CTX_free(new_ctx);
     return ret;
 }
@@ -620,6 +620,29 @@ int EVP_MD_CTX_copy_ex(EVP_MD_CTX *out, const EVP_MD_CTX *in)
             || (in->flags & EVP_MD_CTX_FLAG_NO_INIT) != 0)
         goto legacy;
 
+    /*
+     * If |out| already holds a provider context for the same digest, the
+     * state can be copied into it rather than duplicated.  This avoids an
+     * allocation for the common pattern of repeatedly forking a running
+     * digest (handshake transcripts, HMAC inner and outer states).
+     */
+    if (in->digest->copyctx != NULL
+            && in->algctx != NULL
+            && out->algctx != NULL
+            && out->digest == in->digest
+            && out->fetched_digest == in->fetched_digest) {
+#ifndef FIPS_MODULE
+        if (!EVP_MD_CTX_test_flags(out, EVP_MD_CTX_FLAG_KEEP_PKEY_CTX))
+            EVP_PKEY_CTX_free(out->pctx);
+        out->pctx = NULL;
+#endif
+        in->digest->copyctx(out->algctx, in->algctx);
+        out->reqdigest = in->reqdigest;
+        out->flags = in->flags;
+        out->update = in->update;
+        goto clone_pkey;
+    }
+
     if (in->digest->dupctx == NULL) {
         ERR_raise(ERR_LIB_EVP, EVP_R_NOT_ABLE_TO_COPY_CTX);
         return 0;
@@ -736,6 +759,48 @@ int EVP_Digest(const void *data, size_t count,
     return ret;
 }
 
+int EVP_DigestBatch(const EVP_MD *type, size_t n,
+                    const unsigned char *const *data, const size_t *counts,
+                    unsigned char *const *mds)
+{
+    EVP_MD *fetched = NULL;
+    const EVP_MD *md = type;
+    size_t i;
+    int size, ret = 0;
+
+    if (type == NULL || (n > 0 && (data == NULL || counts == NULL
+                                   || mds == NULL))) {
+        ERR_raise(ERR_LIB_EVP, ERR_R_PASSED_NULL_PARAMETER);
+        return 0;
+    }
+    if ((size = EVP_MD_get_size(type)) <= 0) {
+        ERR_raise(ERR_LIB_EVP, EVP_R_INVALID_DIGEST);
+        return 0;
+    }
+
+    /* Legacy digests are implicitly fetched to find a batch implementation */
+    if (type->prov == NULL && type->type != NID_undef) {
+        ERR_set_mark();
+        fetched = EVP_MD_fetch(NULL, OBJ_nid2sn(type->type), "");
+        ERR_pop_to_mark();
+        if (fetched != NULL)
+            md = fetched;
+    }
+
+    if (md->digest_batch != NULL) {
+        ret = md->digest_batch(ossl_provider_ctx(md->prov), n, data, counts,
+                               mds, (size_t)size);
+    } else {
+        for (i = 0; i < n; i++)
+            if (!EVP_Digest(data[i], counts[i], mds[i], NULL, md, NULL))
+                goto end;
+        ret = 1;
+    }
+ end:
+    EVP_MD_free(fetched);
+    return ret;
+}
+
 int EVP_Q_digest(OSSL_LIB_CTX *libctx, const char *name, const char *propq,
                  const void *data, size_t datalen,
                  unsigned char *md, size_t *mdlen)
@@ -1017,8 +1082,14 @@ static void *evp_md_from_algorithm(int name_id,
     }
 
 #ifndef FIPS_MODULE
+    /*
+     * set_legacy_nid() looks the provider's names up in the legacy digest
+     * db.  Going by the names in |algodef| rather than the namemap means
+     * the legacy names don't have to be loaded into the namemap for this.
+     */
+    OPENSSL_init_crypto(OPENSSL_INIT_ADD_ALL_DIGESTS, NULL);
     md->type = NID_undef;
-    if (!evp_names_do_all(prov, name_id, set_legacy_nid, &md->type)
+    if (!ossl_algorithm_names_do_all(algodef, set_legacy_nid, &md->type)
             || md->type == -1) {
         ERR_raise(ERR_LIB_EVP, ERR_R_INTERNAL_ERROR);
         EVP_MD_free(md);
@@ -1070,6 +1141,10 @@ static void *evp_md_from_algorithm(int name_id,
                 md->digest = OSSL_FUNC_digest_digest(fns);
             /* We don't increment fnct for this as it is stand alone */
             break;
+        case OSSL_FUNC_DIGEST_DIGEST_BATCH:
+            if (md->digest_batch == NULL)
+                md->digest_batch = OSSL_FUNC_digest_digest_batch(fns);
+            break;
         case OSSL_FUNC_DIGEST_FREECTX:
             if (md->freectx == NULL) {
                 md->freectx = OSSL_FUNC_digest_freectx(fns);
@@ -1080,6 +1155,10 @@ static void *evp_md_from_algorithm(int name_id,
             if (md->dupctx == NULL)
                 md->dupctx = OSSL_FUNC_digest_dupctx(fns);
             break;
+        case OSSL_FUNC_DIGEST_COPYCTX:
+            if (md->copyctx == NULL)
+                md->copyctx = OSSL_FUNC_digest_copyctx(fns);
+            break;
         case OSSL_FUNC_DIGEST_GET_PARAMS:
             if (md->get_params == NULL)
                 md->get_params = OSSL_FUNC_digest_get_params(fns);
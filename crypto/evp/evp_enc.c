@@ -1564,8 +1564,14 @@ static void *evp_cipher_from_algorithm(const int name_id,
     }
 
 #ifndef FIPS_MODULE
+    /*
+     * set_legacy_nid() looks the provider's names up in the legacy cipher
+     * db.  Going by the names in |algodef| rather than the namemap means
+     * the legacy names don't have to be loaded into the namemap for this.
+     */
+    OPENSSL_init_crypto(OPENSSL_INIT_ADD_ALL_CIPHERS, NULL);
     cipher->nid = NID_undef;
-    if (!evp_names_do_all(prov, name_id, set_legacy_nid, &cipher->nid)
+    if (!ossl_algorithm_names_do_all(algodef, set_legacy_nid, &cipher->nid)
             || cipher->nid == -1) {
         ERR_raise(ERR_LIB_EVP, ERR_R_INTERNAL_ERROR);
         EVP_CIPHER_free(cipher);
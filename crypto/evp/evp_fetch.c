@@ -269,7 +269,7 @@ inner_evp_generic_fetch(struct evp_method_data_st *methdata,
     }
 
     /* If we haven't received a name id yet, try to get one for the name */
-    name_id = name != NULL ? ossl_namemap_name2num(namemap, name) : 0;
+    name_id = name != NULL ? ossl_namemap_name2num_nolegacy(namemap, name) : 0;
 
     /*
      * If we have a name id, calculate a method id with evp_method_id().
@@ -40,12 +40,12 @@ static void help_get_legacy_alg_type_from_keymgmt(const char *keytype,
         *type = evp_pkey_name2type(keytype);
 }
 
-static int get_legacy_alg_type_from_keymgmt(const EVP_KEYMGMT *keymgmt)
+static int get_legacy_alg_type_from_algodef(const OSSL_ALGORITHM *algodef)
 {
     int type = NID_undef;
 
-    EVP_KEYMGMT_names_do_all(keymgmt, help_get_legacy_alg_type_from_keymgmt,
-                             &type);
+    ossl_algorithm_names_do_all(algodef, help_get_legacy_alg_type_from_keymgmt,
+                                &type);
     return type;
 }
 #endif
@@ -104,6 +104,10 @@ static void *keymgmt_from_algorithm(int name_id,
             if (keymgmt->gen == NULL)
                 keymgmt->gen = OSSL_FUNC_keymgmt_gen(fns);
             break;
+        case OSSL_FUNC_KEYMGMT_GEN_BATCH:
+            if (keymgmt->gen_batch == NULL)
+                keymgmt->gen_batch = OSSL_FUNC_keymgmt_gen_batch(fns);
+            break;
         case OSSL_FUNC_KEYMGMT_GEN_CLEANUP:
             if (keymgmt->gen_cleanup == NULL)
                 keymgmt->gen_cleanup = OSSL_FUNC_keymgmt_gen_cleanup(fns);
@@ -229,7 +233,8 @@ static void *keymgmt_from_algorithm(int name_id,
         || (exportfncnt != 0 && exportfncnt != 2)
         || (keymgmt->gen != NULL
             && (keymgmt->gen_init == NULL
-                || keymgmt->gen_cleanup == NULL))) {
+                || keymgmt->gen_cleanup == NULL))
+        || (keymgmt->gen_batch != NULL && keymgmt->gen == NULL)) {
         EVP_KEYMGMT_free(keymgmt);
         ERR_raise(ERR_LIB_EVP, EVP_R_INVALID_PROVIDER_FUNCTIONS);
         return NULL;
@@ -239,7 +244,7 @@ static void *keymgmt_from_algorithm(int name_id,
         ossl_provider_up_ref(prov);
 
 #ifndef FIPS_MODULE
-    keymgmt->legacy_alg = get_legacy_alg_type_from_keymgmt(keymgmt);
+    keymgmt->legacy_alg = get_legacy_alg_type_from_algodef(algodef);
 #endif
 
     return keymgmt;
@@ -413,6 +418,27 @@ void *evp_keymgmt_gen(const EVP_KEYMGMT *keymgmt, void *genctx,
     return keymgmt->gen(genctx, cb, cbarg);
 }
 
+int evp_keymgmt_gen_batch(const EVP_KEYMGMT *keymgmt, void *genctx,
+                          size_t n, void **keydata,
+                          OSSL_CALLBACK *cb, void *cbarg)
+{
+    size_t i;
+
+    if (keymgmt->gen_batch != NULL)
+        return keymgmt->gen_batch(genctx, n, keydata, cb, cbarg);
+
+    for (i = 0; i < n; i++) {
+        if ((keydata[i] = evp_keymgmt_gen(keymgmt, genctx, cb, cbarg)) == NULL) {
+            while (i-- > 0) {
+                evp_keymgmt_freedata(keymgmt, keydata[i]);
+                keydata[i] = NULL;
+            }
+            return 0;
+        }
+    }
+    return 1;
+}
+
 void evp_keymgmt_gen_cleanup(const EVP_KEYMGMT *keymgmt, void *genctx)
 {
     if (keymgmt->gen_cleanup != NULL)
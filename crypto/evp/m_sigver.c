@@ -715,4 +715,86 @@ int EVP_DigestVerify(EVP_MD_CTX *ctx, const unsigned char *sigret,
         return -1;
     return EVP_DigestVerifyFinal(ctx, sigret, siglen);
 }
+
+int EVP_DigestVerifyBatch(EVP_MD_CTX *ctx, size_t n, EVP_PKEY *const *pkeys,
+                          const unsigned char *const *sigs,
+                          const size_t *siglens,
+                          const unsigned char *const *tbs,
+                          const size_t *tbslens, int *results)
+{
+    EVP_PKEY_CTX *pctx = ctx->pctx;
+    EVP_SIGNATURE *signature;
+    EVP_KEYMGMT *tmp_keymgmt = NULL, *keymgmt;
+    void **provkeys = NULL;
+    size_t i;
+    int ret = -1;
+
+    if ((ctx->flags & EVP_MD_CTX_FLAG_FINALISED) != 0) {
+        ERR_raise(ERR_LIB_EVP, EVP_R_FINAL_ERROR);
+        return -1;
+    }
+
+    if (pctx == NULL
+            || pctx->operation != EVP_PKEY_OP_VERIFYCTX
+            || pctx->op.sig.algctx == NULL
+            || pctx->op.sig.signature == NULL
+            || pctx->op.sig.signature->digest_verify_batch == NULL) {
+        ERR_raise(ERR_LIB_EVP, EVP_R_OPERATION_NOT_SUPPORTED_FOR_THIS_KEYTYPE);
+        return -2;
+    }
+    signature = pctx->op.sig.signature;
+
+    if (n == 0)
+        return 1;
+
+    /* A NULL key tells the provider to use the one |ctx| was set up with */
+    provkeys = OPENSSL_zalloc(n * sizeof(*provkeys));
+    if (provkeys == NULL)
+        return -1;
+
+    if (pkeys != NULL) {
+        tmp_keymgmt =
+            evp_keymgmt_fetch_from_prov(signature->prov,
+                                        EVP_KEYMGMT_get0_name(pctx->keymgmt),
+                                        pctx->propquery);
+        if (tmp_keymgmt == NULL) {
+            ERR_raise(ERR_LIB_EVP, EVP_R_INITIALIZATION_ERROR);
+            goto err;
+        }
+        for (i = 0; i < n; i++) {
+            if (i > 0 && pkeys[i] == pkeys[i - 1]) {
+                provkeys[i] = provkeys[i - 1];
+                continue;
+            }
+            if (pkeys[i] == NULL
+                    || !EVP_PKEY_is_a(pkeys[i],
+                                      EVP_KEYMGMT_get0_name(tmp_keymgmt))) {
+                ERR_raise(ERR_LIB_EVP, EVP_R_DIFFERENT_KEY_TYPES);
+                goto err;
+            }
+            keymgmt = tmp_keymgmt;
+            provkeys[i] = evp_pkey_export_to_provider(pkeys[i], pctx->libctx,
+                                                      &keymgmt,
+                                                      pctx->propquery);
+            if (provkeys[i] == NULL) {
+                ERR_raise(ERR_LIB_EVP, EVP_R_INITIALIZATION_ERROR);
+                goto err;
+            }
+        }
+    }
+
+    if (!signature->digest_verify_batch(pctx->op.sig.algctx, n, provkeys,
+                                        sigs, siglens, tbs, tbslens,
+                                        results))
+        goto err;
+
+    ret = 1;
+    for (i = 0; i < n; i++)
+        if (!results[i])
+            ret = 0;
+ err:
+    EVP_KEYMGMT_free(tmp_keymgmt);
+    OPENSSL_free(provkeys);
+    return ret;
+}
 #endif /* FIPS_MODULE */
@@ -274,6 +274,80 @@ int EVP_PKEY_keygen(EVP_PKEY_CTX *ctx, EVP_PKEY **ppkey)
     return EVP_PKEY_generate(ctx, ppkey);
 }
 
+int EVP_PKEY_generate_batch(EVP_PKEY_CTX *ctx, EVP_PKEY **pkeys, size_t n)
+{
+    void **keydata = NULL;
+    size_t i;
+    int ret = 0;
+    /* Legacy compatible keygen callback info, only used with provider impls */
+    int gentmp[2];
+
+    if (pkeys == NULL)
+        return -1;
+    for (i = 0; i < n; i++)
+        pkeys[i] = NULL;
+
+    if (ctx == NULL || ctx->operation != EVP_PKEY_OP_KEYGEN) {
+        ERR_raise(ERR_LIB_EVP, EVP_R_OPERATION_NOT_INITIALIZED);
+        return -1;
+    }
+
+    /*
+     * Without a provider implementation, or with a template key, there is
+     * nothing to gain over generating the keys one by one.
+     */
+    if (ctx->op.keymgmt.genctx == NULL || ctx->pkey != NULL) {
+        for (i = 0; i < n; i++) {
+            if ((ret = EVP_PKEY_generate(ctx, &pkeys[i])) <= 0)
+                goto err;
+        }
+        return 1;
+    }
+
+    if (n == 0)
+        return 1;
+    if ((keydata = OPENSSL_zalloc(n * sizeof(*keydata))) == NULL)
+        return 0;
+    for (i = 0; i < n; i++) {
+        if ((pkeys[i] = EVP_PKEY_new()) == NULL) {
+            ERR_raise(ERR_LIB_EVP, ERR_R_EVP_LIB);
+            goto err;
+        }
+    }
+
+    /* See EVP_PKEY_generate() */
+    ctx->keygen_info = gentmp;
+    ctx->keygen_info_count = 2;
+    ret = evp_keymgmt_gen_batch(ctx->keymgmt, ctx->op.keymgmt.genctx, n,
+                                keydata, ossl_callback_to_pkey_gencb, ctx);
+    ctx->keygen_info = NULL;
+    if (!ret)
+        goto err;
+
+    for (i = 0; i < n; i++) {
+        if (!evp_keymgmt_util_assign_pkey(pkeys[i], ctx->keymgmt,
+                                          keydata[i])) {
+            ret = 0;
+            goto err;
+        }
+        /* Owned by pkeys[i] now */
+        keydata[i] = NULL;
+        pkeys[i]->type = ctx->legacy_keytype;
+    }
+    OPENSSL_free(keydata);
+    return 1;
+
+ err:
+    for (i = 0; i < n; i++) {
+        if (keydata != NULL)
+            evp_keymgmt_freedata(ctx->keymgmt, keydata[i]);
+        EVP_PKEY_free(pkeys[i]);
+        pkeys[i] = NULL;
+    }
+    OPENSSL_free(keydata);
+    return ret < 0 ? ret : 0;
+}
+
 void EVP_PKEY_CTX_set_cb(EVP_PKEY_CTX *ctx, EVP_PKEY_gen_cb *cb)
 {
     ctx->pkey_gencb = cb;
@@ -154,6 +154,12 @@ static void *evp_signature_from_algorithm(int name_id,
             signature->digest_verify
                 = OSSL_FUNC_signature_digest_verify(fns);
             break;
+        case OSSL_FUNC_SIGNATURE_DIGEST_VERIFY_BATCH:
+            if (signature->digest_verify_batch != NULL)
+                break;
+            signature->digest_verify_batch
+                = OSSL_FUNC_signature_digest_verify_batch(fns);
+            break;
         case OSSL_FUNC_SIGNATURE_FREECTX:
             if (signature->freectx != NULL)
                 break;
@@ -242,6 +248,8 @@ static void *evp_signature_from_algorithm(int name_id,
             && signature->digest_sign_init == NULL)
         || (signature->digest_verify != NULL
             && signature->digest_verify_init == NULL)
+        || (signature->digest_verify_batch != NULL
+            && signature->digest_verify_init == NULL)
         || (gparamfncnt != 0 && gparamfncnt != 2)
         || (sparamfncnt != 0 && sparamfncnt != 2)
         || (gmdparamfncnt != 0 && gmdparamfncnt != 2)
@@ -150,6 +150,13 @@ int ossl_ffc_named_group_get_keylength(const DH_NAMED_GROUP *group)
     return group->keylength;
 }
 
+const BIGNUM *ossl_ffc_named_group_get_p(const DH_NAMED_GROUP *group)
+{
+    if (group == NULL)
+        return NULL;
+    return group->p;
+}
+
 const BIGNUM *ossl_ffc_named_group_get_q(const DH_NAMED_GROUP *group)
 {
     if (group == NULL)
@@ -0,0 +1,945 @@
+/*
+ * Copyright 2024 The OpenSSL Project Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License 2.0 (the "License").  You may not use
+ * this file except in compliance with the License.  You can obtain a copy
+ * in the file LICENSE in the source distribution or at
+ * https://www.openssl.org/source/license.html
+ */
+
+/*
+ * ML-KEM, as specified in FIPS 203.
+ *
+ * Polynomial coefficients are kept fully reduced in a uint16_t.  Products
+ * in the NTT domain are accumulated unreduced in 32 bits, so a whole
+ * matrix-vector product costs one Barrett reduction per output coefficient
+ * rather than one per term.  The matrix A is expanded once, when the key is
+ * set, and kept with the key: decapsulation re-encrypts and so needs it too.
+ * The SHA-3 functions are called directly rather than through EVP.
+ */
+
+#include <string.h>
+#include <openssl/crypto.h>
+#include <openssl/rand.h>
+#include <openssl/core_dispatch.h>
+#include <internal/constant_time.h>
+#include <internal/nelem.h>
+#include <internal/sha3.h>
+#include <crypto/ml_kem.h>
+
+#define DEGREE          256
+#define PRIME           3329
+#define HALF_PRIME      ((PRIME - 1) / 2)
+#define INVERSE_DEGREE  3303            /* 128^-1 mod PRIME */
+#define BARRETT_MULT    1290167         /* floor(2^32 / PRIME) */
+#define MAX_K           4
+#define MAX_ETA         3
+#define MAX_CTEXT_BYTES ML_KEM_1024_CIPHERTEXT_BYTES
+#define MAX_PUBKEY_BYTES ML_KEM_1024_PUBLIC_KEY_BYTES
+#define SHAKE128_BLOCK  168
+
+#define SHA3_PAD        0x06
+#define SHAKE_PAD       0x1f
+
+typedef struct {
+    uint16_t c[DEGREE];
+} scalar;
+
+struct ml_kem_key_st {
+    const ML_KEM_VINFO *vinfo;
+    OSSL_LIB_CTX *libctx;
+    scalar *t;                  /* Public vector, NTT domain */
+    scalar *m;                  /* Public matrix A, NTT domain, row major */
+    scalar *s;                  /* Secret vector, NTT domain, or NULL */
+    uint8_t rho[ML_KEM_RANDOM_BYTES];
+    uint8_t pkhash[ML_KEM_PKHASH_BYTES];
+    uint8_t z[ML_KEM_RANDOM_BYTES];
+};
+
+static const ML_KEM_VINFO vinfo_map[3] = {
+    {
+        "ML-KEM-512",
+        ML_KEM_512_PUBLIC_KEY_BYTES,
+        ML_KEM_512_PRIVATE_KEY_BYTES,
+        ML_KEM_512_CIPHERTEXT_BYTES,
+        ML_KEM_512_VARIANT,
+        ML_KEM_512_BITS,
+        ML_KEM_512_SECBITS,
+        2, 3, 2, 10, 4
+    },
+    {
+        "ML-KEM-768",
+        ML_KEM_768_PUBLIC_KEY_BYTES,
+        ML_KEM_768_PRIVATE_KEY_BYTES,
+        ML_KEM_768_CIPHERTEXT_BYTES,
+        ML_KEM_768_VARIANT,
+        ML_KEM_768_BITS,
+        ML_KEM_768_SECBITS,
+        3, 2, 2, 10, 4
+    },
+    {
+        "ML-KEM-1024",
+        ML_KEM_1024_PUBLIC_KEY_BYTES,
+        ML_KEM_1024_PRIVATE_KEY_BYTES,
+        ML_KEM_1024_CIPHERTEXT_BYTES,
+        ML_KEM_1024_VARIANT,
+        ML_KEM_1024_BITS,
+        ML_KEM_1024_SECBITS,
+        4, 2, 2, 11, 5
+    }
+};
+
+/* 17^BitRev7(i) mod PRIME, the twiddle factors of the NTT */
+static const uint16_t ntt_roots[DEGREE / 2] = {
+    1, 1729, 2580, 3289, 2642, 630, 1897, 848, 1062, 1919, 193, 797, 2786,
+    3260, 569, 1746, 296, 2447, 1339, 1476, 3046, 56, 2240, 1333, 1426, 2094,
+    535, 2882, 2393, 2879, 1974, 821, 289, 331, 3253, 1756, 1197, 2304, 2277,
+    2055, 650, 1977, 2513, 632, 2865, 33, 1320, 1915, 2319, 1435, 807, 452,
+    1438, 2868, 1534, 2402, 2647, 2617, 1481, 648, 2474, 3110, 1227, 910, 17,
+    2761, 583, 2649, 1637, 723, 2288, 1100, 1409, 2662, 3281, 233, 756, 2156,
+    3015, 3050, 1703, 1651, 2789, 1789, 1847, 952, 1461, 2687, 939, 2308,
+    2437, 2388, 733, 2337, 268, 641, 1584, 2298, 2037, 3220, 375, 2549, 2090,
+    1645, 1063, 319, 2773, 757, 2099, 561, 2466, 2594, 2804, 1092, 403, 1026,
+    1143, 2150, 2775, 886, 1722, 1212, 1874, 1029, 2110, 2935, 885, 2154
+};
+
+/* 17^(2 * BitRev7(i) + 1) mod PRIME, used when multiplying in the NTT domain */
+static const uint16_t mod_roots[DEGREE / 2] = {
+    17, 3312, 2761, 568, 583, 2746, 2649, 680, 1637, 1692, 723, 2606, 2288,
+    1041, 1100, 2229, 1409, 1920, 2662, 667, 3281, 48, 233, 3096, 756, 2573,
+    2156, 1173, 3015, 314, 3050, 279, 1703, 1626, 1651, 1678, 2789, 540, 1789,
+    1540, 1847, 1482, 952, 2377, 1461, 1868, 2687, 642, 939, 2390, 2308, 1021,
+    2437, 892, 2388, 941, 733, 2596, 2337, 992, 268, 3061, 641, 2688, 1584,
+    1745, 2298, 1031, 2037, 1292, 3220, 109, 375, 2954, 2549, 780, 2090, 1239,
+    1645, 1684, 1063, 2266, 319, 3010, 2773, 556, 757, 2572, 2099, 1230, 561,
+    2768, 2466, 863, 2594, 735, 2804, 525, 1092, 2237, 403, 2926, 1026, 2303,
+    1143, 2186, 2150, 1179, 2775, 554, 886, 2443, 1722, 1607, 1212, 2117,
+    1874, 1455, 1029, 2300, 2110, 1219, 2935, 394, 885, 2444, 2154, 1175
+};
+
+/*
+ * Hash functions.  None of the SHA-3 calls can fail with the parameters
+ * used here.
+ */
+
+/* H: SHA3-256 */
+static void hash_h(uint8_t out[32], const uint8_t *in, size_t len)
+{
+    KECCAK1600_CTX ctx;
+
+    ossl_sha3_init(&ctx, SHA3_PAD, 256);
+    ossl_sha3_update(&ctx, in, len);
+    ossl_sha3_final(&ctx, out, 32);
+}
+
+/* G: SHA3-512 */
+static void hash_g(uint8_t out[64], const uint8_t *in, size_t len)
+{
+    KECCAK1600_CTX ctx;
+
+    ossl_sha3_init(&ctx, SHA3_PAD, 512);
+    ossl_sha3_update(&ctx, in, len);
+    ossl_sha3_final(&ctx, out, 64);
+    OPENSSL_cleanse(&ctx, sizeof(ctx));
+}
+
+/* PRF: SHAKE256(seed || n) */
+static void prf(uint8_t *out, size_t outlen,
+                const uint8_t seed[ML_KEM_RANDOM_BYTES], uint8_t n)
+{
+    KECCAK1600_CTX ctx;
+
+    ossl_sha3_init(&ctx, SHAKE_PAD, 256);
+    ossl_sha3_update(&ctx, seed, ML_KEM_RANDOM_BYTES);
+    ossl_sha3_update(&ctx, &n, 1);
+    ossl_sha3_final(&ctx, out, outlen);
+    OPENSSL_cleanse(&ctx, sizeof(ctx));
+}
+
+/* J: SHAKE256(z || c), the implicit rejection key */
+static void kdf_j(uint8_t out[ML_KEM_SHARED_SECRET_BYTES],
+                  const uint8_t z[ML_KEM_RANDOM_BYTES],
+                  const uint8_t *ctext, size_t clen)
+{
+    KECCAK1600_CTX ctx;
+
+    ossl_sha3_init(&ctx, SHAKE_PAD, 256);
+    ossl_sha3_update(&ctx, z, ML_KEM_RANDOM_BYTES);
+    ossl_sha3_update(&ctx, ctext, clen);
+    ossl_sha3_final(&ctx, out, ML_KEM_SHARED_SECRET_BYTES);
+    OPENSSL_cleanse(&ctx, sizeof(ctx));
+}
+
+/*
+ * Arithmetic mod PRIME
+ */
+
+/* Returns x mod PRIME for x < 2 * PRIME, in constant time */
+static inline uint16_t reduce_once(uint32_t x)
+{
+    uint32_t sub = x - PRIME;
+
+    return (uint16_t)constant_time_select_32(constant_time_msb_32(sub),
+                                             x, sub);
+}
+
+/*
+ * Returns x mod PRIME for any 32-bit x, in constant time.  The quotient
+ * estimate is at most one too small, so the remainder is below 2 * PRIME.
+ */
+static inline uint16_t reduce(uint32_t x)
+{
+    uint32_t quotient = (uint32_t)(((uint64_t)x * BARRETT_MULT) >> 32);
+
+    return reduce_once(x - quotient * PRIME);
+}
+
+static void scalar_add(scalar *out, const scalar *in)
+{
+    int i;
+
+    for (i = 0; i < DEGREE; i++)
+        out->c[i] = reduce_once(out->c[i] + in->c[i]);
+}
+
+static void scalar_sub(scalar *out, const scalar *in)
+{
+    int i;
+
+    for (i = 0; i < DEGREE; i++)
+        out->c[i] = reduce_once(out->c[i] - in->c[i] + PRIME);
+}
+
+/* FIPS 203, algorithm 9 */
+static void scalar_ntt(scalar *s)
+{
+    int len, start, j, k = 1;
+
+    for (len = DEGREE / 2; len >= 2; len >>= 1) {
+        for (start = 0; start < DEGREE; start += 2 * len) {
+            uint32_t zeta = ntt_roots[k++];
+
+            for (j = start; j < start + len; j++) {
+                uint16_t odd = reduce(zeta * s->c[j + len]);
+                uint16_t even = s->c[j];
+
+                s->c[j] = reduce_once(even + odd);
+                s->c[j + len] = reduce_once(even - odd + PRIME);
+            }
+        }
+    }
+}
+
+/* FIPS 203, algorithm 10 */
+static void scalar_inverse_ntt(scalar *s)
+{
+    int len, start, j, k = DEGREE / 2 - 1;
+
+    for (len = 2; len <= DEGREE / 2; len <<= 1) {
+        for (start = 0; start < DEGREE; start += 2 * len) {
+            uint32_t zeta = ntt_roots[k--];
+
+            for (j = start; j < start + len; j++) {
+                uint16_t even = s->c[j];
+                uint16_t odd = s->c[j + len];
+
+                s->c[j] = reduce_once(even + odd);
+                s->c[j + len] = reduce(zeta * (odd - even + PRIME));
+            }
+        }
+    }
+    for (j = 0; j < DEGREE; j++)
+        s->c[j] = reduce((uint32_t)s->c[j] * INVERSE_DEGREE);
+}
+
+/*
+ * out = sum over j < k of lhs[j * stride] * rhs[j], all in the NTT domain
+ * (FIPS 203, algorithms 11 and 12).  Each term is below 2 * PRIME^2, so for
+ * k <= 4 the sums fit in 32 bits and are only reduced at the end.
+ */
+static void scalar_inner_product(scalar *out, const scalar *lhs, int stride,
+                                 const scalar *rhs, int k)
+{
+    int i, j;
+
+    for (i = 0; i < DEGREE / 2; i++) {
+        uint32_t even = 0, odd = 0;
+
+        for (j = 0; j < k; j++) {
+            const uint16_t *a = &lhs[j * stride].c[2 * i];
+            const uint16_t *b = &rhs[j].c[2 * i];
+
+            even += (uint32_t)a[0] * b[0]
+                + (uint32_t)reduce((uint32_t)a[1] * b[1]) * mod_roots[i];
+            odd += (uint32_t)a[0] * b[1] + (uint32_t)a[1] * b[0];
+        }
+        out->c[2 * i] = reduce(even);
+        out->c[2 * i + 1] = reduce(odd);
+    }
+}
+
+/*
+ * Compress_d and Decompress_d (FIPS 203, section 4.2.1).  compress()
+ * computes round(2^bits * x / PRIME) with the same quotient estimate as
+ * reduce() and then corrects it in constant time.
+ */
+static inline uint16_t compress(uint16_t x, int bits)
+{
+    uint32_t shifted = (uint32_t)x << bits;
+    uint32_t quotient = (uint32_t)(((uint64_t)shifted * BARRETT_MULT) >> 32);
+    uint32_t remainder = shifted - quotient * PRIME;
+
+    quotient += 1 & constant_time_lt(HALF_PRIME, remainder);
+    quotient += 1 & constant_time_lt(PRIME + HALF_PRIME, remainder);
+    return (uint16_t)(quotient & ((1u << bits) - 1));
+}
+
+static inline uint16_t decompress(uint16_t x, int bits)
+{
+    return (uint16_t)(((uint32_t)x * PRIME + (1u << (bits - 1))) >> bits);
+}
+
+static void scalar_compress(scalar *s, int bits)
+{
+    int i;
+
+    for (i = 0; i < DEGREE; i++)
+        s->c[i] = compress(s->c[i], bits);
+}
+
+static void scalar_decompress(scalar *s, int bits)
+{
+    int i;
+
+    for (i = 0; i < DEGREE; i++)
+        s->c[i] = decompress(s->c[i], bits);
+}
+
+/* ByteEncode_d (FIPS 203, algorithm 5), writes 32 * bits bytes */
+static void scalar_encode(uint8_t *out, const scalar *s, int bits)
+{
+    uint32_t acc = 0;
+    int i, used = 0;
+
+    for (i = 0; i < DEGREE; i++) {
+        acc |= (uint32_t)s->c[i] << used;
+        used += bits;
+        while (used >= 8) {
+            *out++ = (uint8_t)acc;
+            acc >>= 8;
+            used -= 8;
+        }
+    }
+}
+
+/*
+ * ByteDecode_d (FIPS 203, algorithm 6), reads 32 * bits bytes.  For 12-bit
+ * coefficients, returns 0 if any is not below PRIME: these are the
+ * encapsulation key "modulus check" failures of FIPS 203, section 7.2.
+ */
+static int scalar_decode(scalar *s, const uint8_t *in, int bits)
+{
+    uint32_t acc = 0, mask = (1u << bits) - 1;
+    int i, used = 0;
+
+    for (i = 0; i < DEGREE; i++) {
+        while (used < bits) {
+            acc |= (uint32_t)*in++ << used;
+            used += 8;
+        }
+        s->c[i] = (uint16_t)(acc & mask);
+        acc >>= bits;
+        used -= bits;
+        if (bits == 12 && s->c[i] >= PRIME)
+            return 0;
+    }
+    return 1;
+}
+
+/*
+ * SampleNTT (FIPS 203, algorithm 7).  Rejection sampling from public data,
+ * so variable time is fine.  Takes coefficients from |len| bytes of XOF
+ * output for as long as |out| needs them, and returns how many it has.
+ */
+static int scalar_sample_ntt_vartime(scalar *out, int done, const uint8_t *buf,
+                                     size_t len)
+{
+    size_t i;
+
+    for (i = 0; i + 3 <= len && done < DEGREE; i += 3) {
+        uint16_t d1 = buf[i] | ((buf[i + 1] & 0x0f) << 8);
+        uint16_t d2 = (buf[i + 1] >> 4) | (buf[i + 2] << 4);
+
+        if (d1 < PRIME)
+            out->c[done++] = d1;
+        if (d2 < PRIME && done < DEGREE)
+            out->c[done++] = d2;
+    }
+    return done;
+}
+
+static void scalar_from_keccak_vartime(scalar *out, KECCAK1600_CTX *ctx)
+{
+    uint8_t buf[SHAKE128_BLOCK];
+    int done = 0;
+
+    while (done < DEGREE) {
+        ossl_sha3_squeeze(ctx, buf, sizeof(buf));
+        done = scalar_sample_ntt_vartime(out, done, buf, sizeof(buf));
+    }
+}
+
+/*
+ * The same for four polynomials at once.  Three blocks are nearly always
+ * enough, so those are squeezed in one go.
+ */
+static void scalar_from_keccak_x4_vartime(scalar *const out[4],
+                                          KECCAK1600_X4_CTX *ctx)
+{
+    uint8_t buf[4][3 * SHAKE128_BLOCK];
+    uint8_t *bufs[4] = { buf[0], buf[1], buf[2], buf[3] };
+    size_t len = sizeof(buf[0]);
+    int done[4] = { 0, 0, 0, 0 };
+    int l, more;
+
+    do {
+        ossl_sha3_squeeze_x4(ctx, bufs, len);
+        for (l = 0, more = 0; l < 4; l++) {
+            done[l] = scalar_sample_ntt_vartime(out[l], done[l], buf[l], len);
+            more |= done[l] < DEGREE;
+        }
+        len = SHAKE128_BLOCK;
+    } while (more);
+}
+
+/* SamplePolyCBD_eta (FIPS 203, algorithm 8), reads 64 * eta bytes */
+static void scalar_centered_binomial(scalar *out, const uint8_t *in, int eta)
+{
+    int i, j;
+
+    if (eta == 2) {
+        for (i = 0; i < DEGREE; i += 2, in++) {
+            /* Sums of adjacent bit pairs */
+            uint32_t t = (in[0] & 0x55) + ((in[0] >> 1) & 0x55);
+
+            out->c[i] = reduce_once((t & 3) - ((t >> 2) & 3) + PRIME);
+            out->c[i + 1] = reduce_once(((t >> 4) & 3) - (t >> 6) + PRIME);
+        }
+    } else {
+        for (i = 0; i < DEGREE; i += 4, in += 3) {
+            uint32_t w = in[0] | ((uint32_t)in[1] << 8)
+                | ((uint32_t)in[2] << 16);
+            /* Sums of adjacent bit triples */
+            uint32_t t = (w & 0x249249) + ((w >> 1) & 0x249249)
+                + ((w >> 2) & 0x249249);
+
+            for (j = 0; j < 4; j++, t >>= 6)
+                out->c[i + j] = reduce_once((t & 7) - ((t >> 3) & 7) + PRIME);
+        }
+    }
+}
+
+/*
+ * Expands rho into the matrix A, with A[i][j] at m[i * k + j].  The k^2
+ * XOFs are independent, so they are run four at a time.
+ */
+static void matrix_expand(scalar *m, const uint8_t rho[ML_KEM_RANDOM_BYTES],
+                          int k)
+{
+    KECCAK1600_CTX ctx;
+    KECCAK1600_X4_CTX ctx4;
+    uint8_t in[4][ML_KEM_RANDOM_BYTES + 2];
+    const uint8_t *ins[4] = { in[0], in[1], in[2], in[3] };
+    scalar *outs[4];
+    int i, l;
+
+    for (i = 0; i + 4 <= k * k; i += 4) {
+        for (l = 0; l < 4; l++) {
+            memcpy(in[l], rho, ML_KEM_RANDOM_BYTES);
+            in[l][ML_KEM_RANDOM_BYTES] = (uint8_t)((i + l) % k);
+            in[l][ML_KEM_RANDOM_BYTES + 1] = (uint8_t)((i + l) / k);
+            outs[l] = &m[i + l];
+        }
+        ossl_sha3_init_x4(&ctx4, SHAKE_PAD, 128);
+        ossl_sha3_absorb_x4(&ctx4, ins, sizeof(in[0]));
+        scalar_from_keccak_x4_vartime(outs, &ctx4);
+    }
+    for (; i < k * k; i++) {
+        memcpy(in[0], rho, ML_KEM_RANDOM_BYTES);
+        in[0][ML_KEM_RANDOM_BYTES] = (uint8_t)(i % k);
+        in[0][ML_KEM_RANDOM_BYTES + 1] = (uint8_t)(i / k);
+        ossl_sha3_init(&ctx, SHAKE_PAD, 128);
+        ossl_sha3_update(&ctx, in[0], sizeof(in[0]));
+        scalar_from_keccak_vartime(&m[i], &ctx);
+    }
+}
+
+/* Samples a noise polynomial from PRF(seed, n) */
+static void scalar_noise(scalar *out, const uint8_t seed[ML_KEM_RANDOM_BYTES],
+                         uint8_t n, int eta)
+{
+    uint8_t buf[64 * MAX_ETA];
+
+    prf(buf, 64 * eta, seed, n);
+    scalar_centered_binomial(out, buf, eta);
+    OPENSSL_cleanse(buf, sizeof(buf));
+}
+
+/*
+ * Samples |count| noise polynomials from PRF(seed, n), PRF(seed, n + 1) and
+ * so on, four at a time as far as possible.
+ */
+static void scalar_noise_many(scalar *out, int count,
+                              const uint8_t seed[ML_KEM_RANDOM_BYTES],
+                              uint8_t n, int eta)
+{
+    KECCAK1600_X4_CTX ctx;
+    uint8_t in[4][ML_KEM_RANDOM_BYTES + 1], buf[4][64 * MAX_ETA];
+    const uint8_t *ins[4] = { in[0], in[1], in[2], in[3] };
+    uint8_t *bufs[4] = { buf[0], buf[1], buf[2], buf[3] };
+    int l;
+
+    for (; count >= 4; count -= 4, out += 4, n += 4) {
+        for (l = 0; l < 4; l++) {
+            memcpy(in[l], seed, ML_KEM_RANDOM_BYTES);
+            in[l][ML_KEM_RANDOM_BYTES] = (uint8_t)(n + l);
+        }
+        ossl_sha3_init_x4(&ctx, SHAKE_PAD, 256);
+        ossl_sha3_absorb_x4(&ctx, ins, sizeof(in[0]));
+        ossl_sha3_squeeze_x4(&ctx, bufs, 64 * eta);
+        for (l = 0; l < 4; l++)
+            scalar_centered_binomial(&out[l], buf[l], eta);
+    }
+    for (; count > 0; count--)
+        scalar_noise(out++, seed, n++, eta);
+    OPENSSL_cleanse(&ctx, sizeof(ctx));
+    OPENSSL_cleanse(in, sizeof(in));
+    OPENSSL_cleanse(buf, sizeof(buf));
+}
+
+/*
+ * K-PKE.Encrypt (FIPS 203, algorithm 14), with the public key already
+ * decoded and A expanded.
+ */
+static void encrypt_cpa(uint8_t *out, const uint8_t message[32],
+                        const uint8_t r[ML_KEM_RANDOM_BYTES],
+                        const ML_KEM_KEY *key)
+{
+    const ML_KEM_VINFO *vinfo = key->vinfo;
+    int i, k = vinfo->k;
+    /* y, e1 and e2 are PRF(r, n) for n = 0 .. 2k in that order */
+    scalar noise[2 * MAX_K + 1], *y = noise, *e1 = noise + k, *e2 = e1 + k;
+    scalar u, v, m;
+
+    if (vinfo->eta1 == vinfo->eta2) {
+        scalar_noise_many(noise, 2 * k + 1, r, 0, vinfo->eta1);
+    } else {
+        scalar_noise_many(y, k, r, 0, vinfo->eta1);
+        scalar_noise_many(e1, k + 1, r, (uint8_t)k, vinfo->eta2);
+    }
+    for (i = 0; i < k; i++)
+        scalar_ntt(&y[i]);
+    for (i = 0; i < k; i++) {
+        /* u[i] = NTT^-1(sum over j of A[j][i] * y[j]) + e1[i] */
+        scalar_inner_product(&u, &key->m[i], k, y, k);
+        scalar_inverse_ntt(&u);
+        scalar_add(&u, &e1[i]);
+        scalar_compress(&u, vinfo->du);
+        scalar_encode(out, &u, vinfo->du);
+        out += 32 * vinfo->du;
+    }
+
+    /* v = NTT^-1(t . y) + e2 + Decompress_1(message) */
+    scalar_inner_product(&v, key->t, 1, y, k);
+    scalar_inverse_ntt(&v);
+    scalar_add(&v, e2);
+    scalar_decode(&m, message, 1);
+    scalar_decompress(&m, 1);
+    scalar_add(&v, &m);
+    scalar_compress(&v, vinfo->dv);
+    scalar_encode(out, &v, vinfo->dv);
+
+    OPENSSL_cleanse(noise, sizeof(noise));
+    OPENSSL_cleanse(&u, sizeof(u));
+    OPENSSL_cleanse(&v, sizeof(v));
+    OPENSSL_cleanse(&m, sizeof(m));
+}
+
+/* K-PKE.Decrypt (FIPS 203, algorithm 15) */
+static void decrypt_cpa(uint8_t out[32], const uint8_t *ctext,
+                        const ML_KEM_KEY *key)
+{
+    const ML_KEM_VINFO *vinfo = key->vinfo;
+    int i, k = vinfo->k;
+    scalar u[MAX_K], v, w;
+
+    for (i = 0; i < k; i++) {
+        scalar_decode(&u[i], ctext, vinfo->du);
+        scalar_decompress(&u[i], vinfo->du);
+        scalar_ntt(&u[i]);
+        ctext += 32 * vinfo->du;
+    }
+    scalar_decode(&v, ctext, vinfo->dv);
+    scalar_decompress(&v, vinfo->dv);
+
+    /* w = v - NTT^-1(s . NTT(u)) */
+    scalar_inner_product(&w, key->s, 1, u, k);
+    scalar_inverse_ntt(&w);
+    scalar_sub(&v, &w);
+    scalar_compress(&v, 1);
+    scalar_encode(out, &v, 1);
+
+    OPENSSL_cleanse(&v, sizeof(v));
+    OPENSSL_cleanse(&w, sizeof(w));
+}
+
+/*
+ * Key management
+ */
+
+const ML_KEM_VINFO *ossl_ml_kem_get_vinfo(int variant)
+{
+    if (variant < 0 || variant >= (int)OSSL_NELEM(vinfo_map))
+        return NULL;
+    return &vinfo_map[variant];
+}
+
+ML_KEM_KEY *ossl_ml_kem_key_new(OSSL_LIB_CTX *libctx, int variant)
+{
+    const ML_KEM_VINFO *vinfo = ossl_ml_kem_get_vinfo(variant);
+    ML_KEM_KEY *key;
+
+    if (vinfo == NULL)
+        return NULL;
+    if ((key = OPENSSL_zalloc(sizeof(*key))) == NULL)
+        return NULL;
+    key->vinfo = vinfo;
+    key->libctx = libctx;
+    return key;
+}
+
+/* Number of polynomials held by a key with all of t, m and s */
+static size_t key_scalars(const ML_KEM_VINFO *vinfo)
+{
+    return (size_t)vinfo->k * (vinfo->k + 2);
+}
+
+/* Discards any key material, leaving an empty key of the same variant */
+void ossl_ml_kem_key_reset(ML_KEM_KEY *key)
+{
+    OPENSSL_clear_free(key->t, key_scalars(key->vinfo) * sizeof(scalar));
+    key->t = key->m = key->s = NULL;
+    OPENSSL_cleanse(key->z, sizeof(key->z));
+}
+
+void ossl_ml_kem_key_free(ML_KEM_KEY *key)
+{
+    if (key == NULL)
+        return;
+    ossl_ml_kem_key_reset(key);
+    OPENSSL_free(key);
+}
+
+/* Allocates room for t, m and s; the key is otherwise still empty */
+static int key_alloc(ML_KEM_KEY *key)
+{
+    int k = key->vinfo->k;
+
+    if (key->t != NULL)
+        return 0;
+    key->t = OPENSSL_malloc(key_scalars(key->vinfo) * sizeof(scalar));
+    if (key->t == NULL)
+        return 0;
+    key->m = key->t + k;
+    return 1;
+}
+
+ML_KEM_KEY *ossl_ml_kem_key_dup(const ML_KEM_KEY *key, int selection)
+{
+    ML_KEM_KEY *ret;
+    int k;
+
+    if (key == NULL)
+        return NULL;
+    if ((ret = ossl_ml_kem_key_new(key->libctx, key->vinfo->variant)) == NULL)
+        return NULL;
+    if ((selection & OSSL_KEYMGMT_SELECT_KEYPAIR) == 0 || key->t == NULL)
+        return ret;
+
+    if (!key_alloc(ret)) {
+        ossl_ml_kem_key_free(ret);
+        return NULL;
+    }
+    k = key->vinfo->k;
+    /* t and m are adjacent, s follows them and is only copied if selected */
+    memcpy(ret->t, key->t, (k + k * k) * sizeof(scalar));
+    memcpy(ret->rho, key->rho, sizeof(ret->rho));
+    memcpy(ret->pkhash, key->pkhash, sizeof(ret->pkhash));
+    if ((selection & OSSL_KEYMGMT_SELECT_PRIVATE_KEY) != 0 && key->s != NULL) {
+        ret->s = ret->m + k * k;
+        memcpy(ret->s, key->s, k * sizeof(scalar));
+        memcpy(ret->z, key->z, sizeof(ret->z));
+    }
+    return ret;
+}
+
+const ML_KEM_VINFO *ossl_ml_kem_key_vinfo(const ML_KEM_KEY *key)
+{
+    return key->vinfo;
+}
+
+int ossl_ml_kem_have_pubkey(const ML_KEM_KEY *key)
+{
+    return key != NULL && key->t != NULL;
+}
+
+int ossl_ml_kem_have_prvkey(const ML_KEM_KEY *key)
+{
+    return key != NULL && key->s != NULL;
+}
+
+/*
+ * Public keys are equal when their hashes are: H is collision resistant and
+ * the hash is already to hand.
+ */
+int ossl_ml_kem_pubkey_cmp(const ML_KEM_KEY *key1, const ML_KEM_KEY *key2)
+{
+    return ossl_ml_kem_have_pubkey(key1) && ossl_ml_kem_have_pubkey(key2)
+        && key1->vinfo == key2->vinfo
+        && memcmp(key1->pkhash, key2->pkhash, sizeof(key1->pkhash)) == 0;
+}
+
+/* Decodes t, expands A from rho and stores H(ek) */
+static int parse_public_key(const uint8_t *in, ML_KEM_KEY *key)
+{
+    const ML_KEM_VINFO *vinfo = key->vinfo;
+    int i;
+
+    for (i = 0; i < vinfo->k; i++)
+        if (!scalar_decode(&key->t[i], in + 384 * i, 12))
+            return 0;
+    memcpy(key->rho, in + 384 * vinfo->k, sizeof(key->rho));
+    matrix_expand(key->m, key->rho, vinfo->k);
+    hash_h(key->pkhash, in, vinfo->pubkey_bytes);
+    return 1;
+}
+
+static void encode_public_key(uint8_t *out, const ML_KEM_KEY *key)
+{
+    int i;
+
+    for (i = 0; i < key->vinfo->k; i++)
+        scalar_encode(out + 384 * i, &key->t[i], 12);
+    memcpy(out + 384 * key->vinfo->k, key->rho, sizeof(key->rho));
+}
+
+int ossl_ml_kem_parse_public_key(const uint8_t *in, size_t len,
+                                 ML_KEM_KEY *key)
+{
+    if (len != key->vinfo->pubkey_bytes || !key_alloc(key))
+        return 0;
+    if (!parse_public_key(in, key)) {
+        ossl_ml_kem_key_reset(key);
+        return 0;
+    }
+    return 1;
+}
+
+/*
+ * The private key is dk_pke || ek || H(ek) || z.  Both the modulus check on
+ * ek and the hash check of FIPS 203, section 7.3, are done here, once,
+ * rather than on every decapsulation.
+ */
+int ossl_ml_kem_parse_private_key(const uint8_t *in, size_t len,
+                                  ML_KEM_KEY *key)
+{
+    const ML_KEM_VINFO *vinfo = key->vinfo;
+    int i, k = vinfo->k;
+    scalar *s;
+
+    if (len != vinfo->prvkey_bytes || !key_alloc(key))
+        return 0;
+    s = key->m + k * k;
+    for (i = 0; i < k; i++)
+        if (!scalar_decode(&s[i], in + 384 * i, 12))
+            goto err;
+    in += 384 * k;
+    if (!parse_public_key(in, key))
+        goto err;
+    in += vinfo->pubkey_bytes;
+    if (memcmp(key->pkhash, in, ML_KEM_PKHASH_BYTES) != 0)
+        goto err;
+    in += ML_KEM_PKHASH_BYTES;
+    memcpy(key->z, in, sizeof(key->z));
+    key->s = s;
+    return 1;
+
+ err:
+    ossl_ml_kem_key_reset(key);
+    return 0;
+}
+
+int ossl_ml_kem_encode_public_key(uint8_t *out, size_t len,
+                                  const ML_KEM_KEY *key)
+{
+    if (!ossl_ml_kem_have_pubkey(key) || len != key->vinfo->pubkey_bytes)
+        return 0;
+    encode_public_key(out, key);
+    return 1;
+}
+
+int ossl_ml_kem_encode_private_key(uint8_t *out, size_t len,
+                                   const ML_KEM_KEY *key)
+{
+    const ML_KEM_VINFO *vinfo;
+    int i;
+
+    if (!ossl_ml_kem_have_prvkey(key))
+        return 0;
+    vinfo = key->vinfo;
+    if (len != vinfo->prvkey_bytes)
+        return 0;
+    for (i = 0; i < vinfo->k; i++)
+        scalar_encode(out + 384 * i, &key->s[i], 12);
+    out += 384 * vinfo->k;
+    encode_public_key(out, key);
+    out += vinfo->pubkey_bytes;
+    memcpy(out, key->pkhash, ML_KEM_PKHASH_BYTES);
+    memcpy(out + ML_KEM_PKHASH_BYTES, key->z, sizeof(key->z));
+    return 1;
+}
+
+/*
+ * ML-KEM.KeyGen_internal (FIPS 203, algorithms 13 and 16).  |seed| is d || z;
+ * if it is NULL a fresh one is drawn from the private DRBG.
+ */
+int ossl_ml_kem_genkey(ML_KEM_KEY *key, const uint8_t *seed, size_t seedlen)
+{
+    const ML_KEM_VINFO *vinfo = key->vinfo;
+    int i, k = vinfo->k, ret = 0;
+    uint8_t dz[ML_KEM_SEED_BYTES], rho_sigma[64];
+    uint8_t pubkey[MAX_PUBKEY_BYTES];
+    /* s and e are PRF(sigma, n) for n = 0 .. 2k - 1 in that order */
+    scalar noise[2 * MAX_K], *e = noise + k;
+
+    if (seed != NULL) {
+        if (seedlen != ML_KEM_SEED_BYTES)
+            return 0;
+        memcpy(dz, seed, sizeof(dz));
+    } else if (RAND_priv_bytes_ex(key->libctx, dz, sizeof(dz), 0) <= 0) {
+        return 0;
+    }
+    if (!key_alloc(key))
+        goto end;
+    key->s = key->m + k * k;
+
+    /* (rho, sigma) = G(d || k) */
+    memcpy(rho_sigma, dz, ML_KEM_RANDOM_BYTES);
+    rho_sigma[ML_KEM_RANDOM_BYTES] = (uint8_t)k;
+    hash_g(rho_sigma, rho_sigma, ML_KEM_RANDOM_BYTES + 1);
+    memcpy(key->rho, rho_sigma, sizeof(key->rho));
+    memcpy(key->z, dz + ML_KEM_RANDOM_BYTES, sizeof(key->z));
+    matrix_expand(key->m, key->rho, k);
+
+    scalar_noise_many(noise, 2 * k, rho_sigma + 32, 0, vinfo->eta1);
+    for (i = 0; i < k; i++) {
+        key->s[i] = noise[i];
+        scalar_ntt(&key->s[i]);
+    }
+    /* t = A * s + e */
+    for (i = 0; i < k; i++) {
+        scalar_inner_product(&key->t[i], &key->m[i * k], 1, key->s, k);
+        scalar_ntt(&e[i]);
+        scalar_add(&key->t[i], &e[i]);
+    }
+    encode_public_key(pubkey, key);
+    hash_h(key->pkhash, pubkey, vinfo->pubkey_bytes);
+    ret = 1;
+
+ end:
+    OPENSSL_cleanse(dz, sizeof(dz));
+    OPENSSL_cleanse(rho_sigma, sizeof(rho_sigma));
+    OPENSSL_cleanse(noise, sizeof(noise));
+    return ret;
+}
+
+/* ML-KEM.Encaps_internal (FIPS 203, algorithm 17) */
+int ossl_ml_kem_encap_seed(uint8_t *ctext, size_t clen,
+                           uint8_t *shared_secret, size_t slen,
+                           const uint8_t *entropy, size_t elen,
+                           const ML_KEM_KEY *key)
+{
+    uint8_t input[ML_KEM_RANDOM_BYTES + ML_KEM_PKHASH_BYTES];
+    uint8_t Kr[ML_KEM_SHARED_SECRET_BYTES + ML_KEM_RANDOM_BYTES];
+
+    if (!ossl_ml_kem_have_pubkey(key)
+        || clen != key->vinfo->ctext_bytes
+        || slen != ML_KEM_SHARED_SECRET_BYTES
+        || elen != ML_KEM_RANDOM_BYTES)
+        return 0;
+
+    /* (K, r) = G(m || H(ek)) */
+    memcpy(input, entropy, ML_KEM_RANDOM_BYTES);
+    memcpy(input + ML_KEM_RANDOM_BYTES, key->pkhash, ML_KEM_PKHASH_BYTES);
+    hash_g(Kr, input, sizeof(input));
+    encrypt_cpa(ctext, entropy, Kr + ML_KEM_SHARED_SECRET_BYTES, key);
+    memcpy(shared_secret, Kr, ML_KEM_SHARED_SECRET_BYTES);
+
+    OPENSSL_cleanse(input, sizeof(input));
+    OPENSSL_cleanse(Kr, sizeof(Kr));
+    return 1;
+}
+
+int ossl_ml_kem_encap_rand(uint8_t *ctext, size_t clen,
+                           uint8_t *shared_secret, size_t slen,
+                           const ML_KEM_KEY *key)
+{
+    uint8_t m[ML_KEM_RANDOM_BYTES];
+    int ret;
+
+    if (!ossl_ml_kem_have_pubkey(key)
+        || RAND_bytes_ex(key->libctx, m, sizeof(m), 0) <= 0)
+        return 0;
+    ret = ossl_ml_kem_encap_seed(ctext, clen, shared_secret, slen,
+                                 m, sizeof(m), key);
+    OPENSSL_cleanse(m, sizeof(m));
+    return ret;
+}
+
+/*
+ * ML-KEM.Decaps_internal (FIPS 203, algorithm 18).  A ciphertext that does
+ * not re-encrypt to itself yields the implicit rejection key J(z || c), and
+ * the choice between the two is made in constant time.
+ */
+int ossl_ml_kem_decap(uint8_t *shared_secret, size_t slen,
+                      const uint8_t *ctext, size_t clen,
+                      const ML_KEM_KEY *key)
+{
+    uint8_t input[32 + ML_KEM_PKHASH_BYTES];
+    uint8_t Kr[ML_KEM_SHARED_SECRET_BYTES + ML_KEM_RANDOM_BYTES];
+    uint8_t failure_key[ML_KEM_SHARED_SECRET_BYTES];
+    uint8_t tmp_ctext[MAX_CTEXT_BYTES];
+    unsigned char mask;
+    size_t i;
+
+    if (!ossl_ml_kem_have_prvkey(key)
+        || clen != key->vinfo->ctext_bytes
+        || slen != ML_KEM_SHARED_SECRET_BYTES)
+        return 0;
+
+    decrypt_cpa(input, ctext, key);
+    memcpy(input + 32, key->pkhash, ML_KEM_PKHASH_BYTES);
+    hash_g(Kr, input, sizeof(input));
+    encrypt_cpa(tmp_ctext, input, Kr + ML_KEM_SHARED_SECRET_BYTES, key);
+    kdf_j(failure_key, key->z, ctext, clen);
+
+    mask = constant_time_is_zero_8(CRYPTO_memcmp(ctext, tmp_ctext, clen));
+    for (i = 0; i < ML_KEM_SHARED_SECRET_BYTES; i++)
+        shared_secret[i] = constant_time_select_8(mask, Kr[i], failure_key[i]);
+
+    OPENSSL_cleanse(input, sizeof(input));
+    OPENSSL_cleanse(Kr, sizeof(Kr));
+    OPENSSL_cleanse(failure_key, sizeof(failure_key));
+    OPENSSL_cleanse(tmp_ctext, sizeof(tmp_ctext));
+    return 1;
+}
@@ -21,7 +21,10 @@
 #ifndef FIPS_MODULE
 # include <openssl/x509.h>
 # include <crypto/asn1.h>
+# include <crypto/asn1_dsa.h>
+# include <internal/packet.h>
 #endif
+#include <internal/nelem.h>
 #include <internal/sizes.h>
 #include <internal/param_build_set.h>
 #include <crypto/rsa.h>
@@ -673,6 +676,56 @@ int ossl_rsa_param_decode(RSA *rsa, const X509_ALGOR *alg)
     return 1;
 }
 
+/*
+ * d2i_RSAPrivateKey() for a DER encoded two-prime key, with the INTEGERs
+ * read straight into the BIGNUMs of the key rather than going through the
+ * ASN.1 template decoder.  Anything else, such as a multi-prime key or an
+ * encoding that isn't DER, is left to d2i_RSAPrivateKey().
+ */
+RSA *ossl_rsa_d2i_private_key(RSA **a, const unsigned char **pp, long len)
+{
+    BIGNUM *bn[8] = { NULL };
+    PACKET pkt, seq;
+    unsigned int tag;
+    unsigned long version;
+    RSA *rsa = NULL;
+    int i, ok;
+
+    if (a != NULL || len <= 0)
+        return d2i_RSAPrivateKey(a, pp, len);
+
+    ok = PACKET_buf_init(&pkt, *pp, (size_t)len)
+         && PACKET_get_1(&pkt, &tag)
+         && tag == (V_ASN1_SEQUENCE | V_ASN1_CONSTRUCTED)
+         && ossl_decode_der_length(&pkt, &seq)
+         /* INTEGER 0, for a two-prime key */
+         && PACKET_get_net_3(&seq, &version)
+         && version == 0x020100;
+    /* n and e, then d, p, q, dmp1, dmq1 and iqmp, which are kept secure */
+    for (i = 0; ok && i < (int)OSSL_NELEM(bn); i++) {
+        bn[i] = i < 2 ? BN_new() : BN_secure_new();
+        ok = bn[i] != NULL && ossl_decode_der_integer(&seq, bn[i]);
+        if (ok && i >= 2)
+            BN_set_flags(bn[i], BN_FLG_CONSTTIME);
+    }
+    if (!ok || PACKET_remaining(&seq) != 0 || (rsa = RSA_new()) == NULL) {
+        for (i = 0; i < (int)OSSL_NELEM(bn); i++)
+            BN_clear_free(bn[i]);
+        return d2i_RSAPrivateKey(NULL, pp, len);
+    }
+
+    rsa->n = bn[0];
+    rsa->e = bn[1];
+    rsa->d = bn[2];
+    rsa->p = bn[3];
+    rsa->q = bn[4];
+    rsa->dmp1 = bn[5];
+    rsa->dmq1 = bn[6];
+    rsa->iqmp = bn[7];
+    *pp = PACKET_data(&pkt);
+    return rsa;
+}
+
 RSA *ossl_rsa_key_from_pkcs8(const PKCS8_PRIV_KEY_INFO *p8inf,
                              OSSL_LIB_CTX *libctx, const char *propq)
 {
@@ -683,7 +736,7 @@ RSA *ossl_rsa_key_from_pkcs8(const PKCS8_PRIV_KEY_INFO *p8inf,
 
     if (!PKCS8_pkey_get0(NULL, &p, &pklen, &alg, p8inf))
         return 0;
-    rsa = d2i_RSAPrivateKey(NULL, &p, pklen);
+    rsa = ossl_rsa_d2i_private_key(NULL, &p, pklen);
     if (rsa == NULL) {
         ERR_raise(ERR_LIB_RSA, ERR_R_RSA_LIB);
         return NULL;
@@ -114,6 +114,17 @@ static BIGNUM *rsa_get_public_exp(const BIGNUM *d, const BIGNUM *p,
 }
 
 BN_BLINDING *RSA_setup_blinding(RSA *rsa, BN_CTX *in_ctx)
+{
+    return ossl_rsa_setup_blinding(rsa, rsa->_method_mod_n, in_ctx);
+}
+
+/*
+ * Sets up a blinding using |mont| for rsa->n.  Another thread may be
+ * setting rsa->_method_mod_n, so callers that don't hold rsa->lock read it
+ * under the lock and pass it in.
+ */
+BN_BLINDING *ossl_rsa_setup_blinding(RSA *rsa, BN_MONT_CTX *mont,
+                                     BN_CTX *in_ctx)
 {
     BIGNUM *e;
     BN_CTX *ctx;
@@ -153,7 +164,7 @@ BN_BLINDING *RSA_setup_blinding(RSA *rsa, BN_CTX *in_ctx)
         BN_with_flags(n, rsa->n, BN_FLG_CONSTTIME);
 
         ret = BN_BLINDING_create_param(NULL, e, n, ctx, rsa->meth->bn_mod_exp,
-                                       rsa->_method_mod_n);
+                                       mont);
         /* We MUST free n before any further use of rsa->n */
         BN_free(n);
     }
@@ -173,3 +184,35 @@ BN_BLINDING *RSA_setup_blinding(RSA *rsa, BN_CTX *in_ctx)
 
     return ret;
 }
+
+RSA_BLINDING_SHARD *ossl_rsa_blinding_pool_new(void)
+{
+    RSA_BLINDING_SHARD *pool;
+    int i;
+
+    pool = OPENSSL_zalloc(RSA_BLINDING_SHARDS * sizeof(*pool));
+    if (pool == NULL)
+        return NULL;
+    for (i = 0; i < RSA_BLINDING_SHARDS; i++) {
+        pool[i].lock = CRYPTO_THREAD_lock_new();
+        pool[i].free = sk_BN_BLINDING_new_null();
+        if (pool[i].lock == NULL || pool[i].free == NULL) {
+            ossl_rsa_blinding_pool_free(pool);
+            return NULL;
+        }
+    }
+    return pool;
+}
+
+void ossl_rsa_blinding_pool_free(RSA_BLINDING_SHARD *pool)
+{
+    int i;
+
+    if (pool == NULL)
+        return;
+    for (i = 0; i < RSA_BLINDING_SHARDS; i++) {
+        CRYPTO_THREAD_lock_free(pool[i].lock);
+        sk_BN_BLINDING_pop_free(pool[i].free, BN_BLINDING_free);
+    }
+    OPENSSL_free(pool);
+}
@@ -24,6 +24,7 @@
 #include <internal/cryptlib.h>
 #include <openssl/bn.h>
 #include <openssl/self_test.h>
+#include <crypto/bn.h>
 #include <providers/providercommon.h>
 #include "rsa_local.h"
 
@@ -222,8 +223,8 @@ int ossl_rsa_multiprime_derive(RSA *rsa, int bits, int primes,
     if (iqmp == NULL)
         goto err;
 
-    if (BN_mod_inverse(iqmp, sk_BIGNUM_value(factors, 1),
-                       sk_BIGNUM_value(factors, 0), ctx) == NULL)
+    if (!ossl_bn_mod_inverse_consttime(iqmp, sk_BIGNUM_value(factors, 1),
+                                       sk_BIGNUM_value(factors, 0), ctx))
         goto err;
     if (!sk_BIGNUM_insert(coeffs, iqmp, sk_BIGNUM_num(coeffs)))
         goto err;
@@ -234,8 +235,8 @@ int ossl_rsa_multiprime_derive(RSA *rsa, int bits, int primes,
         newcoeff = BN_new();
         if (newcoeff == NULL)
             goto err;
-        if (BN_mod_inverse(newcoeff, newpp, sk_BIGNUM_value(factors, i),
-                           ctx) == NULL) {
+        if (!ossl_bn_mod_inverse_consttime(newcoeff, newpp,
+                                           sk_BIGNUM_value(factors, i), ctx)) {
             BN_free(newcoeff);
             goto err;
         }
@@ -548,9 +549,8 @@ static int rsa_multiprime_keygen(RSA *rsa, int bits, int primes,
 
 
     BN_set_flags(r0, BN_FLG_CONSTTIME);
-    if (BN_mod_inverse(rsa->d, rsa->e, r0, ctx) == NULL) {
+    if (!ossl_bn_mod_inverse_consttime(rsa->d, rsa->e, r0, ctx))
         goto err;               /* d */
-    }
 
     /* derive any missing exponents and coefficients */
     if (!ossl_rsa_multiprime_derive(rsa, bits, primes, e_value,
@@ -176,7 +176,7 @@ void RSA_free(RSA *r)
     sk_RSA_PRIME_INFO_pop_free(r->prime_infos, ossl_rsa_multip_info_free);
 #endif
     BN_BLINDING_free(r->blinding);
-    BN_BLINDING_free(r->mt_blinding);
+    ossl_rsa_blinding_pool_free(r->blinding_pool);
     OPENSSL_free(r);
 }
 
@@ -26,6 +26,19 @@ typedef struct rsa_prime_info_st {
 
 DECLARE_ASN1_ITEM(RSA_PRIME_INFO)
 DEFINE_STACK_OF(RSA_PRIME_INFO)
+DEFINE_STACK_OF(BN_BLINDING)
+
+/*
+ * The blindings that threads borrow are spread over this many separately
+ * locked free lists, picked by thread id, so that threads signing with the
+ * same key rarely wait for one another.
+ */
+#define RSA_BLINDING_SHARDS     16
+
+typedef struct {
+    CRYPTO_RWLOCK *lock;
+    STACK_OF(BN_BLINDING) *free;
+} RSA_BLINDING_SHARD;
 
 #if defined(FIPS_MODULE) && !defined(OPENSSL_NO_ACVP_TESTS)
 struct rsa_acvp_test_st {
@@ -94,7 +107,11 @@ struct rsa_st {
     BN_MONT_CTX *_method_mod_p;
     BN_MONT_CTX *_method_mod_q;
     BN_BLINDING *blinding;
-    BN_BLINDING *mt_blinding;
+    /*
+     * RSA_BLINDING_SHARDS free lists of blindings for threads other than
+     * the owner of |blinding| to borrow
+     */
+    RSA_BLINDING_SHARD *blinding_pool;
     CRYPTO_RWLOCK *lock;
 
     int dirty_cnt;
@@ -150,6 +167,10 @@ struct rsa_meth_st {
 /* Macros to test if a pkey or ctx is for a PSS key */
 #define pkey_is_pss(pkey) (pkey->ameth->pkey_id == EVP_PKEY_RSA_PSS)
 #define pkey_ctx_is_pss(ctx) (ctx->pmeth->pkey_id == EVP_PKEY_RSA_PSS)
+BN_BLINDING *ossl_rsa_setup_blinding(RSA *rsa, BN_MONT_CTX *mont,
+                                     BN_CTX *in_ctx);
+RSA_BLINDING_SHARD *ossl_rsa_blinding_pool_new(void);
+void ossl_rsa_blinding_pool_free(RSA_BLINDING_SHARD *pool);
 int ossl_rsa_multiprime_derive(RSA *rsa, int bits, int primes,
                                  BIGNUM *e_value,
                                  STACK_OF(BIGNUM) *factors, STACK_OF(BIGNUM) *exps,
@@ -96,6 +96,30 @@ const RSA_METHOD *RSA_null_method(void)
     return NULL;
 }
 
+/*
+ * r = f^e mod n.  Public exponents are nearly always small and odd, 65537
+ * above all, and those get a square-and-multiply chain on the cached
+ * Montgomery context rather than the general sliding window exponentiation.
+ */
+static int rsa_ossl_public_mod_exp(BIGNUM *r, const BIGNUM *f, RSA *rsa,
+                                   BN_CTX *ctx)
+{
+    if (rsa->flags & RSA_FLAG_CACHE_PUBLIC)
+        if (!BN_MONT_CTX_set_locked(&rsa->_method_mod_n, rsa->lock,
+                                    rsa->n, ctx))
+            return 0;
+
+    if (rsa->meth->bn_mod_exp == BN_mod_exp_mont
+            && rsa->_method_mod_n != NULL
+            && BN_num_bits(rsa->e) <= BN_BITS2
+            && BN_is_odd(rsa->e) && !BN_is_one(rsa->e))
+        return ossl_bn_mod_exp_mont_word_exp(r, f, BN_get_word(rsa->e),
+                                             rsa->_method_mod_n, ctx);
+
+    return rsa->meth->bn_mod_exp(r, f, rsa->e, rsa->n, ctx,
+                                 rsa->_method_mod_n);
+}
+
 static int rsa_ossl_public_encrypt(int flen, const unsigned char *from,
                                   unsigned char *to, RSA *rsa, int padding)
 {
@@ -161,13 +185,7 @@ static int rsa_ossl_public_encrypt(int flen, const unsigned char *from,
         goto err;
     }
 
-    if (rsa->flags & RSA_FLAG_CACHE_PUBLIC)
-        if (!BN_MONT_CTX_set_locked(&rsa->_method_mod_n, rsa->lock,
-                                    rsa->n, ctx))
-            goto err;
-
-    if (!rsa->meth->bn_mod_exp(ret, f, rsa->e, rsa->n, ctx,
-                               rsa->_method_mod_n))
+    if (!rsa_ossl_public_mod_exp(ret, f, rsa, ctx))
         goto err;
 
     /*
@@ -182,97 +200,133 @@ static int rsa_ossl_public_encrypt(int flen, const unsigned char *from,
     return r;
 }
 
-static BN_BLINDING *rsa_get_blinding(RSA *rsa, int *local, BN_CTX *ctx)
+/*
+ * Picks the shard of rsa->blinding_pool for the calling thread by an FNV-1a
+ * hash of its id. Thread ids are often addresses a fixed stride apart, so
+ * a weaker hash puts many threads on the same few shards.
+ */
+static RSA_BLINDING_SHARD *rsa_blinding_shard(RSA_BLINDING_SHARD *pool)
 {
-    BN_BLINDING *ret;
+    CRYPTO_THREAD_ID tid = CRYPTO_THREAD_get_current_id();
+    const unsigned char *p = (const unsigned char *)&tid;
+    uint32_t h = 2166136261U;
+    size_t i;
+
+    for (i = 0; i < sizeof(tid); i++)
+        h = (h ^ p[i]) * 16777619U;
+    return &pool[(h ^ (h >> 16)) % RSA_BLINDING_SHARDS];
+}
 
+/*
+ * Returns a blinding for the calling thread to use on its own. The first
+ * thread to use the key owns rsa->blinding. Any other thread borrows one
+ * from its shard of rsa->blinding_pool, setting up a new one if the shard
+ * is empty, and hands it back with rsa_put_blinding(). Once the pool is
+ * set up, a thread holds rsa->lock only as a reader and otherwise only the
+ * lock of its own shard, and neither while setting up a blinding.
+ */
+static BN_BLINDING *rsa_get_blinding(RSA *rsa, RSA_BLINDING_SHARD **shard,
+                                     BN_CTX *ctx)
+{
+    BN_BLINDING *ret = NULL;
+    RSA_BLINDING_SHARD *pool, *newpool = NULL;
+    BN_MONT_CTX *mont;
+    int owned;
+
+    *shard = NULL;
     if (!CRYPTO_THREAD_read_lock(rsa->lock))
         return NULL;
+    owned = rsa->blinding != NULL
+            && BN_BLINDING_is_current_thread(rsa->blinding);
+    if (owned)
+        ret = rsa->blinding;
+    pool = rsa->blinding_pool;
+    mont = rsa->_method_mod_n;
+    CRYPTO_THREAD_unlock(rsa->lock);
+    if (owned)
+        return ret;
 
-    if (rsa->blinding == NULL) {
+    if (pool == NULL) {
         /*
-         * This dance with upgrading the lock from read to write will be
-         * slower in cases of a single use RSA object, but should be
-         * significantly better in multi-thread cases (e.g. servers). It's
-         * probably worth it.
+         * The first use of the key. Whichever blinding and pool get
+         * installed first are kept, any others set up meanwhile are
+         * borrowed or freed.
          */
-        CRYPTO_THREAD_unlock(rsa->lock);
-        if (!CRYPTO_THREAD_write_lock(rsa->lock))
+        if ((ret = ossl_rsa_setup_blinding(rsa, mont, ctx)) == NULL)
             return NULL;
-        if (rsa->blinding == NULL)
-            rsa->blinding = RSA_setup_blinding(rsa, ctx);
+        if ((newpool = ossl_rsa_blinding_pool_new()) == NULL
+                || !CRYPTO_THREAD_write_lock(rsa->lock)) {
+            ossl_rsa_blinding_pool_free(newpool);
+            BN_BLINDING_free(ret);
+            return NULL;
+        }
+        if (rsa->blinding == NULL) {
+            rsa->blinding = ret;
+            owned = 1;
+        }
+        if (rsa->blinding_pool == NULL) {
+            rsa->blinding_pool = newpool;
+            newpool = NULL;
+        }
+        pool = rsa->blinding_pool;
+        CRYPTO_THREAD_unlock(rsa->lock);
+        ossl_rsa_blinding_pool_free(newpool);
+        if (!owned)
+            *shard = rsa_blinding_shard(pool);
+        return ret;
     }
 
-    ret = rsa->blinding;
-    if (ret == NULL)
-        goto err;
-
-    if (BN_BLINDING_is_current_thread(ret)) {
-        /* rsa->blinding is ours! */
-
-        *local = 1;
-    } else {
-        /* resort to rsa->mt_blinding instead */
-
-        /*
-         * instructs rsa_blinding_convert(), rsa_blinding_invert() that the
-         * BN_BLINDING is shared, meaning that accesses require locks, and
-         * that the blinding factor must be stored outside the BN_BLINDING
-         */
-        *local = 0;
-
-        if (rsa->mt_blinding == NULL) {
-            CRYPTO_THREAD_unlock(rsa->lock);
-            if (!CRYPTO_THREAD_write_lock(rsa->lock))
-                return NULL;
-            if (rsa->mt_blinding == NULL)
-                rsa->mt_blinding = RSA_setup_blinding(rsa, ctx);
-        }
-        ret = rsa->mt_blinding;
+    *shard = rsa_blinding_shard(pool);
+    if (CRYPTO_THREAD_write_lock((*shard)->lock)) {
+        ret = sk_BN_BLINDING_pop((*shard)->free);
+        CRYPTO_THREAD_unlock((*shard)->lock);
     }
 
- err:
-    CRYPTO_THREAD_unlock(rsa->lock);
+    /* An empty shard grows by one */
+    if (ret == NULL && (ret = ossl_rsa_setup_blinding(rsa, mont, ctx)) == NULL)
+        *shard = NULL;
     return ret;
 }
 
-static int rsa_blinding_convert(BN_BLINDING *b, BIGNUM *f, BIGNUM *unblind,
-                                BN_CTX *ctx)
+/*
+ * Readies |b| for its next use and, if it was borrowed from |shard|, hands
+ * it back. The update that the next use would start with is done here,
+ * after the result is computed and outside every lock, so a thread taking
+ * a blinding from the pool can use it straight away.
+ */
+static void rsa_put_blinding(BN_BLINDING *b, RSA_BLINDING_SHARD *shard,
+                             BN_CTX *ctx)
 {
-    if (unblind == NULL) {
-        /*
-         * Local blinding: store the unblinding factor in BN_BLINDING.
-         */
-        return BN_BLINDING_convert_ex(f, NULL, b, ctx);
+    int ok;
+
+    if (b == NULL)
+        return;
+    ok = ossl_bn_blinding_prepare(b, ctx);
+    if (shard == NULL)
+        return;
+    if (ok && CRYPTO_THREAD_write_lock(shard->lock)) {
+        ok = sk_BN_BLINDING_push(shard->free, b) > 0;
+        CRYPTO_THREAD_unlock(shard->lock);
     } else {
-        /*
-         * Shared blinding: store the unblinding factor outside BN_BLINDING.
-         */
-        int ret;
-
-        if (!BN_BLINDING_lock(b))
-            return 0;
-
-        ret = BN_BLINDING_convert_ex(f, unblind, b, ctx);
-        BN_BLINDING_unlock(b);
-
-        return ret;
+        ok = 0;
     }
+    if (!ok)
+        BN_BLINDING_free(b);
 }
 
-static int rsa_blinding_invert(BN_BLINDING *b, BIGNUM *f, BIGNUM *unblind,
-                               BN_CTX *ctx)
+/*
+ * A blinding is only ever used by one thread at a time, so the unblinding
+ * factor is kept in it.
+ */
+static int rsa_blinding_convert(BN_BLINDING *b, BIGNUM *f, BN_CTX *ctx)
+{
+    return BN_BLINDING_convert_ex(f, NULL, b, ctx);
+}
+
+static int rsa_blinding_invert(BN_BLINDING *b, BIGNUM *f, BN_CTX *ctx)
 {
-    /*
-     * For local blinding, unblind is set to NULL, and BN_BLINDING_invert_ex
-     * will use the unblinding factor stored in BN_BLINDING. If BN_BLINDING
-     * is shared between threads, unblind must be non-null:
-     * BN_BLINDING_invert_ex will then use the local unblinding factor, and
-     * will only read the modulus from BN_BLINDING. In both cases it's safe
-     * to access the blinding without a lock.
-     */
     BN_set_flags(f, BN_FLG_CONSTTIME);
-    return BN_BLINDING_invert_ex(f, unblind, b, ctx);
+    return BN_BLINDING_invert_ex(f, NULL, b, ctx);
 }
 
 /* signing */
@@ -283,13 +337,7 @@ static int rsa_ossl_private_encrypt(int flen, const unsigned char *from,
     int i, num = 0, r = -1;
     unsigned char *buf = NULL;
     BN_CTX *ctx = NULL;
-    int local_blinding = 0;
-    /*
-     * Used only if the blinding structure is shared. A non-NULL unblind
-     * instructs rsa_blinding_convert() and rsa_blinding_invert() to store
-     * the unblinding factor outside the blinding structure.
-     */
-    BIGNUM *unblind = NULL;
+    RSA_BLINDING_SHARD *blinding_shard = NULL;
     BN_BLINDING *blinding = NULL;
 
     if ((ctx = BN_CTX_new_ex(rsa->libctx)) == NULL)
@@ -334,21 +382,15 @@ static int rsa_ossl_private_encrypt(int flen, const unsigned char *from,
             goto err;
 
     if (!(rsa->flags & RSA_FLAG_NO_BLINDING)) {
-        blinding = rsa_get_blinding(rsa, &local_blinding, ctx);
+        blinding = rsa_get_blinding(rsa, &blinding_shard, ctx);
         if (blinding == NULL) {
             ERR_raise(ERR_LIB_RSA, ERR_R_INTERNAL_ERROR);
             goto err;
         }
     }
 
-    if (blinding != NULL) {
-        if (!local_blinding && ((unblind = BN_CTX_get(ctx)) == NULL)) {
-            ERR_raise(ERR_LIB_RSA, ERR_R_BN_LIB);
-            goto err;
-        }
-        if (!rsa_blinding_convert(blinding, f, unblind, ctx))
-            goto err;
-    }
+    if (blinding != NULL && !rsa_blinding_convert(blinding, f, ctx))
+        goto err;
 
     if ((rsa->flags & RSA_FLAG_EXT_PKEY) ||
         (rsa->version == RSA_ASN1_VERSION_MULTI) ||
@@ -380,7 +422,7 @@ static int rsa_ossl_private_encrypt(int flen, const unsigned char *from,
     }
 
     if (blinding)
-        if (!rsa_blinding_invert(blinding, ret, unblind, ctx))
+        if (!rsa_blinding_invert(blinding, ret, ctx))
             goto err;
 
     if (padding == RSA_X931_PADDING) {
@@ -400,6 +442,7 @@ static int rsa_ossl_private_encrypt(int flen, const unsigned char *from,
      */
     r = BN_bn2binpad(res, to, num);
  err:
+    rsa_put_blinding(blinding, blinding_shard, ctx);
     BN_CTX_end(ctx);
     BN_CTX_free(ctx);
     OPENSSL_clear_free(buf, num);
@@ -499,13 +542,7 @@ static int rsa_ossl_private_decrypt(int flen, const unsigned char *from,
     unsigned char *buf = NULL;
     unsigned char kdk[SHA256_DIGEST_LENGTH] = {0};
     BN_CTX *ctx = NULL;
-    int local_blinding = 0;
-    /*
-     * Used only if the blinding structure is shared. A non-NULL unblind
-     * instructs rsa_blinding_convert() and rsa_blinding_invert() to store
-     * the unblinding factor outside the blinding structure.
-     */
-    BIGNUM *unblind = NULL;
+    RSA_BLINDING_SHARD *blinding_shard = NULL;
     BN_BLINDING *blinding = NULL;
 
     /*
@@ -557,21 +594,15 @@ static int rsa_ossl_private_decrypt(int flen, const unsigned char *from,
             goto err;
 
     if (!(rsa->flags & RSA_FLAG_NO_BLINDING)) {
-        blinding = rsa_get_blinding(rsa, &local_blinding, ctx);
+        blinding = rsa_get_blinding(rsa, &blinding_shard, ctx);
         if (blinding == NULL) {
             ERR_raise(ERR_LIB_RSA, ERR_R_INTERNAL_ERROR);
             goto err;
         }
     }
 
-    if (blinding != NULL) {
-        if (!local_blinding && ((unblind = BN_CTX_get(ctx)) == NULL)) {
-            ERR_raise(ERR_LIB_RSA, ERR_R_BN_LIB);
-            goto err;
-        }
-        if (!rsa_blinding_convert(blinding, f, unblind, ctx))
-            goto err;
-    }
+    if (blinding != NULL && !rsa_blinding_convert(blinding, f, ctx))
+        goto err;
 
     /* do the decrypt */
     if ((rsa->flags & RSA_FLAG_EXT_PKEY) ||
@@ -603,7 +634,7 @@ static int rsa_ossl_private_decrypt(int flen, const unsigned char *from,
     }
 
     if (blinding)
-        if (!rsa_blinding_invert(blinding, ret, unblind, ctx))
+        if (!rsa_blinding_invert(blinding, ret, ctx))
             goto err;
 
     /*
@@ -647,6 +678,7 @@ static int rsa_ossl_private_decrypt(int flen, const unsigned char *from,
 #endif
 
  err:
+    rsa_put_blinding(blinding, blinding_shard, ctx);
     BN_CTX_end(ctx);
     BN_CTX_free(ctx);
     OPENSSL_clear_free(buf, num);
@@ -711,13 +743,7 @@ static int rsa_ossl_public_decrypt(int flen, const unsigned char *from,
         goto err;
     }
 
-    if (rsa->flags & RSA_FLAG_CACHE_PUBLIC)
-        if (!BN_MONT_CTX_set_locked(&rsa->_method_mod_n, rsa->lock,
-                                    rsa->n, ctx))
-            goto err;
-
-    if (!rsa->meth->bn_mod_exp(ret, f, rsa->e, rsa->n, ctx,
-                               rsa->_method_mod_n))
+    if (!rsa_ossl_public_mod_exp(ret, f, rsa, ctx))
         goto err;
 
     if ((padding == RSA_X931_PADDING) && ((bn_get_words(ret)[0] & 0xf) != 12))
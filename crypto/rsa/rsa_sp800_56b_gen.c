@@ -15,11 +15,44 @@
 #include <openssl/rand.h>
 #include <crypto/bn.h>
 #include <crypto/security_bits.h>
+#include <internal/thread.h>
 #include "rsa_local.h"
 
 #define RSA_FIPS1864_MIN_KEYGEN_KEYSIZE 2048
 #define RSA_FIPS1864_MIN_KEYGEN_STRENGTH 112
 
+#if defined(OPENSSL_NO_DEFAULT_THREAD_POOL) && defined(OPENSSL_NO_THREAD_POOL)
+# define RSA_NO_KEYGEN_THREADS
+#endif
+
+#if !defined(OPENSSL_THREADS) || defined(FIPS_MODULE)
+# define RSA_NO_KEYGEN_THREADS
+#endif
+
+#ifndef RSA_NO_KEYGEN_THREADS
+typedef struct {
+    OSSL_LIB_CTX *libctx;
+    BIGNUM *q, *Xqo;
+    int nbits;
+    const BIGNUM *e;
+    int ret;
+} RSA_GEN_Q_JOB;
+
+/* Generates q and Xq on a thread of the pool, without a callback */
+static uint32_t rsa_gen_q_thr(void *data)
+{
+    RSA_GEN_Q_JOB *job = data;
+    BN_CTX *ctx = BN_CTX_new_ex(job->libctx);
+
+    job->ret = ctx != NULL
+        && ossl_bn_rsa_fips186_4_gen_prob_primes(job->q, job->Xqo, NULL, NULL,
+                                                 NULL, NULL, NULL, job->nbits,
+                                                 job->e, ctx, NULL);
+    BN_CTX_free(ctx);
+    return 1;
+}
+#endif
+
 /*
  * Generate probable primes 'p' & 'q'. See FIPS 186-4 Section B.3.6
  * "Generation of Probable Primes with Conditions Based on Auxiliary Probable
@@ -56,7 +89,7 @@ int ossl_rsa_fips186_4_gen_prob_primes(RSA *rsa, RSA_ACVP_TEST *test,
                                        int nbits, const BIGNUM *e, BN_CTX *ctx,
                                        BN_GENCB *cb)
 {
-    int ret = 0, ok;
+    int ret = 0, ok, have_q = 0;
     /* Temp allocated BIGNUMS */
     BIGNUM *Xpo = NULL, *Xqo = NULL, *tmp = NULL;
     /* Intermediate BIGNUMS that can be returned for testing */
@@ -65,6 +98,10 @@ int ossl_rsa_fips186_4_gen_prob_primes(RSA *rsa, RSA_ACVP_TEST *test,
     /* Intermediate BIGNUMS that can be input for testing */
     BIGNUM *Xp = NULL, *Xp1 = NULL, *Xp2 = NULL;
     BIGNUM *Xq = NULL, *Xq1 = NULL, *Xq2 = NULL;
+#ifndef RSA_NO_KEYGEN_THREADS
+    RSA_GEN_Q_JOB job;
+    void *thread = NULL;
+#endif
 
 #if defined(FIPS_MODULE) && !defined(OPENSSL_NO_ACVP_TESTS)
     if (test != NULL) {
@@ -118,14 +155,40 @@ int ossl_rsa_fips186_4_gen_prob_primes(RSA *rsa, RSA_ACVP_TEST *test,
     BN_set_flags(rsa->p, BN_FLG_CONSTTIME);
     BN_set_flags(rsa->q, BN_FLG_CONSTTIME);
 
+#ifndef RSA_NO_KEYGEN_THREADS
+    /*
+     * q doesn't depend on p until Step 6, so if the pool has a thread to
+     * spare, the first q is generated there while this thread works on p.
+     * If it can't be, q is generated below as usual.
+     */
+    if (test == NULL && ossl_get_avail_threads(rsa->libctx) > 0) {
+        job.libctx = rsa->libctx;
+        job.q = rsa->q;
+        job.Xqo = Xqo;
+        job.nbits = nbits;
+        job.e = e;
+        job.ret = 0;
+        thread = ossl_crypto_thread_start(rsa->libctx, &rsa_gen_q_thr, &job);
+    }
+#endif
+
     /* (Step 4) Generate p, Xp */
-    if (!ossl_bn_rsa_fips186_4_gen_prob_primes(rsa->p, Xpo, p1, p2, Xp, Xp1, Xp2,
-                                               nbits, e, ctx, cb))
+    ok = ossl_bn_rsa_fips186_4_gen_prob_primes(rsa->p, Xpo, p1, p2, Xp, Xp1,
+                                               Xp2, nbits, e, ctx, cb);
+#ifndef RSA_NO_KEYGEN_THREADS
+    if (thread != NULL) {
+        have_q = ossl_crypto_thread_join(thread, NULL) && job.ret;
+        ossl_crypto_thread_clean(thread);
+    }
+#endif
+    if (!ok)
         goto err;
-    for (;;) {
+    for (;; have_q = 0) {
         /* (Step 5) Generate q, Xq*/
-        if (!ossl_bn_rsa_fips186_4_gen_prob_primes(rsa->q, Xqo, q1, q2, Xq, Xq1,
-                                                   Xq2, nbits, e, ctx, cb))
+        if (!have_q
+                && !ossl_bn_rsa_fips186_4_gen_prob_primes(rsa->q, Xqo, q1, q2,
+                                                          Xq, Xq1, Xq2, nbits,
+                                                          e, ctx, cb))
             goto err;
 
         /* (Step 6) |Xp - Xq| > 2^(nbitlen/2 - 100) */
@@ -270,7 +333,7 @@ int ossl_rsa_sp800_56b_derive_params_from_pq(RSA *rsa, int nbits,
         if (rsa->d == NULL)
             goto err;
         BN_set_flags(rsa->d, BN_FLG_CONSTTIME);
-        if (BN_mod_inverse(rsa->d, e, lcm, ctx) == NULL)
+        if (!ossl_bn_mod_inverse_consttime(rsa->d, e, lcm, ctx))
             goto err;
 
         /* (Step 3) return an error if d is too small */
@@ -310,7 +373,7 @@ int ossl_rsa_sp800_56b_derive_params_from_pq(RSA *rsa, int nbits,
     if (rsa->iqmp == NULL)
         goto err;
     BN_set_flags(rsa->iqmp, BN_FLG_CONSTTIME);
-    if (BN_mod_inverse(rsa->iqmp, rsa->q, rsa->p, ctx) == NULL)
+    if (!ossl_bn_mod_inverse_consttime(rsa->iqmp, rsa->q, rsa->p, ctx))
         goto err;
 
     rsa->dirty_cnt++;
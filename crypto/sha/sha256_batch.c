@@ -0,0 +1,381 @@
+/*
+ * Copyright 2024 The OpenSSL Project Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License 2.0 (the "License").  You may not use
+ * this file except in compliance with the License.  You can obtain a copy
+ * in the file LICENSE in the source distribution or at
+ * https://www.openssl.org/source/license.html
+ */
+
+/*
+ * SHA256 low level APIs are deprecated for public use, but still ok for
+ * internal use.
+ */
+#include <internal/deprecated.h>
+
+#include <string.h>
+#include <openssl/crypto.h>
+#include <openssl/sha.h>
+#include <crypto/sha.h>
+
+static void sha256_one(const unsigned char *in, size_t inl, unsigned char *out)
+{
+    SHA256_CTX c;
+
+    SHA256_Init(&c);
+    SHA256_Update(&c, in, inl);
+    SHA256_Final(out, &c);
+    OPENSSL_cleanse(&c, sizeof(c));
+}
+
+/*
+ * The second block of both HMAC hashes in a PBKDF2 iteration is a digest,
+ * so it is the digest followed by the same padding every time.
+ */
+static void chain_pad(unsigned char *blk)
+{
+    memset(blk + SHA256_DIGEST_LENGTH, 0,
+           SHA256_CBLOCK - SHA256_DIGEST_LENGTH);
+    blk[SHA256_DIGEST_LENGTH] = 0x80;
+    /* The length in bits of the key block and the digest, 0x300 */
+    blk[SHA256_CBLOCK - 2] = 0x03;
+}
+
+static void chain_put(unsigned char *blk, const SHA_LONG h[8])
+{
+    int k;
+
+    for (k = 0; k < 8; k++) {
+        blk[4 * k] = (unsigned char)(h[k] >> 24);
+        blk[4 * k + 1] = (unsigned char)(h[k] >> 16);
+        blk[4 * k + 2] = (unsigned char)(h[k] >> 8);
+        blk[4 * k + 3] = (unsigned char)h[k];
+    }
+}
+
+static void sha256_hmac_chain_one(SHA256_HMAC_CHAIN *c, uint64_t iter)
+{
+    SHA256_CTX ctx;
+    unsigned char blk[SHA256_CBLOCK];
+    uint64_t j;
+    int k;
+
+    chain_pad(blk);
+    for (j = 0; j < iter; j++) {
+        chain_put(blk, c->u);
+        memcpy(ctx.h, c->ipad, sizeof(ctx.h));
+        SHA256_Transform(&ctx, blk);
+        chain_put(blk, ctx.h);
+        memcpy(ctx.h, c->opad, sizeof(ctx.h));
+        SHA256_Transform(&ctx, blk);
+        for (k = 0; k < 8; k++) {
+            c->u[k] = ctx.h[k];
+            c->t[k] ^= ctx.h[k];
+        }
+    }
+    OPENSSL_cleanse(&ctx, sizeof(ctx));
+    OPENSSL_cleanse(blk, sizeof(blk));
+}
+
+#ifdef SHA256_MB_ASM
+
+/*
+ * The x86_64 multi-buffer kernel hashes eight independent streams at once,
+ * using AVX2 when it can, or SSE or SHA-NI on four or two lanes at a time.
+ * The state is kept transposed, one word of every lane per row.
+ */
+typedef struct {
+    unsigned int A[8], B[8], C[8], D[8], E[8], F[8], G[8], H[8];
+} SHA256_MB_CTX;
+
+typedef struct {
+    const unsigned char *ptr;
+    int blocks;
+} HASH_DESC;
+
+void sha256_multi_block(SHA256_MB_CTX *, const HASH_DESC *, int);
+
+# define MB_LANES       8
+/* Blocks given to a lane per call, so that finished lanes get refilled */
+# define MB_CHUNK       16
+/* Messages up to this size are copied and hashed with one call */
+# define MB_COPY_MAX    (4 * SHA256_CBLOCK)
+
+typedef struct {
+    size_t msg;                 /* Index of the message in this lane */
+    const unsigned char *ptr;   /* Next full block of the message body */
+    size_t blocks;              /* Full blocks of the body left to do */
+    int tail_blocks;            /* 0 while the body is being hashed */
+    int busy;
+    unsigned char tail[MB_COPY_MAX + 2 * SHA256_CBLOCK];
+} MB_LANE;
+
+static const SHA_LONG sha256_iv[8] = {
+    0x6a09e667UL, 0xbb67ae85UL, 0x3c6ef372UL, 0xa54ff53aUL,
+    0x510e527fUL, 0x9b05688cUL, 0x1f83d9abUL, 0x5be0cd19UL
+};
+
+static void mb_set_words(SHA256_MB_CTX *mctx, int i, const SHA_LONG h[8])
+{
+    mctx->A[i] = h[0];
+    mctx->B[i] = h[1];
+    mctx->C[i] = h[2];
+    mctx->D[i] = h[3];
+    mctx->E[i] = h[4];
+    mctx->F[i] = h[5];
+    mctx->G[i] = h[6];
+    mctx->H[i] = h[7];
+}
+
+static void mb_get_words(const SHA256_MB_CTX *mctx, int i, SHA_LONG h[8])
+{
+    h[0] = mctx->A[i];
+    h[1] = mctx->B[i];
+    h[2] = mctx->C[i];
+    h[3] = mctx->D[i];
+    h[4] = mctx->E[i];
+    h[5] = mctx->F[i];
+    h[6] = mctx->G[i];
+    h[7] = mctx->H[i];
+}
+
+static void mb_set_state(SHA256_MB_CTX *mctx, int i)
+{
+    mb_set_words(mctx, i, sha256_iv);
+}
+
+static void mb_move_state(SHA256_MB_CTX *mctx, int to, int from)
+{
+    mctx->A[to] = mctx->A[from];
+    mctx->B[to] = mctx->B[from];
+    mctx->C[to] = mctx->C[from];
+    mctx->D[to] = mctx->D[from];
+    mctx->E[to] = mctx->E[from];
+    mctx->F[to] = mctx->F[from];
+    mctx->G[to] = mctx->G[from];
+    mctx->H[to] = mctx->H[from];
+}
+
+static void mb_put_word(unsigned char *out, unsigned int w)
+{
+    out[0] = (unsigned char)(w >> 24);
+    out[1] = (unsigned char)(w >> 16);
+    out[2] = (unsigned char)(w >> 8);
+    out[3] = (unsigned char)w;
+}
+
+static void mb_get_digest(const SHA256_MB_CTX *mctx, int i, unsigned char *out)
+{
+    mb_put_word(out, mctx->A[i]);
+    mb_put_word(out + 4, mctx->B[i]);
+    mb_put_word(out + 8, mctx->C[i]);
+    mb_put_word(out + 12, mctx->D[i]);
+    mb_put_word(out + 16, mctx->E[i]);
+    mb_put_word(out + 20, mctx->F[i]);
+    mb_put_word(out + 24, mctx->G[i]);
+    mb_put_word(out + 28, mctx->H[i]);
+}
+
+/*
+ * Loads message |msg| into |lane|.  A short message is copied whole into
+ * the lane's buffer with its padding, otherwise the body is hashed in
+ * place and only the last partial block and the padding are copied.
+ */
+static void mb_load(MB_LANE *lane, size_t msg, const unsigned char *in,
+                    size_t inl)
+{
+    size_t body = inl <= MB_COPY_MAX ? 0 : inl / SHA256_CBLOCK;
+    size_t rest = inl - body * SHA256_CBLOCK;
+    size_t padded = (rest + 1 + 8 + SHA256_CBLOCK - 1) & ~(size_t)(SHA256_CBLOCK - 1);
+    uint64_t bits = (uint64_t)inl << 3;
+    int j;
+
+    lane->msg = msg;
+    lane->ptr = in;
+    lane->blocks = body;
+    lane->tail_blocks = 0;
+    lane->busy = 1;
+    memcpy(lane->tail, in + body * SHA256_CBLOCK, rest);
+    lane->tail[rest] = 0x80;
+    memset(lane->tail + rest + 1, 0, padded - rest - 1);
+    for (j = 0; j < 8; j++)
+        lane->tail[padded - 1 - j] = (unsigned char)(bits >> (8 * j));
+    if (body == 0)
+        lane->tail_blocks = (int)(padded / SHA256_CBLOCK);
+}
+
+static void sha256_batch_mb(size_t n, const unsigned char *const *in,
+                            const size_t *inl, unsigned char *const *out)
+{
+    unsigned char storage[sizeof(SHA256_MB_CTX) + 32];
+    SHA256_MB_CTX *mctx;
+    MB_LANE lanes[MB_LANES];
+    HASH_DESC desc[MB_LANES];
+    size_t next = 0;
+    int i, j, active;
+
+    mctx = (SHA256_MB_CTX *)(storage + 32 - ((size_t)storage % 32));
+    for (i = 0; i < MB_LANES; i++)
+        lanes[i].busy = 0;
+
+    for (;;) {
+        for (i = 0; i < MB_LANES && next < n; i++) {
+            if (!lanes[i].busy) {
+                mb_load(&lanes[i], next, in[next], inl[next]);
+                mb_set_state(mctx, i);
+                next++;
+            }
+        }
+
+        /*
+         * The SHA-NI code stops at the first pair of idle lanes, so once
+         * there is nothing left to refill them with, the busy lanes are
+         * moved down to keep them together at the front.
+         */
+        for (i = 0, j = MB_LANES - 1; ; i++, j--) {
+            while (i < MB_LANES && lanes[i].busy)
+                i++;
+            while (j >= 0 && !lanes[j].busy)
+                j--;
+            if (i >= j)
+                break;
+            lanes[i] = lanes[j];
+            lanes[j].busy = 0;
+            mb_move_state(mctx, i, j);
+        }
+
+        active = 0;
+        for (i = 0; i < MB_LANES; i++) {
+            MB_LANE *lane = &lanes[i];
+
+            if (!lane->busy) {
+                /* The kernel skips lanes with no blocks */
+                desc[i].ptr = lane->tail;
+                desc[i].blocks = 0;
+                continue;
+            }
+            active++;
+            if (lane->tail_blocks == 0) {
+                desc[i].ptr = lane->ptr;
+                desc[i].blocks = (int)(lane->blocks < MB_CHUNK
+                                       ? lane->blocks : MB_CHUNK);
+            } else {
+                desc[i].ptr = lane->tail;
+                desc[i].blocks = lane->tail_blocks;
+            }
+        }
+        if (active == 0)
+            break;
+
+        sha256_multi_block(mctx, desc, 2);
+
+        for (i = 0; i < MB_LANES; i++) {
+            MB_LANE *lane = &lanes[i];
+
+            if (!lane->busy)
+                continue;
+            if (lane->tail_blocks != 0) {
+                mb_get_digest(mctx, i, out[lane->msg]);
+                lane->busy = 0;
+                continue;
+            }
+            lane->ptr += (size_t)desc[i].blocks * SHA256_CBLOCK;
+            lane->blocks -= desc[i].blocks;
+            if (lane->blocks == 0) {
+                size_t rest = inl[lane->msg] % SHA256_CBLOCK;
+
+                lane->tail_blocks = rest + 1 + 8 > SHA256_CBLOCK ? 2 : 1;
+            }
+        }
+    }
+
+    OPENSSL_cleanse(storage, sizeof(storage));
+    OPENSSL_cleanse(lanes, sizeof(lanes));
+}
+
+/*
+ * All the chains do the same number of iterations, so up to eight of them
+ * go through the kernel in lockstep, one block each per call.
+ */
+static void sha256_hmac_chain_mb(SHA256_HMAC_CHAIN *c, int n, uint64_t iter)
+{
+    unsigned char storage[sizeof(SHA256_MB_CTX) + 32];
+    unsigned char blk[MB_LANES][SHA256_CBLOCK];
+    SHA256_MB_CTX *mctx;
+    HASH_DESC desc[MB_LANES];
+    uint64_t j;
+    int i, k;
+
+    mctx = (SHA256_MB_CTX *)(storage + 32 - ((size_t)storage % 32));
+    for (i = 0; i < MB_LANES; i++) {
+        chain_pad(blk[i]);
+        desc[i].ptr = blk[i];
+        desc[i].blocks = i < n;
+    }
+
+    for (j = 0; j < iter; j++) {
+        for (i = 0; i < n; i++) {
+            chain_put(blk[i], c[i].u);
+            mb_set_words(mctx, i, c[i].ipad);
+        }
+        sha256_multi_block(mctx, desc, 2);
+        for (i = 0; i < n; i++) {
+            mb_get_words(mctx, i, c[i].u);
+            chain_put(blk[i], c[i].u);
+            mb_set_words(mctx, i, c[i].opad);
+        }
+        sha256_multi_block(mctx, desc, 2);
+        for (i = 0; i < n; i++) {
+            mb_get_words(mctx, i, c[i].u);
+            for (k = 0; k < 8; k++)
+                c[i].t[k] ^= c[i].u[k];
+        }
+    }
+
+    OPENSSL_cleanse(storage, sizeof(storage));
+    OPENSSL_cleanse(blk, sizeof(blk));
+}
+#endif
+
+/*
+ * Computes the SHA-256 digest of each of the |n| messages |in[i]| of
+ * length |inl[i]| into |out[i]|.
+ */
+void ossl_sha256_batch(size_t n, const unsigned char *const *in,
+                       const size_t *inl, unsigned char *const *out)
+{
+    size_t i;
+
+#ifdef SHA256_MB_ASM
+    /* Below this there aren't enough messages to fill the lanes */
+    if (n >= 4) {
+        sha256_batch_mb(n, in, inl, out);
+        return;
+    }
+#endif
+    for (i = 0; i < n; i++)
+        sha256_one(in[i], inl[i], out[i]);
+}
+
+/*
+ * Runs |iter| PBKDF2 iterations on each of the |n| chains |c|: the HMAC of
+ * |u| replaces |u| and is XORed into |t|.
+ */
+void ossl_sha256_hmac_chain(SHA256_HMAC_CHAIN *c, size_t n, uint64_t iter)
+{
+#ifdef SHA256_MB_ASM
+    /*
+     * The kernel costs about as much for two or three chains as for four,
+     * which is when it starts to beat doing them one at a time.
+     */
+    while (n >= 4) {
+        int lanes = n < MB_LANES ? (int)n : MB_LANES;
+
+        sha256_hmac_chain_mb(c, lanes, iter);
+        c += lanes;
+        n -= lanes;
+    }
+#endif
+    for (; n > 0; n--, c++)
+        sha256_hmac_chain_one(c, iter);
+}
@@ -8,10 +8,17 @@
  */
 
 #include <string.h>
+#include <openssl/crypto.h>
 #include <internal/sha3.h>
 
 void SHA3_squeeze(uint64_t A[5][5], unsigned char *out, size_t len, size_t r, int next);
 
+#if defined(KECCAK1600_ASM) && (defined(__x86_64) || defined(_M_AMD64))
+# define KECCAK1600_X4_ASM
+void ossl_keccak1600_x4_avx2(uint64_t A[4][5][5]);
+int ossl_keccak1600_x4_avx2_eligible(void);
+#endif
+
 void ossl_sha3_reset(KECCAK1600_CTX *ctx)
 {
     memset(ctx->A, 0, sizeof(ctx->A));
@@ -199,3 +206,147 @@ int ossl_sha3_squeeze(KECCAK1600_CTX *ctx, unsigned char *out, size_t outlen)
 
     return 1;
 }
+
+/*
+ * Four-way sponges.  Without a four-way permutation each of the four
+ * states is run through SHA3_absorb() and SHA3_squeeze() in turn, so the
+ * results are the same either way.
+ */
+
+int ossl_sha3_init_x4(KECCAK1600_X4_CTX *ctx, unsigned char pad, size_t bitlen)
+{
+    size_t bsz = SHA3_BLOCKSIZE(bitlen);
+
+    if (bsz > KECCAK1600_WIDTH / 8 - 32)
+        return 0;
+    memset(ctx->A, 0, sizeof(ctx->A));
+    ctx->block_size = bsz;
+    ctx->pad = pad;
+    ctx->xof_state = XOF_STATE_INIT;
+#ifdef KECCAK1600_X4_ASM
+    ctx->x4 = ossl_keccak1600_x4_avx2_eligible();
+#else
+    ctx->x4 = 0;
+#endif
+    return 1;
+}
+
+/* XORs one block into each state and permutes them */
+static void sha3_absorb_block_x4(KECCAK1600_X4_CTX *ctx,
+                                 const unsigned char *const in[4],
+                                 size_t off)
+{
+    size_t bsz = ctx->block_size;
+    size_t l;
+
+#ifdef KECCAK1600_X4_ASM
+    if (ctx->x4) {
+        size_t i;
+
+        for (l = 0; l < 4; l++) {
+            const unsigned char *inp = in[l] + off;
+            uint64_t *A = &ctx->A[l][0][0];
+
+            for (i = 0; i < bsz / 8; i++, inp += 8)
+                A[i] ^=
+                    (uint64_t)inp[0] | (uint64_t)inp[1] << 8
+                    | (uint64_t)inp[2] << 16 | (uint64_t)inp[3] << 24
+                    | (uint64_t)inp[4] << 32 | (uint64_t)inp[5] << 40
+                    | (uint64_t)inp[6] << 48 | (uint64_t)inp[7] << 56;
+        }
+        ossl_keccak1600_x4_avx2(ctx->A);
+        return;
+    }
+#endif
+    for (l = 0; l < 4; l++)
+        (void)SHA3_absorb(ctx->A[l], in[l] + off, bsz, bsz);
+}
+
+/*
+ * Absorbs |len| bytes from each of |in|, and the padding.  This can only
+ * be done once, after which the sponges can only be squeezed.
+ */
+int ossl_sha3_absorb_x4(KECCAK1600_X4_CTX *ctx,
+                        const unsigned char *const in[4], size_t len)
+{
+    size_t bsz = ctx->block_size;
+    size_t off, rem, l;
+    unsigned char buf[4][KECCAK1600_WIDTH / 8 - 32];
+    const unsigned char *last[4];
+
+    if (ctx->xof_state != XOF_STATE_INIT)
+        return 0;
+
+    for (off = 0; len - off >= bsz; off += bsz)
+        sha3_absorb_block_x4(ctx, in, off);
+
+    /* Pad the data with 10*1, as in ossl_sha3_final() */
+    rem = len - off;
+    for (l = 0; l < 4; l++) {
+        memcpy(buf[l], in[l] + off, rem);
+        memset(buf[l] + rem, 0, bsz - rem);
+        buf[l][rem] = ctx->pad;
+        buf[l][bsz - 1] |= 0x80;
+        last[l] = buf[l];
+    }
+    sha3_absorb_block_x4(ctx, last, 0);
+    OPENSSL_cleanse(buf, sizeof(buf));
+
+    ctx->xof_state = XOF_STATE_ABSORB;
+    return 1;
+}
+
+/*
+ * Squeezes |outlen| bytes into each of |out|.  This can be called again
+ * to continue the output, as long as all calls but the last ask for a
+ * multiple of the block size.
+ */
+int ossl_sha3_squeeze_x4(KECCAK1600_X4_CTX *ctx, unsigned char *const out[4],
+                         size_t outlen)
+{
+    size_t bsz = ctx->block_size;
+    size_t off, len, l;
+    int next;
+
+    if (ctx->xof_state != XOF_STATE_ABSORB
+        && ctx->xof_state != XOF_STATE_SQUEEZE)
+        return 0;
+
+    for (off = 0; off < outlen; off += len) {
+        len = outlen - off < bsz ? outlen - off : bsz;
+        next = ctx->xof_state == XOF_STATE_SQUEEZE;
+#ifdef KECCAK1600_X4_ASM
+        if (ctx->x4) {
+            size_t i;
+
+            if (next)
+                ossl_keccak1600_x4_avx2(ctx->A);
+            for (l = 0; l < 4; l++) {
+                const uint64_t *A = &ctx->A[l][0][0];
+                unsigned char *outp = out[l] + off;
+
+                for (i = 0; i + 8 <= len; i += 8, outp += 8) {
+                    uint64_t w = A[i / 8];
+
+                    outp[0] = (unsigned char)w;
+                    outp[1] = (unsigned char)(w >> 8);
+                    outp[2] = (unsigned char)(w >> 16);
+                    outp[3] = (unsigned char)(w >> 24);
+                    outp[4] = (unsigned char)(w >> 32);
+                    outp[5] = (unsigned char)(w >> 40);
+                    outp[6] = (unsigned char)(w >> 48);
+                    outp[7] = (unsigned char)(w >> 56);
+                }
+                for (; i < len; i++)
+                    *outp++ = (unsigned char)(A[i / 8] >> (8 * (i % 8)));
+            }
+        } else
+#endif
+        {
+            for (l = 0; l < 4; l++)
+                SHA3_squeeze(ctx->A[l], out[l] + off, len, bsz, next);
+        }
+        ctx->xof_state = len == bsz ? XOF_STATE_SQUEEZE : XOF_STATE_FINAL;
+    }
+    return 1;
+}
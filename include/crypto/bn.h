@@ -113,6 +113,43 @@ int ossl_bn_rsa_fips186_4_derive_prime(BIGNUM *Y, BIGNUM *X, const BIGNUM *Xin,
 
 OSSL_LIB_CTX *ossl_bn_get_libctx(BN_CTX *ctx);
 
+int ossl_bn_mod_exp_mont_word_exp(BIGNUM *rr, const BIGNUM *a, BN_ULONG e,
+                                  BN_MONT_CTX *mont, BN_CTX *ctx);
+int ossl_bn_mod_inverse_consttime(BIGNUM *r, const BIGNUM *a, const BIGNUM *m,
+                                  BN_CTX *ctx);
+int ossl_bn_blinding_prepare(BN_BLINDING *b, BN_CTX *ctx);
+
+/*
+ * Fixed-width arithmetic modulo the modulus m of a Montgomery context, on
+ * arrays of exactly ossl_bn_fixed_words() words holding values below m
+ */
+# define OSSL_BN_FIXED_MAX_BITS  4096
+# define OSSL_BN_FIXED_MAX_WORDS (OSSL_BN_FIXED_MAX_BITS / BN_BITS2)
+
+int ossl_bn_fixed_words(const BN_MONT_CTX *mont);
+int ossl_bn_fixed_load(BN_ULONG *r, const BIGNUM *a, const BN_MONT_CTX *mont);
+int ossl_bn_fixed_store(BIGNUM *r, const BN_ULONG *a,
+                        const BN_MONT_CTX *mont);
+void ossl_bn_fixed_mont_mul(BN_ULONG *r, const BN_ULONG *a, const BN_ULONG *b,
+                            const BN_MONT_CTX *mont);
+void ossl_bn_fixed_mod_add(BN_ULONG *r, const BN_ULONG *a, const BN_ULONG *b,
+                           const BN_MONT_CTX *mont);
+void ossl_bn_fixed_mod_sub(BN_ULONG *r, const BN_ULONG *a, const BN_ULONG *b,
+                           const BN_MONT_CTX *mont);
+void ossl_bn_fixed_mod_half(BN_ULONG *r, const BN_ULONG *a,
+                            const BN_MONT_CTX *mont);
+int ossl_bn_fixed_is_zero(const BN_ULONG *a, const BN_MONT_CTX *mont);
+
+/* Fixed-base exponentiation, for a base and modulus used many times over */
+typedef struct bn_comb_st BN_COMB;
+
+BN_COMB *ossl_bn_comb_new(const BIGNUM *g, const BIGNUM *m, int bits,
+                          BN_CTX *ctx);
+void ossl_bn_comb_free(BN_COMB *comb);
+int ossl_bn_comb_bits(const BN_COMB *comb);
+int ossl_bn_mod_exp_comb(BIGNUM *r, const BIGNUM *e, const BN_COMB *comb,
+                         BN_CTX *ctx);
+
 extern const BIGNUM ossl_bn_inv_sqrt_2;
 
 #if defined(OPENSSL_SYS_LINUX) && !defined(FIPS_MODULE) && defined (__s390x__) \
@@ -27,6 +27,12 @@ void *ossl_fips_prov_ossl_ctx_new(OSSL_LIB_CTX *);
 #if defined(OPENSSL_THREADS)
 void *ossl_threads_ctx_new(OSSL_LIB_CTX *);
 #endif
+#ifndef OPENSSL_NO_DH
+void *ossl_dh_combs_new(OSSL_LIB_CTX *);
+#endif
+#if !defined(OPENSSL_NO_EC) && !defined(FIPS_MODULE)
+void *ossl_ec_combs_new(OSSL_LIB_CTX *);
+#endif
 
 void ossl_provider_store_free(void *);
 void ossl_property_string_data_free(void *);
@@ -46,3 +52,9 @@ void ossl_release_default_drbg_ctx(void);
 #if defined(OPENSSL_THREADS)
 void ossl_threads_ctx_free(void *);
 #endif
+#ifndef OPENSSL_NO_DH
+void ossl_dh_combs_free(void *);
+#endif
+#if !defined(OPENSSL_NO_EC) && !defined(FIPS_MODULE)
+void ossl_ec_combs_free(void *);
+#endif
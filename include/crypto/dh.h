@@ -14,6 +14,7 @@
 # include <openssl/params.h>
 # include <openssl/dh.h>
 # include <internal/ffc.h>
+# include <crypto/bn.h>
 
 DH *ossl_dh_new_by_nid_ex(OSSL_LIB_CTX *libctx, int nid);
 DH *ossl_dh_new_ex(OSSL_LIB_CTX *libctx);
@@ -27,6 +28,7 @@ const char *ossl_dh_gen_type_id2name(int id);
 int ossl_dh_gen_type_name2id(const char *name, int type);
 void ossl_dh_cache_named_group(DH *dh);
 int ossl_dh_is_named_safe_prime_group(const DH *dh);
+const BN_COMB *ossl_dh_get0_named_group_comb(const DH *dh, BN_CTX *ctx);
 
 FFC_PARAMS *ossl_dh_get0_params(DH *dh);
 int ossl_dh_get0_nid(const DH *dh);
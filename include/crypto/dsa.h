@@ -13,6 +13,7 @@
 # include <openssl/core.h>
 # include <openssl/dsa.h>
 # include <internal/ffc.h>
+# include <internal/deterministic_nonce.h>
 
 /*
  * DSA Paramgen types
@@ -32,7 +33,8 @@ int ossl_dsa_generate_ffc_parameters(DSA *dsa, int type, int pbits, int qbits,
 int ossl_dsa_sign_int(int type, const unsigned char *dgst, int dlen,
                       unsigned char *sig, unsigned int *siglen, DSA *dsa,
                       unsigned int nonce_type, const char *digestname,
-                      OSSL_LIB_CTX *libctx, const char *propq);
+                      OSSL_LIB_CTX *libctx, const char *propq,
+                      OSSL_RFC6979_CTX *nonce_ctx);
 
 FFC_PARAMS *ossl_dsa_get0_params(DSA *dsa);
 int ossl_dsa_ffc_params_fromdata(DSA *dsa, const OSSL_PARAM params[]);
@@ -24,6 +24,7 @@ int evp_pkey_ctx_set_ec_param_enc_prov(EVP_PKEY_CTX *ctx, int param_enc);
 #  include <openssl/core.h>
 #  include <openssl/ec.h>
 #  include <crypto/types.h>
+#  include <internal/deterministic_nonce.h>
 
 /*-
  * Computes the multiplicative inverse of x in the range
@@ -65,6 +66,10 @@ int ossl_ec_key_pairwise_check(const EC_KEY *eckey, BN_CTX *ctx);
 OSSL_LIB_CTX *ossl_ec_key_get_libctx(const EC_KEY *eckey);
 const char *ossl_ec_key_get0_propq(const EC_KEY *eckey);
 void ossl_ec_key_set0_libctx(EC_KEY *key, OSSL_LIB_CTX *libctx);
+int ossl_ec_key_set_pub_precompute(EC_KEY *key, int after);
+int ossl_ec_key_get_pub_precompute(const EC_KEY *key);
+int ossl_ec_key_pub_mul(const EC_KEY *key, EC_POINT *r, const BIGNUM *u1,
+                        const BIGNUM *u2, BN_CTX *ctx);
 
 /* Backend support */
 int ossl_ec_group_todata(const EC_GROUP *group, OSSL_PARAM_BLD *tmpl,
@@ -100,6 +105,7 @@ int ossl_ecdsa_deterministic_sign(const unsigned char *dgst, int dlen,
                                   unsigned char *sig, unsigned int *siglen,
                                   EC_KEY *eckey, unsigned int nonce_type,
                                   const char *digestname,
-                                  OSSL_LIB_CTX *libctx, const char *propq);
+                                  OSSL_LIB_CTX *libctx, const char *propq,
+                                  OSSL_RFC6979_CTX *nonce_ctx);
 # endif /* OPENSSL_NO_EC */
 #endif
@@ -89,6 +89,9 @@ int ossl_x25519(uint8_t out_shared_key[32], const uint8_t private_key[32],
                 const uint8_t peer_public_value[32]);
 void ossl_x25519_public_from_private(uint8_t out_public_value[32],
                                      const uint8_t private_key[32]);
+void ossl_x25519_public_from_private_batch(size_t n,
+                                           uint8_t *const *out_public_values,
+                                           const uint8_t *const *private_keys);
 
 int
 ossl_ed25519_public_from_private(OSSL_LIB_CTX *ctx, uint8_t out_public_key[32],
@@ -107,6 +110,15 @@ ossl_ed25519_verify(const uint8_t *tbs, size_t tbs_len,
                     const uint8_t *context, size_t context_len,
                     OSSL_LIB_CTX *libctx, const char *propq);
 int
+ossl_ed25519_verify_batch(size_t n, const uint8_t *const *tbs,
+                          const size_t *tbs_len,
+                          const uint8_t *const *signatures,
+                          const uint8_t *const *public_keys, int *results,
+                          const uint8_t dom2flag, const uint8_t phflag,
+                          const uint8_t csflag, const uint8_t *context,
+                          size_t context_len, OSSL_LIB_CTX *libctx,
+                          const char *propq);
+int
 ossl_ed448_public_from_private(OSSL_LIB_CTX *ctx, uint8_t out_public_key[57],
                                const uint8_t private_key[57], const char *propq);
 int
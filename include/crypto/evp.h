@@ -283,8 +283,10 @@ struct evp_md_st {
     OSSL_FUNC_digest_final_fn *dfinal;
     OSSL_FUNC_digest_squeeze_fn *dsqueeze;
     OSSL_FUNC_digest_digest_fn *digest;
+    OSSL_FUNC_digest_digest_batch_fn *digest_batch;
     OSSL_FUNC_digest_freectx_fn *freectx;
     OSSL_FUNC_digest_dupctx_fn *dupctx;
+    OSSL_FUNC_digest_copyctx_fn *copyctx;
     OSSL_FUNC_digest_get_params_fn *get_params;
     OSSL_FUNC_digest_set_ctx_params_fn *set_ctx_params;
     OSSL_FUNC_digest_get_ctx_params_fn *get_ctx_params;
@@ -826,6 +828,9 @@ int evp_keymgmt_gen_set_params(const EVP_KEYMGMT *keymgmt, void *genctx,
                                const OSSL_PARAM params[]);
 void *evp_keymgmt_gen(const EVP_KEYMGMT *keymgmt, void *genctx,
                       OSSL_CALLBACK *cb, void *cbarg);
+int evp_keymgmt_gen_batch(const EVP_KEYMGMT *keymgmt, void *genctx,
+                          size_t n, void **keydata,
+                          OSSL_CALLBACK *cb, void *cbarg);
 void evp_keymgmt_gen_cleanup(const EVP_KEYMGMT *keymgmt, void *genctx);
 
 int evp_keymgmt_has_load(const EVP_KEYMGMT *keymgmt);
@@ -0,0 +1,102 @@
+/*
+ * Copyright 2024 The OpenSSL Project Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License 2.0 (the "License").  You may not use
+ * this file except in compliance with the License.  You can obtain a copy
+ * in the file LICENSE in the source distribution or at
+ * https://www.openssl.org/source/license.html
+ */
+
+/* Internal ML-KEM functions for other submodules: not for application use */
+
+#ifndef OSSL_CRYPTO_ML_KEM_H
+# define OSSL_CRYPTO_ML_KEM_H
+
+# include <openssl/opensslconf.h>
+
+# ifndef OPENSSL_NO_ML_KEM
+
+#  include <stddef.h>
+#  include <stdint.h>
+#  include <openssl/types.h>
+
+/* Sizes shared by all three parameter sets (FIPS 203, section 8) */
+#  define ML_KEM_SHARED_SECRET_BYTES    32
+#  define ML_KEM_RANDOM_BYTES           32
+#  define ML_KEM_PKHASH_BYTES           32
+#  define ML_KEM_SEED_BYTES             (2 * ML_KEM_RANDOM_BYTES)
+
+#  define ML_KEM_512_VARIANT            0
+#  define ML_KEM_768_VARIANT            1
+#  define ML_KEM_1024_VARIANT           2
+
+#  define ML_KEM_512_BITS               512
+#  define ML_KEM_512_SECBITS            128
+#  define ML_KEM_512_PUBLIC_KEY_BYTES   800
+#  define ML_KEM_512_PRIVATE_KEY_BYTES  1632
+#  define ML_KEM_512_CIPHERTEXT_BYTES   768
+
+#  define ML_KEM_768_BITS               768
+#  define ML_KEM_768_SECBITS            192
+#  define ML_KEM_768_PUBLIC_KEY_BYTES   1184
+#  define ML_KEM_768_PRIVATE_KEY_BYTES  2400
+#  define ML_KEM_768_CIPHERTEXT_BYTES   1088
+
+#  define ML_KEM_1024_BITS              1024
+#  define ML_KEM_1024_SECBITS           256
+#  define ML_KEM_1024_PUBLIC_KEY_BYTES  1568
+#  define ML_KEM_1024_PRIVATE_KEY_BYTES 3168
+#  define ML_KEM_1024_CIPHERTEXT_BYTES  1568
+
+typedef struct ml_kem_vinfo_st {
+    const char *algorithm_name;
+    size_t pubkey_bytes;
+    size_t prvkey_bytes;
+    size_t ctext_bytes;
+    int variant;
+    int bits;
+    int secbits;
+    int k;
+    int eta1;
+    int eta2;
+    int du;
+    int dv;
+} ML_KEM_VINFO;
+
+typedef struct ml_kem_key_st ML_KEM_KEY;
+
+const ML_KEM_VINFO *ossl_ml_kem_get_vinfo(int variant);
+
+ML_KEM_KEY *ossl_ml_kem_key_new(OSSL_LIB_CTX *libctx, int variant);
+void ossl_ml_kem_key_free(ML_KEM_KEY *key);
+void ossl_ml_kem_key_reset(ML_KEM_KEY *key);
+ML_KEM_KEY *ossl_ml_kem_key_dup(const ML_KEM_KEY *key, int selection);
+const ML_KEM_VINFO *ossl_ml_kem_key_vinfo(const ML_KEM_KEY *key);
+
+int ossl_ml_kem_have_pubkey(const ML_KEM_KEY *key);
+int ossl_ml_kem_have_prvkey(const ML_KEM_KEY *key);
+int ossl_ml_kem_pubkey_cmp(const ML_KEM_KEY *key1, const ML_KEM_KEY *key2);
+
+int ossl_ml_kem_genkey(ML_KEM_KEY *key, const uint8_t *seed, size_t seedlen);
+int ossl_ml_kem_parse_public_key(const uint8_t *in, size_t len,
+                                 ML_KEM_KEY *key);
+int ossl_ml_kem_parse_private_key(const uint8_t *in, size_t len,
+                                  ML_KEM_KEY *key);
+int ossl_ml_kem_encode_public_key(uint8_t *out, size_t len,
+                                  const ML_KEM_KEY *key);
+int ossl_ml_kem_encode_private_key(uint8_t *out, size_t len,
+                                   const ML_KEM_KEY *key);
+
+int ossl_ml_kem_encap_seed(uint8_t *ctext, size_t clen,
+                           uint8_t *shared_secret, size_t slen,
+                           const uint8_t *entropy, size_t elen,
+                           const ML_KEM_KEY *key);
+int ossl_ml_kem_encap_rand(uint8_t *ctext, size_t clen,
+                           uint8_t *shared_secret, size_t slen,
+                           const ML_KEM_KEY *key);
+int ossl_ml_kem_decap(uint8_t *shared_secret, size_t slen,
+                      const uint8_t *ctext, size_t clen,
+                      const ML_KEM_KEY *key);
+
+# endif /* OPENSSL_NO_ML_KEM */
+#endif /* OSSL_CRYPTO_ML_KEM_H */
@@ -79,6 +79,7 @@ RSA_PSS_PARAMS *ossl_rsa_pss_decode(const X509_ALGOR *alg);
 int ossl_rsa_param_decode(RSA *rsa, const X509_ALGOR *alg);
 RSA *ossl_rsa_key_from_pkcs8(const PKCS8_PRIV_KEY_INFO *p8inf,
                              OSSL_LIB_CTX *libctx, const char *propq);
+RSA *ossl_rsa_d2i_private_key(RSA **a, const unsigned char **pp, long len);
 
 int ossl_rsa_padding_check_PKCS1_type_2(OSSL_LIB_CTX *ctx,
                                         unsigned char *to, int tlen,
@@ -18,5 +18,20 @@ int sha512_224_init(SHA512_CTX *);
 int sha512_256_init(SHA512_CTX *);
 int ossl_sha1_ctrl(SHA_CTX *ctx, int cmd, int mslen, void *ms);
 unsigned char *ossl_sha1(const unsigned char *d, size_t n, unsigned char *md);
+void ossl_sha256_batch(size_t n, const unsigned char *const *in,
+                       const size_t *inl, unsigned char *const *out);
+
+/*
+ * One PBKDF2-HMAC-SHA256 output block in progress.  The HMAC key is given by
+ * the states after hashing the inner and outer padded key blocks.
+ */
+typedef struct {
+    SHA_LONG ipad[8];
+    SHA_LONG opad[8];
+    SHA_LONG u[8];              /* The last HMAC output */
+    SHA_LONG t[8];              /* The XOR of all the HMAC outputs */
+} SHA256_HMAC_CHAIN;
+
+void ossl_sha256_hmac_chain(SHA256_HMAC_CHAIN *c, size_t n, uint64_t iter);
 
 #endif
@@ -62,6 +62,9 @@ void ossl_algorithm_do_all(OSSL_LIB_CTX *libctx, int operation_id,
                                        int no_store, void *data, int *result),
                            void *data);
 char *ossl_algorithm_get1_first_name(const OSSL_ALGORITHM *algo);
+int ossl_algorithm_names_do_all(const OSSL_ALGORITHM *algo,
+                                void (*fn)(const char *name, void *data),
+                                void *data);
 
 __owur int ossl_lib_ctx_write_lock(OSSL_LIB_CTX *ctx);
 __owur int ossl_lib_ctx_read_lock(OSSL_LIB_CTX *ctx);
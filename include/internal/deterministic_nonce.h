@@ -12,12 +12,20 @@
 
 # include <openssl/bn.h>
 
+typedef struct ossl_rfc6979_ctx_st OSSL_RFC6979_CTX;
+
+OSSL_RFC6979_CTX *ossl_rfc6979_ctx_new(const char *digestname,
+                                       OSSL_LIB_CTX *libctx,
+                                       const char *propq);
+void ossl_rfc6979_ctx_free(OSSL_RFC6979_CTX *ctx);
+
 int ossl_gen_deterministic_nonce_rfc6979(BIGNUM *out, const BIGNUM *q,
                                          const BIGNUM *priv,
                                          const unsigned char *message,
                                          size_t message_len,
                                          const char *digestname,
                                          OSSL_LIB_CTX *libctx,
-                                         const char *propq);
+                                         const char *propq,
+                                         OSSL_RFC6979_CTX *ctx);
 
 #endif /*OSSL_INTERNAL_DETERMINISTIC_NONCE_H */
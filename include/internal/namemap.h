@@ -27,6 +27,18 @@ int ossl_namemap_add_name(OSSL_NAMEMAP *namemap, int number, const char *name);
 int ossl_namemap_name2num(const OSSL_NAMEMAP *namemap, const char *name);
 int ossl_namemap_name2num_n(const OSSL_NAMEMAP *namemap,
                             const char *name, size_t name_len);
+/*
+ * Like ossl_namemap_name2num(), but a miss doesn't pull in the names from
+ * the legacy method db.  For lookups that are retried once providers have
+ * registered their names anyway.
+ */
+int ossl_namemap_name2num_nolegacy(const OSSL_NAMEMAP *namemap,
+                                   const char *name);
+/*
+ * Adds the names from the legacy method db to a stored namemap, which is
+ * otherwise done on the first ossl_namemap_name2num() miss.
+ */
+int ossl_namemap_load_legacy(const OSSL_NAMEMAP *namemap);
 const char *ossl_namemap_num2name(const OSSL_NAMEMAP *namemap, int number,
                                   size_t idx);
 int ossl_namemap_doall_names(const OSSL_NAMEMAP *namemap, int number,
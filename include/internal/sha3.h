@@ -48,6 +48,20 @@ struct keccak_st {
     int xof_state;
 };
 
+/*
+ * Four independent sponges of the same kind, run side by side so that the
+ * permutations can be computed together where the processor allows it.
+ * All four absorb an input of the same length, once, and then squeeze the
+ * same amount of output.
+ */
+typedef struct keccak_x4_st {
+    uint64_t A[4][5][5];
+    size_t block_size;
+    unsigned char pad;
+    int xof_state;
+    int x4;                     /* whether to use the four-way permutation */
+} KECCAK1600_X4_CTX;
+
 void ossl_sha3_reset(KECCAK1600_CTX *ctx);
 int ossl_sha3_init(KECCAK1600_CTX *ctx, unsigned char pad, size_t bitlen);
 int ossl_keccak_kmac_init(KECCAK1600_CTX *ctx, unsigned char pad,
@@ -56,6 +70,13 @@ int ossl_sha3_update(KECCAK1600_CTX *ctx, const void *_inp, size_t len);
 int ossl_sha3_final(KECCAK1600_CTX *ctx, unsigned char *out, size_t outlen);
 int ossl_sha3_squeeze(KECCAK1600_CTX *ctx, unsigned char *out, size_t outlen);
 
+int ossl_sha3_init_x4(KECCAK1600_X4_CTX *ctx, unsigned char pad,
+                      size_t bitlen);
+int ossl_sha3_absorb_x4(KECCAK1600_X4_CTX *ctx,
+                        const unsigned char *const in[4], size_t len);
+int ossl_sha3_squeeze_x4(KECCAK1600_X4_CTX *ctx, unsigned char *const out[4],
+                         size_t outlen);
+
 size_t SHA3_absorb(uint64_t A[5][5], const unsigned char *inp, size_t len,
                    size_t r);
 
@@ -300,6 +300,8 @@ OSSL_CORE_MAKE_FUNC(int, provider_self_test, (void *provctx))
 # define OSSL_FUNC_DIGEST_SETTABLE_CTX_PARAMS       12
 # define OSSL_FUNC_DIGEST_GETTABLE_CTX_PARAMS       13
 # define OSSL_FUNC_DIGEST_SQUEEZE                   14
+# define OSSL_FUNC_DIGEST_COPYCTX                   15
+# define OSSL_FUNC_DIGEST_DIGEST_BATCH              16
 
 OSSL_CORE_MAKE_FUNC(void *, digest_newctx, (void *provctx))
 OSSL_CORE_MAKE_FUNC(int, digest_init, (void *dctx, const OSSL_PARAM params[]))
@@ -314,9 +316,14 @@ OSSL_CORE_MAKE_FUNC(int, digest_squeeze,
 OSSL_CORE_MAKE_FUNC(int, digest_digest,
                     (void *provctx, const unsigned char *in, size_t inl,
                      unsigned char *out, size_t *outl, size_t outsz))
+OSSL_CORE_MAKE_FUNC(int, digest_digest_batch,
+                    (void *provctx, size_t n, const unsigned char *const *in,
+                     const size_t *inl, unsigned char *const *out,
+                     size_t outsz))
 
 OSSL_CORE_MAKE_FUNC(void, digest_freectx, (void *dctx))
 OSSL_CORE_MAKE_FUNC(void *, digest_dupctx, (void *dctx))
+OSSL_CORE_MAKE_FUNC(void, digest_copyctx, (void *outctx, void *inctx))
 
 OSSL_CORE_MAKE_FUNC(int, digest_get_params, (OSSL_PARAM params[]))
 OSSL_CORE_MAKE_FUNC(int, digest_set_ctx_params,
@@ -672,6 +679,12 @@ OSSL_CORE_MAKE_FUNC(const OSSL_PARAM *, keymgmt_import_types_ex,
 OSSL_CORE_MAKE_FUNC(const OSSL_PARAM *, keymgmt_export_types_ex,
                     (void *provctx, int selection))
 
+/* Generation of several keys at once */
+# define OSSL_FUNC_KEYMGMT_GEN_BATCH                  47
+OSSL_CORE_MAKE_FUNC(int, keymgmt_gen_batch,
+                    (void *genctx, size_t n, void **keydata,
+                     OSSL_CALLBACK *cb, void *cbarg))
+
 /* Key Exchange */
 
 # define OSSL_FUNC_KEYEXCH_NEWCTX                      1
@@ -729,6 +742,7 @@ OSSL_CORE_MAKE_FUNC(const OSSL_PARAM *, keyexch_gettable_ctx_params,
 # define OSSL_FUNC_SIGNATURE_GETTABLE_CTX_MD_PARAMS 23
 # define OSSL_FUNC_SIGNATURE_SET_CTX_MD_PARAMS      24
 # define OSSL_FUNC_SIGNATURE_SETTABLE_CTX_MD_PARAMS 25
+# define OSSL_FUNC_SIGNATURE_DIGEST_VERIFY_BATCH    26
 
 OSSL_CORE_MAKE_FUNC(void *, signature_newctx, (void *provctx,
                                                   const char *propq))
@@ -771,6 +785,11 @@ OSSL_CORE_MAKE_FUNC(int, signature_digest_verify_final,
 OSSL_CORE_MAKE_FUNC(int, signature_digest_verify,
                     (void *ctx, const unsigned char *sig, size_t siglen,
                      const unsigned char *tbs, size_t tbslen))
+OSSL_CORE_MAKE_FUNC(int, signature_digest_verify_batch,
+                    (void *ctx, size_t n, void *const *provkeys,
+                     const unsigned char *const *sigs, const size_t *siglens,
+                     const unsigned char *const *tbs, const size_t *tbslens,
+                     int *results))
 OSSL_CORE_MAKE_FUNC(void, signature_freectx, (void *ctx))
 OSSL_CORE_MAKE_FUNC(void *, signature_dupctx, (void *ctx))
 OSSL_CORE_MAKE_FUNC(int, signature_get_ctx_params,
@@ -713,6 +713,9 @@ __owur int EVP_DigestFinal_ex(EVP_MD_CTX *ctx, unsigned char *md,
 __owur int EVP_Digest(const void *data, size_t count,
                           unsigned char *md, unsigned int *size,
                           const EVP_MD *type, ENGINE *impl);
+__owur int EVP_DigestBatch(const EVP_MD *type, size_t n,
+                           const unsigned char *const *data,
+                           const size_t *counts, unsigned char *const *mds);
 __owur int EVP_Q_digest(OSSL_LIB_CTX *libctx, const char *name,
                         const char *propq, const void *data, size_t datalen,
                         unsigned char *md, size_t *mdlen);
@@ -817,6 +820,12 @@ __owur int EVP_VerifyFinal_ex(EVP_MD_CTX *ctx, const unsigned char *sigbuf,
 __owur int EVP_DigestVerify(EVP_MD_CTX *ctx, const unsigned char *sigret,
                             size_t siglen, const unsigned char *tbs,
                             size_t tbslen);
+__owur int EVP_DigestVerifyBatch(EVP_MD_CTX *ctx, size_t n,
+                                 EVP_PKEY *const *pkeys,
+                                 const unsigned char *const *sigs,
+                                 const size_t *siglens,
+                                 const unsigned char *const *tbs,
+                                 const size_t *tbslens, int *results);
 
 __owur int EVP_DigestSignInit_ex(EVP_MD_CTX *ctx, EVP_PKEY_CTX **pctx,
                           const char *mdname, OSSL_LIB_CTX *libctx,
@@ -1981,6 +1990,7 @@ int EVP_PKEY_paramgen(EVP_PKEY_CTX *ctx, EVP_PKEY **ppkey);
 int EVP_PKEY_keygen_init(EVP_PKEY_CTX *ctx);
 int EVP_PKEY_keygen(EVP_PKEY_CTX *ctx, EVP_PKEY **ppkey);
 int EVP_PKEY_generate(EVP_PKEY_CTX *ctx, EVP_PKEY **ppkey);
+int EVP_PKEY_generate_batch(EVP_PKEY_CTX *ctx, EVP_PKEY **pkeys, size_t n);
 int EVP_PKEY_check(EVP_PKEY_CTX *ctx);
 int EVP_PKEY_public_check(EVP_PKEY_CTX *ctx);
 int EVP_PKEY_public_check_quick(EVP_PKEY_CTX *ctx);
@@ -0,0 +1,45 @@
+/*
+ * Copyright 2024 The OpenSSL Project Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License 2.0 (the "License").  You may not use
+ * this file except in compliance with the License.  You can obtain a copy
+ * in the file LICENSE in the source distribution or at
+ * https://www.openssl.org/source/license.html
+ */
+
+#ifndef OSSL_PROVIDERS_MLX_KEM_H
+# define OSSL_PROVIDERS_MLX_KEM_H
+
+# include <openssl/opensslconf.h>
+
+# if !defined(OPENSSL_NO_ML_KEM) && !defined(OPENSSL_NO_EC)
+
+#  include <crypto/ml_kem.h>
+#  include <crypto/ecx.h>
+
+/*
+ * X25519MLKEM768, the hybrid TLS key exchange.  Every encoding puts the
+ * ML-KEM-768 part first: the client share is the ML-KEM encapsulation key
+ * then the X25519 public key, the server share is the ML-KEM ciphertext
+ * then the server's X25519 public key, and the shared secret is the ML-KEM
+ * secret followed by the X25519 secret.
+ */
+#  define MLX_KEM_PUBKEY_BYTES \
+    (ML_KEM_768_PUBLIC_KEY_BYTES + X25519_KEYLEN)
+#  define MLX_KEM_PRVKEY_BYTES \
+    (ML_KEM_768_PRIVATE_KEY_BYTES + X25519_KEYLEN)
+#  define MLX_KEM_CIPHERTEXT_BYTES \
+    (ML_KEM_768_CIPHERTEXT_BYTES + X25519_KEYLEN)
+#  define MLX_KEM_SHARED_SECRET_BYTES \
+    (ML_KEM_SHARED_SECRET_BYTES + X25519_KEYLEN)
+
+/* Whether the key has a public or private part is that of |mkey| */
+typedef struct {
+    OSSL_LIB_CTX *libctx;
+    ML_KEM_KEY *mkey;
+    uint8_t xpub[X25519_KEYLEN];
+    uint8_t xprv[X25519_KEYLEN];
+} MLX_KEY;
+
+# endif
+#endif
@@ -95,6 +95,10 @@ static const TLS_GROUP_CONSTANTS group_list[] = {
     { OSSL_TLS_GROUP_ID_ffdhe4096, 128, TLS1_3_VERSION, 0, -1, -1 },
     { OSSL_TLS_GROUP_ID_ffdhe6144, 128, TLS1_3_VERSION, 0, -1, -1 },
     { OSSL_TLS_GROUP_ID_ffdhe8192, 192, TLS1_3_VERSION, 0, -1, -1 },
+    { OSSL_TLS_GROUP_ID_mlkem512, 128, TLS1_3_VERSION, 0, -1, -1 },
+    { OSSL_TLS_GROUP_ID_mlkem768, 192, TLS1_3_VERSION, 0, -1, -1 },
+    { OSSL_TLS_GROUP_ID_mlkem1024, 256, TLS1_3_VERSION, 0, -1, -1 },
+    { OSSL_TLS_GROUP_ID_X25519MLKEM768, 192, TLS1_3_VERSION, 0, -1, -1 },
 };
 
 #define TLS_GROUP_ENTRY(tlsname, realname, algorithm, idx) \
@@ -123,7 +127,40 @@ static const TLS_GROUP_CONSTANTS group_list[] = {
         OSSL_PARAM_END \
     }
 
-static const OSSL_PARAM param_group_list[][10] = {
+# if !defined(OPENSSL_NO_ML_KEM) && !defined(FIPS_MODULE)
+static const unsigned int is_kem = 1;
+
+/* As TLS_GROUP_ENTRY, but for a key encapsulation method */
+#  define TLS_KEM_GROUP_ENTRY(tlsname, realname, algorithm, idx) \
+    { \
+        OSSL_PARAM_utf8_string(OSSL_CAPABILITY_TLS_GROUP_NAME, \
+                               tlsname, \
+                               sizeof(tlsname)), \
+        OSSL_PARAM_utf8_string(OSSL_CAPABILITY_TLS_GROUP_NAME_INTERNAL, \
+                               realname, \
+                               sizeof(realname)), \
+        OSSL_PARAM_utf8_string(OSSL_CAPABILITY_TLS_GROUP_ALG, \
+                               algorithm, \
+                               sizeof(algorithm)), \
+        OSSL_PARAM_uint(OSSL_CAPABILITY_TLS_GROUP_ID, \
+                        (unsigned int *)&group_list[idx].group_id), \
+        OSSL_PARAM_uint(OSSL_CAPABILITY_TLS_GROUP_SECURITY_BITS, \
+                        (unsigned int *)&group_list[idx].secbits), \
+        OSSL_PARAM_int(OSSL_CAPABILITY_TLS_GROUP_MIN_TLS, \
+                        (unsigned int *)&group_list[idx].mintls), \
+        OSSL_PARAM_int(OSSL_CAPABILITY_TLS_GROUP_MAX_TLS, \
+                        (unsigned int *)&group_list[idx].maxtls), \
+        OSSL_PARAM_int(OSSL_CAPABILITY_TLS_GROUP_MIN_DTLS, \
+                        (unsigned int *)&group_list[idx].mindtls), \
+        OSSL_PARAM_int(OSSL_CAPABILITY_TLS_GROUP_MAX_DTLS, \
+                        (unsigned int *)&group_list[idx].maxdtls), \
+        OSSL_PARAM_uint(OSSL_CAPABILITY_TLS_GROUP_IS_KEM, \
+                        (unsigned int *)&is_kem), \
+        OSSL_PARAM_END \
+    }
+# endif
+
+static const OSSL_PARAM param_group_list[][11] = {
 # ifndef OPENSSL_NO_EC
 #  ifndef FIPS_MODULE
     TLS_GROUP_ENTRY("sect163r1", "sect163r1", "EC", 1),
@@ -178,6 +215,15 @@ static const OSSL_PARAM param_group_list[][10] = {
     TLS_GROUP_ENTRY("ffdhe6144", "ffdhe6144", "DH", 36),
     TLS_GROUP_ENTRY("ffdhe8192", "ffdhe8192", "DH", 37),
 # endif
+# if !defined(OPENSSL_NO_ML_KEM) && !defined(FIPS_MODULE)
+    TLS_KEM_GROUP_ENTRY("MLKEM512", "ML-KEM-512", "ML-KEM-512", 38),
+    TLS_KEM_GROUP_ENTRY("MLKEM768", "ML-KEM-768", "ML-KEM-768", 39),
+    TLS_KEM_GROUP_ENTRY("MLKEM1024", "ML-KEM-1024", "ML-KEM-1024", 40),
+#  ifndef OPENSSL_NO_EC
+    TLS_KEM_GROUP_ENTRY("X25519MLKEM768", "X25519MLKEM768", "X25519MLKEM768",
+                        41),
+#  endif
+# endif
 };
 #endif /* !defined(OPENSSL_NO_EC) || !defined(OPENSSL_NO_DH) */
 
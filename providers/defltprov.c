@@ -429,6 +429,18 @@ static const OSSL_ALGORITHM deflt_asym_kem[] = {
     { PROV_NAMES_X25519, "provider=default", ossl_ecx_asym_kem_functions },
     { PROV_NAMES_X448, "provider=default", ossl_ecx_asym_kem_functions },
     { PROV_NAMES_EC, "provider=default", ossl_ec_asym_kem_functions },
+#endif
+#ifndef OPENSSL_NO_ML_KEM
+    { PROV_NAMES_ML_KEM_512, "provider=default",
+      ossl_ml_kem_asym_kem_functions },
+    { PROV_NAMES_ML_KEM_768, "provider=default",
+      ossl_ml_kem_asym_kem_functions },
+    { PROV_NAMES_ML_KEM_1024, "provider=default",
+      ossl_ml_kem_asym_kem_functions },
+# ifndef OPENSSL_NO_EC
+    { PROV_NAMES_X25519MLKEM768, "provider=default",
+      ossl_mlx_kem_asym_kem_functions },
+# endif
 #endif
     { NULL, NULL, NULL }
 };
@@ -481,6 +493,18 @@ static const OSSL_ALGORITHM deflt_keymgmt[] = {
 #ifndef OPENSSL_NO_SM2
     { PROV_NAMES_SM2, "provider=default", ossl_sm2_keymgmt_functions,
       PROV_DESCS_SM2 },
+#endif
+#ifndef OPENSSL_NO_ML_KEM
+    { PROV_NAMES_ML_KEM_512, "provider=default",
+      ossl_ml_kem_512_keymgmt_functions, PROV_DESCS_ML_KEM_512 },
+    { PROV_NAMES_ML_KEM_768, "provider=default",
+      ossl_ml_kem_768_keymgmt_functions, PROV_DESCS_ML_KEM_768 },
+    { PROV_NAMES_ML_KEM_1024, "provider=default",
+      ossl_ml_kem_1024_keymgmt_functions, PROV_DESCS_ML_KEM_1024 },
+# ifndef OPENSSL_NO_EC
+    { PROV_NAMES_X25519MLKEM768, "provider=default",
+      ossl_mlx_kem_keymgmt_functions, PROV_DESCS_X25519MLKEM768 },
+# endif
 #endif
     { NULL, NULL, NULL }
 };
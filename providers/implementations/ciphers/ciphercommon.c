@@ -17,6 +17,7 @@
 #include "ciphercommon_local.h"
 #include <providers/provider_ctx.h>
 #include <providers/providercommon.h>
+#include <internal/param_names.h>
 
 /*-
  * Generic cipher functions for OSSL_PARAM gettables and settables
@@ -43,56 +44,59 @@ int ossl_cipher_generic_get_params(OSSL_PARAM params[], unsigned int md,
                                    size_t kbits, size_t blkbits, size_t ivbits)
 {
     OSSL_PARAM *p;
+    int ok;
 
-    p = OSSL_PARAM_locate(params, OSSL_CIPHER_PARAM_MODE);
-    if (p != NULL && !OSSL_PARAM_set_uint(p, md)) {
-        ERR_raise(ERR_LIB_PROV, PROV_R_FAILED_TO_SET_PARAMETER);
-        return 0;
-    }
-    p = OSSL_PARAM_locate(params, OSSL_CIPHER_PARAM_AEAD);
-    if (p != NULL
-        && !OSSL_PARAM_set_int(p, (flags & PROV_CIPHER_FLAG_AEAD) != 0)) {
-        ERR_raise(ERR_LIB_PROV, PROV_R_FAILED_TO_SET_PARAMETER);
-        return 0;
-    }
-    p = OSSL_PARAM_locate(params, OSSL_CIPHER_PARAM_CUSTOM_IV);
-    if (p != NULL
-        && !OSSL_PARAM_set_int(p, (flags & PROV_CIPHER_FLAG_CUSTOM_IV) != 0)) {
-        ERR_raise(ERR_LIB_PROV, PROV_R_FAILED_TO_SET_PARAMETER);
-        return 0;
-    }
-    p = OSSL_PARAM_locate(params, OSSL_CIPHER_PARAM_CTS);
-    if (p != NULL
-        && !OSSL_PARAM_set_int(p, (flags & PROV_CIPHER_FLAG_CTS) != 0)) {
-        ERR_raise(ERR_LIB_PROV, PROV_R_FAILED_TO_SET_PARAMETER);
-        return 0;
-    }
-    p = OSSL_PARAM_locate(params, OSSL_CIPHER_PARAM_TLS1_MULTIBLOCK);
-    if (p != NULL
-        && !OSSL_PARAM_set_int(p, (flags & PROV_CIPHER_FLAG_TLS1_MULTIBLOCK) != 0)) {
-        ERR_raise(ERR_LIB_PROV, PROV_R_FAILED_TO_SET_PARAMETER);
-        return 0;
-    }
-    p = OSSL_PARAM_locate(params, OSSL_CIPHER_PARAM_HAS_RAND_KEY);
-    if (p != NULL
-        && !OSSL_PARAM_set_int(p, (flags & PROV_CIPHER_FLAG_RAND_KEY) != 0)) {
-        ERR_raise(ERR_LIB_PROV, PROV_R_FAILED_TO_SET_PARAMETER);
-        return 0;
-    }
-    p = OSSL_PARAM_locate(params, OSSL_CIPHER_PARAM_KEYLEN);
-    if (p != NULL && !OSSL_PARAM_set_size_t(p, kbits / 8)) {
-        ERR_raise(ERR_LIB_PROV, PROV_R_FAILED_TO_SET_PARAMETER);
-        return 0;
-    }
-    p = OSSL_PARAM_locate(params, OSSL_CIPHER_PARAM_BLOCK_SIZE);
-    if (p != NULL && !OSSL_PARAM_set_size_t(p, blkbits / 8)) {
-        ERR_raise(ERR_LIB_PROV, PROV_R_FAILED_TO_SET_PARAMETER);
-        return 0;
-    }
-    p = OSSL_PARAM_locate(params, OSSL_CIPHER_PARAM_IVLEN);
-    if (p != NULL && !OSSL_PARAM_set_size_t(p, ivbits / 8)) {
-        ERR_raise(ERR_LIB_PROV, PROV_R_FAILED_TO_SET_PARAMETER);
-        return 0;
+    if (params == NULL)
+        return 1;
+
+    for (p = params; p->key != NULL; p++) {
+        switch (ossl_param_find_pidx(p->key)) {
+        default:
+            continue;
+
+        case PIDX_CIPHER_PARAM_MODE:
+            ok = OSSL_PARAM_set_uint(p, md);
+            break;
+
+        case PIDX_CIPHER_PARAM_AEAD:
+            ok = OSSL_PARAM_set_int(p, (flags & PROV_CIPHER_FLAG_AEAD) != 0);
+            break;
+
+        case PIDX_CIPHER_PARAM_CUSTOM_IV:
+            ok = OSSL_PARAM_set_int(p,
+                                    (flags & PROV_CIPHER_FLAG_CUSTOM_IV) != 0);
+            break;
+
+        case PIDX_CIPHER_PARAM_CTS:
+            ok = OSSL_PARAM_set_int(p, (flags & PROV_CIPHER_FLAG_CTS) != 0);
+            break;
+
+        case PIDX_CIPHER_PARAM_TLS1_MULTIBLOCK:
+            ok = OSSL_PARAM_set_int(p,
+                                    (flags & PROV_CIPHER_FLAG_TLS1_MULTIBLOCK) != 0);
+            break;
+
+        case PIDX_CIPHER_PARAM_HAS_RAND_KEY:
+            ok = OSSL_PARAM_set_int(p,
+                                    (flags & PROV_CIPHER_FLAG_RAND_KEY) != 0);
+            break;
+
+        case PIDX_CIPHER_PARAM_KEYLEN:
+            ok = OSSL_PARAM_set_size_t(p, kbits / 8);
+            break;
+
+        case PIDX_CIPHER_PARAM_BLOCK_SIZE:
+            ok = OSSL_PARAM_set_size_t(p, blkbits / 8);
+            break;
+
+        case PIDX_CIPHER_PARAM_IVLEN:
+            ok = OSSL_PARAM_set_size_t(p, ivbits / 8);
+            break;
+        }
+        if (!ok) {
+            ERR_raise(ERR_LIB_PROV, PROV_R_FAILED_TO_SET_PARAMETER);
+            return 0;
+        }
     }
     return 1;
 }
@@ -575,46 +579,50 @@ int ossl_cipher_generic_get_ctx_params(void *vctx, OSSL_PARAM params[])
 {
     PROV_CIPHER_CTX *ctx = (PROV_CIPHER_CTX *)vctx;
     OSSL_PARAM *p;
+    int ok;
 
-    p = OSSL_PARAM_locate(params, OSSL_CIPHER_PARAM_IVLEN);
-    if (p != NULL && !OSSL_PARAM_set_size_t(p, ctx->ivlen)) {
-        ERR_raise(ERR_LIB_PROV, PROV_R_FAILED_TO_SET_PARAMETER);
-        return 0;
-    }
-    p = OSSL_PARAM_locate(params, OSSL_CIPHER_PARAM_PADDING);
-    if (p != NULL && !OSSL_PARAM_set_uint(p, ctx->pad)) {
-        ERR_raise(ERR_LIB_PROV, PROV_R_FAILED_TO_SET_PARAMETER);
-        return 0;
-    }
-    p = OSSL_PARAM_locate(params, OSSL_CIPHER_PARAM_IV);
-    if (p != NULL
-        && !OSSL_PARAM_set_octet_ptr(p, &ctx->oiv, ctx->ivlen)
-        && !OSSL_PARAM_set_octet_string(p, &ctx->oiv, ctx->ivlen)) {
-        ERR_raise(ERR_LIB_PROV, PROV_R_FAILED_TO_SET_PARAMETER);
-        return 0;
-    }
-    p = OSSL_PARAM_locate(params, OSSL_CIPHER_PARAM_UPDATED_IV);
-    if (p != NULL
-        && !OSSL_PARAM_set_octet_ptr(p, &ctx->iv, ctx->ivlen)
-        && !OSSL_PARAM_set_octet_string(p, &ctx->iv, ctx->ivlen)) {
-        ERR_raise(ERR_LIB_PROV, PROV_R_FAILED_TO_SET_PARAMETER);
-        return 0;
-    }
-    p = OSSL_PARAM_locate(params, OSSL_CIPHER_PARAM_NUM);
-    if (p != NULL && !OSSL_PARAM_set_uint(p, ctx->num)) {
-        ERR_raise(ERR_LIB_PROV, PROV_R_FAILED_TO_SET_PARAMETER);
-        return 0;
-    }
-    p = OSSL_PARAM_locate(params, OSSL_CIPHER_PARAM_KEYLEN);
-    if (p != NULL && !OSSL_PARAM_set_size_t(p, ctx->keylen)) {
-        ERR_raise(ERR_LIB_PROV, PROV_R_FAILED_TO_SET_PARAMETER);
-        return 0;
-    }
-    p = OSSL_PARAM_locate(params, OSSL_CIPHER_PARAM_TLS_MAC);
-    if (p != NULL
-        && !OSSL_PARAM_set_octet_ptr(p, ctx->tlsmac, ctx->tlsmacsize)) {
-        ERR_raise(ERR_LIB_PROV, PROV_R_FAILED_TO_SET_PARAMETER);
-        return 0;
+    if (params == NULL)
+        return 1;
+
+    for (p = params; p->key != NULL; p++) {
+        switch (ossl_param_find_pidx(p->key)) {
+        default:
+            continue;
+
+        case PIDX_CIPHER_PARAM_IVLEN:
+            ok = OSSL_PARAM_set_size_t(p, ctx->ivlen);
+            break;
+
+        case PIDX_CIPHER_PARAM_PADDING:
+            ok = OSSL_PARAM_set_uint(p, ctx->pad);
+            break;
+
+        case PIDX_CIPHER_PARAM_IV:
+            ok = OSSL_PARAM_set_octet_ptr(p, &ctx->oiv, ctx->ivlen)
+                 || OSSL_PARAM_set_octet_string(p, &ctx->oiv, ctx->ivlen);
+            break;
+
+        case PIDX_CIPHER_PARAM_UPDATED_IV:
+            ok = OSSL_PARAM_set_octet_ptr(p, &ctx->iv, ctx->ivlen)
+                 || OSSL_PARAM_set_octet_string(p, &ctx->iv, ctx->ivlen);
+            break;
+
+        case PIDX_CIPHER_PARAM_NUM:
+            ok = OSSL_PARAM_set_uint(p, ctx->num);
+            break;
+
+        case PIDX_CIPHER_PARAM_KEYLEN:
+            ok = OSSL_PARAM_set_size_t(p, ctx->keylen);
+            break;
+
+        case PIDX_CIPHER_PARAM_TLS_MAC:
+            ok = OSSL_PARAM_set_octet_ptr(p, ctx->tlsmac, ctx->tlsmacsize);
+            break;
+        }
+        if (!ok) {
+            ERR_raise(ERR_LIB_PROV, PROV_R_FAILED_TO_SET_PARAMETER);
+            return 0;
+        }
     }
     return 1;
 }
@@ -623,53 +631,54 @@ int ossl_cipher_generic_set_ctx_params(void *vctx, const OSSL_PARAM params[])
 {
     PROV_CIPHER_CTX *ctx = (PROV_CIPHER_CTX *)vctx;
     const OSSL_PARAM *p;
+    unsigned int u;
 
     if (params == NULL)
         return 1;
 
-    p = OSSL_PARAM_locate_const(params, OSSL_CIPHER_PARAM_PADDING);
-    if (p != NULL) {
-        unsigned int pad;
+    for (p = params; p->key != NULL; p++) {
+        switch (ossl_param_find_pidx(p->key)) {
+        default:
+            break;
 
-        if (!OSSL_PARAM_get_uint(p, &pad)) {
-            ERR_raise(ERR_LIB_PROV, PROV_R_FAILED_TO_GET_PARAMETER);
-            return 0;
-        }
-        ctx->pad = pad ? 1 : 0;
-    }
-    p = OSSL_PARAM_locate_const(params, OSSL_CIPHER_PARAM_USE_BITS);
-    if (p != NULL) {
-        unsigned int bits;
+        case PIDX_CIPHER_PARAM_PADDING:
+            if (!OSSL_PARAM_get_uint(p, &u)) {
+                ERR_raise(ERR_LIB_PROV, PROV_R_FAILED_TO_GET_PARAMETER);
+                return 0;
+            }
+            ctx->pad = u ? 1 : 0;
+            break;
 
-        if (!OSSL_PARAM_get_uint(p, &bits)) {
-            ERR_raise(ERR_LIB_PROV, PROV_R_FAILED_TO_GET_PARAMETER);
-            return 0;
-        }
-        ctx->use_bits = bits ? 1 : 0;
-    }
-    p = OSSL_PARAM_locate_const(params, OSSL_CIPHER_PARAM_TLS_VERSION);
-    if (p != NULL) {
-        if (!OSSL_PARAM_get_uint(p, &ctx->tlsversion)) {
-            ERR_raise(ERR_LIB_PROV, PROV_R_FAILED_TO_GET_PARAMETER);
-            return 0;
-        }
-    }
-    p = OSSL_PARAM_locate_const(params, OSSL_CIPHER_PARAM_TLS_MAC_SIZE);
-    if (p != NULL) {
-        if (!OSSL_PARAM_get_size_t(p, &ctx->tlsmacsize)) {
-            ERR_raise(ERR_LIB_PROV, PROV_R_FAILED_TO_GET_PARAMETER);
-            return 0;
-        }
-    }
-    p = OSSL_PARAM_locate_const(params, OSSL_CIPHER_PARAM_NUM);
-    if (p != NULL) {
-        unsigned int num;
+        case PIDX_CIPHER_PARAM_USE_BITS:
+            if (!OSSL_PARAM_get_uint(p, &u)) {
+                ERR_raise(ERR_LIB_PROV, PROV_R_FAILED_TO_GET_PARAMETER);
+                return 0;
+            }
+            ctx->use_bits = u ? 1 : 0;
+            break;
 
-        if (!OSSL_PARAM_get_uint(p, &num)) {
-            ERR_raise(ERR_LIB_PROV, PROV_R_FAILED_TO_GET_PARAMETER);
-            return 0;
+        case PIDX_CIPHER_PARAM_TLS_VERSION:
+            if (!OSSL_PARAM_get_uint(p, &ctx->tlsversion)) {
+                ERR_raise(ERR_LIB_PROV, PROV_R_FAILED_TO_GET_PARAMETER);
+                return 0;
+            }
+            break;
+
+        case PIDX_CIPHER_PARAM_TLS_MAC_SIZE:
+            if (!OSSL_PARAM_get_size_t(p, &ctx->tlsmacsize)) {
+                ERR_raise(ERR_LIB_PROV, PROV_R_FAILED_TO_GET_PARAMETER);
+                return 0;
+            }
+            break;
+
+        case PIDX_CIPHER_PARAM_NUM:
+            if (!OSSL_PARAM_get_uint(p, &u)) {
+                ERR_raise(ERR_LIB_PROV, PROV_R_FAILED_TO_GET_PARAMETER);
+                return 0;
+            }
+            ctx->num = u;
+            break;
         }
-        ctx->num = num;
     }
     return 1;
 }
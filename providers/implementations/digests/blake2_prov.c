@@ -99,6 +99,7 @@ static OSSL_FUNC_digest_init_fn blake##variantsize##_internal_init; \
 static OSSL_FUNC_digest_newctx_fn blake##variantsize##_newctx; \
 static OSSL_FUNC_digest_freectx_fn blake##variantsize##_freectx; \
 static OSSL_FUNC_digest_dupctx_fn blake##variantsize##_dupctx; \
+static OSSL_FUNC_digest_copyctx_fn blake##variantsize##_copyctx; \
 static OSSL_FUNC_digest_final_fn blake##variantsize##_internal_final; \
 static OSSL_FUNC_digest_get_params_fn blake##variantsize##_get_params; \
  \
@@ -135,6 +136,12 @@ static void *blake##variantsize##_dupctx(void *ctx) \
     return ret; \
 } \
  \
+static void blake##variantsize##_copyctx(void *out, void *in) \
+{ \
+    *(struct blake##variant##_md_data_st *)out = \
+        *(struct blake##variant##_md_data_st *)in; \
+} \
+ \
 static int blake##variantsize##_internal_final(void *ctx, unsigned char *out, \
                                      size_t *outl, size_t outsz) \
 { \
@@ -169,6 +176,7 @@ const OSSL_DISPATCH ossl_blake##variantsize##_functions[] = { \
     {OSSL_FUNC_DIGEST_FINAL, (void (*)(void))blake##variantsize##_internal_final}, \
     {OSSL_FUNC_DIGEST_FREECTX, (void (*)(void))blake##variantsize##_freectx}, \
     {OSSL_FUNC_DIGEST_DUPCTX, (void (*)(void))blake##variantsize##_dupctx}, \
+    {OSSL_FUNC_DIGEST_COPYCTX, (void (*)(void))blake##variantsize##_copyctx}, \
     {OSSL_FUNC_DIGEST_GET_PARAMS, (void (*)(void))blake##variantsize##_get_params}, \
     {OSSL_FUNC_DIGEST_GETTABLE_PARAMS, \
      (void (*)(void))ossl_digest_default_gettable_params}, \
@@ -9,34 +9,44 @@
 
 #include <openssl/err.h>
 #include <openssl/proverr.h>
+#include <internal/param_names.h>
 #include <providers/digestcommon.h>
 
 int ossl_digest_default_get_params(OSSL_PARAM params[], size_t blksz,
                                    size_t paramsz, unsigned long flags)
 {
-    OSSL_PARAM *p = NULL;
+    OSSL_PARAM *p;
+    int ok;
 
-    p = OSSL_PARAM_locate(params, OSSL_DIGEST_PARAM_BLOCK_SIZE);
-    if (p != NULL && !OSSL_PARAM_set_size_t(p, blksz)) {
-        ERR_raise(ERR_LIB_PROV, PROV_R_FAILED_TO_SET_PARAMETER);
-        return 0;
-    }
-    p = OSSL_PARAM_locate(params, OSSL_DIGEST_PARAM_SIZE);
-    if (p != NULL && !OSSL_PARAM_set_size_t(p, paramsz)) {
-        ERR_raise(ERR_LIB_PROV, PROV_R_FAILED_TO_SET_PARAMETER);
-        return 0;
-    }
-    p = OSSL_PARAM_locate(params, OSSL_DIGEST_PARAM_XOF);
-    if (p != NULL
-        && !OSSL_PARAM_set_int(p, (flags & PROV_DIGEST_FLAG_XOF) != 0)) {
-        ERR_raise(ERR_LIB_PROV, PROV_R_FAILED_TO_SET_PARAMETER);
-        return 0;
-    }
-    p = OSSL_PARAM_locate(params, OSSL_DIGEST_PARAM_ALGID_ABSENT);
-    if (p != NULL
-        && !OSSL_PARAM_set_int(p, (flags & PROV_DIGEST_FLAG_ALGID_ABSENT) != 0)) {
-        ERR_raise(ERR_LIB_PROV, PROV_R_FAILED_TO_SET_PARAMETER);
-        return 0;
+    if (params == NULL)
+        return 1;
+
+    for (p = params; p->key != NULL; p++) {
+        switch (ossl_param_find_pidx(p->key)) {
+        default:
+            continue;
+
+        case PIDX_DIGEST_PARAM_BLOCK_SIZE:
+            ok = OSSL_PARAM_set_size_t(p, blksz);
+            break;
+
+        case PIDX_DIGEST_PARAM_SIZE:
+            ok = OSSL_PARAM_set_size_t(p, paramsz);
+            break;
+
+        case PIDX_DIGEST_PARAM_XOF:
+            ok = OSSL_PARAM_set_int(p, (flags & PROV_DIGEST_FLAG_XOF) != 0);
+            break;
+
+        case PIDX_DIGEST_PARAM_ALGID_ABSENT:
+            ok = OSSL_PARAM_set_int(p,
+                                    (flags & PROV_DIGEST_FLAG_ALGID_ABSENT) != 0);
+            break;
+        }
+        if (!ok) {
+            ERR_raise(ERR_LIB_PROV, PROV_R_FAILED_TO_SET_PARAMETER);
+            return 0;
+        }
     }
     return 1;
 }
@@ -67,10 +67,34 @@ IMPLEMENT_digest_functions(sha224, SHA256_CTX,
                            SHA256_CBLOCK, SHA224_DIGEST_LENGTH, SHA2_FLAGS,
                            SHA224_Init, SHA224_Update, SHA224_Final)
 
+static OSSL_FUNC_digest_init_fn sha256_internal_init;
+static OSSL_FUNC_digest_digest_batch_fn sha256_digest_batch;
+
+static int sha256_internal_init(void *ctx,
+                                ossl_unused const OSSL_PARAM params[])
+{
+    return ossl_prov_is_running() && SHA256_Init(ctx);
+}
+
+/* Independent messages are interleaved on the multi-buffer code if any */
+static int sha256_digest_batch(ossl_unused void *provctx, size_t n,
+                               const unsigned char *const *in,
+                               const size_t *inl, unsigned char *const *out,
+                               size_t outsz)
+{
+    if (!ossl_prov_is_running() || outsz < SHA256_DIGEST_LENGTH)
+        return 0;
+    ossl_sha256_batch(n, in, inl, out);
+    return 1;
+}
+
 /* ossl_sha256_functions */
-IMPLEMENT_digest_functions(sha256, SHA256_CTX,
-                           SHA256_CBLOCK, SHA256_DIGEST_LENGTH, SHA2_FLAGS,
-                           SHA256_Init, SHA256_Update, SHA256_Final)
+PROV_DISPATCH_FUNC_DIGEST_CONSTRUCT_START(sha256, SHA256_CTX, SHA256_CBLOCK,
+                                          SHA256_DIGEST_LENGTH, SHA2_FLAGS,
+                                          SHA256_Update, SHA256_Final),
+    { OSSL_FUNC_DIGEST_INIT, (void (*)(void))sha256_internal_init },
+    { OSSL_FUNC_DIGEST_DIGEST_BATCH, (void (*)(void))sha256_digest_batch },
+PROV_DISPATCH_FUNC_DIGEST_CONSTRUCT_END
 #ifndef FIPS_MODULE
 /* ossl_sha256_192_functions */
 IMPLEMENT_digest_functions(sha256_192, SHA256_CTX,
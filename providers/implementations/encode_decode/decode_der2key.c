@@ -528,7 +528,7 @@ static void *sm2_d2i_PKCS8(void **key, const unsigned char **der, long der_len,
 /* ---------------------------------------------------------------------- */
 
 #define rsa_evp_type                    EVP_PKEY_RSA
-#define rsa_d2i_private_key             (d2i_of_void *)d2i_RSAPrivateKey
+#define rsa_d2i_private_key             (d2i_of_void *)ossl_rsa_d2i_private_key
 #define rsa_d2i_public_key              (d2i_of_void *)d2i_RSAPublicKey
 #define rsa_d2i_key_params              NULL
 
@@ -561,7 +561,7 @@ static void rsa_adjust(void *key, struct der2key_ctx_st *ctx)
 }
 
 #define rsapss_evp_type                 EVP_PKEY_RSA_PSS
-#define rsapss_d2i_private_key          (d2i_of_void *)d2i_RSAPrivateKey
+#define rsapss_d2i_private_key          (d2i_of_void *)ossl_rsa_d2i_private_key
 #define rsapss_d2i_public_key           (d2i_of_void *)d2i_RSAPublicKey
 #define rsapss_d2i_key_params           NULL
 #define rsapss_d2i_PKCS8                rsa_d2i_PKCS8
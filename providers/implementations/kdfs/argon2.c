@@ -147,13 +147,6 @@ typedef enum {
     ARGON2_ID = 2
 } ARGON2_TYPE;
 
-typedef struct {
-    uint32_t pass;
-    uint32_t lane;
-    uint8_t slice;
-    uint32_t index;
-} ARGON2_POS;
-
 typedef struct {
     void *provctx;
     uint32_t outlen;
@@ -173,6 +166,7 @@ typedef struct {
     uint32_t early_clean;
     ARGON2_TYPE type;
     BLOCK *memory;
+    uint32_t memory_alloc;
     uint32_t passes;
     uint32_t memory_blocks;
     uint32_t segment_length;
@@ -183,9 +177,22 @@ typedef struct {
     char *propq;
 } KDF_ARGON2;
 
+/*
+ * The worker threads of a derivation.  Thread i fills lanes i, i + threads,
+ * ... of each slice, then waits at the sync point for the others.
+ */
 typedef struct {
-    ARGON2_POS pos;
     KDF_ARGON2 *ctx;
+    CRYPTO_MUTEX *lock;
+    CRYPTO_CONDVAR *cond;
+    uint32_t waiting;
+    uint32_t generation;
+    int abort;
+} ARGON2_SYNC;
+
+typedef struct {
+    ARGON2_SYNC *sync;
+    uint32_t first_lane;
 } ARGON2_THREAD_DATA;
 
 static OSSL_FUNC_kdf_newctx_fn kdf_argon2i_new;
@@ -249,6 +256,7 @@ static void fill_segment(const KDF_ARGON2 *ctx, uint32_t pass, uint32_t lane,
                          uint8_t slice);
 
 # if !defined(ARGON2_NO_THREADS)
+static int sync_point(ARGON2_SYNC *sync);
 static uint32_t fill_segment_thr(void *thread_data);
 static int fill_mem_blocks_mt(KDF_ARGON2 *ctx);
 # endif
@@ -257,6 +265,7 @@ static int fill_mem_blocks_st(KDF_ARGON2 *ctx);
 static inline int fill_memory_blocks(KDF_ARGON2 *ctx);
 
 static void initial_hash(uint8_t *blockhash, KDF_ARGON2 *ctx);
+static void free_memory(KDF_ARGON2 *ctx);
 static int initialize(KDF_ARGON2 *ctx);
 static void finalize(const KDF_ARGON2 *ctx, void *out);
 
@@ -547,82 +556,104 @@ static void fill_segment(const KDF_ARGON2 *ctx, uint32_t pass, uint32_t lane,
 
 # if !defined(ARGON2_NO_THREADS)
 
-static uint32_t fill_segment_thr(void *thread_data)
+/*
+ * Waits until all threads have reached the sync point.  Returns 0 if the
+ * derivation was abandoned instead.
+ */
+static int sync_point(ARGON2_SYNC *sync)
 {
-    ARGON2_THREAD_DATA *my_data;
+    uint32_t generation;
+    int ret;
+
+    ossl_crypto_mutex_lock(sync->lock);
+    generation = sync->generation;
+    if (!sync->abort && ++sync->waiting == sync->ctx->threads) {
+        sync->waiting = 0;
+        sync->generation++;
+        ossl_crypto_condvar_broadcast(sync->cond);
+    } else {
+        while (!sync->abort && generation == sync->generation)
+            ossl_crypto_condvar_wait(sync->cond, sync->lock);
+    }
+    ret = !sync->abort;
+    ossl_crypto_mutex_unlock(sync->lock);
+    return ret;
+}
 
-    my_data = (ARGON2_THREAD_DATA *) thread_data;
-    fill_segment(my_data->ctx, my_data->pos.pass, my_data->pos.lane,
-                 my_data->pos.slice);
+static uint32_t fill_segment_thr(void *thread_data)
+{
+    ARGON2_THREAD_DATA *my_data = (ARGON2_THREAD_DATA *)thread_data;
+    KDF_ARGON2 *ctx = my_data->sync->ctx;
+    uint32_t r, s, l;
 
-    return 0;
+    for (r = 0; r < ctx->passes; ++r) {
+        for (s = 0; s < ARGON2_SYNC_POINTS; ++s) {
+            for (l = my_data->first_lane; l < ctx->lanes; l += ctx->threads)
+                fill_segment(ctx, r, l, s);
+            if (!sync_point(my_data->sync))
+                return 0;
+        }
+    }
+    return 1;
 }
 
+/*
+ * The workers are started once and kept for all passes and slices, rather
+ * than started for every segment.  The calling thread is one of them.
+ */
 static int fill_mem_blocks_mt(KDF_ARGON2 *ctx)
 {
-    uint32_t r, s, l, ll;
-    void **t;
+    ARGON2_SYNC sync;
     ARGON2_THREAD_DATA *t_data;
+    void **t;
+    uint32_t i, started = 1;
+    int ret = 0;
 
-    t = OPENSSL_zalloc(sizeof(void *)*ctx->lanes);
-    t_data = OPENSSL_zalloc(ctx->lanes * sizeof(ARGON2_THREAD_DATA));
+    memset(&sync, 0, sizeof(sync));
+    sync.ctx = ctx;
+    sync.lock = ossl_crypto_mutex_new();
+    sync.cond = ossl_crypto_condvar_new();
+    t = OPENSSL_zalloc(sizeof(void *) * ctx->threads);
+    t_data = OPENSSL_zalloc(ctx->threads * sizeof(ARGON2_THREAD_DATA));
 
-    if (t == NULL || t_data == NULL)
-        goto fail;
+    if (sync.lock == NULL || sync.cond == NULL || t == NULL || t_data == NULL)
+        goto end;
 
-    for (r = 0; r < ctx->passes; ++r) {
-        for (s = 0; s < ARGON2_SYNC_POINTS; ++s) {
-            for (l = 0; l < ctx->lanes; ++l) {
-                ARGON2_POS p;
-                if (l >= ctx->threads) {
-                    if (ossl_crypto_thread_join(t[l - ctx->threads], NULL) == 0)
-                        goto fail;
-                    if (ossl_crypto_thread_clean(t[l - ctx->threads]) == 0)
-                        goto fail;
-                    t[l] = NULL;
-                }
-
-                p.pass = r;
-                p.lane = l;
-                p.slice = (uint8_t)s;
-                p.index = 0;
-
-                t_data[l].ctx = ctx;
-                memcpy(&(t_data[l].pos), &p, sizeof(ARGON2_POS));
-                t[l] = ossl_crypto_thread_start(ctx->libctx, &fill_segment_thr,
-                                                (void *) &t_data[l]);
-                if (t[l] == NULL) {
-                    for (ll = 0; ll < l; ++ll) {
-                        if (ossl_crypto_thread_join(t[ll], NULL) == 0)
-                            goto fail;
-                        if (ossl_crypto_thread_clean(t[ll]) == 0)
-                            goto fail;
-                        t[ll] = NULL;
-                    }
-                    goto fail;
-                }
-            }
-            for (l = ctx->lanes - ctx->threads; l < ctx->lanes; ++l) {
-                if (ossl_crypto_thread_join(t[l], NULL) == 0)
-                    goto fail;
-                if (ossl_crypto_thread_clean(t[l]) == 0)
-                    goto fail;
-                t[l] = NULL;
-            }
-        }
+    for (i = 0; i < ctx->threads; ++i) {
+        t_data[i].sync = &sync;
+        t_data[i].first_lane = i;
     }
 
-    OPENSSL_free(t_data);
-    OPENSSL_free(t);
+    for (; started < ctx->threads; ++started) {
+        t[started] = ossl_crypto_thread_start(ctx->libctx, &fill_segment_thr,
+                                              (void *)&t_data[started]);
+        if (t[started] == NULL)
+            break;
+    }
 
-    return 1;
+    if (started == ctx->threads) {
+        ret = fill_segment_thr(&t_data[0]) != 0;
+    } else {
+        /* Release the workers that did start from their first sync point */
+        ossl_crypto_mutex_lock(sync.lock);
+        sync.abort = 1;
+        ossl_crypto_condvar_broadcast(sync.cond);
+        ossl_crypto_mutex_unlock(sync.lock);
+    }
 
-fail:
-    if (t_data != NULL)
-        OPENSSL_free(t_data);
-    if (t != NULL)
-        OPENSSL_free(t);
-    return 0;
+    for (i = 1; i < started; ++i) {
+        if (ossl_crypto_thread_join(t[i], NULL) == 0)
+            ret = 0;
+        if (ossl_crypto_thread_clean(t[i]) == 0)
+            ret = 0;
+    }
+
+end:
+    ossl_crypto_condvar_free(&sync.cond);
+    ossl_crypto_mutex_free(&sync.lock);
+    OPENSSL_free(t_data);
+    OPENSSL_free(t);
+    return ret;
 }
 
 # endif /* !defined(ARGON2_NO_THREADS) */
@@ -722,6 +753,20 @@ fail:
     EVP_MD_CTX_destroy(mdctx);
 }
 
+static void free_memory(KDF_ARGON2 *ctx)
+{
+    if (ctx->memory == NULL)
+        return;
+
+    if (ctx->type != ARGON2_D)
+        OPENSSL_secure_clear_free(ctx->memory,
+                                  ctx->memory_alloc * sizeof(BLOCK));
+    else
+        OPENSSL_clear_free(ctx->memory, ctx->memory_alloc * sizeof(BLOCK));
+    ctx->memory = NULL;
+    ctx->memory_alloc = 0;
+}
+
 static int initialize(KDF_ARGON2 *ctx)
 {
     uint8_t blockhash[ARGON2_PREHASH_SEED_LENGTH];
@@ -732,17 +777,27 @@ static int initialize(KDF_ARGON2 *ctx)
     if (ctx->memory_blocks * sizeof(BLOCK) / sizeof(BLOCK) != ctx->memory_blocks)
         return 0;
 
-    if (ctx->type != ARGON2_D)
-        ctx->memory = OPENSSL_secure_zalloc(ctx->memory_blocks *
-                                            sizeof(BLOCK));
-    else
-        ctx->memory = OPENSSL_zalloc(ctx->memory_blocks *
-                                     sizeof(BLOCK));
-
+    /*
+     * The memory is kept from one derivation to the next, which saves the
+     * cost of faulting in fresh pages for every hash.  Every block is
+     * written before it is read, so it need not be zeroed.
+     */
+    if (ctx->memory_alloc < ctx->memory_blocks)
+        free_memory(ctx);
     if (ctx->memory == NULL) {
-        ERR_raise_data(ERR_LIB_PROV, PROV_R_INVALID_MEMORY_SIZE,
-                       "cannot allocate required memory");
-        return 0;
+        if (ctx->type != ARGON2_D)
+            ctx->memory = OPENSSL_secure_malloc(ctx->memory_blocks *
+                                                sizeof(BLOCK));
+        else
+            ctx->memory = OPENSSL_malloc(ctx->memory_blocks *
+                                         sizeof(BLOCK));
+
+        if (ctx->memory == NULL) {
+            ERR_raise_data(ERR_LIB_PROV, PROV_R_INVALID_MEMORY_SIZE,
+                           "cannot allocate required memory");
+            return 0;
+        }
+        ctx->memory_alloc = ctx->memory_blocks;
     }
 
     initial_hash(blockhash, ctx);
@@ -778,13 +833,7 @@ static void finalize(const KDF_ARGON2 *ctx, void *out)
                  ARGON2_BLOCK_SIZE);
     OPENSSL_cleanse(blockhash.v, ARGON2_BLOCK_SIZE);
     OPENSSL_cleanse(blockhash_bytes, ARGON2_BLOCK_SIZE);
-
-    if (ctx->type != ARGON2_D)
-        OPENSSL_secure_clear_free(ctx->memory,
-                                  ctx->memory_blocks * sizeof(BLOCK));
-    else
-        OPENSSL_clear_free(ctx->memory,
-                           ctx->memory_blocks * sizeof(BLOCK));
+    OPENSSL_cleanse(ctx->memory, ctx->memory_blocks * sizeof(BLOCK));
 }
 
 static int blake2b_mac(EVP_MAC *mac, void *out, size_t outlen, const void *in,
@@ -1001,6 +1050,8 @@ static void kdf_argon2_free(void *vctx)
     if (ctx->ad != NULL)
         OPENSSL_clear_free(ctx->ad, ctx->adlen);
 
+    free_memory(ctx);
+
     EVP_MD_free(ctx->md);
     EVP_MAC_free(ctx->mac);
 
@@ -1098,7 +1149,6 @@ static int kdf_argon2_derive(void *vctx, unsigned char *out, size_t outlen,
     segment_length = memory_blocks / (ctx->lanes * ARGON2_SYNC_POINTS);
     memory_blocks = segment_length * (ctx->lanes * ARGON2_SYNC_POINTS);
 
-    ctx->memory = NULL;
     ctx->memory_blocks = memory_blocks;
     ctx->segment_length = segment_length;
     ctx->passes = ctx->t_cost;
@@ -1107,8 +1157,10 @@ static int kdf_argon2_derive(void *vctx, unsigned char *out, size_t outlen,
     if (initialize(ctx) != 1)
         return 0;
 
-    if (fill_memory_blocks(ctx) != 1)
+    if (fill_memory_blocks(ctx) != 1) {
+        OPENSSL_cleanse(ctx->memory, ctx->memory_blocks * sizeof(BLOCK));
         return 0;
+    }
 
     finalize(ctx, out);
 
@@ -1125,6 +1177,8 @@ static void kdf_argon2_reset(void *vctx)
     type = ctx->type;
     libctx = ctx->libctx;
 
+    free_memory(ctx);
+
     EVP_MD_free(ctx->md);
     EVP_MAC_free(ctx->mac);
 
@@ -24,6 +24,7 @@
 #include <internal/cryptlib.h>
 #include <internal/numbers.h>
 #include <crypto/evp.h>
+#include <crypto/sha.h>
 #include <providers/provider_ctx.h>
 #include <providers/providercommon.h>
 #include <providers/implementations.h>
@@ -49,7 +50,7 @@ static OSSL_FUNC_kdf_get_ctx_params_fn kdf_pbkdf2_get_ctx_params;
 static int pbkdf2_derive(const char *pass, size_t passlen,
                          const unsigned char *salt, int saltlen, uint64_t iter,
                          const EVP_MD *digest, unsigned char *key,
-                         size_t keylen, int extra_checks);
+                         size_t keylen, int extra_checks, int builtin_sha256);
 
 typedef struct {
     void *provctx;
@@ -170,6 +171,23 @@ static int pbkdf2_set_membuf(unsigned char **buffer, size_t *buflen,
     return 1;
 }
 
+/*
+ * SHA-256 from this provider can be done with the low level code, which
+ * runs several output blocks side by side.  A SHA-256 from elsewhere is
+ * used through EVP like any other digest.
+ */
+static int pbkdf2_is_builtin_sha256(KDF_PBKDF2 *ctx, const EVP_MD *md)
+{
+    const OSSL_PROVIDER *prov;
+
+    if (md == NULL || ossl_prov_digest_engine(&ctx->digest) != NULL
+            || !EVP_MD_is_a(md, SN_sha256))
+        return 0;
+    prov = EVP_MD_get0_provider(md);
+    return prov != NULL
+        && OSSL_PROVIDER_get0_provider_ctx(prov) == ctx->provctx;
+}
+
 static int kdf_pbkdf2_derive(void *vctx, unsigned char *key, size_t keylen,
                              const OSSL_PARAM params[])
 {
@@ -192,7 +210,8 @@ static int kdf_pbkdf2_derive(void *vctx, unsigned char *key, size_t keylen,
     md = ossl_prov_digest_md(&ctx->digest);
     return pbkdf2_derive((char *)ctx->pass, ctx->pass_len,
                          ctx->salt, ctx->salt_len, ctx->iter,
-                         md, key, keylen, ctx->lower_bound_checks);
+                         md, key, keylen, ctx->lower_bound_checks,
+                         pbkdf2_is_builtin_sha256(ctx, md));
 }
 
 static int kdf_pbkdf2_set_ctx_params(void *vctx, const OSSL_PARAM params[])
@@ -291,6 +310,102 @@ const OSSL_DISPATCH ossl_kdf_pbkdf2_functions[] = {
     OSSL_DISPATCH_END
 };
 
+/* The output blocks done together by pbkdf2_sha256() */
+#define PBKDF2_SHA256_CHAINS 8
+
+static void pbkdf2_sha256_pad(SHA256_CTX *c, const unsigned char *k,
+                              unsigned char pad)
+{
+    unsigned char blk[SHA256_CBLOCK];
+    int i;
+
+    for (i = 0; i < SHA256_CBLOCK; i++)
+        blk[i] = k[i] ^ pad;
+    SHA256_Init(c);
+    SHA256_Update(c, blk, sizeof(blk));
+    OPENSSL_cleanse(blk, sizeof(blk));
+}
+
+/*
+ * PBKDF2 with HMAC-SHA256, the HMAC done by hand from the hash states of
+ * the two padded keys.  Each iteration is then just two compressions, and
+ * up to eight output blocks are iterated together.
+ */
+static int pbkdf2_sha256(const char *pass, size_t passlen,
+                         const unsigned char *salt, int saltlen,
+                         uint64_t iter, unsigned char *key, size_t keylen)
+{
+    SHA256_HMAC_CHAIN c[PBKDF2_SHA256_CHAINS];
+    SHA256_CTX ictx, octx, sctx;
+    unsigned char k[SHA256_CBLOCK], digtmp[SHA256_DIGEST_LENGTH], itmp[4];
+    unsigned long i = 1;
+    size_t n, l, m, cplen;
+
+    memset(k, 0, sizeof(k));
+    if (passlen > SHA256_CBLOCK) {
+        SHA256_Init(&sctx);
+        SHA256_Update(&sctx, pass, passlen);
+        SHA256_Final(k, &sctx);
+    } else if (passlen > 0) {
+        memcpy(k, pass, passlen);
+    }
+    pbkdf2_sha256_pad(&ictx, k, 0x36);
+    pbkdf2_sha256_pad(&octx, k, 0x5c);
+
+    while (keylen > 0) {
+        n = (keylen + SHA256_DIGEST_LENGTH - 1) / SHA256_DIGEST_LENGTH;
+        if (n > PBKDF2_SHA256_CHAINS)
+            n = PBKDF2_SHA256_CHAINS;
+
+        for (l = 0; l < n; l++, i++) {
+            itmp[0] = (unsigned char)((i >> 24) & 0xff);
+            itmp[1] = (unsigned char)((i >> 16) & 0xff);
+            itmp[2] = (unsigned char)((i >> 8) & 0xff);
+            itmp[3] = (unsigned char)(i & 0xff);
+
+            /* U_1 = HMAC(P, S || INT(i)) */
+            sctx = ictx;
+            SHA256_Update(&sctx, salt, saltlen);
+            SHA256_Update(&sctx, itmp, 4);
+            SHA256_Final(digtmp, &sctx);
+            sctx = octx;
+            SHA256_Update(&sctx, digtmp, sizeof(digtmp));
+            SHA256_Final(digtmp, &sctx);
+            memcpy(c[l].ipad, ictx.h, sizeof(c[l].ipad));
+            memcpy(c[l].opad, octx.h, sizeof(c[l].opad));
+            for (m = 0; m < 8; m++)
+                c[l].u[m] = c[l].t[m] =
+                    ((SHA_LONG)digtmp[4 * m] << 24)
+                    | ((SHA_LONG)digtmp[4 * m + 1] << 16)
+                    | ((SHA_LONG)digtmp[4 * m + 2] << 8)
+                    | (SHA_LONG)digtmp[4 * m + 3];
+        }
+
+        ossl_sha256_hmac_chain(c, n, iter - 1);
+
+        for (l = 0; l < n; l++) {
+            for (m = 0; m < 8; m++) {
+                digtmp[4 * m] = (unsigned char)(c[l].t[m] >> 24);
+                digtmp[4 * m + 1] = (unsigned char)(c[l].t[m] >> 16);
+                digtmp[4 * m + 2] = (unsigned char)(c[l].t[m] >> 8);
+                digtmp[4 * m + 3] = (unsigned char)c[l].t[m];
+            }
+            cplen = keylen < SHA256_DIGEST_LENGTH ? keylen : SHA256_DIGEST_LENGTH;
+            memcpy(key, digtmp, cplen);
+            key += cplen;
+            keylen -= cplen;
+        }
+    }
+
+    OPENSSL_cleanse(c, sizeof(c));
+    OPENSSL_cleanse(&ictx, sizeof(ictx));
+    OPENSSL_cleanse(&octx, sizeof(octx));
+    OPENSSL_cleanse(&sctx, sizeof(sctx));
+    OPENSSL_cleanse(k, sizeof(k));
+    OPENSSL_cleanse(digtmp, sizeof(digtmp));
+    return 1;
+}
+
 /*
  * This is an implementation of PKCS#5 v2.0 password based encryption key
  * derivation function PBKDF2. SHA1 version verified against test vectors
@@ -304,7 +419,8 @@ const OSSL_DISPATCH ossl_kdf_pbkdf2_functions[] = {
 static int pbkdf2_derive(const char *pass, size_t passlen,
                          const unsigned char *salt, int saltlen, uint64_t iter,
                          const EVP_MD *digest, unsigned char *key,
-                         size_t keylen, int lower_bound_checks)
+                         size_t keylen, int lower_bound_checks,
+                         int builtin_sha256)
 {
     int ret = 0;
     unsigned char digtmp[EVP_MAX_MD_SIZE], *p, itmp[4];
@@ -341,6 +457,9 @@ static int pbkdf2_derive(const char *pass, size_t passlen,
         }
     }
 
+    if (builtin_sha256 && iter > 0)
+        return pbkdf2_sha256(pass, passlen, salt, saltlen, iter, key, keylen);
+
     hctx_tpl = HMAC_CTX_new();
     if (hctx_tpl == NULL)
         return 0;
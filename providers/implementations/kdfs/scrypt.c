@@ -17,6 +17,7 @@
 #include <openssl/proverr.h>
 #include <crypto/evp.h>
 #include <internal/numbers.h>
+#include <internal/thread.h>
 #include <providers/implementations.h>
 #include <providers/provider_ctx.h>
 #include <providers/providercommon.h>
@@ -24,6 +25,14 @@
 
 #ifndef OPENSSL_NO_SCRYPT
 
+#if defined(OPENSSL_NO_DEFAULT_THREAD_POOL) && defined(OPENSSL_NO_THREAD_POOL)
+# define SCRYPT_NO_THREADS
+#endif
+
+#if !defined(OPENSSL_THREADS)
+# define SCRYPT_NO_THREADS
+#endif
+
 static OSSL_FUNC_kdf_newctx_fn kdf_scrypt_new;
 static OSSL_FUNC_kdf_dupctx_fn kdf_scrypt_dup;
 static OSSL_FUNC_kdf_freectx_fn kdf_scrypt_free;
@@ -38,7 +47,8 @@ static int scrypt_alg(const char *pass, size_t passlen,
                       const unsigned char *salt, size_t saltlen,
                       uint64_t N, uint64_t r, uint64_t p, uint64_t maxmem,
                       unsigned char *key, size_t keylen, EVP_MD *sha256,
-                      OSSL_LIB_CTX *libctx, const char *propq);
+                      OSSL_LIB_CTX *libctx, const char *propq,
+                      uint32_t threads, unsigned char **mem, size_t *memlen);
 
 typedef struct {
     OSSL_LIB_CTX *libctx;
@@ -50,7 +60,11 @@ typedef struct {
     uint64_t N;
     uint64_t r, p;
     uint64_t maxmem_bytes;
+    uint32_t threads;
     EVP_MD *sha256;
+    /* Working memory, kept for the next derivation */
+    unsigned char *mem;
+    size_t mem_len;
 } KDF_SCRYPT;
 
 static void kdf_scrypt_init(KDF_SCRYPT *ctx);
@@ -93,6 +107,9 @@ static void kdf_scrypt_reset(void *vctx)
 
     OPENSSL_free(ctx->salt);
     OPENSSL_clear_free(ctx->pass, ctx->pass_len);
+    OPENSSL_clear_free(ctx->mem, ctx->mem_len);
+    ctx->mem = NULL;
+    ctx->mem_len = 0;
     kdf_scrypt_init(ctx);
 }
 
@@ -119,6 +136,7 @@ static void *kdf_scrypt_dup(void *vctx)
         dest->r = src->r;
         dest->p = src->p;
         dest->maxmem_bytes = src->maxmem_bytes;
+        dest->threads = src->threads;
         dest->sha256 = src->sha256;
     }
     return dest;
@@ -138,6 +156,7 @@ static void kdf_scrypt_init(KDF_SCRYPT *ctx)
     ctx->r = 8;
     ctx->p = 1;
     ctx->maxmem_bytes = 1025 * 1024 * 1024;
+    ctx->threads = 1;
 }
 
 static int scrypt_set_membuf(unsigned char **buffer, size_t *buflen,
@@ -205,7 +224,8 @@ static int kdf_scrypt_derive(void *vctx, unsigned char *key, size_t keylen,
     return scrypt_alg((char *)ctx->pass, ctx->pass_len, ctx->salt,
                       ctx->salt_len, ctx->N, ctx->r, ctx->p,
                       ctx->maxmem_bytes, key, keylen, ctx->sha256,
-                      ctx->libctx, ctx->propq);
+                      ctx->libctx, ctx->propq, ctx->threads,
+                      &ctx->mem, &ctx->mem_len);
 }
 
 static int is_power_of_two(uint64_t value)
@@ -260,6 +280,15 @@ static int kdf_scrypt_set_ctx_params(void *vctx, const OSSL_PARAM params[])
         ctx->maxmem_bytes = u64_value;
     }
 
+    if ((p = OSSL_PARAM_locate_const(params, OSSL_KDF_PARAM_THREADS))
+        != NULL) {
+        uint32_t threads;
+
+        if (!OSSL_PARAM_get_uint32(p, &threads) || threads < 1)
+            return 0;
+        ctx->threads = threads;
+    }
+
     p = OSSL_PARAM_locate_const(params, OSSL_KDF_PARAM_PROPERTIES);
     if (p != NULL) {
         if (p->data_type != OSSL_PARAM_UTF8_STRING
@@ -280,6 +309,7 @@ static const OSSL_PARAM *kdf_scrypt_settable_ctx_params(ossl_unused void *ctx,
         OSSL_PARAM_uint32(OSSL_KDF_PARAM_SCRYPT_R, NULL),
         OSSL_PARAM_uint32(OSSL_KDF_PARAM_SCRYPT_P, NULL),
         OSSL_PARAM_uint64(OSSL_KDF_PARAM_SCRYPT_MAXMEM, NULL),
+        OSSL_PARAM_uint32(OSSL_KDF_PARAM_THREADS, NULL),
         OSSL_PARAM_utf8_string(OSSL_KDF_PARAM_PROPERTIES, NULL, 0),
         OSSL_PARAM_END
     };
@@ -366,27 +396,27 @@ static void salsa208_word_specification(uint32_t inout[16])
     OPENSSL_cleanse(x, sizeof(x));
 }
 
-static void scryptBlockMix(uint32_t *B_, uint32_t *B, uint64_t r)
+/* |X| is 16 words of scratch space */
+static void scryptBlockMix(uint32_t *B_, uint32_t *B, uint64_t r, uint32_t *X)
 {
     uint64_t i, j;
-    uint32_t X[16], *pB;
+    uint32_t *pB;
 
-    memcpy(X, B + (r * 2 - 1) * 16, sizeof(X));
+    memcpy(X, B + (r * 2 - 1) * 16, 16 * sizeof(*X));
     pB = B;
     for (i = 0; i < r * 2; i++) {
         for (j = 0; j < 16; j++)
             X[j] ^= *pB++;
         salsa208_word_specification(X);
-        memcpy(B_ + (i / 2 + (i & 1) * r) * 16, X, sizeof(X));
+        memcpy(B_ + (i / 2 + (i & 1) * r) * 16, X, 16 * sizeof(*X));
     }
-    OPENSSL_cleanse(X, sizeof(X));
 }
 
 static void scryptROMix(unsigned char *B, uint64_t r, uint64_t N,
                         uint32_t *X, uint32_t *T, uint32_t *V)
 {
     unsigned char *pB;
-    uint32_t *pV;
+    uint32_t *pV, S[16];
     uint64_t i, k;
 
     /* Convert from little endian input */
@@ -398,18 +428,20 @@ static void scryptROMix(unsigned char *B, uint64_t r, uint64_t N,
     }
 
     for (i = 1; i < N; i++, pV += 32 * r)
-        scryptBlockMix(pV, pV - 32 * r, r);
+        scryptBlockMix(pV, pV - 32 * r, r, S);
 
-    scryptBlockMix(X, V + (N - 1) * 32 * r, r);
+    scryptBlockMix(X, V + (N - 1) * 32 * r, r, S);
 
     for (i = 0; i < N; i++) {
         uint32_t j;
-        j = X[16 * (2 * r - 1)] % N;
+        /* N is a power of 2 */
+        j = X[16 * (2 * r - 1)] & (uint32_t)(N - 1);
         pV = V + 32 * r * j;
         for (k = 0; k < 32 * r; k++)
             T[k] = X[k] ^ *pV++;
-        scryptBlockMix(X, T, r);
+        scryptBlockMix(X, T, r, S);
     }
+    OPENSSL_cleanse(S, sizeof(S));
     /* Convert output to little endian */
     for (i = 0, pB = B; i < 32 * r; i++) {
         uint32_t xtmp = X[i];
@@ -440,16 +472,103 @@ static void scryptROMix(unsigned char *B, uint64_t r, uint64_t N,
 
 #define SCRYPT_PR_MAX   ((1 << 30) - 1)
 
+/*
+ * One thread's share of the p ROMix instances, each with its own X, T
+ * and V.
+ */
+typedef struct {
+    unsigned char *B;
+    uint64_t r, N, p;
+    uint64_t first, step;
+    uint32_t *X, *T, *V;
+} SCRYPT_ROMIX_JOB;
+
+static void scrypt_romix_job(SCRYPT_ROMIX_JOB *job)
+{
+    uint64_t i;
+
+    for (i = job->first; i < job->p; i += job->step)
+        scryptROMix(job->B + 128 * job->r * i, job->r, job->N,
+                    job->X, job->T, job->V);
+}
+
+#ifndef SCRYPT_NO_THREADS
+static uint32_t scrypt_romix_thr(void *data)
+{
+    scrypt_romix_job((SCRYPT_ROMIX_JOB *)data);
+    return 1;
+}
+#endif
+
+/*
+ * Runs the p instances on |nthreads| threads, the calling thread included.
+ * Any share that can't be given to a thread is done by the caller.
+ */
+static int scrypt_romix_all(unsigned char *B, uint64_t r, uint64_t N,
+                            uint64_t p, uint64_t nthreads, size_t Vlen,
+                            OSSL_LIB_CTX *libctx)
+{
+    SCRYPT_ROMIX_JOB *jobs;
+    void **t;
+    uint64_t k;
+    int rv = 1;
+
+    jobs = OPENSSL_zalloc(nthreads * sizeof(*jobs));
+    t = OPENSSL_zalloc(nthreads * sizeof(*t));
+    if (jobs == NULL || t == NULL) {
+        rv = 0;
+        goto end;
+    }
+
+    for (k = 0; k < nthreads; k++) {
+        jobs[k].B = B;
+        jobs[k].r = r;
+        jobs[k].N = N;
+        jobs[k].p = p;
+        jobs[k].first = k;
+        jobs[k].step = nthreads;
+        jobs[k].X = (uint32_t *)(B + p * 128 * r + k * Vlen);
+        jobs[k].T = jobs[k].X + 32 * r;
+        jobs[k].V = jobs[k].T + 32 * r;
+    }
+
+#ifndef SCRYPT_NO_THREADS
+    for (k = 1; k < nthreads; k++)
+        t[k] = ossl_crypto_thread_start(libctx, &scrypt_romix_thr, &jobs[k]);
+#endif
+
+    for (k = 0; k < nthreads; k++)
+        if (t[k] == NULL)
+            scrypt_romix_job(&jobs[k]);
+
+#ifndef SCRYPT_NO_THREADS
+    for (k = 1; k < nthreads; k++) {
+        if (t[k] == NULL)
+            continue;
+        if (ossl_crypto_thread_join(t[k], NULL) == 0)
+            rv = 0;
+        if (ossl_crypto_thread_clean(t[k]) == 0)
+            rv = 0;
+    }
+#endif
+
+ end:
+    OPENSSL_free(jobs);
+    OPENSSL_free(t);
+    return rv;
+}
+
 static int scrypt_alg(const char *pass, size_t passlen,
                       const unsigned char *salt, size_t saltlen,
                       uint64_t N, uint64_t r, uint64_t p, uint64_t maxmem,
                       unsigned char *key, size_t keylen, EVP_MD *sha256,
-                      OSSL_LIB_CTX *libctx, const char *propq)
+                      OSSL_LIB_CTX *libctx, const char *propq,
+                      uint32_t threads, unsigned char **mem, size_t *memlen)
 {
     int rv = 0;
     unsigned char *B;
-    uint32_t *X, *V, *T;
-    uint64_t i, Blen, Vlen;
+    uint64_t i, Blen, Vlen, nthreads;
+    size_t len;
 
     /* Sanity check parameters */
     /* initial check, r,p must be non zero, N >= 2 and a power of 2 */
@@ -520,18 +639,39 @@ static int scrypt_alg(const char *pass, size_t passlen,
     if (key == NULL)
         return 1;
 
-    B = OPENSSL_malloc((size_t)(Blen + Vlen));
-    if (B == NULL)
-        return 0;
-    X = (uint32_t *)(B + Blen);
-    T = X + 32 * r;
-    V = T + 32 * r;
+    /*
+     * Each extra thread needs its own V, so use only as many threads as
+     * there are instances, free threads in the pool, and memory for.
+     */
+    nthreads = threads < p ? threads : p;
+#ifndef SCRYPT_NO_THREADS
+    if (nthreads > 1) {
+        i = ossl_get_avail_threads(libctx);
+        if (nthreads > i + 1)
+            nthreads = i + 1;
+    }
+#else
+    nthreads = 1;
+#endif
+    while (nthreads > 1 && Vlen > (maxmem - Blen) / nthreads)
+        nthreads--;
+    len = (size_t)(Blen + nthreads * Vlen);
+
+    /* The memory is kept for the next derivation if it is large enough */
+    if (*memlen < len) {
+        OPENSSL_clear_free(*mem, *memlen);
+        *memlen = 0;
+        if ((*mem = OPENSSL_malloc(len)) == NULL)
+            return 0;
+        *memlen = len;
+    }
+    B = *mem;
     if (ossl_pkcs5_pbkdf2_hmac_ex(pass, passlen, salt, saltlen, 1, sha256,
                                   (int)Blen, B, libctx, propq) == 0)
         goto err;
 
-    for (i = 0; i < p; i++)
-        scryptROMix(B + 128 * r * i, r, N, X, T, V);
+    if (!scrypt_romix_all(B, r, N, p, nthreads, (size_t)Vlen, libctx))
+        goto err;
 
     if (ossl_pkcs5_pbkdf2_hmac_ex(pass, passlen, B, (int)Blen, 1, sha256,
                                   keylen, key, libctx, propq) == 0)
@@ -541,7 +681,7 @@ static int scrypt_alg(const char *pass, size_t passlen,
     if (rv == 0)
         ERR_raise(ERR_LIB_EVP, EVP_R_PBKDF2_ERROR);
 
-    OPENSSL_clear_free(B, (size_t)(Blen + Vlen));
+    OPENSSL_cleanse(B, len);
     return rv;
 }
 
@@ -0,0 +1,231 @@
+/*
+ * Copyright 2024 The OpenSSL Project Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License 2.0 (the "License").  You may not use
+ * this file except in compliance with the License.  You can obtain a copy
+ * in the file LICENSE in the source distribution or at
+ * https://www.openssl.org/source/license.html
+ */
+
+/* ML-KEM, FIPS 203, for all three parameter sets */
+
+#include <string.h>
+#include <openssl/crypto.h>
+#include <openssl/evp.h>
+#include <openssl/core_dispatch.h>
+#include <openssl/core_names.h>
+#include <openssl/params.h>
+#include <openssl/err.h>
+#include <openssl/proverr.h>
+#include <crypto/ml_kem.h>
+#include <providers/provider_ctx.h>
+#include <providers/implementations.h>
+#include <providers/providercommon.h>
+
+static OSSL_FUNC_kem_newctx_fn ml_kem_newctx;
+static OSSL_FUNC_kem_freectx_fn ml_kem_freectx;
+static OSSL_FUNC_kem_dupctx_fn ml_kem_dupctx;
+static OSSL_FUNC_kem_encapsulate_init_fn ml_kem_encapsulate_init;
+static OSSL_FUNC_kem_encapsulate_fn ml_kem_encapsulate;
+static OSSL_FUNC_kem_decapsulate_init_fn ml_kem_decapsulate_init;
+static OSSL_FUNC_kem_decapsulate_fn ml_kem_decapsulate;
+static OSSL_FUNC_kem_set_ctx_params_fn ml_kem_set_ctx_params;
+static OSSL_FUNC_kem_settable_ctx_params_fn ml_kem_settable_ctx_params;
+
+typedef struct {
+    OSSL_LIB_CTX *libctx;
+    ML_KEM_KEY *key;
+    uint8_t *entropy;           /* NULL, or entropy_buf once "ikme" is set */
+    uint8_t entropy_buf[ML_KEM_RANDOM_BYTES];
+} PROV_ML_KEM_CTX;
+
+static void *ml_kem_newctx(void *provctx)
+{
+    PROV_ML_KEM_CTX *ctx;
+
+    if (!ossl_prov_is_running())
+        return NULL;
+    if ((ctx = OPENSSL_zalloc(sizeof(*ctx))) == NULL)
+        return NULL;
+    ctx->libctx = PROV_LIBCTX_OF(provctx);
+    return ctx;
+}
+
+static void ml_kem_freectx(void *vctx)
+{
+    PROV_ML_KEM_CTX *ctx = vctx;
+
+    if (ctx == NULL)
+        return;
+    OPENSSL_clear_free(ctx, sizeof(*ctx));
+}
+
+/* The key belongs to the EVP_PKEY, so a duplicate shares it */
+static void *ml_kem_dupctx(void *vctx)
+{
+    PROV_ML_KEM_CTX *src = vctx, *dst;
+
+    if (!ossl_prov_is_running())
+        return NULL;
+    if ((dst = OPENSSL_memdup(src, sizeof(*src))) == NULL)
+        return NULL;
+    if (src->entropy != NULL)
+        dst->entropy = dst->entropy_buf;
+    return dst;
+}
+
+static int ml_kem_init(void *vctx, int operation, void *vkey,
+                       const OSSL_PARAM params[])
+{
+    PROV_ML_KEM_CTX *ctx = vctx;
+    ML_KEM_KEY *key = vkey;
+
+    if (!ossl_prov_is_running())
+        return 0;
+
+    if (operation == EVP_PKEY_OP_ENCAPSULATE
+        ? !ossl_ml_kem_have_pubkey(key) : !ossl_ml_kem_have_prvkey(key)) {
+        ERR_raise(ERR_LIB_PROV, PROV_R_MISSING_KEY);
+        return 0;
+    }
+    ctx->key = key;
+    ctx->entropy = NULL;
+    return ml_kem_set_ctx_params(vctx, params);
+}
+
+static int ml_kem_encapsulate_init(void *vctx, void *vkey,
+                                   const OSSL_PARAM params[])
+{
+    return ml_kem_init(vctx, EVP_PKEY_OP_ENCAPSULATE, vkey, params);
+}
+
+static int ml_kem_decapsulate_init(void *vctx, void *vkey,
+                                   const OSSL_PARAM params[])
+{
+    return ml_kem_init(vctx, EVP_PKEY_OP_DECAPSULATE, vkey, params);
+}
+
+/*
+ * "ikme" fixes the encapsulation randomness, the m of FIPS 203.  This is
+ * for known answer tests only.
+ */
+static int ml_kem_set_ctx_params(void *vctx, const OSSL_PARAM params[])
+{
+    PROV_ML_KEM_CTX *ctx = vctx;
+    const OSSL_PARAM *p;
+
+    if (ctx == NULL)
+        return 0;
+
+    p = OSSL_PARAM_locate_const(params, OSSL_KEM_PARAM_IKME);
+    if (p != NULL) {
+        void *buf = ctx->entropy_buf;
+        size_t len;
+
+        if (!OSSL_PARAM_get_octet_string(p, &buf, sizeof(ctx->entropy_buf),
+                                         &len)
+            || len != sizeof(ctx->entropy_buf)) {
+            ERR_raise(ERR_LIB_PROV, PROV_R_INVALID_SEED_LENGTH);
+            return 0;
+        }
+        ctx->entropy = ctx->entropy_buf;
+    }
+    return 1;
+}
+
+static const OSSL_PARAM *ml_kem_settable_ctx_params(ossl_unused void *vctx,
+                                                    ossl_unused void *provctx)
+{
+    static const OSSL_PARAM settable[] = {
+        OSSL_PARAM_octet_string(OSSL_KEM_PARAM_IKME, NULL, 0),
+        OSSL_PARAM_END
+    };
+
+    return settable;
+}
+
+static int ml_kem_encapsulate(void *vctx, unsigned char *out, size_t *outlen,
+                              unsigned char *secret, size_t *secretlen)
+{
+    PROV_ML_KEM_CTX *ctx = vctx;
+    const ML_KEM_VINFO *vinfo = ossl_ml_kem_key_vinfo(ctx->key);
+    int ret;
+
+    if (out == NULL) {
+        if (outlen == NULL && secretlen == NULL)
+            return 0;
+        if (outlen != NULL)
+            *outlen = vinfo->ctext_bytes;
+        if (secretlen != NULL)
+            *secretlen = ML_KEM_SHARED_SECRET_BYTES;
+        return 1;
+    }
+    if (secret == NULL || secretlen == NULL || outlen == NULL)
+        return 0;
+    if (*secretlen < ML_KEM_SHARED_SECRET_BYTES) {
+        ERR_raise(ERR_LIB_PROV, PROV_R_BAD_LENGTH);
+        return 0;
+    }
+    if (*outlen < vinfo->ctext_bytes) {
+        ERR_raise(ERR_LIB_PROV, PROV_R_OUTPUT_BUFFER_TOO_SMALL);
+        return 0;
+    }
+
+    if (ctx->entropy != NULL)
+        ret = ossl_ml_kem_encap_seed(out, vinfo->ctext_bytes,
+                                     secret, ML_KEM_SHARED_SECRET_BYTES,
+                                     ctx->entropy, ML_KEM_RANDOM_BYTES,
+                                     ctx->key);
+    else
+        ret = ossl_ml_kem_encap_rand(out, vinfo->ctext_bytes,
+                                     secret, ML_KEM_SHARED_SECRET_BYTES,
+                                     ctx->key);
+    if (!ret)
+        return 0;
+    *outlen = vinfo->ctext_bytes;
+    *secretlen = ML_KEM_SHARED_SECRET_BYTES;
+    return 1;
+}
+
+static int ml_kem_decapsulate(void *vctx, unsigned char *out, size_t *outlen,
+                              const unsigned char *in, size_t inlen)
+{
+    PROV_ML_KEM_CTX *ctx = vctx;
+    const ML_KEM_VINFO *vinfo = ossl_ml_kem_key_vinfo(ctx->key);
+
+    if (out == NULL) {
+        if (outlen == NULL)
+            return 0;
+        *outlen = ML_KEM_SHARED_SECRET_BYTES;
+        return 1;
+    }
+    if (outlen == NULL || *outlen < ML_KEM_SHARED_SECRET_BYTES) {
+        ERR_raise(ERR_LIB_PROV, PROV_R_OUTPUT_BUFFER_TOO_SMALL);
+        return 0;
+    }
+    if (inlen != vinfo->ctext_bytes) {
+        ERR_raise(ERR_LIB_PROV, PROV_R_INVALID_INPUT_LENGTH);
+        return 0;
+    }
+    if (!ossl_ml_kem_decap(out, ML_KEM_SHARED_SECRET_BYTES, in, inlen,
+                           ctx->key))
+        return 0;
+    *outlen = ML_KEM_SHARED_SECRET_BYTES;
+    return 1;
+}
+
+const OSSL_DISPATCH ossl_ml_kem_asym_kem_functions[] = {
+    { OSSL_FUNC_KEM_NEWCTX, (void (*)(void))ml_kem_newctx },
+    { OSSL_FUNC_KEM_ENCAPSULATE_INIT,
+      (void (*)(void))ml_kem_encapsulate_init },
+    { OSSL_FUNC_KEM_ENCAPSULATE, (void (*)(void))ml_kem_encapsulate },
+    { OSSL_FUNC_KEM_DECAPSULATE_INIT,
+      (void (*)(void))ml_kem_decapsulate_init },
+    { OSSL_FUNC_KEM_DECAPSULATE, (void (*)(void))ml_kem_decapsulate },
+    { OSSL_FUNC_KEM_FREECTX, (void (*)(void))ml_kem_freectx },
+    { OSSL_FUNC_KEM_DUPCTX, (void (*)(void))ml_kem_dupctx },
+    { OSSL_FUNC_KEM_SET_CTX_PARAMS, (void (*)(void))ml_kem_set_ctx_params },
+    { OSSL_FUNC_KEM_SETTABLE_CTX_PARAMS,
+      (void (*)(void))ml_kem_settable_ctx_params },
+    OSSL_DISPATCH_END
+};
@@ -0,0 +1,210 @@
+/*
+ * Copyright 2024 The OpenSSL Project Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License 2.0 (the "License").  You may not use
+ * this file except in compliance with the License.  You can obtain a copy
+ * in the file LICENSE in the source distribution or at
+ * https://www.openssl.org/source/license.html
+ */
+
+/* The X25519MLKEM768 hybrid, an ML-KEM-768 KEM run alongside X25519 */
+
+#include <string.h>
+#include <openssl/crypto.h>
+#include <openssl/evp.h>
+#include <openssl/core_dispatch.h>
+#include <openssl/core_names.h>
+#include <openssl/params.h>
+#include <openssl/err.h>
+#include <openssl/proverr.h>
+#include <openssl/rand.h>
+#include <providers/mlx_kem.h>
+#include <providers/provider_ctx.h>
+#include <providers/implementations.h>
+#include <providers/providercommon.h>
+
+static OSSL_FUNC_kem_newctx_fn mlx_kem_newctx;
+static OSSL_FUNC_kem_freectx_fn mlx_kem_freectx;
+static OSSL_FUNC_kem_dupctx_fn mlx_kem_dupctx;
+static OSSL_FUNC_kem_encapsulate_init_fn mlx_kem_encapsulate_init;
+static OSSL_FUNC_kem_encapsulate_fn mlx_kem_encapsulate;
+static OSSL_FUNC_kem_decapsulate_init_fn mlx_kem_decapsulate_init;
+static OSSL_FUNC_kem_decapsulate_fn mlx_kem_decapsulate;
+static OSSL_FUNC_kem_set_ctx_params_fn mlx_kem_set_ctx_params;
+static OSSL_FUNC_kem_settable_ctx_params_fn mlx_kem_settable_ctx_params;
+
+typedef struct {
+    OSSL_LIB_CTX *libctx;
+    MLX_KEY *key;
+} PROV_MLX_KEM_CTX;
+
+static void *mlx_kem_newctx(void *provctx)
+{
+    PROV_MLX_KEM_CTX *ctx;
+
+    if (!ossl_prov_is_running())
+        return NULL;
+    if ((ctx = OPENSSL_zalloc(sizeof(*ctx))) == NULL)
+        return NULL;
+    ctx->libctx = PROV_LIBCTX_OF(provctx);
+    return ctx;
+}
+
+static void mlx_kem_freectx(void *vctx)
+{
+    OPENSSL_free(vctx);
+}
+
+static void *mlx_kem_dupctx(void *vctx)
+{
+    if (!ossl_prov_is_running())
+        return NULL;
+    return OPENSSL_memdup(vctx, sizeof(PROV_MLX_KEM_CTX));
+}
+
+static int mlx_kem_init(void *vctx, int operation, void *vkey,
+                        const OSSL_PARAM params[])
+{
+    PROV_MLX_KEM_CTX *ctx = vctx;
+    MLX_KEY *key = vkey;
+
+    if (!ossl_prov_is_running())
+        return 0;
+
+    if (operation == EVP_PKEY_OP_ENCAPSULATE
+        ? !ossl_ml_kem_have_pubkey(key->mkey)
+        : !ossl_ml_kem_have_prvkey(key->mkey)) {
+        ERR_raise(ERR_LIB_PROV, PROV_R_MISSING_KEY);
+        return 0;
+    }
+    ctx->key = key;
+    return mlx_kem_set_ctx_params(vctx, params);
+}
+
+static int mlx_kem_encapsulate_init(void *vctx, void *vkey,
+                                    const OSSL_PARAM params[])
+{
+    return mlx_kem_init(vctx, EVP_PKEY_OP_ENCAPSULATE, vkey, params);
+}
+
+static int mlx_kem_decapsulate_init(void *vctx, void *vkey,
+                                    const OSSL_PARAM params[])
+{
+    return mlx_kem_init(vctx, EVP_PKEY_OP_DECAPSULATE, vkey, params);
+}
+
+/* There are no settable parameters */
+static int mlx_kem_set_ctx_params(void *vctx, const OSSL_PARAM params[])
+{
+    return vctx != NULL;
+}
+
+static const OSSL_PARAM *mlx_kem_settable_ctx_params(ossl_unused void *vctx,
+                                                     ossl_unused void *provctx)
+{
+    static const OSSL_PARAM settable[] = {
+        OSSL_PARAM_END
+    };
+
+    return settable;
+}
+
+static int mlx_kem_encapsulate(void *vctx, unsigned char *out, size_t *outlen,
+                               unsigned char *secret, size_t *secretlen)
+{
+    PROV_MLX_KEM_CTX *ctx = vctx;
+    uint8_t eprv[X25519_KEYLEN];
+    int ret = 0;
+
+    if (out == NULL) {
+        if (outlen == NULL && secretlen == NULL)
+            return 0;
+        if (outlen != NULL)
+            *outlen = MLX_KEM_CIPHERTEXT_BYTES;
+        if (secretlen != NULL)
+            *secretlen = MLX_KEM_SHARED_SECRET_BYTES;
+        return 1;
+    }
+    if (secret == NULL || secretlen == NULL || outlen == NULL)
+        return 0;
+    if (*secretlen < MLX_KEM_SHARED_SECRET_BYTES) {
+        ERR_raise(ERR_LIB_PROV, PROV_R_BAD_LENGTH);
+        return 0;
+    }
+    if (*outlen < MLX_KEM_CIPHERTEXT_BYTES) {
+        ERR_raise(ERR_LIB_PROV, PROV_R_OUTPUT_BUFFER_TOO_SMALL);
+        return 0;
+    }
+
+    if (!ossl_ml_kem_encap_rand(out, ML_KEM_768_CIPHERTEXT_BYTES,
+                                secret, ML_KEM_SHARED_SECRET_BYTES,
+                                ctx->key->mkey))
+        goto end;
+
+    /* The X25519 half is an ephemeral-static Diffie-Hellman exchange */
+    if (RAND_priv_bytes_ex(ctx->libctx, eprv, sizeof(eprv), 0) <= 0)
+        goto end;
+    ossl_x25519_public_from_private(out + ML_KEM_768_CIPHERTEXT_BYTES, eprv);
+    if (!ossl_x25519(secret + ML_KEM_SHARED_SECRET_BYTES, eprv,
+                     ctx->key->xpub)) {
+        ERR_raise(ERR_LIB_PROV, PROV_R_FAILED_DURING_DERIVATION);
+        goto end;
+    }
+
+    *outlen = MLX_KEM_CIPHERTEXT_BYTES;
+    *secretlen = MLX_KEM_SHARED_SECRET_BYTES;
+    ret = 1;
+ end:
+    OPENSSL_cleanse(eprv, sizeof(eprv));
+    if (!ret)
+        OPENSSL_cleanse(secret, MLX_KEM_SHARED_SECRET_BYTES);
+    return ret;
+}
+
+static int mlx_kem_decapsulate(void *vctx, unsigned char *out, size_t *outlen,
+                               const unsigned char *in, size_t inlen)
+{
+    PROV_MLX_KEM_CTX *ctx = vctx;
+
+    if (out == NULL) {
+        if (outlen == NULL)
+            return 0;
+        *outlen = MLX_KEM_SHARED_SECRET_BYTES;
+        return 1;
+    }
+    if (outlen == NULL || *outlen < MLX_KEM_SHARED_SECRET_BYTES) {
+        ERR_raise(ERR_LIB_PROV, PROV_R_OUTPUT_BUFFER_TOO_SMALL);
+        return 0;
+    }
+    if (inlen != MLX_KEM_CIPHERTEXT_BYTES) {
+        ERR_raise(ERR_LIB_PROV, PROV_R_INVALID_INPUT_LENGTH);
+        return 0;
+    }
+    if (!ossl_ml_kem_decap(out, ML_KEM_SHARED_SECRET_BYTES,
+                           in, ML_KEM_768_CIPHERTEXT_BYTES, ctx->key->mkey))
+        return 0;
+    if (!ossl_x25519(out + ML_KEM_SHARED_SECRET_BYTES, ctx->key->xprv,
+                     in + ML_KEM_768_CIPHERTEXT_BYTES)) {
+        OPENSSL_cleanse(out, MLX_KEM_SHARED_SECRET_BYTES);
+        ERR_raise(ERR_LIB_PROV, PROV_R_FAILED_DURING_DERIVATION);
+        return 0;
+    }
+    *outlen = MLX_KEM_SHARED_SECRET_BYTES;
+    return 1;
+}
+
+const OSSL_DISPATCH ossl_mlx_kem_asym_kem_functions[] = {
+    { OSSL_FUNC_KEM_NEWCTX, (void (*)(void))mlx_kem_newctx },
+    { OSSL_FUNC_KEM_ENCAPSULATE_INIT,
+      (void (*)(void))mlx_kem_encapsulate_init },
+    { OSSL_FUNC_KEM_ENCAPSULATE, (void (*)(void))mlx_kem_encapsulate },
+    { OSSL_FUNC_KEM_DECAPSULATE_INIT,
+      (void (*)(void))mlx_kem_decapsulate_init },
+    { OSSL_FUNC_KEM_DECAPSULATE, (void (*)(void))mlx_kem_decapsulate },
+    { OSSL_FUNC_KEM_FREECTX, (void (*)(void))mlx_kem_freectx },
+    { OSSL_FUNC_KEM_DUPCTX, (void (*)(void))mlx_kem_dupctx },
+    { OSSL_FUNC_KEM_SET_CTX_PARAMS, (void (*)(void))mlx_kem_set_ctx_params },
+    { OSSL_FUNC_KEM_SETTABLE_CTX_PARAMS,
+      (void (*)(void))mlx_kem_settable_ctx_params },
+    OSSL_DISPATCH_END
+};
@@ -666,6 +666,11 @@ int common_get_params(void *key, OSSL_PARAM params[], int sm2)
             goto err;
     }
 
+    if ((p = OSSL_PARAM_locate(params, OSSL_PKEY_PARAM_EC_PUB_PRECOMPUTE))
+            != NULL
+        && !OSSL_PARAM_set_int(p, ossl_ec_key_get_pub_precompute(eck)))
+        goto err;
+
     if (!sm2) {
         if ((p = OSSL_PARAM_locate(params, OSSL_PKEY_PARAM_DEFAULT_DIGEST)) != NULL
                 && !OSSL_PARAM_set_utf8_string(p, EC_DEFAULT_MD))
@@ -731,6 +736,7 @@ static const OSSL_PARAM ec_known_gettable_params[] = {
     OSSL_PARAM_utf8_string(OSSL_PKEY_PARAM_DEFAULT_DIGEST, NULL, 0),
     OSSL_PARAM_octet_string(OSSL_PKEY_PARAM_ENCODED_PUBLIC_KEY, NULL, 0),
     OSSL_PARAM_int(OSSL_PKEY_PARAM_EC_DECODED_FROM_EXPLICIT_PARAMS, NULL),
+    OSSL_PARAM_int(OSSL_PKEY_PARAM_EC_PUB_PRECOMPUTE, NULL),
     EC_IMEXPORTABLE_DOM_PARAMETERS,
     EC_IMEXPORTABLE_PUBLIC_KEY,
     OSSL_PARAM_BN(OSSL_PKEY_PARAM_EC_PUB_X, NULL, 0),
@@ -754,6 +760,7 @@ static const OSSL_PARAM ec_known_settable_params[] = {
     OSSL_PARAM_octet_string(OSSL_PKEY_PARAM_EC_SEED, NULL, 0),
     OSSL_PARAM_int(OSSL_PKEY_PARAM_EC_INCLUDE_PUBLIC, NULL),
     OSSL_PARAM_utf8_string(OSSL_PKEY_PARAM_EC_GROUP_CHECK_TYPE, NULL, 0),
+    OSSL_PARAM_int(OSSL_PKEY_PARAM_EC_PUB_PRECOMPUTE, NULL),
     OSSL_PARAM_END
 };
 
@@ -792,6 +799,15 @@ int ec_set_params(void *key, const OSSL_PARAM params[])
             return 0;
     }
 
+    p = OSSL_PARAM_locate_const(params, OSSL_PKEY_PARAM_EC_PUB_PRECOMPUTE);
+    if (p != NULL) {
+        int after;
+
+        if (!OSSL_PARAM_get_int(p, &after)
+                || !ossl_ec_key_set_pub_precompute(eck, after))
+            return 0;
+    }
+
     return ossl_ec_key_otherparams_fromdata(eck, params);
 }
 
@@ -41,6 +41,7 @@ static OSSL_FUNC_keymgmt_gen_fn x25519_gen;
 static OSSL_FUNC_keymgmt_gen_fn x448_gen;
 static OSSL_FUNC_keymgmt_gen_fn ed25519_gen;
 static OSSL_FUNC_keymgmt_gen_fn ed448_gen;
+static OSSL_FUNC_keymgmt_gen_batch_fn x25519_gen_batch;
 static OSSL_FUNC_keymgmt_gen_cleanup_fn ecx_gen_cleanup;
 static OSSL_FUNC_keymgmt_gen_set_params_fn ecx_gen_set_params;
 static OSSL_FUNC_keymgmt_gen_settable_params_fn ecx_gen_settable_params;
@@ -737,6 +738,78 @@ static void *x25519_gen(void *genctx, OSSL_CALLBACK *osslcb, void *cbarg)
     return ecx_gen(gctx);
 }
 
+static int x25519_gen_batch(void *genctx, size_t n, void **keydata,
+                            OSSL_CALLBACK *osslcb, void *cbarg)
+{
+    struct ecx_gen_ctx *gctx = genctx;
+    ECX_KEY *key;
+    unsigned char **privkeys = NULL, **pubkeys = NULL;
+    size_t i;
+    int batch = 1;
+
+    if (!ossl_prov_is_running())
+        return 0;
+
+    for (i = 0; i < n; i++)
+        keydata[i] = NULL;
+
+#ifdef S390X_EC_ASM
+    if (OPENSSL_s390xcap_P.pcc[1] & S390X_CAPBIT(S390X_SCALAR_MULTIPLY_X25519))
+        batch = 0;
+#endif
+#ifndef FIPS_MODULE
+    if (gctx->dhkem_ikm != NULL && gctx->dhkem_ikmlen != 0)
+        batch = 0;
+#endif
+    if ((gctx->selection & OSSL_KEYMGMT_SELECT_KEYPAIR) == 0)
+        batch = 0;
+
+    if (!batch) {
+        for (i = 0; i < n; i++)
+            if ((keydata[i] = x25519_gen(genctx, osslcb, cbarg)) == NULL)
+                goto err;
+        return 1;
+    }
+
+    if ((privkeys = OPENSSL_malloc(n * sizeof(*privkeys))) == NULL
+            || (pubkeys = OPENSSL_malloc(n * sizeof(*pubkeys))) == NULL)
+        goto err;
+    for (i = 0; i < n; i++) {
+        if ((key = ossl_ecx_key_new(gctx->libctx, gctx->type, 0,
+                                    gctx->propq)) == NULL) {
+            ERR_raise(ERR_LIB_PROV, ERR_R_EC_LIB);
+            goto err;
+        }
+        keydata[i] = key;
+        if ((privkeys[i] = ossl_ecx_key_allocate_privkey(key)) == NULL) {
+            ERR_raise(ERR_LIB_PROV, ERR_R_EC_LIB);
+            goto err;
+        }
+        if (RAND_priv_bytes_ex(gctx->libctx, privkeys[i], key->keylen, 0) <= 0)
+            goto err;
+        privkeys[i][0] &= 248;
+        privkeys[i][X25519_KEYLEN - 1] &= 127;
+        privkeys[i][X25519_KEYLEN - 1] |= 64;
+        pubkeys[i] = key->pubkey;
+    }
+    ossl_x25519_public_from_private_batch(n, pubkeys,
+                                          (const uint8_t *const *)privkeys);
+    for (i = 0; i < n; i++)
+        ((ECX_KEY *)keydata[i])->haspubkey = 1;
+    OPENSSL_free(privkeys);
+    OPENSSL_free(pubkeys);
+    return 1;
+
+ err:
+    for (i = 0; i < n; i++) {
+        ossl_ecx_key_free(keydata[i]);
+        keydata[i] = NULL;
+    }
+    OPENSSL_free(privkeys);
+    OPENSSL_free(pubkeys);
+    return 0;
+}
+
 static void *x448_gen(void *genctx, OSSL_CALLBACK *osslcb, void *cbarg)
 {
     struct ecx_gen_ctx *gctx = genctx;
@@ -946,7 +1019,7 @@ static int ed448_validate(const void *keydata, int selection, int checktype)
     return ecx_validate(keydata, selection, ECX_KEY_TYPE_ED448, ED448_KEYLEN);
 }
 
-#define MAKE_KEYMGMT_FUNCTIONS(alg) \
+#define MAKE_KEYMGMT_FUNCTIONS(alg, extra) \
     const OSSL_DISPATCH ossl_##alg##_keymgmt_functions[] = { \
         { OSSL_FUNC_KEYMGMT_NEW, (void (*)(void))alg##_new_key }, \
         { OSSL_FUNC_KEYMGMT_FREE, (void (*)(void))ossl_ecx_key_free }, \
@@ -969,13 +1042,18 @@ static int ed448_validate(const void *keydata, int selection, int checktype)
         { OSSL_FUNC_KEYMGMT_GEN_CLEANUP, (void (*)(void))ecx_gen_cleanup }, \
         { OSSL_FUNC_KEYMGMT_LOAD, (void (*)(void))ecx_load }, \
         { OSSL_FUNC_KEYMGMT_DUP, (void (*)(void))ecx_dup }, \
+        extra \
         OSSL_DISPATCH_END \
     };
 
-MAKE_KEYMGMT_FUNCTIONS(x25519)
-MAKE_KEYMGMT_FUNCTIONS(x448)
-MAKE_KEYMGMT_FUNCTIONS(ed25519)
-MAKE_KEYMGMT_FUNCTIONS(ed448)
+#define ECX_GEN_BATCH(alg) \
+    { OSSL_FUNC_KEYMGMT_GEN_BATCH, (void (*)(void))alg##_gen_batch },
+#define ECX_NO_EXTRA
+
+MAKE_KEYMGMT_FUNCTIONS(x25519, ECX_GEN_BATCH(x25519))
+MAKE_KEYMGMT_FUNCTIONS(x448, ECX_NO_EXTRA)
+MAKE_KEYMGMT_FUNCTIONS(ed25519, ECX_NO_EXTRA)
+MAKE_KEYMGMT_FUNCTIONS(ed448, ECX_NO_EXTRA)
 
 #ifdef S390X_EC_ASM
 # include "s390x_arch.h"
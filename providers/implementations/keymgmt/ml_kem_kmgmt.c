@@ -0,0 +1,479 @@
+/*
+ * Copyright 2024 The OpenSSL Project Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License 2.0 (the "License").  You may not use
+ * this file except in compliance with the License.  You can obtain a copy
+ * in the file LICENSE in the source distribution or at
+ * https://www.openssl.org/source/license.html
+ */
+
+#include <string.h>
+#include <openssl/core_dispatch.h>
+#include <openssl/core_names.h>
+#include <openssl/params.h>
+#include <openssl/err.h>
+#include <openssl/proverr.h>
+#include <openssl/param_build.h>
+#include <crypto/ml_kem.h>
+#include <providers/implementations.h>
+#include <providers/providercommon.h>
+#include <providers/provider_ctx.h>
+
+static OSSL_FUNC_keymgmt_free_fn ml_kem_free_key;
+static OSSL_FUNC_keymgmt_has_fn ml_kem_has;
+static OSSL_FUNC_keymgmt_match_fn ml_kem_match;
+static OSSL_FUNC_keymgmt_validate_fn ml_kem_validate;
+static OSSL_FUNC_keymgmt_import_fn ml_kem_import;
+static OSSL_FUNC_keymgmt_export_fn ml_kem_export;
+static OSSL_FUNC_keymgmt_import_types_fn ml_kem_imexport_types;
+static OSSL_FUNC_keymgmt_export_types_fn ml_kem_imexport_types;
+static OSSL_FUNC_keymgmt_get_params_fn ml_kem_get_params;
+static OSSL_FUNC_keymgmt_gettable_params_fn ml_kem_gettable_params;
+static OSSL_FUNC_keymgmt_set_params_fn ml_kem_set_params;
+static OSSL_FUNC_keymgmt_settable_params_fn ml_kem_settable_params;
+static OSSL_FUNC_keymgmt_gen_set_params_fn ml_kem_gen_set_params;
+static OSSL_FUNC_keymgmt_gen_settable_params_fn ml_kem_gen_settable_params;
+static OSSL_FUNC_keymgmt_gen_fn ml_kem_gen;
+static OSSL_FUNC_keymgmt_gen_cleanup_fn ml_kem_gen_cleanup;
+static OSSL_FUNC_keymgmt_dup_fn ml_kem_dup;
+
+#define ML_KEM_POSSIBLE_SELECTIONS (OSSL_KEYMGMT_SELECT_KEYPAIR)
+
+struct ml_kem_gen_ctx {
+    OSSL_LIB_CTX *libctx;
+    int variant;
+    int selection;
+    uint8_t *seed;              /* NULL, or seedbuf once a seed is set */
+    uint8_t seedbuf[ML_KEM_SEED_BYTES];
+};
+
+static void *ml_kem_new_key(void *provctx, int variant)
+{
+    if (!ossl_prov_is_running())
+        return NULL;
+    return ossl_ml_kem_key_new(PROV_LIBCTX_OF(provctx), variant);
+}
+
+static void ml_kem_free_key(void *keydata)
+{
+    ossl_ml_kem_key_free(keydata);
+}
+
+static int ml_kem_has(const void *keydata, int selection)
+{
+    const ML_KEM_KEY *key = keydata;
+    int ok = 0;
+
+    if (ossl_prov_is_running() && key != NULL) {
+        /* ML-KEM keys have no domain parameters */
+        ok = 1;
+
+        if ((selection & OSSL_KEYMGMT_SELECT_PUBLIC_KEY) != 0)
+            ok = ok && ossl_ml_kem_have_pubkey(key);
+        if ((selection & OSSL_KEYMGMT_SELECT_PRIVATE_KEY) != 0)
+            ok = ok && ossl_ml_kem_have_prvkey(key);
+    }
+    return ok;
+}
+
+/*
+ * A private key always carries its public key, so comparing public keys
+ * is enough whatever the selection.
+ */
+static int ml_kem_match(const void *keydata1, const void *keydata2,
+                        int selection)
+{
+    const ML_KEM_KEY *key1 = keydata1;
+    const ML_KEM_KEY *key2 = keydata2;
+    int ok = 1;
+
+    if (!ossl_prov_is_running())
+        return 0;
+
+    if ((selection & OSSL_KEYMGMT_SELECT_DOMAIN_PARAMETERS) != 0)
+        ok = ok && ossl_ml_kem_key_vinfo(key1) == ossl_ml_kem_key_vinfo(key2);
+    if ((selection & OSSL_KEYMGMT_SELECT_KEYPAIR) != 0)
+        ok = ok && ossl_ml_kem_pubkey_cmp(key1, key2);
+    return ok;
+}
+
+/* Keys are checked when they are imported, so there is nothing more to do */
+static int ml_kem_validate(const void *keydata, int selection, int checktype)
+{
+    const ML_KEM_KEY *key = keydata;
+
+    if ((selection & ML_KEM_POSSIBLE_SELECTIONS) == 0)
+        return 1;
+    return ml_kem_has(key, selection);
+}
+
+static int ml_kem_import(void *keydata, int selection,
+                         const OSSL_PARAM params[])
+{
+    ML_KEM_KEY *key = keydata;
+    const ML_KEM_VINFO *vinfo;
+    const OSSL_PARAM *pub, *prv = NULL;
+    const void *pubenc = NULL, *prvenc = NULL;
+    size_t publen = 0, prvlen = 0;
+
+    if (!ossl_prov_is_running() || key == NULL)
+        return 0;
+    if ((selection & OSSL_KEYMGMT_SELECT_KEYPAIR) == 0)
+        return 0;
+
+    vinfo = ossl_ml_kem_key_vinfo(key);
+    pub = OSSL_PARAM_locate_const(params, OSSL_PKEY_PARAM_PUB_KEY);
+    if ((selection & OSSL_KEYMGMT_SELECT_PRIVATE_KEY) != 0)
+        prv = OSSL_PARAM_locate_const(params, OSSL_PKEY_PARAM_PRIV_KEY);
+    if (pub == NULL && prv == NULL) {
+        ERR_raise(ERR_LIB_PROV, PROV_R_MISSING_KEY);
+        return 0;
+    }
+    if ((pub != NULL
+         && !OSSL_PARAM_get_octet_string_ptr(pub, &pubenc, &publen))
+        || (prv != NULL
+            && !OSSL_PARAM_get_octet_string_ptr(prv, &prvenc, &prvlen)))
+        return 0;
+    if ((pub != NULL && publen != vinfo->pubkey_bytes)
+        || (prv != NULL && prvlen != vinfo->prvkey_bytes)) {
+        ERR_raise(ERR_LIB_PROV, PROV_R_INVALID_KEY_LENGTH);
+        return 0;
+    }
+
+    /* The private key includes the public key, which must then agree */
+    ossl_ml_kem_key_reset(key);
+    if (prv != NULL) {
+        if (!ossl_ml_kem_parse_private_key(prvenc, prvlen, key))
+            goto err;
+        if (pub != NULL
+            && memcmp(pubenc, (const uint8_t *)prvenc + 384 * vinfo->k,
+                      publen) != 0)
+            goto err;
+    } else if (!ossl_ml_kem_parse_public_key(pubenc, publen, key)) {
+        goto err;
+    }
+    return 1;
+
+ err:
+    ossl_ml_kem_key_reset(key);
+    ERR_raise(ERR_LIB_PROV, PROV_R_INVALID_KEY);
+    return 0;
+}
+
+static int ml_kem_export(void *keydata, int selection,
+                         OSSL_CALLBACK *param_cb, void *cbarg)
+{
+    ML_KEM_KEY *key = keydata;
+    const ML_KEM_VINFO *vinfo;
+    OSSL_PARAM_BLD *tmpl;
+    OSSL_PARAM *params = NULL;
+    uint8_t *pubenc = NULL, *prvenc = NULL;
+    int ret = 0;
+
+    if (!ossl_prov_is_running() || key == NULL)
+        return 0;
+    if ((selection & OSSL_KEYMGMT_SELECT_KEYPAIR) == 0)
+        return 0;
+
+    vinfo = ossl_ml_kem_key_vinfo(key);
+    if ((tmpl = OSSL_PARAM_BLD_new()) == NULL)
+        return 0;
+
+    if (ossl_ml_kem_have_pubkey(key)) {
+        if ((pubenc = OPENSSL_malloc(vinfo->pubkey_bytes)) == NULL
+            || !ossl_ml_kem_encode_public_key(pubenc, vinfo->pubkey_bytes, key)
+            || !OSSL_PARAM_BLD_push_octet_string(tmpl, OSSL_PKEY_PARAM_PUB_KEY,
+                                                 pubenc, vinfo->pubkey_bytes))
+            goto err;
+    }
+    if ((selection & OSSL_KEYMGMT_SELECT_PRIVATE_KEY) != 0
+        && ossl_ml_kem_have_prvkey(key)) {
+        if ((prvenc = OPENSSL_secure_malloc(vinfo->prvkey_bytes)) == NULL
+            || !ossl_ml_kem_encode_private_key(prvenc, vinfo->prvkey_bytes,
+                                               key)
+            || !OSSL_PARAM_BLD_push_octet_string(tmpl, OSSL_PKEY_PARAM_PRIV_KEY,
+                                                 prvenc, vinfo->prvkey_bytes))
+            goto err;
+    }
+
+    params = OSSL_PARAM_BLD_to_param(tmpl);
+    if (params == NULL)
+        goto err;
+
+    ret = param_cb(params, cbarg);
+    OSSL_PARAM_free(params);
+ err:
+    OSSL_PARAM_BLD_free(tmpl);
+    OPENSSL_secure_clear_free(prvenc, vinfo->prvkey_bytes);
+    OPENSSL_free(pubenc);
+    return ret;
+}
+
+static const OSSL_PARAM ml_kem_key_types[] = {
+    OSSL_PARAM_octet_string(OSSL_PKEY_PARAM_PUB_KEY, NULL, 0),
+    OSSL_PARAM_octet_string(OSSL_PKEY_PARAM_PRIV_KEY, NULL, 0),
+    OSSL_PARAM_END
+};
+
+static const OSSL_PARAM *ml_kem_imexport_types(int selection)
+{
+    if ((selection & OSSL_KEYMGMT_SELECT_KEYPAIR) != 0)
+        return ml_kem_key_types;
+    return NULL;
+}
+
+/* Encodes the key into |p|, or just reports the length if there's no room */
+static int set_key_param(OSSL_PARAM *p, const ML_KEM_KEY *key, int private)
+{
+    const ML_KEM_VINFO *vinfo = ossl_ml_kem_key_vinfo(key);
+    size_t len = private ? vinfo->prvkey_bytes : vinfo->pubkey_bytes;
+
+    if (p->data_type != OSSL_PARAM_OCTET_STRING)
+        return 0;
+    p->return_size = len;
+    if (p->data == NULL)
+        return 1;
+    if (p->data_size < len)
+        return 0;
+    if (private)
+        return ossl_ml_kem_encode_private_key(p->data, len, key);
+    return ossl_ml_kem_encode_public_key(p->data, len, key);
+}
+
+static int ml_kem_get_params(void *keydata, OSSL_PARAM params[])
+{
+    ML_KEM_KEY *key = keydata;
+    const ML_KEM_VINFO *vinfo = ossl_ml_kem_key_vinfo(key);
+    OSSL_PARAM *p;
+
+    if ((p = OSSL_PARAM_locate(params, OSSL_PKEY_PARAM_BITS)) != NULL
+        && !OSSL_PARAM_set_int(p, vinfo->bits))
+        return 0;
+    if ((p = OSSL_PARAM_locate(params, OSSL_PKEY_PARAM_SECURITY_BITS)) != NULL
+        && !OSSL_PARAM_set_int(p, vinfo->secbits))
+        return 0;
+    if ((p = OSSL_PARAM_locate(params, OSSL_PKEY_PARAM_MAX_SIZE)) != NULL
+        && !OSSL_PARAM_set_int(p, (int)vinfo->ctext_bytes))
+        return 0;
+
+    if (ossl_ml_kem_have_pubkey(key)) {
+        if ((p = OSSL_PARAM_locate(params,
+                                   OSSL_PKEY_PARAM_ENCODED_PUBLIC_KEY)) != NULL
+            && !set_key_param(p, key, 0))
+            return 0;
+        if ((p = OSSL_PARAM_locate(params, OSSL_PKEY_PARAM_PUB_KEY)) != NULL
+            && !set_key_param(p, key, 0))
+            return 0;
+    }
+    if (ossl_ml_kem_have_prvkey(key)
+        && (p = OSSL_PARAM_locate(params, OSSL_PKEY_PARAM_PRIV_KEY)) != NULL
+        && !set_key_param(p, key, 1))
+        return 0;
+    return 1;
+}
+
+static const OSSL_PARAM *ml_kem_gettable_params(void *provctx)
+{
+    static const OSSL_PARAM gettable[] = {
+        OSSL_PARAM_int(OSSL_PKEY_PARAM_BITS, NULL),
+        OSSL_PARAM_int(OSSL_PKEY_PARAM_SECURITY_BITS, NULL),
+        OSSL_PARAM_int(OSSL_PKEY_PARAM_MAX_SIZE, NULL),
+        OSSL_PARAM_octet_string(OSSL_PKEY_PARAM_ENCODED_PUBLIC_KEY, NULL, 0),
+        OSSL_PARAM_octet_string(OSSL_PKEY_PARAM_PUB_KEY, NULL, 0),
+        OSSL_PARAM_octet_string(OSSL_PKEY_PARAM_PRIV_KEY, NULL, 0),
+        OSSL_PARAM_END
+    };
+
+    return gettable;
+}
+
+/*
+ * Setting the encoded public key replaces whatever the key held before.
+ * This is how a TLS server loads the client's key share into the blank key
+ * made by parameter generation.
+ */
+static int ml_kem_set_params(void *keydata, const OSSL_PARAM params[])
+{
+    ML_KEM_KEY *key = keydata;
+    const OSSL_PARAM *p;
+    const void *buf;
+    size_t len;
+
+    p = OSSL_PARAM_locate_const(params, OSSL_PKEY_PARAM_ENCODED_PUBLIC_KEY);
+    if (p == NULL)
+        return 1;
+    if (!OSSL_PARAM_get_octet_string_ptr(p, &buf, &len))
+        return 0;
+    ossl_ml_kem_key_reset(key);
+    if (!ossl_ml_kem_parse_public_key(buf, len, key)) {
+        ERR_raise(ERR_LIB_PROV, PROV_R_INVALID_KEY);
+        return 0;
+    }
+    return 1;
+}
+
+static const OSSL_PARAM *ml_kem_settable_params(void *provctx)
+{
+    static const OSSL_PARAM settable[] = {
+        OSSL_PARAM_octet_string(OSSL_PKEY_PARAM_ENCODED_PUBLIC_KEY, NULL, 0),
+        OSSL_PARAM_END
+    };
+
+    return settable;
+}
+
+static void *ml_kem_gen_init(void *provctx, int selection,
+                             const OSSL_PARAM params[], int variant)
+{
+    struct ml_kem_gen_ctx *gctx;
+
+    if (!ossl_prov_is_running())
+        return NULL;
+
+    if ((gctx = OPENSSL_zalloc(sizeof(*gctx))) == NULL)
+        return NULL;
+    gctx->libctx = PROV_LIBCTX_OF(provctx);
+    gctx->variant = variant;
+    gctx->selection = selection;
+    if (!ml_kem_gen_set_params(gctx, params)) {
+        ml_kem_gen_cleanup(gctx);
+        gctx = NULL;
+    }
+    return gctx;
+}
+
+static int ml_kem_gen_set_params(void *genctx, const OSSL_PARAM params[])
+{
+    struct ml_kem_gen_ctx *gctx = genctx;
+    const OSSL_PARAM *p;
+
+    if (gctx == NULL)
+        return 0;
+
+    /*
+     * A group name is accepted, as for X25519, so long as it names the one
+     * parameter set this key manager implements.
+     */
+    p = OSSL_PARAM_locate_const(params, OSSL_PKEY_PARAM_GROUP_NAME);
+    if (p != NULL) {
+        const ML_KEM_VINFO *vinfo = ossl_ml_kem_get_vinfo(gctx->variant);
+
+        if (p->data_type != OSSL_PARAM_UTF8_STRING
+            || OPENSSL_strcasecmp(p->data, vinfo->algorithm_name) != 0) {
+            ERR_raise(ERR_LIB_PROV, ERR_R_PASSED_INVALID_ARGUMENT);
+            return 0;
+        }
+    }
+    p = OSSL_PARAM_locate_const(params, OSSL_PKEY_PARAM_ML_KEM_SEED);
+    if (p != NULL) {
+        void *buf = gctx->seedbuf;
+        size_t len;
+
+        if (!OSSL_PARAM_get_octet_string(p, &buf, sizeof(gctx->seedbuf),
+                                         &len)
+            || len != sizeof(gctx->seedbuf)) {
+            ERR_raise(ERR_LIB_PROV, PROV_R_INVALID_SEED_LENGTH);
+            return 0;
+        }
+        gctx->seed = gctx->seedbuf;
+    }
+    return 1;
+}
+
+static const OSSL_PARAM *ml_kem_gen_settable_params(ossl_unused void *genctx,
+                                                    ossl_unused void *provctx)
+{
+    static const OSSL_PARAM settable[] = {
+        OSSL_PARAM_utf8_string(OSSL_PKEY_PARAM_GROUP_NAME, NULL, 0),
+        OSSL_PARAM_octet_string(OSSL_PKEY_PARAM_ML_KEM_SEED, NULL, 0),
+        OSSL_PARAM_END
+    };
+
+    return settable;
+}
+
+static void *ml_kem_gen(void *genctx, OSSL_CALLBACK *osslcb, void *cbarg)
+{
+    struct ml_kem_gen_ctx *gctx = genctx;
+    ML_KEM_KEY *key;
+
+    if (!ossl_prov_is_running() || gctx == NULL)
+        return NULL;
+    if ((key = ossl_ml_kem_key_new(gctx->libctx, gctx->variant)) == NULL)
+        return NULL;
+
+    /* If we're doing parameter generation then we just return a blank key */
+    if ((gctx->selection & OSSL_KEYMGMT_SELECT_KEYPAIR) == 0)
+        return key;
+
+    if (!ossl_ml_kem_genkey(key, gctx->seed,
+                            gctx->seed != NULL ? sizeof(gctx->seedbuf) : 0)) {
+        ERR_raise(ERR_LIB_PROV, PROV_R_FAILED_TO_GENERATE_KEY);
+        ossl_ml_kem_key_free(key);
+        return NULL;
+    }
+    return key;
+}
+
+static void ml_kem_gen_cleanup(void *genctx)
+{
+    struct ml_kem_gen_ctx *gctx = genctx;
+
+    if (gctx == NULL)
+        return;
+    OPENSSL_clear_free(gctx, sizeof(*gctx));
+}
+
+static void *ml_kem_dup(const void *keydata, int selection)
+{
+    if (!ossl_prov_is_running())
+        return NULL;
+    return ossl_ml_kem_key_dup(keydata, selection);
+}
+
+#define MAKE_KEYMGMT_FUNCTIONS(bits)                                           \
+    static OSSL_FUNC_keymgmt_new_fn ml_kem_##bits##_new_key;                   \
+    static OSSL_FUNC_keymgmt_gen_init_fn ml_kem_##bits##_gen_init;             \
+    static void *ml_kem_##bits##_new_key(void *provctx)                        \
+    {                                                                          \
+        return ml_kem_new_key(provctx, ML_KEM_##bits##_VARIANT);               \
+    }                                                                          \
+    static void *ml_kem_##bits##_gen_init(void *provctx, int selection,        \
+                                          const OSSL_PARAM params[])           \
+    {                                                                          \
+        return ml_kem_gen_init(provctx, selection, params,                     \
+                               ML_KEM_##bits##_VARIANT);                       \
+    }                                                                          \
+    const OSSL_DISPATCH ossl_ml_kem_##bits##_keymgmt_functions[] = {           \
+        { OSSL_FUNC_KEYMGMT_NEW, (void (*)(void))ml_kem_##bits##_new_key },    \
+        { OSSL_FUNC_KEYMGMT_FREE, (void (*)(void))ml_kem_free_key },           \
+        { OSSL_FUNC_KEYMGMT_GET_PARAMS, (void (*)(void))ml_kem_get_params },   \
+        { OSSL_FUNC_KEYMGMT_GETTABLE_PARAMS,                                   \
+          (void (*)(void))ml_kem_gettable_params },                            \
+        { OSSL_FUNC_KEYMGMT_SET_PARAMS, (void (*)(void))ml_kem_set_params },   \
+        { OSSL_FUNC_KEYMGMT_SETTABLE_PARAMS,                                   \
+          (void (*)(void))ml_kem_settable_params },                            \
+        { OSSL_FUNC_KEYMGMT_HAS, (void (*)(void))ml_kem_has },                 \
+        { OSSL_FUNC_KEYMGMT_MATCH, (void (*)(void))ml_kem_match },             \
+        { OSSL_FUNC_KEYMGMT_VALIDATE, (void (*)(void))ml_kem_validate },       \
+        { OSSL_FUNC_KEYMGMT_IMPORT, (void (*)(void))ml_kem_import },           \
+        { OSSL_FUNC_KEYMGMT_IMPORT_TYPES,                                      \
+          (void (*)(void))ml_kem_imexport_types },                             \
+        { OSSL_FUNC_KEYMGMT_EXPORT, (void (*)(void))ml_kem_export },           \
+        { OSSL_FUNC_KEYMGMT_EXPORT_TYPES,                                      \
+          (void (*)(void))ml_kem_imexport_types },                             \
+        { OSSL_FUNC_KEYMGMT_GEN_INIT,                                          \
+          (void (*)(void))ml_kem_##bits##_gen_init },                          \
+        { OSSL_FUNC_KEYMGMT_GEN_SET_PARAMS,                                    \
+          (void (*)(void))ml_kem_gen_set_params },                             \
+        { OSSL_FUNC_KEYMGMT_GEN_SETTABLE_PARAMS,                               \
+          (void (*)(void))ml_kem_gen_settable_params },                        \
+        { OSSL_FUNC_KEYMGMT_GEN, (void (*)(void))ml_kem_gen },                 \
+        { OSSL_FUNC_KEYMGMT_GEN_CLEANUP, (void (*)(void))ml_kem_gen_cleanup }, \
+        { OSSL_FUNC_KEYMGMT_DUP, (void (*)(void))ml_kem_dup },                 \
+        OSSL_DISPATCH_END                                                      \
+    }
+
+MAKE_KEYMGMT_FUNCTIONS(512);
+MAKE_KEYMGMT_FUNCTIONS(768);
+MAKE_KEYMGMT_FUNCTIONS(1024);
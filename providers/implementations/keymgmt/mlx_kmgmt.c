@@ -0,0 +1,495 @@
+/*
+ * Copyright 2024 The OpenSSL Project Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License 2.0 (the "License").  You may not use
+ * this file except in compliance with the License.  You can obtain a copy
+ * in the file LICENSE in the source distribution or at
+ * https://www.openssl.org/source/license.html
+ */
+
+#include <string.h>
+#include <openssl/core_dispatch.h>
+#include <openssl/core_names.h>
+#include <openssl/params.h>
+#include <openssl/err.h>
+#include <openssl/proverr.h>
+#include <openssl/param_build.h>
+#include <openssl/rand.h>
+#include <providers/mlx_kem.h>
+#include <providers/implementations.h>
+#include <providers/providercommon.h>
+#include <providers/provider_ctx.h>
+
+static OSSL_FUNC_keymgmt_new_fn mlx_kem_new_key;
+static OSSL_FUNC_keymgmt_free_fn mlx_kem_free_key;
+static OSSL_FUNC_keymgmt_has_fn mlx_kem_has;
+static OSSL_FUNC_keymgmt_match_fn mlx_kem_match;
+static OSSL_FUNC_keymgmt_validate_fn mlx_kem_validate;
+static OSSL_FUNC_keymgmt_import_fn mlx_kem_import;
+static OSSL_FUNC_keymgmt_export_fn mlx_kem_export;
+static OSSL_FUNC_keymgmt_import_types_fn mlx_kem_imexport_types;
+static OSSL_FUNC_keymgmt_export_types_fn mlx_kem_imexport_types;
+static OSSL_FUNC_keymgmt_get_params_fn mlx_kem_get_params;
+static OSSL_FUNC_keymgmt_gettable_params_fn mlx_kem_gettable_params;
+static OSSL_FUNC_keymgmt_set_params_fn mlx_kem_set_params;
+static OSSL_FUNC_keymgmt_settable_params_fn mlx_kem_settable_params;
+static OSSL_FUNC_keymgmt_gen_init_fn mlx_kem_gen_init;
+static OSSL_FUNC_keymgmt_gen_set_params_fn mlx_kem_gen_set_params;
+static OSSL_FUNC_keymgmt_gen_settable_params_fn mlx_kem_gen_settable_params;
+static OSSL_FUNC_keymgmt_gen_fn mlx_kem_gen;
+static OSSL_FUNC_keymgmt_gen_cleanup_fn mlx_kem_gen_cleanup;
+static OSSL_FUNC_keymgmt_dup_fn mlx_kem_dup;
+
+#define MLX_KEM_NAME "X25519MLKEM768"
+#define MLX_KEM_SECBITS ML_KEM_768_SECBITS
+
+struct mlx_kem_gen_ctx {
+    OSSL_LIB_CTX *libctx;
+    int selection;
+};
+
+static MLX_KEY *mlx_kem_key_new(OSSL_LIB_CTX *libctx)
+{
+    MLX_KEY *key;
+
+    if ((key = OPENSSL_zalloc(sizeof(*key))) == NULL)
+        return NULL;
+    key->libctx = libctx;
+    if ((key->mkey = ossl_ml_kem_key_new(libctx, ML_KEM_768_VARIANT)) == NULL) {
+        OPENSSL_free(key);
+        return NULL;
+    }
+    return key;
+}
+
+static void mlx_kem_key_reset(MLX_KEY *key)
+{
+    ossl_ml_kem_key_reset(key->mkey);
+    OPENSSL_cleanse(key->xprv, sizeof(key->xprv));
+    memset(key->xpub, 0, sizeof(key->xpub));
+}
+
+static void *mlx_kem_new_key(void *provctx)
+{
+    if (!ossl_prov_is_running())
+        return NULL;
+    return mlx_kem_key_new(PROV_LIBCTX_OF(provctx));
+}
+
+static void mlx_kem_free_key(void *keydata)
+{
+    MLX_KEY *key = keydata;
+
+    if (key == NULL)
+        return;
+    ossl_ml_kem_key_free(key->mkey);
+    OPENSSL_clear_free(key, sizeof(*key));
+}
+
+static int mlx_kem_has(const void *keydata, int selection)
+{
+    const MLX_KEY *key = keydata;
+    int ok = 0;
+
+    if (ossl_prov_is_running() && key != NULL) {
+        ok = 1;
+
+        if ((selection & OSSL_KEYMGMT_SELECT_PUBLIC_KEY) != 0)
+            ok = ok && ossl_ml_kem_have_pubkey(key->mkey);
+        if ((selection & OSSL_KEYMGMT_SELECT_PRIVATE_KEY) != 0)
+            ok = ok && ossl_ml_kem_have_prvkey(key->mkey);
+    }
+    return ok;
+}
+
+static int mlx_kem_match(const void *keydata1, const void *keydata2,
+                         int selection)
+{
+    const MLX_KEY *key1 = keydata1;
+    const MLX_KEY *key2 = keydata2;
+
+    if (!ossl_prov_is_running())
+        return 0;
+    if ((selection & OSSL_KEYMGMT_SELECT_KEYPAIR) == 0)
+        return 1;
+    return ossl_ml_kem_pubkey_cmp(key1->mkey, key2->mkey)
+        && CRYPTO_memcmp(key1->xpub, key2->xpub, sizeof(key1->xpub)) == 0;
+}
+
+static int mlx_kem_validate(const void *keydata, int selection, int checktype)
+{
+    if ((selection & OSSL_KEYMGMT_SELECT_KEYPAIR) == 0)
+        return 1;
+    return mlx_kem_has(keydata, selection);
+}
+
+static int mlx_kem_parse_public_key(const uint8_t *in, size_t len,
+                                    MLX_KEY *key)
+{
+    if (len != MLX_KEM_PUBKEY_BYTES
+        || !ossl_ml_kem_parse_public_key(in, ML_KEM_768_PUBLIC_KEY_BYTES,
+                                         key->mkey))
+        return 0;
+    memcpy(key->xpub, in + ML_KEM_768_PUBLIC_KEY_BYTES, sizeof(key->xpub));
+    return 1;
+}
+
+static int mlx_kem_parse_private_key(const uint8_t *in, size_t len,
+                                     MLX_KEY *key)
+{
+    if (len != MLX_KEM_PRVKEY_BYTES
+        || !ossl_ml_kem_parse_private_key(in, ML_KEM_768_PRIVATE_KEY_BYTES,
+                                          key->mkey))
+        return 0;
+    memcpy(key->xprv, in + ML_KEM_768_PRIVATE_KEY_BYTES, sizeof(key->xprv));
+    ossl_x25519_public_from_private(key->xpub, key->xprv);
+    return 1;
+}
+
+static int mlx_kem_encode_public_key(uint8_t *out, const MLX_KEY *key)
+{
+    if (!ossl_ml_kem_encode_public_key(out, ML_KEM_768_PUBLIC_KEY_BYTES,
+                                       key->mkey))
+        return 0;
+    memcpy(out + ML_KEM_768_PUBLIC_KEY_BYTES, key->xpub, sizeof(key->xpub));
+    return 1;
+}
+
+static int mlx_kem_encode_private_key(uint8_t *out, const MLX_KEY *key)
+{
+    if (!ossl_ml_kem_encode_private_key(out, ML_KEM_768_PRIVATE_KEY_BYTES,
+                                        key->mkey))
+        return 0;
+    memcpy(out + ML_KEM_768_PRIVATE_KEY_BYTES, key->xprv, sizeof(key->xprv));
+    return 1;
+}
+
+static int mlx_kem_import(void *keydata, int selection,
+                          const OSSL_PARAM params[])
+{
+    MLX_KEY *key = keydata;
+    const OSSL_PARAM *pub, *prv = NULL;
+    const void *pubenc = NULL, *prvenc = NULL;
+    size_t publen = 0, prvlen = 0;
+    uint8_t check[MLX_KEM_PUBKEY_BYTES];
+
+    if (!ossl_prov_is_running() || key == NULL)
+        return 0;
+    if ((selection & OSSL_KEYMGMT_SELECT_KEYPAIR) == 0)
+        return 0;
+
+    pub = OSSL_PARAM_locate_const(params, OSSL_PKEY_PARAM_PUB_KEY);
+    if ((selection & OSSL_KEYMGMT_SELECT_PRIVATE_KEY) != 0)
+        prv = OSSL_PARAM_locate_const(params, OSSL_PKEY_PARAM_PRIV_KEY);
+    if (pub == NULL && prv == NULL) {
+        ERR_raise(ERR_LIB_PROV, PROV_R_MISSING_KEY);
+        return 0;
+    }
+    if ((pub != NULL
+         && !OSSL_PARAM_get_octet_string_ptr(pub, &pubenc, &publen))
+        || (prv != NULL
+            && !OSSL_PARAM_get_octet_string_ptr(prv, &prvenc, &prvlen)))
+        return 0;
+    if ((pub != NULL && publen != MLX_KEM_PUBKEY_BYTES)
+        || (prv != NULL && prvlen != MLX_KEM_PRVKEY_BYTES)) {
+        ERR_raise(ERR_LIB_PROV, PROV_R_INVALID_KEY_LENGTH);
+        return 0;
+    }
+
+    mlx_kem_key_reset(key);
+    if (prv != NULL) {
+        if (!mlx_kem_parse_private_key(prvenc, prvlen, key))
+            goto err;
+        if (pub != NULL
+            && (!mlx_kem_encode_public_key(check, key)
+                || memcmp(check, pubenc, publen) != 0))
+            goto err;
+    } else if (!mlx_kem_parse_public_key(pubenc, publen, key)) {
+        goto err;
+    }
+    return 1;
+
+ err:
+    mlx_kem_key_reset(key);
+    ERR_raise(ERR_LIB_PROV, PROV_R_INVALID_KEY);
+    return 0;
+}
+
+static int mlx_kem_export(void *keydata, int selection,
+                          OSSL_CALLBACK *param_cb, void *cbarg)
+{
+    MLX_KEY *key = keydata;
+    OSSL_PARAM_BLD *tmpl;
+    OSSL_PARAM *params = NULL;
+    uint8_t *pubenc = NULL, *prvenc = NULL;
+    int ret = 0;
+
+    if (!ossl_prov_is_running() || key == NULL)
+        return 0;
+    if ((selection & OSSL_KEYMGMT_SELECT_KEYPAIR) == 0)
+        return 0;
+
+    if ((tmpl = OSSL_PARAM_BLD_new()) == NULL)
+        return 0;
+
+    if (ossl_ml_kem_have_pubkey(key->mkey)) {
+        if ((pubenc = OPENSSL_malloc(MLX_KEM_PUBKEY_BYTES)) == NULL
+            || !mlx_kem_encode_public_key(pubenc, key)
+            || !OSSL_PARAM_BLD_push_octet_string(tmpl, OSSL_PKEY_PARAM_PUB_KEY,
+                                                 pubenc, MLX_KEM_PUBKEY_BYTES))
+            goto err;
+    }
+    if ((selection & OSSL_KEYMGMT_SELECT_PRIVATE_KEY) != 0
+        && ossl_ml_kem_have_prvkey(key->mkey)) {
+        if ((prvenc = OPENSSL_secure_malloc(MLX_KEM_PRVKEY_BYTES)) == NULL
+            || !mlx_kem_encode_private_key(prvenc, key)
+            || !OSSL_PARAM_BLD_push_octet_string(tmpl, OSSL_PKEY_PARAM_PRIV_KEY,
+                                                 prvenc, MLX_KEM_PRVKEY_BYTES))
+            goto err;
+    }
+
+    params = OSSL_PARAM_BLD_to_param(tmpl);
+    if (params == NULL)
+        goto err;
+
+    ret = param_cb(params, cbarg);
+    OSSL_PARAM_free(params);
+ err:
+    OSSL_PARAM_BLD_free(tmpl);
+    OPENSSL_secure_clear_free(prvenc, MLX_KEM_PRVKEY_BYTES);
+    OPENSSL_free(pubenc);
+    return ret;
+}
+
+static const OSSL_PARAM mlx_kem_key_types[] = {
+    OSSL_PARAM_octet_string(OSSL_PKEY_PARAM_PUB_KEY, NULL, 0),
+    OSSL_PARAM_octet_string(OSSL_PKEY_PARAM_PRIV_KEY, NULL, 0),
+    OSSL_PARAM_END
+};
+
+static const OSSL_PARAM *mlx_kem_imexport_types(int selection)
+{
+    if ((selection & OSSL_KEYMGMT_SELECT_KEYPAIR) != 0)
+        return mlx_kem_key_types;
+    return NULL;
+}
+
+/* Encodes the key into |p|, or just reports the length if there's no room */
+static int set_key_param(OSSL_PARAM *p, const MLX_KEY *key, int private)
+{
+    size_t len = private ? MLX_KEM_PRVKEY_BYTES : MLX_KEM_PUBKEY_BYTES;
+
+    if (p->data_type != OSSL_PARAM_OCTET_STRING)
+        return 0;
+    p->return_size = len;
+    if (p->data == NULL)
+        return 1;
+    if (p->data_size < len)
+        return 0;
+    if (private)
+        return mlx_kem_encode_private_key(p->data, key);
+    return mlx_kem_encode_public_key(p->data, key);
+}
+
+static int mlx_kem_get_params(void *keydata, OSSL_PARAM params[])
+{
+    MLX_KEY *key = keydata;
+    OSSL_PARAM *p;
+
+    /* The "bits" of a hybrid are those of its ML-KEM part */
+    if ((p = OSSL_PARAM_locate(params, OSSL_PKEY_PARAM_BITS)) != NULL
+        && !OSSL_PARAM_set_int(p, ML_KEM_768_BITS))
+        return 0;
+    if ((p = OSSL_PARAM_locate(params, OSSL_PKEY_PARAM_SECURITY_BITS)) != NULL
+        && !OSSL_PARAM_set_int(p, MLX_KEM_SECBITS))
+        return 0;
+    if ((p = OSSL_PARAM_locate(params, OSSL_PKEY_PARAM_MAX_SIZE)) != NULL
+        && !OSSL_PARAM_set_int(p, MLX_KEM_CIPHERTEXT_BYTES))
+        return 0;
+
+    if (ossl_ml_kem_have_pubkey(key->mkey)) {
+        if ((p = OSSL_PARAM_locate(params,
+                                   OSSL_PKEY_PARAM_ENCODED_PUBLIC_KEY)) != NULL
+            && !set_key_param(p, key, 0))
+            return 0;
+        if ((p = OSSL_PARAM_locate(params, OSSL_PKEY_PARAM_PUB_KEY)) != NULL
+            && !set_key_param(p, key, 0))
+            return 0;
+    }
+    if (ossl_ml_kem_have_prvkey(key->mkey)
+        && (p = OSSL_PARAM_locate(params, OSSL_PKEY_PARAM_PRIV_KEY)) != NULL
+        && !set_key_param(p, key, 1))
+        return 0;
+    return 1;
+}
+
+static const OSSL_PARAM *mlx_kem_gettable_params(void *provctx)
+{
+    static const OSSL_PARAM gettable[] = {
+        OSSL_PARAM_int(OSSL_PKEY_PARAM_BITS, NULL),
+        OSSL_PARAM_int(OSSL_PKEY_PARAM_SECURITY_BITS, NULL),
+        OSSL_PARAM_int(OSSL_PKEY_PARAM_MAX_SIZE, NULL),
+        OSSL_PARAM_octet_string(OSSL_PKEY_PARAM_ENCODED_PUBLIC_KEY, NULL, 0),
+        OSSL_PARAM_octet_string(OSSL_PKEY_PARAM_PUB_KEY, NULL, 0),
+        OSSL_PARAM_octet_string(OSSL_PKEY_PARAM_PRIV_KEY, NULL, 0),
+        OSSL_PARAM_END
+    };
+
+    return gettable;
+}
+
+static int mlx_kem_set_params(void *keydata, const OSSL_PARAM params[])
+{
+    MLX_KEY *key = keydata;
+    const OSSL_PARAM *p;
+    const void *buf;
+    size_t len;
+
+    p = OSSL_PARAM_locate_const(params, OSSL_PKEY_PARAM_ENCODED_PUBLIC_KEY);
+    if (p == NULL)
+        return 1;
+    if (!OSSL_PARAM_get_octet_string_ptr(p, &buf, &len))
+        return 0;
+    mlx_kem_key_reset(key);
+    if (!mlx_kem_parse_public_key(buf, len, key)) {
+        ERR_raise(ERR_LIB_PROV, PROV_R_INVALID_KEY);
+        return 0;
+    }
+    return 1;
+}
+
+static const OSSL_PARAM *mlx_kem_settable_params(void *provctx)
+{
+    static const OSSL_PARAM settable[] = {
+        OSSL_PARAM_octet_string(OSSL_PKEY_PARAM_ENCODED_PUBLIC_KEY, NULL, 0),
+        OSSL_PARAM_END
+    };
+
+    return settable;
+}
+
+static void *mlx_kem_gen_init(void *provctx, int selection,
+                              const OSSL_PARAM params[])
+{
+    struct mlx_kem_gen_ctx *gctx;
+
+    if (!ossl_prov_is_running())
+        return NULL;
+
+    if ((gctx = OPENSSL_zalloc(sizeof(*gctx))) == NULL)
+        return NULL;
+    gctx->libctx = PROV_LIBCTX_OF(provctx);
+    gctx->selection = selection;
+    if (!mlx_kem_gen_set_params(gctx, params)) {
+        mlx_kem_gen_cleanup(gctx);
+        gctx = NULL;
+    }
+    return gctx;
+}
+
+static int mlx_kem_gen_set_params(void *genctx, const OSSL_PARAM params[])
+{
+    struct mlx_kem_gen_ctx *gctx = genctx;
+    const OSSL_PARAM *p;
+
+    if (gctx == NULL)
+        return 0;
+
+    p = OSSL_PARAM_locate_const(params, OSSL_PKEY_PARAM_GROUP_NAME);
+    if (p != NULL
+        && (p->data_type != OSSL_PARAM_UTF8_STRING
+            || OPENSSL_strcasecmp(p->data, MLX_KEM_NAME) != 0)) {
+        ERR_raise(ERR_LIB_PROV, ERR_R_PASSED_INVALID_ARGUMENT);
+        return 0;
+    }
+    return 1;
+}
+
+static const OSSL_PARAM *mlx_kem_gen_settable_params(ossl_unused void *genctx,
+                                                     ossl_unused void *provctx)
+{
+    static const OSSL_PARAM settable[] = {
+        OSSL_PARAM_utf8_string(OSSL_PKEY_PARAM_GROUP_NAME, NULL, 0),
+        OSSL_PARAM_END
+    };
+
+    return settable;
+}
+
+static void *mlx_kem_gen(void *genctx, OSSL_CALLBACK *osslcb, void *cbarg)
+{
+    struct mlx_kem_gen_ctx *gctx = genctx;
+    MLX_KEY *key;
+
+    if (!ossl_prov_is_running() || gctx == NULL)
+        return NULL;
+    if ((key = mlx_kem_key_new(gctx->libctx)) == NULL)
+        return NULL;
+
+    /* If we're doing parameter generation then we just return a blank key */
+    if ((gctx->selection & OSSL_KEYMGMT_SELECT_KEYPAIR) == 0)
+        return key;
+
+    if (!ossl_ml_kem_genkey(key->mkey, NULL, 0)
+        || RAND_priv_bytes_ex(gctx->libctx, key->xprv, sizeof(key->xprv),
+                              0) <= 0) {
+        ERR_raise(ERR_LIB_PROV, PROV_R_FAILED_TO_GENERATE_KEY);
+        mlx_kem_free_key(key);
+        return NULL;
+    }
+    ossl_x25519_public_from_private(key->xpub, key->xprv);
+    return key;
+}
+
+static void mlx_kem_gen_cleanup(void *genctx)
+{
+    OPENSSL_free(genctx);
+}
+
+static void *mlx_kem_dup(const void *keydata, int selection)
+{
+    const MLX_KEY *src = keydata;
+    MLX_KEY *dst;
+
+    if (!ossl_prov_is_running())
+        return NULL;
+    if ((dst = OPENSSL_zalloc(sizeof(*dst))) == NULL)
+        return NULL;
+    dst->libctx = src->libctx;
+    if ((dst->mkey = ossl_ml_kem_key_dup(src->mkey, selection)) == NULL) {
+        OPENSSL_free(dst);
+        return NULL;
+    }
+    if ((selection & OSSL_KEYMGMT_SELECT_KEYPAIR) != 0)
+        memcpy(dst->xpub, src->xpub, sizeof(dst->xpub));
+    if ((selection & OSSL_KEYMGMT_SELECT_PRIVATE_KEY) != 0)
+        memcpy(dst->xprv, src->xprv, sizeof(dst->xprv));
+    return dst;
+}
+
+const OSSL_DISPATCH ossl_mlx_kem_keymgmt_functions[] = {
+    { OSSL_FUNC_KEYMGMT_NEW, (void (*)(void))mlx_kem_new_key },
+    { OSSL_FUNC_KEYMGMT_FREE, (void (*)(void))mlx_kem_free_key },
+    { OSSL_FUNC_KEYMGMT_GET_PARAMS, (void (*)(void))mlx_kem_get_params },
+    { OSSL_FUNC_KEYMGMT_GETTABLE_PARAMS,
+      (void (*)(void))mlx_kem_gettable_params },
+    { OSSL_FUNC_KEYMGMT_SET_PARAMS, (void (*)(void))mlx_kem_set_params },
+    { OSSL_FUNC_KEYMGMT_SETTABLE_PARAMS,
+      (void (*)(void))mlx_kem_settable_params },
+    { OSSL_FUNC_KEYMGMT_HAS, (void (*)(void))mlx_kem_has },
+    { OSSL_FUNC_KEYMGMT_MATCH, (void (*)(void))mlx_kem_match },
+    { OSSL_FUNC_KEYMGMT_VALIDATE, (void (*)(void))mlx_kem_validate },
+    { OSSL_FUNC_KEYMGMT_IMPORT, (void (*)(void))mlx_kem_import },
+    { OSSL_FUNC_KEYMGMT_IMPORT_TYPES, (void (*)(void))mlx_kem_imexport_types },
+    { OSSL_FUNC_KEYMGMT_EXPORT, (void (*)(void))mlx_kem_export },
+    { OSSL_FUNC_KEYMGMT_EXPORT_TYPES, (void (*)(void))mlx_kem_imexport_types },
+    { OSSL_FUNC_KEYMGMT_GEN_INIT, (void (*)(void))mlx_kem_gen_init },
+    { OSSL_FUNC_KEYMGMT_GEN_SET_PARAMS,
+      (void (*)(void))mlx_kem_gen_set_params },
+    { OSSL_FUNC_KEYMGMT_GEN_SETTABLE_PARAMS,
+      (void (*)(void))mlx_kem_gen_settable_params },
+    { OSSL_FUNC_KEYMGMT_GEN, (void (*)(void))mlx_kem_gen },
+    { OSSL_FUNC_KEYMGMT_GEN_CLEANUP, (void (*)(void))mlx_kem_gen_cleanup },
+    { OSSL_FUNC_KEYMGMT_DUP, (void (*)(void))mlx_kem_dup },
+    OSSL_DISPATCH_END
+};
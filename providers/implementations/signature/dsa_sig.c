@@ -76,6 +76,8 @@ typedef struct {
 
     /* If this is set to 1 then the generated k is not random */
     unsigned int nonce_type;
+    /* The HMAC_DRBG for deterministic k, kept for the digest in use */
+    OSSL_RFC6979_CTX *nonce_ctx;
 
     char mdname[OSSL_MAX_NAME_SIZE];
 
@@ -159,6 +161,10 @@ static int dsa_setup_md(PROV_DSA_CTX *ctx,
 
         EVP_MD_CTX_free(ctx->mdctx);
         EVP_MD_free(ctx->md);
+#ifndef FIPS_MODULE
+        ossl_rfc6979_ctx_free(ctx->nonce_ctx);
+        ctx->nonce_ctx = NULL;
+#endif
 
         /*
          * We do not care about DER writing errors.
@@ -252,9 +258,20 @@ static int dsa_sign(void *vpdsactx, unsigned char *sig, size_t *siglen,
     if (mdsize != 0 && tbslen != mdsize)
         return 0;
 
+#ifndef FIPS_MODULE
+    /* Without one, each signature sets up its own HMAC_DRBG */
+    if (pdsactx->nonce_type != 0 && pdsactx->nonce_ctx == NULL) {
+        ERR_set_mark();
+        pdsactx->nonce_ctx = ossl_rfc6979_ctx_new(pdsactx->mdname,
+                                                  pdsactx->libctx,
+                                                  pdsactx->propq);
+        ERR_pop_to_mark();
+    }
+#endif
     ret = ossl_dsa_sign_int(0, tbs, tbslen, sig, &sltmp, pdsactx->dsa,
                             pdsactx->nonce_type, pdsactx->mdname,
-                            pdsactx->libctx, pdsactx->propq);
+                            pdsactx->libctx, pdsactx->propq,
+                            pdsactx->nonce_ctx);
     if (ret <= 0)
         return 0;
 
@@ -397,6 +414,9 @@ static void dsa_freectx(void *vpdsactx)
     ctx->mdctx = NULL;
     ctx->md = NULL;
     DSA_free(ctx->dsa);
+#ifndef FIPS_MODULE
+    ossl_rfc6979_ctx_free(ctx->nonce_ctx);
+#endif
     OPENSSL_free(ctx);
 }
 
@@ -417,6 +437,7 @@ static void *dsa_dupctx(void *vpdsactx)
     dstctx->md = NULL;
     dstctx->mdctx = NULL;
     dstctx->propq = NULL;
+    dstctx->nonce_ctx = NULL;
 
     if (srcctx->dsa != NULL && !DSA_up_ref(srcctx->dsa))
         goto err;
@@ -26,6 +26,7 @@
 #include <internal/sizes.h>
 #include <internal/cryptlib.h>
 #include <internal/deterministic_nonce.h>
+#include <internal/param_names.h>
 #include <providers/providercommon.h>
 #include <providers/implementations.h>
 #include <providers/provider_ctx.h>
@@ -105,6 +106,8 @@ typedef struct {
 #endif
     /* If this is set then the generated k is not random */
     unsigned int nonce_type;
+    /* The HMAC_DRBG for deterministic k, kept for the digest in use */
+    OSSL_RFC6979_CTX *nonce_ctx;
 } PROV_ECDSA_CTX;
 
 static void *ecdsa_newctx(void *provctx, const char *propq)
@@ -196,10 +199,20 @@ static int ecdsa_sign(void *vctx, unsigned char *sig, size_t *siglen,
         return 0;
 
     if (ctx->nonce_type != 0) {
+#ifndef FIPS_MODULE
+        /* Without one, each signature sets up its own HMAC_DRBG */
+        if (ctx->nonce_ctx == NULL) {
+            ERR_set_mark();
+            ctx->nonce_ctx = ossl_rfc6979_ctx_new(ctx->mdname, ctx->libctx,
+                                                  ctx->propq);
+            ERR_pop_to_mark();
+        }
+#endif
         ret = ossl_ecdsa_deterministic_sign(tbs, tbslen, sig, &sltmp,
                                             ctx->ec, ctx->nonce_type,
                                             ctx->mdname,
-                                            ctx->libctx, ctx->propq);
+                                            ctx->libctx, ctx->propq,
+                                            ctx->nonce_ctx);
     } else {
         ret = ECDSA_sign_ex(0, tbs, tbslen, sig, &sltmp, ctx->kinv, ctx->r,
                             ctx->ec);
@@ -270,6 +283,10 @@ static int ecdsa_setup_md(PROV_ECDSA_CTX *ctx, const char *mdname,
 
     EVP_MD_CTX_free(ctx->mdctx);
     EVP_MD_free(ctx->md);
+#ifndef FIPS_MODULE
+    ossl_rfc6979_ctx_free(ctx->nonce_ctx);
+    ctx->nonce_ctx = NULL;
+#endif
 
     ctx->aid_len = 0;
     if (WPACKET_init_der(&pkt, ctx->aid_buf, sizeof(ctx->aid_buf))
@@ -394,6 +411,9 @@ static void ecdsa_freectx(void *vctx)
     EC_KEY_free(ctx->ec);
     BN_clear_free(ctx->kinv);
     BN_clear_free(ctx->r);
+#ifndef FIPS_MODULE
+    ossl_rfc6979_ctx_free(ctx->nonce_ctx);
+#endif
     OPENSSL_free(ctx);
 }
 
@@ -414,6 +434,7 @@ static void *ecdsa_dupctx(void *vctx)
     dstctx->md = NULL;
     dstctx->mdctx = NULL;
     dstctx->propq = NULL;
+    dstctx->nonce_ctx = NULL;
 
     if (srcctx->ec != NULL && !EC_KEY_up_ref(srcctx->ec))
         goto err;
@@ -452,25 +473,37 @@ static int ecdsa_get_ctx_params(void *vctx, OSSL_PARAM *params)
 
     if (ctx == NULL)
         return 0;
+    if (params == NULL)
+        return 1;
 
-    p = OSSL_PARAM_locate(params, OSSL_SIGNATURE_PARAM_ALGORITHM_ID);
-    if (p != NULL && !OSSL_PARAM_set_octet_string(p, ctx->aid, ctx->aid_len))
-        return 0;
-
-    p = OSSL_PARAM_locate(params, OSSL_SIGNATURE_PARAM_DIGEST_SIZE);
-    if (p != NULL && !OSSL_PARAM_set_size_t(p, ctx->mdsize))
-        return 0;
-
-    p = OSSL_PARAM_locate(params, OSSL_SIGNATURE_PARAM_DIGEST);
-    if (p != NULL && !OSSL_PARAM_set_utf8_string(p, ctx->md == NULL
-                                                    ? ctx->mdname
-                                                    : EVP_MD_get0_name(ctx->md)))
-        return 0;
-
-    p = OSSL_PARAM_locate(params, OSSL_SIGNATURE_PARAM_NONCE_TYPE);
-    if (p != NULL && !OSSL_PARAM_set_uint(p, ctx->nonce_type))
-        return 0;
-
+    for (p = params; p->key != NULL; p++) {
+        switch (ossl_param_find_pidx(p->key)) {
+        default:
+            break;
+
+        case PIDX_SIGNATURE_PARAM_ALGORITHM_ID:
+            if (!OSSL_PARAM_set_octet_string(p, ctx->aid, ctx->aid_len))
+                return 0;
+            break;
+
+        case PIDX_SIGNATURE_PARAM_DIGEST_SIZE:
+            if (!OSSL_PARAM_set_size_t(p, ctx->mdsize))
+                return 0;
+            break;
+
+        case PIDX_SIGNATURE_PARAM_DIGEST:
+            if (!OSSL_PARAM_set_utf8_string(p, ctx->md == NULL
+                                               ? ctx->mdname
+                                               : EVP_MD_get0_name(ctx->md)))
+                return 0;
+            break;
+
+        case PIDX_SIGNATURE_PARAM_NONCE_TYPE:
+            if (!OSSL_PARAM_set_uint(p, ctx->nonce_type))
+                return 0;
+            break;
+        }
+    }
     return 1;
 }
 
@@ -491,7 +524,7 @@ static const OSSL_PARAM *ecdsa_gettable_ctx_params(ossl_unused void *vctx,
 static int ecdsa_set_ctx_params(void *vctx, const OSSL_PARAM params[])
 {
     PROV_ECDSA_CTX *ctx = (PROV_ECDSA_CTX *)vctx;
-    const OSSL_PARAM *p;
+    const OSSL_PARAM *p, *digestp = NULL, *propsp = NULL, *mdsizep = NULL;
     size_t mdsize = 0;
 
     if (ctx == NULL)
@@ -499,21 +532,49 @@ static int ecdsa_set_ctx_params(void *vctx, const OSSL_PARAM params[])
     if (params == NULL)
         return 1;
 
+    /*
+     * The digest has to be set up before its size is checked, so only
+     * remember where those parameters are while walking the array.
+     */
+    for (p = params; p->key != NULL; p++) {
+        switch (ossl_param_find_pidx(p->key)) {
+        default:
+            break;
+
 #if !defined(OPENSSL_NO_ACVP_TESTS)
-    p = OSSL_PARAM_locate_const(params, OSSL_SIGNATURE_PARAM_KAT);
-    if (p != NULL && !OSSL_PARAM_get_uint(p, &ctx->kattest))
-        return 0;
+        case PIDX_SIGNATURE_PARAM_KAT:
+            if (!OSSL_PARAM_get_uint(p, &ctx->kattest))
+                return 0;
+            break;
 #endif
 
-    p = OSSL_PARAM_locate_const(params, OSSL_SIGNATURE_PARAM_DIGEST);
-    if (p != NULL) {
+        case PIDX_SIGNATURE_PARAM_DIGEST:
+            if (digestp == NULL)
+                digestp = p;
+            break;
+
+        case PIDX_SIGNATURE_PARAM_PROPERTIES:
+            if (propsp == NULL)
+                propsp = p;
+            break;
+
+        case PIDX_SIGNATURE_PARAM_DIGEST_SIZE:
+            if (mdsizep == NULL)
+                mdsizep = p;
+            break;
+
+        case PIDX_SIGNATURE_PARAM_NONCE_TYPE:
+            if (!OSSL_PARAM_get_uint(p, &ctx->nonce_type))
+                return 0;
+            break;
+        }
+    }
+
+    if (digestp != NULL) {
         char mdname[OSSL_MAX_NAME_SIZE] = "", *pmdname = mdname;
         char mdprops[OSSL_MAX_PROPQUERY_SIZE] = "", *pmdprops = mdprops;
-        const OSSL_PARAM *propsp =
-            OSSL_PARAM_locate_const(params,
-                                    OSSL_SIGNATURE_PARAM_PROPERTIES);
 
-        if (!OSSL_PARAM_get_utf8_string(p, &pmdname, sizeof(mdname)))
+        if (!OSSL_PARAM_get_utf8_string(digestp, &pmdname, sizeof(mdname)))
             return 0;
         if (propsp != NULL
             && !OSSL_PARAM_get_utf8_string(propsp, &pmdprops, sizeof(mdprops)))
@@ -522,17 +583,12 @@ static int ecdsa_set_ctx_params(void *vctx, const OSSL_PARAM params[])
             return 0;
     }
 
-    p = OSSL_PARAM_locate_const(params, OSSL_SIGNATURE_PARAM_DIGEST_SIZE);
-    if (p != NULL) {
-        if (!OSSL_PARAM_get_size_t(p, &mdsize)
+    if (mdsizep != NULL) {
+        if (!OSSL_PARAM_get_size_t(mdsizep, &mdsize)
             || (!ctx->flag_allow_md && mdsize != ctx->mdsize))
             return 0;
         ctx->mdsize = mdsize;
     }
-    p = OSSL_PARAM_locate_const(params, OSSL_SIGNATURE_PARAM_NONCE_TYPE);
-    if (p != NULL
-        && !OSSL_PARAM_get_uint(p, &ctx->nonce_type))
-        return 0;
 
     return 1;
 }
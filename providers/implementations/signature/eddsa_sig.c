@@ -67,6 +67,7 @@ static OSSL_FUNC_signature_digest_sign_fn ed25519_digest_sign;
 static OSSL_FUNC_signature_digest_sign_fn ed448_digest_sign;
 static OSSL_FUNC_signature_digest_verify_fn ed25519_digest_verify;
 static OSSL_FUNC_signature_digest_verify_fn ed448_digest_verify;
+static OSSL_FUNC_signature_digest_verify_batch_fn ed25519_digest_verify_batch;
 static OSSL_FUNC_signature_freectx_fn eddsa_freectx;
 static OSSL_FUNC_signature_dupctx_fn eddsa_dupctx;
 static OSSL_FUNC_signature_get_ctx_params_fn eddsa_get_ctx_params;
@@ -412,6 +413,69 @@ int ed25519_digest_verify(void *vpeddsactx, const unsigned char *sig,
                                peddsactx->libctx, edkey->propq);
 }
 
+static int ed25519_digest_verify_batch(void *vpeddsactx, size_t n,
+                                       void *const *vedkeys,
+                                       const unsigned char *const *sigs,
+                                       const size_t *siglens,
+                                       const unsigned char *const *tbs,
+                                       const size_t *tbslens, int *results)
+{
+    PROV_EDDSA_CTX *peddsactx = (PROV_EDDSA_CTX *)vpeddsactx;
+    const ECX_KEY *edkey;
+    const unsigned char **sig = NULL, **pub = NULL, **msg = NULL;
+    unsigned char *md = NULL;
+    size_t *msglen = NULL;
+    size_t i;
+    int ret = 0;
+
+    if (!ossl_prov_is_running())
+        return 0;
+
+    sig = OPENSSL_malloc(n * sizeof(*sig));
+    pub = OPENSSL_malloc(n * sizeof(*pub));
+    if (sig == NULL || pub == NULL)
+        goto err;
+    if (peddsactx->prehash_flag) {
+        msg = OPENSSL_malloc(n * sizeof(*msg));
+        msglen = OPENSSL_malloc(n * sizeof(*msglen));
+        md = OPENSSL_malloc(n * EDDSA_PREHASH_OUTPUT_LEN);
+        if (msg == NULL || msglen == NULL || md == NULL)
+            goto err;
+    }
+
+    for (i = 0; i < n; i++) {
+        edkey = vedkeys[i] != NULL ? vedkeys[i] : peddsactx->key;
+        pub[i] = edkey->pubkey;
+        /* A signature of the wrong length is simply invalid */
+        sig[i] = siglens[i] == ED25519_SIGSIZE ? sigs[i] : NULL;
+        if (peddsactx->prehash_flag) {
+            msg[i] = md + i * EDDSA_PREHASH_OUTPUT_LEN;
+            if (!EVP_Q_digest(peddsactx->libctx, SN_sha512, NULL, tbs[i],
+                              tbslens[i], md + i * EDDSA_PREHASH_OUTPUT_LEN,
+                              &msglen[i])
+                    || msglen[i] != EDDSA_PREHASH_OUTPUT_LEN)
+                goto err;
+        }
+    }
+
+    ossl_ed25519_verify_batch(n, msg != NULL ? msg : (const uint8_t **)tbs,
+                              msglen != NULL ? msglen : tbslens, sig, pub,
+                              results, peddsactx->dom2_flag,
+                              peddsactx->prehash_flag,
+                              peddsactx->context_string_flag,
+                              peddsactx->context_string,
+                              peddsactx->context_string_len,
+                              peddsactx->libctx, peddsactx->key->propq);
+    ret = 1;
+ err:
+    OPENSSL_free(sig);
+    OPENSSL_free(pub);
+    OPENSSL_free(msg);
+    OPENSSL_free(msglen);
+    OPENSSL_free(md);
+    return ret;
+}
+
 int ed448_digest_verify(void *vpeddsactx, const unsigned char *sig,
                         size_t siglen, const unsigned char *tbs,
                         size_t tbslen)
@@ -599,6 +663,8 @@ const OSSL_DISPATCH ossl_ed25519_signature_functions[] = {
       (void (*)(void))eddsa_digest_signverify_init },
     { OSSL_FUNC_SIGNATURE_DIGEST_VERIFY,
       (void (*)(void))ed25519_digest_verify },
+    { OSSL_FUNC_SIGNATURE_DIGEST_VERIFY_BATCH,
+      (void (*)(void))ed25519_digest_verify_batch },
     { OSSL_FUNC_SIGNATURE_FREECTX, (void (*)(void))eddsa_freectx },
     { OSSL_FUNC_SIGNATURE_DUPCTX, (void (*)(void))eddsa_dupctx },
     { OSSL_FUNC_SIGNATURE_GET_CTX_PARAMS, (void (*)(void))eddsa_get_ctx_params },
@@ -25,6 +25,7 @@
 #include <internal/cryptlib.h>
 #include <internal/nelem.h>
 #include <internal/sizes.h>
+#include <internal/param_names.h>
 #include <crypto/rsa.h>
 #include <providers/providercommon.h>
 #include <providers/implementations.h>
@@ -47,6 +48,7 @@ static OSSL_FUNC_signature_digest_sign_final_fn rsa_digest_sign_final;
 static OSSL_FUNC_signature_digest_verify_init_fn rsa_digest_verify_init;
 static OSSL_FUNC_signature_digest_verify_update_fn rsa_digest_signverify_update;
 static OSSL_FUNC_signature_digest_verify_final_fn rsa_digest_verify_final;
+static OSSL_FUNC_signature_digest_verify_batch_fn rsa_digest_verify_batch;
 static OSSL_FUNC_signature_freectx_fn rsa_freectx;
 static OSSL_FUNC_signature_dupctx_fn rsa_dupctx;
 static OSSL_FUNC_signature_get_ctx_params_fn rsa_get_ctx_params;
@@ -974,6 +976,67 @@ int rsa_digest_verify_final(void *vprsactx, const unsigned char *sig,
     return rsa_verify(vprsactx, sig, siglen, digest, (size_t)dlen);
 }
 
+/*
+ * Each signature is checked as rsa_digest_verify_final() would, with the
+ * settings of |prsactx|, but without setting up a new operation each time.
+ * Keys other than the one |prsactx| was initialised with must be of the same
+ * type and size, and without PSS restrictions of their own.
+ */
+static int rsa_digest_verify_batch(void *vprsactx, size_t n,
+                                   void *const *vrsas,
+                                   const unsigned char *const *sigs,
+                                   const size_t *siglens,
+                                   const unsigned char *const *tbs,
+                                   const size_t *tbslens, int *results)
+{
+    PROV_RSA_CTX *prsactx = (PROV_RSA_CTX *)vprsactx;
+    RSA *rsa, *initrsa;
+    EVP_MD_CTX *mdctx = NULL;
+    unsigned char digest[EVP_MAX_MD_SIZE];
+    unsigned int dlen = 0;
+    size_t i;
+    int ret = 0;
+
+    if (!ossl_prov_is_running() || prsactx == NULL || prsactx->mdctx == NULL)
+        return 0;
+    initrsa = prsactx->rsa;
+
+    for (i = 0; i < n; i++) {
+        if ((rsa = vrsas[i]) == NULL || rsa == initrsa)
+            continue;
+        if (RSA_test_flags(rsa, RSA_FLAG_TYPE_MASK)
+                != RSA_test_flags(initrsa, RSA_FLAG_TYPE_MASK)
+                || RSA_size(rsa) != RSA_size(initrsa)
+                || !ossl_rsa_pss_params_30_is_unrestricted(
+                        ossl_rsa_get0_pss_params_30(rsa))) {
+            ERR_raise(ERR_LIB_PROV, PROV_R_INVALID_KEY);
+            return 0;
+        }
+        if (!ossl_rsa_check_key(prsactx->libctx, rsa, EVP_PKEY_OP_VERIFY))
+            return 0;
+    }
+
+    if ((mdctx = EVP_MD_CTX_new()) == NULL)
+        return 0;
+    for (i = 0; i < n; i++) {
+        if (!EVP_DigestInit_ex2(mdctx, prsactx->md, NULL)
+                || !EVP_DigestUpdate(mdctx, tbs[i], tbslens[i])
+                || !EVP_DigestFinal_ex(mdctx, digest, &dlen))
+            goto err;
+        prsactx->rsa = vrsas[i] != NULL ? vrsas[i] : initrsa;
+        /* A signature that doesn't verify is a result, not an error */
+        ERR_set_mark();
+        results[i] = rsa_verify(prsactx, sigs[i], siglens[i], digest,
+                                (size_t)dlen) > 0;
+        ERR_pop_to_mark();
+    }
+    ret = 1;
+ err:
+    prsactx->rsa = initrsa;
+    EVP_MD_CTX_free(mdctx);
+    return ret;
+}
+
 static void rsa_freectx(void *vprsactx)
 {
     PROV_RSA_CTX *prsactx = (PROV_RSA_CTX *)vprsactx;
@@ -1161,7 +1224,8 @@ static const OSSL_PARAM *rsa_gettable_ctx_params(ossl_unused void *vprsactx,
 static int rsa_set_ctx_params(void *vprsactx, const OSSL_PARAM params[])
 {
     PROV_RSA_CTX *prsactx = (PROV_RSA_CTX *)vprsactx;
-    const OSSL_PARAM *p;
+    const OSSL_PARAM *p, *digestp = NULL, *propsp = NULL, *padp = NULL;
+    const OSSL_PARAM *saltlenp = NULL, *mgf1p = NULL, *mgf1propsp = NULL;
     int pad_mode;
     int saltlen;
     char mdname[OSSL_MAX_NAME_SIZE] = "", *pmdname = NULL;
@@ -1174,15 +1238,53 @@ static int rsa_set_ctx_params(void *vprsactx, const OSSL_PARAM params[])
     if (params == NULL)
         return 1;
 
+    /*
+     * The parameters depend on each other, e.g. the salt length can only be
+     * set once PSS padding is selected, so they are gathered in a single
+     * pass and then processed in a fixed order.
+     */
+    for (p = params; p->key != NULL; p++) {
+        switch (ossl_param_find_pidx(p->key)) {
+        default:
+            break;
+
+        case PIDX_SIGNATURE_PARAM_DIGEST:
+            if (digestp == NULL)
+                digestp = p;
+            break;
+
+        case PIDX_SIGNATURE_PARAM_PROPERTIES:
+            if (propsp == NULL)
+                propsp = p;
+            break;
+
+        case PIDX_SIGNATURE_PARAM_PAD_MODE:
+            if (padp == NULL)
+                padp = p;
+            break;
+
+        case PIDX_SIGNATURE_PARAM_PSS_SALTLEN:
+            if (saltlenp == NULL)
+                saltlenp = p;
+            break;
+
+        case PIDX_SIGNATURE_PARAM_MGF1_DIGEST:
+            if (mgf1p == NULL)
+                mgf1p = p;
+            break;
+
+        case PIDX_SIGNATURE_PARAM_MGF1_PROPERTIES:
+            if (mgf1propsp == NULL)
+                mgf1propsp = p;
+            break;
+        }
+    }
+
     pad_mode = prsactx->pad_mode;
     saltlen = prsactx->saltlen;
 
-    p = OSSL_PARAM_locate_const(params, OSSL_SIGNATURE_PARAM_DIGEST);
+    p = digestp;
     if (p != NULL) {
-        const OSSL_PARAM *propsp =
-            OSSL_PARAM_locate_const(params,
-                                    OSSL_SIGNATURE_PARAM_PROPERTIES);
-
         pmdname = mdname;
         if (!OSSL_PARAM_get_utf8_string(p, &pmdname, sizeof(mdname)))
             return 0;
@@ -1195,7 +1297,7 @@ static int rsa_set_ctx_params(void *vprsactx, const OSSL_PARAM params[])
         }
     }
 
-    p = OSSL_PARAM_locate_const(params, OSSL_SIGNATURE_PARAM_PAD_MODE);
+    p = padp;
     if (p != NULL) {
         const char *err_extra_text = NULL;
 
@@ -1265,7 +1367,7 @@ static int rsa_set_ctx_params(void *vprsactx, const OSSL_PARAM params[])
         }
     }
 
-    p = OSSL_PARAM_locate_const(params, OSSL_SIGNATURE_PARAM_PSS_SALTLEN);
+    p = saltlenp;
     if (p != NULL) {
         if (pad_mode != RSA_PKCS1_PSS_PADDING) {
             ERR_raise_data(ERR_LIB_PROV, PROV_R_NOT_SUPPORTED,
@@ -1339,19 +1441,15 @@ static int rsa_set_ctx_params(void *vprsactx, const OSSL_PARAM params[])
         }
     }
 
-    p = OSSL_PARAM_locate_const(params, OSSL_SIGNATURE_PARAM_MGF1_DIGEST);
+    p = mgf1p;
     if (p != NULL) {
-        const OSSL_PARAM *propsp =
-            OSSL_PARAM_locate_const(params,
-                                    OSSL_SIGNATURE_PARAM_MGF1_PROPERTIES);
-
         pmgf1mdname = mgf1mdname;
         if (!OSSL_PARAM_get_utf8_string(p, &pmgf1mdname, sizeof(mgf1mdname)))
             return 0;
 
-        if (propsp != NULL) {
+        if (mgf1propsp != NULL) {
             pmgf1mdprops = mgf1mdprops;
-            if (!OSSL_PARAM_get_utf8_string(propsp,
+            if (!OSSL_PARAM_get_utf8_string(mgf1propsp,
                                             &pmgf1mdprops, sizeof(mgf1mdprops)))
                 return 0;
         }
@@ -1473,6 +1571,8 @@ const OSSL_DISPATCH ossl_rsa_signature_functions[] = {
       (void (*)(void))rsa_digest_signverify_update },
     { OSSL_FUNC_SIGNATURE_DIGEST_VERIFY_FINAL,
       (void (*)(void))rsa_digest_verify_final },
+    { OSSL_FUNC_SIGNATURE_DIGEST_VERIFY_BATCH,
+      (void (*)(void))rsa_digest_verify_batch },
     { OSSL_FUNC_SIGNATURE_FREECTX, (void (*)(void))rsa_freectx },
     { OSSL_FUNC_SIGNATURE_DUPCTX, (void (*)(void))rsa_dupctx },
     { OSSL_FUNC_SIGNATURE_GET_CTX_PARAMS, (void (*)(void))rsa_get_ctx_params },
@@ -242,6 +242,8 @@ void ssl3_free_digest_list(SSL *s)
     s->s3.handshake_buffer = NULL;
     EVP_MD_CTX_free(s->s3.handshake_dgst);
     s->s3.handshake_dgst = NULL;
+    EVP_MD_CTX_free(s->s3.handshake_dgst_copy);
+    s->s3.handshake_dgst_copy = NULL;
 }
 
 int ssl3_finish_mac(SSL *s, const unsigned char *buf, size_t len)
@@ -3210,6 +3210,7 @@ void ssl3_free(SSL *s)
     OPENSSL_free(sc->s3.tmp.peer_cert_sigalgs);
     OPENSSL_free(sc->s3.tmp.valid_flags);
     ssl3_free_digest_list(sc);
+    tls13_hkdf_cache_free(sc);
     OPENSSL_free(sc->s3.alpn_selected);
     OPENSSL_free(sc->s3.alpn_proposed);
 
@@ -3241,6 +3242,7 @@ int ssl3_clear(SSL *s)
     EVP_PKEY_free(sc->s3.peer_tmp);
 
     ssl3_free_digest_list(sc);
+    tls13_hkdf_cache_free(sc);
 
     OPENSSL_free(sc->s3.alpn_selected);
     OPENSSL_free(sc->s3.alpn_proposed);
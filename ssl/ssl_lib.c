@@ -4072,6 +4072,52 @@ int SSL_CTX_up_ref(SSL_CTX *ctx)
     return ((i > 1) ? 1 : 0);
 }
 
+static void ssl_ctx_freeze_certs(STACK_OF(X509) *sk)
+{
+    int i;
+
+    for (i = 0; i < sk_X509_num(sk); i++)
+        X509_check_purpose(sk_X509_value(sk, i), -1, 0);
+}
+
+static void ssl_ctx_freeze_store(X509_STORE *store)
+{
+    STACK_OF(X509_OBJECT) *objs;
+    X509 *x;
+    int i;
+
+    if (store == NULL || (objs = X509_STORE_get1_objects(store)) == NULL)
+        return;
+    for (i = 0; i < sk_X509_OBJECT_num(objs); i++)
+        if ((x = X509_OBJECT_get0_X509(sk_X509_OBJECT_value(objs, i))) != NULL)
+            X509_check_purpose(x, -1, 0);
+    sk_X509_OBJECT_pop_free(objs, X509_OBJECT_free);
+}
+
+int SSL_CTX_freeze(SSL_CTX *ctx)
+{
+    CERT *c = ctx->cert;
+    size_t i;
+
+    if (!OSSL_LIB_CTX_freeze(ctx->libctx, ctx->propq))
+        return 0;
+
+    /*
+     * Decode the extensions of every certificate the context holds now,
+     * rather than on first use, where it would write to the certificate.
+     */
+    for (i = 0; i < c->ssl_pkey_num; i++) {
+        if (c->pkeys[i].x509 != NULL)
+            X509_check_purpose(c->pkeys[i].x509, -1, 0);
+        ssl_ctx_freeze_certs(c->pkeys[i].chain);
+    }
+    ssl_ctx_freeze_certs(ctx->extra_certs);
+    ssl_ctx_freeze_store(ctx->cert_store);
+    ssl_ctx_freeze_store(c->chain_store);
+    ssl_ctx_freeze_store(c->verify_store);
+    return 1;
+}
+
 void SSL_CTX_free(SSL_CTX *a)
 {
     int i;
@@ -5713,34 +5759,37 @@ int ssl_handshake_hash(SSL_CONNECTION *s,
                        unsigned char *out, size_t outlen,
                        size_t *hashlen)
 {
-    EVP_MD_CTX *ctx = NULL;
+    EVP_MD_CTX *ctx = s->s3.handshake_dgst_copy;
     EVP_MD_CTX *hdgst = s->s3.handshake_dgst;
     int hashleni = EVP_MD_CTX_get_size(hdgst);
-    int ret = 0;
 
     if (hashleni < 0 || (size_t)hashleni > outlen) {
         SSLfatal(s, SSL_AD_INTERNAL_ERROR, ERR_R_INTERNAL_ERROR);
-        goto err;
+        return 0;
     }
 
-    ctx = EVP_MD_CTX_new();
     if (ctx == NULL) {
-        SSLfatal(s, SSL_AD_INTERNAL_ERROR, ERR_R_INTERNAL_ERROR);
-        goto err;
+        ctx = EVP_MD_CTX_new();
+        if (ctx == NULL) {
+            SSLfatal(s, SSL_AD_INTERNAL_ERROR, ERR_R_INTERNAL_ERROR);
+            return 0;
+        }
+        s->s3.handshake_dgst_copy = ctx;
     }
 
+    /*
+     * Copying into the same context every time lets the digest provider
+     * overwrite its existing state instead of allocating a new one.
+     */
     if (!EVP_MD_CTX_copy_ex(ctx, hdgst)
         || EVP_DigestFinal_ex(ctx, out, NULL) <= 0) {
         SSLfatal(s, SSL_AD_INTERNAL_ERROR, ERR_R_INTERNAL_ERROR);
-        goto err;
+        return 0;
     }
 
     *hashlen = hashleni;
 
-    ret = 1;
- err:
-    EVP_MD_CTX_free(ctx);
-    return ret;
+    return 1;
 }
 
 int SSL_session_reused(const SSL *s)
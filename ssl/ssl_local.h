@@ -1190,6 +1190,20 @@ typedef struct quic_data_st QUIC_DATA;
 int quic_set_encryption_secrets(SSL *ssl, OSSL_ENCRYPTION_LEVEL level);
 #endif
 
+/*
+ * Number of secrets for which tls13_hkdf_expand() keeps a keyed HMAC context.
+ * Each TLS 1.3 secret is expanded two or three times in a row, the master
+ * secret four times.
+ */
+# define TLS13_HKDF_CACHE_SIZE   4
+
+typedef struct tls13_hkdf_key_st {
+    EVP_MD *md;
+    unsigned char secret[EVP_MAX_MD_SIZE];
+    size_t secretlen;
+    EVP_MAC_CTX *ctx;
+} TLS13_HKDF_KEY;
+
 struct ssl_st {
     int type;
     SSL_CTX *ctx;
@@ -1267,6 +1281,19 @@ struct ssl_st {
          * freed and MD_CTX for the required digest is stored here.
          */
         EVP_MD_CTX *handshake_dgst;
+        /*
+         * Scratch context that ssl_handshake_hash() finalises copies of
+         * handshake_dgst in.  It is kept so that each copy can reuse the
+         * provider side context of the previous one.
+         */
+        EVP_MD_CTX *handshake_dgst_copy;
+        /*
+         * HMAC contexts keyed with recently expanded TLS 1.3 secrets, used
+         * by tls13_hkdf_expand() and released by tls13_hkdf_cache_free().
+         */
+        EVP_MAC *hkdf_mac;
+        TLS13_HKDF_KEY hkdf_keys[TLS13_HKDF_CACHE_SIZE];
+        size_t hkdf_next;
         /*
          * Set whenever an expected ChangeCipherSpec message is processed.
          * Unset when the peer's Finished message is received.
@@ -2683,6 +2710,7 @@ __owur int tls13_hkdf_expand(SSL_CONNECTION *s,
                              const unsigned char *label, size_t labellen,
                              const unsigned char *data, size_t datalen,
                              unsigned char *out, size_t outlen, int fatal);
+void tls13_hkdf_cache_free(SSL_CONNECTION *s);
 __owur int tls13_hkdf_expand_ex(OSSL_LIB_CTX *libctx, const char *propq,
                                 const EVP_MD *md,
                                 const unsigned char *secret,
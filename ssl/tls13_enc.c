@@ -111,6 +111,134 @@ int tls13_hkdf_expand_ex(OSSL_LIB_CTX *libctx, const char *propq,
     return ret == 0;
 }
 
+static void tls13_hkdf_key_free(TLS13_HKDF_KEY *k)
+{
+    EVP_MAC_CTX_free(k->ctx);
+    EVP_MD_free(k->md);
+    OPENSSL_cleanse(k, sizeof(*k));
+}
+
+void tls13_hkdf_cache_free(SSL *s)
+{
+    size_t i;
+
+    for (i = 0; i < OSSL_NELEM(s->s3.hkdf_keys); i++)
+        tls13_hkdf_key_free(&s->s3.hkdf_keys[i]);
+    s->s3.hkdf_next = 0;
+    EVP_MAC_free(s->s3.hkdf_mac);
+    s->s3.hkdf_mac = NULL;
+}
+
+/*
+ * Return an HMAC context keyed with the |hashlen| byte |secret| for |md|.
+ * The key schedule expands each secret several times in a row, so the last
+ * few keyed contexts are kept and re-initialised from their precomputed
+ * inner and outer pad states rather than being rekeyed.
+ */
+static EVP_MAC_CTX *tls13_hkdf_key_ctx(SSL *s, const EVP_MD *md,
+                                       const unsigned char *secret,
+                                       size_t hashlen)
+{
+    SSL_CTX *sctx = s->ctx;
+    TLS13_HKDF_KEY *k;
+    OSSL_PARAM params[3], *p = params;
+    size_t i;
+
+    for (i = 0; i < OSSL_NELEM(s->s3.hkdf_keys); i++) {
+        k = &s->s3.hkdf_keys[i];
+        if (k->md == md && k->secretlen == hashlen
+                && CRYPTO_memcmp(k->secret, secret, hashlen) == 0)
+            return k->ctx;
+    }
+
+    if (s->s3.hkdf_mac == NULL) {
+        s->s3.hkdf_mac = EVP_MAC_fetch(sctx->libctx, OSSL_MAC_NAME_HMAC,
+                                       sctx->propq);
+        if (s->s3.hkdf_mac == NULL)
+            return NULL;
+    }
+
+    k = &s->s3.hkdf_keys[s->s3.hkdf_next];
+    s->s3.hkdf_next = (s->s3.hkdf_next + 1) % OSSL_NELEM(s->s3.hkdf_keys);
+    EVP_MD_free(k->md);
+    k->md = NULL;
+    k->secretlen = 0;
+    if (k->ctx == NULL && (k->ctx = EVP_MAC_CTX_new(s->s3.hkdf_mac)) == NULL)
+        return NULL;
+
+    *p++ = OSSL_PARAM_construct_utf8_string(OSSL_MAC_PARAM_DIGEST,
+                                            (char *)EVP_MD_get0_name(md), 0);
+    if (sctx->propq != NULL)
+        *p++ = OSSL_PARAM_construct_utf8_string(OSSL_MAC_PARAM_PROPERTIES,
+                                                sctx->propq, 0);
+    *p = OSSL_PARAM_construct_end();
+    if (!EVP_MAC_init(k->ctx, secret, hashlen, params)
+            || !EVP_MD_up_ref((EVP_MD *)md))
+        return NULL;
+
+    k->md = (EVP_MD *)md;
+    memcpy(k->secret, secret, hashlen);
+    k->secretlen = hashlen;
+    return k->ctx;
+}
+
+/*
+ * HKDF-Expand-Label from RFC 8446 using a cached keyed HMAC context. This
+ * gives the same result as tls13_hkdf_expand_ex() without fetching the KDF
+ * or allocating anything once the secret is in the cache.
+ */
+static int tls13_hkdf_expand_cached(SSL *s, const EVP_MD *md,
+                                    const unsigned char *secret,
+                                    const unsigned char *label,
+                                    size_t labellen,
+                                    const unsigned char *data, size_t datalen,
+                                    unsigned char *out, size_t outlen)
+{
+    unsigned char hkdflabel[2 + 1 + 255 + 1 + 255];
+    unsigned char t[EVP_MAX_MD_SIZE];
+    size_t hkdflabellen, hashlen, tlen = 0, done, n;
+    unsigned char ctr;
+    EVP_MAC_CTX *ctx;
+    WPACKET pkt;
+    int l, ret = 0;
+
+    if (labellen > TLS13_MAX_LABEL_LEN || (l = EVP_MD_get_size(md)) <= 0)
+        return 0;
+    hashlen = (size_t)l;
+    if (outlen > 255 * hashlen
+            || (ctx = tls13_hkdf_key_ctx(s, md, secret, hashlen)) == NULL)
+        return 0;
+
+    if (!WPACKET_init_static_len(&pkt, hkdflabel, sizeof(hkdflabel), 0)
+            || !WPACKET_put_bytes_u16(&pkt, outlen)
+            || !WPACKET_start_sub_packet_u8(&pkt)
+            || !WPACKET_memcpy(&pkt, label_prefix, sizeof(label_prefix) - 1)
+            || !WPACKET_memcpy(&pkt, label, labellen)
+            || !WPACKET_close(&pkt)
+            || !WPACKET_sub_memcpy_u8(&pkt, data, (data == NULL) ? 0 : datalen)
+            || !WPACKET_get_total_written(&pkt, &hkdflabellen)
+            || !WPACKET_finish(&pkt)) {
+        WPACKET_cleanup(&pkt);
+        return 0;
+    }
+
+    /* T(n) = HMAC(secret, T(n - 1) | HkdfLabel | n) */
+    for (ctr = 1, done = 0; done < outlen; ctr++, done += n) {
+        if (!EVP_MAC_init(ctx, NULL, 0, NULL)
+                || !EVP_MAC_update(ctx, t, tlen)
+                || !EVP_MAC_update(ctx, hkdflabel, hkdflabellen)
+                || !EVP_MAC_update(ctx, &ctr, 1)
+                || !EVP_MAC_final(ctx, t, &tlen, sizeof(t)))
+            goto err;
+        n = outlen - done < tlen ? outlen - done : tlen;
+        memcpy(out + done, t, n);
+    }
+    ret = 1;
+ err:
+    OPENSSL_cleanse(t, sizeof(t));
+    return ret;
+}
+
 int tls13_hkdf_expand(SSL *s, const EVP_MD *md,
                       const unsigned char *secret,
                       const unsigned char *label, size_t labellen,
@@ -118,13 +246,21 @@ int tls13_hkdf_expand(SSL *s, const EVP_MD *md,
                       unsigned char *out, size_t outlen, int fatal)
 {
     int ret;
-    SSL_CTX *sctx = s->ctx;
 
-    ret = tls13_hkdf_expand_ex(sctx->libctx, sctx->propq, md,
-                               secret, label, labellen, data, datalen,
-                               out, outlen, !fatal);
-    if (ret == 0 && fatal)
-        SSLfatal(s, SSL_AD_INTERNAL_ERROR, ERR_R_INTERNAL_ERROR);
+    ret = tls13_hkdf_expand_cached(s, md, secret, label, labellen,
+                                   data, datalen, out, outlen);
+    if (ret == 0) {
+        if (fatal)
+            SSLfatal(s, SSL_AD_INTERNAL_ERROR, ERR_R_INTERNAL_ERROR);
+        else if (labellen > TLS13_MAX_LABEL_LEN)
+            /*
+             * Probably we have been called from SSL_export_keying_material(),
+             * or SSL_export_keying_material_early().
+             */
+            ERR_raise(ERR_LIB_SSL, SSL_R_TLS_ILLEGAL_EXPORTER_LABEL);
+        else
+            ERR_raise(ERR_LIB_SSL, ERR_R_INTERNAL_ERROR);
+    }
 
     return ret;
 }
@@ -958,6 +1094,8 @@ int tls13_update_key(SSL *s, int sending)
     }
     ret = 1;
  err:
+    /* Don't keep the previous traffic secret around in the HKDF cache */
+    tls13_hkdf_cache_free(s);
     OPENSSL_cleanse(key, sizeof(key));
     OPENSSL_cleanse(secret, sizeof(secret));
     return ret;
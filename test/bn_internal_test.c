@@ -20,6 +20,7 @@
 #include <internal/numbers.h>
 #include <test/testutil.h>
 #include "bn_prime.h"
+#include "bn_local.h"
 #include <crypto/bn.h>
 
 static BN_CTX *ctx;
@@ -86,6 +87,311 @@ err:
     return ret;
 }
 
+/*
+ * Check the sieve over w + k * step against trial division. The step is a
+ * multiple of 3, so that every candidate or none is a multiple of 3.
+ */
+static int test_bn_prime_sieve(void)
+{
+    int ret = 0, i, pass;
+    size_t k;
+    BIGNUM *w = NULL, *step = NULL, *c = NULL;
+    BN_PRIME_SIEVE *sieve = NULL;
+    unsigned char composite[300];
+
+    if (!TEST_ptr(w = BN_new())
+            || !TEST_ptr(step = BN_new())
+            || !TEST_ptr(c = BN_new())
+            || !TEST_true(BN_rand(w, 1024, BN_RAND_TOP_ONE, BN_RAND_BOTTOM_ODD))
+            || !TEST_true(BN_rand(step, 200, BN_RAND_TOP_ONE,
+                                  BN_RAND_BOTTOM_ANY))
+            || !TEST_true(BN_mul_word(step, 6))
+            || !TEST_ptr(sieve = ossl_bn_prime_sieve_new(step)))
+        goto err;
+
+    for (pass = 0; pass < 2; pass++) {
+        /* The second time round, every candidate is a multiple of 3 */
+        if (pass == 1 && !TEST_true(BN_mul_word(w, 3)))
+            goto err;
+        if (!TEST_true(ossl_bn_prime_sieve(sieve, w, composite,
+                                           sizeof(composite)))
+                || !TEST_ptr(BN_copy(c, w)))
+            goto err;
+        for (k = 0; k < sizeof(composite); k++) {
+            int has_factor = 0;
+
+            for (i = 1; i < NUMPRIMES && !has_factor; i++)
+                has_factor = BN_mod_word(c, primes[i]) == 0;
+            if (!TEST_int_eq(composite[k], has_factor)
+                    || !TEST_true(BN_add(c, c, step)))
+                goto err;
+        }
+    }
+    ret = 1;
+err:
+    ossl_bn_prime_sieve_free(sieve);
+    BN_free(w);
+    BN_free(step);
+    BN_free(c);
+    return ret;
+}
+
+/*
+ * Check fixed-base exponentiation against BN_mod_exp() for exponents of
+ * every length the comb takes, including the all-zero and all-one ones.
+ */
+static const int comb_bits[] = { 1, 5, 64, 225, 301 };
+
+static int test_bn_mod_exp_comb(int idx)
+{
+    int ret = 0, bits = comb_bits[idx], i;
+    BIGNUM *g = NULL, *m = NULL, *e = NULL, *r = NULL, *expected = NULL;
+    BN_COMB *comb = NULL;
+
+    if (!TEST_ptr(g = BN_new())
+            || !TEST_ptr(m = BN_new())
+            || !TEST_ptr(e = BN_new())
+            || !TEST_ptr(r = BN_new())
+            || !TEST_ptr(expected = BN_new())
+            || !TEST_true(BN_rand(m, 1024, BN_RAND_TOP_ONE, BN_RAND_BOTTOM_ODD))
+            || !TEST_true(BN_rand_range(g, m))
+            || !TEST_ptr(comb = ossl_bn_comb_new(g, m, bits, ctx))
+            || !TEST_int_ge(ossl_bn_comb_bits(comb), bits))
+        goto err;
+
+    for (i = 0; i < 20; i++) {
+        if (i == 0) {
+            BN_zero(e);
+        } else if (i == 1) {
+            if (!TEST_true(BN_set_word(e, 0))
+                    || !TEST_true(BN_set_bit(e, bits))
+                    || !TEST_true(BN_sub_word(e, 1)))
+                goto err;
+        } else if (!TEST_true(BN_rand(e, bits, BN_RAND_TOP_ANY,
+                                      BN_RAND_BOTTOM_ANY))) {
+            goto err;
+        }
+        if (!TEST_true(BN_mod_exp(expected, g, e, m, ctx))
+                || !TEST_true(ossl_bn_mod_exp_comb(r, e, comb, ctx))
+                || !TEST_BN_eq(r, expected))
+            goto err;
+    }
+
+    /* An exponent that is too long is refused */
+    if (!TEST_true(BN_set_word(e, 0))
+            || !TEST_true(BN_set_bit(e, ossl_bn_comb_bits(comb)))
+            || !TEST_false(ossl_bn_mod_exp_comb(r, e, comb, ctx)))
+        goto err;
+    ERR_clear_error();
+    ret = 1;
+err:
+    ossl_bn_comb_free(comb);
+    BN_free(g);
+    BN_free(m);
+    BN_free(e);
+    BN_free(r);
+    BN_free(expected);
+    return ret;
+}
+
+static const int word_exp_bits[] = { 64, 1000, 2048, 4096, 16384 };
+
+static int test_bn_mod_exp_mont_word_exp(int idx)
+{
+    static const BN_ULONG exps[] = { 3, 17, 65537, BN_MASK2 };
+    int ret = 0, i, j;
+    BIGNUM *a = NULL, *m = NULL, *e = NULL, *r = NULL, *expected = NULL;
+    BN_MONT_CTX *mont = NULL;
+
+    if (!TEST_ptr(a = BN_new())
+            || !TEST_ptr(m = BN_new())
+            || !TEST_ptr(e = BN_new())
+            || !TEST_ptr(r = BN_new())
+            || !TEST_ptr(expected = BN_new())
+            || !TEST_ptr(mont = BN_MONT_CTX_new())
+            || !TEST_true(BN_rand(m, word_exp_bits[idx], BN_RAND_TOP_ONE,
+                                  BN_RAND_BOTTOM_ODD))
+            || !TEST_true(BN_MONT_CTX_set(mont, m, ctx)))
+        goto err;
+
+    for (i = 0; i < (int)OSSL_NELEM(exps); i++) {
+        if (!TEST_true(BN_set_word(e, exps[i])))
+            goto err;
+        for (j = 0; j < 4; j++) {
+            if (j == 0)
+                BN_zero(a);
+            else if (j == 1 ? !TEST_true(BN_sub(a, m, BN_value_one()))
+                            : !TEST_true(BN_rand_range(a, m)))
+                goto err;
+            if (!TEST_true(BN_mod_exp(expected, a, e, m, ctx))
+                    || !TEST_true(ossl_bn_mod_exp_mont_word_exp(r, a, exps[i],
+                                                                mont, ctx))
+                    || !TEST_BN_eq(r, expected))
+                goto err;
+        }
+    }
+
+    /* An even exponent or an unreduced base is refused */
+    if (!TEST_false(ossl_bn_mod_exp_mont_word_exp(r, a, 65536, mont, ctx))
+            || !TEST_false(ossl_bn_mod_exp_mont_word_exp(r, m, 65537, mont,
+                                                         ctx)))
+        goto err;
+    ERR_clear_error();
+    ret = 1;
+err:
+    BN_MONT_CTX_free(mont);
+    BN_free(a);
+    BN_free(m);
+    BN_free(e);
+    BN_free(r);
+    BN_free(expected);
+    return ret;
+}
+
+static const int fixed_bits[] = { 64, 256, 521, 4096 };
+
+/* Check the fixed-width helpers against BN_mod_mul_montgomery() and friends */
+static int test_bn_fixed(int idx)
+{
+    BN_ULONG fa[OSSL_BN_FIXED_MAX_WORDS], fb[OSSL_BN_FIXED_MAX_WORDS];
+    BN_ULONG fr[OSSL_BN_FIXED_MAX_WORDS];
+    int ret = 0, i;
+    BIGNUM *a = NULL, *b = NULL, *m = NULL, *r = NULL, *expected = NULL;
+    BN_MONT_CTX *mont = NULL;
+
+    if (!TEST_ptr(a = BN_new())
+            || !TEST_ptr(b = BN_new())
+            || !TEST_ptr(m = BN_new())
+            || !TEST_ptr(r = BN_new())
+            || !TEST_ptr(expected = BN_new())
+            || !TEST_ptr(mont = BN_MONT_CTX_new())
+            || !TEST_true(BN_rand(m, fixed_bits[idx], BN_RAND_TOP_ONE,
+                                  BN_RAND_BOTTOM_ODD))
+            || !TEST_true(BN_MONT_CTX_set(mont, m, ctx))
+            || !TEST_int_gt(ossl_bn_fixed_words(mont), 0))
+        goto err;
+
+    for (i = 0; i < 20; i++) {
+        if (!TEST_true(BN_rand_range(a, m))
+                || !TEST_true(BN_rand_range(b, m)))
+            goto err;
+        if (i == 0)
+            BN_zero(b);
+        else if (i == 1 && !TEST_true(BN_sub(a, m, BN_value_one())))
+            goto err;
+        if (!TEST_true(ossl_bn_fixed_load(fa, a, mont))
+                || !TEST_true(ossl_bn_fixed_load(fb, b, mont)))
+            goto err;
+
+        ossl_bn_fixed_mont_mul(fr, fa, fb, mont);
+        if (!TEST_true(ossl_bn_fixed_store(r, fr, mont))
+                || !TEST_true(BN_mod_mul_montgomery(expected, a, b, mont, ctx))
+                || !TEST_BN_eq(r, expected))
+            goto err;
+        ossl_bn_fixed_mod_add(fr, fa, fb, mont);
+        if (!TEST_true(ossl_bn_fixed_store(r, fr, mont))
+                || !TEST_true(BN_mod_add(expected, a, b, m, ctx))
+                || !TEST_BN_eq(r, expected))
+            goto err;
+        ossl_bn_fixed_mod_sub(fr, fa, fb, mont);
+        if (!TEST_true(ossl_bn_fixed_store(r, fr, mont))
+                || !TEST_true(BN_mod_sub(expected, a, b, m, ctx))
+                || !TEST_BN_eq(r, expected))
+            goto err;
+        ossl_bn_fixed_mod_half(fr, fa, mont);
+        ossl_bn_fixed_mod_add(fr, fr, fr, mont);
+        if (!TEST_true(ossl_bn_fixed_store(r, fr, mont))
+                || !TEST_BN_eq(r, a))
+            goto err;
+        if (!TEST_int_eq(ossl_bn_fixed_is_zero(fb, mont), BN_is_zero(b)))
+            goto err;
+    }
+    ret = 1;
+err:
+    BN_MONT_CTX_free(mont);
+    BN_free(a);
+    BN_free(b);
+    BN_free(m);
+    BN_free(r);
+    BN_free(expected);
+    return ret;
+}
+
+static const int inverse_bits[] = { 2, 17, 62, 63, 256, 521, 2048, 4096, 4097 };
+
+/* Check ossl_bn_mod_inverse_consttime() against BN_mod_inverse() */
+static int test_bn_mod_inverse_consttime(int idx)
+{
+    int ret = 0, i, coprime;
+    BIGNUM *a = NULL, *m = NULL, *r = NULL, *g = NULL, *expected = NULL;
+
+    if (!TEST_ptr(a = BN_new())
+            || !TEST_ptr(m = BN_new())
+            || !TEST_ptr(r = BN_new())
+            || !TEST_ptr(g = BN_new())
+            || !TEST_ptr(expected = BN_new())
+            || !TEST_true(BN_rand(m, inverse_bits[idx], BN_RAND_TOP_ONE,
+                                  BN_RAND_BOTTOM_ODD)))
+        goto err;
+
+    for (i = 0; i < 20; i++) {
+        if (!TEST_true(BN_rand_range(a, m)))
+            goto err;
+        if (i == 0)
+            BN_zero(a);
+        else if (i == 1)
+            BN_one(a);
+        else if (i == 2 && !TEST_true(BN_sub(a, m, BN_value_one())))
+            goto err;
+        else if (i == 3 && !TEST_true(BN_add(a, a, m)))
+            goto err;
+        else if (i == 4 && !TEST_true(BN_mul_word(a, 3)))
+            goto err;
+        if (!TEST_true(BN_gcd(g, a, m, ctx)))
+            goto err;
+        coprime = BN_is_one(g);
+        if (!TEST_int_eq(ossl_bn_mod_inverse_consttime(r, a, m, ctx), coprime))
+            goto err;
+        if (!coprime) {
+            ERR_clear_error();
+            continue;
+        }
+        if (!TEST_ptr(BN_mod_inverse(expected, a, m, ctx))
+                || !TEST_BN_eq(r, expected))
+            goto err;
+    }
+
+    /* An even modulus needs an odd a, and m + 1 is even */
+    if (!TEST_true(BN_add_word(m, 1))
+            || !TEST_false(ossl_bn_mod_inverse_consttime(r, m, m, ctx)))
+        goto err;
+    ERR_clear_error();
+    for (i = 0; i < 20; i++) {
+        if (!TEST_true(BN_rand(a, (i + 1) * inverse_bits[idx] / 20 + 1,
+                               BN_RAND_TOP_ONE, BN_RAND_BOTTOM_ODD))
+                || !TEST_true(BN_gcd(g, a, m, ctx)))
+            goto err;
+        coprime = BN_is_one(g);
+        if (!TEST_int_eq(ossl_bn_mod_inverse_consttime(r, a, m, ctx), coprime))
+            goto err;
+        if (!coprime) {
+            ERR_clear_error();
+            continue;
+        }
+        if (!TEST_ptr(BN_mod_inverse(expected, a, m, ctx))
+                || !TEST_BN_eq(r, expected))
+            goto err;
+    }
+    ret = 1;
+err:
+    BN_free(a);
+    BN_free(m);
+    BN_free(r);
+    BN_free(g);
+    BN_free(expected);
+    return ret;
+}
+
 int setup_tests(void)
 {
     if (!TEST_ptr(ctx = BN_CTX_new()))
@@ -94,6 +400,13 @@ int setup_tests(void)
     ADD_TEST(test_is_prime_enhanced);
     ADD_ALL_TESTS(test_is_composite_enhanced, (int)OSSL_NELEM(composites));
     ADD_TEST(test_bn_small_factors);
+    ADD_TEST(test_bn_prime_sieve);
+    ADD_ALL_TESTS(test_bn_mod_exp_comb, (int)OSSL_NELEM(comb_bits));
+    ADD_ALL_TESTS(test_bn_mod_exp_mont_word_exp,
+                  (int)OSSL_NELEM(word_exp_bits));
+    ADD_ALL_TESTS(test_bn_fixed, (int)OSSL_NELEM(fixed_bits));
+    ADD_ALL_TESTS(test_bn_mod_inverse_consttime,
+                  (int)OSSL_NELEM(inverse_bits));
 
     return 1;
 }
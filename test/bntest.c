@@ -1844,6 +1844,44 @@ static int test_bin2zero(void)
     return ret;
 }
 
+/*
+ * Inputs that fill any number of whole chunks, with or without a partial one
+ * at the top, against the value built up a byte at a time
+ */
+static int test_bin2bn_chunks(void)
+{
+    unsigned char be[4 * BN_BYTES + 3], le[sizeof(be)];
+    BIGNUM *bn = NULL, *expected = NULL;
+    int len, i, ret = 0;
+
+    if (!TEST_ptr(bn = BN_new())
+        || !TEST_ptr(expected = BN_new()))
+        goto err;
+
+    for (i = 0; i < (int)sizeof(be); i++)
+        be[i] = (unsigned char)(0xf1 - 37 * i);
+    for (len = 1; len <= (int)sizeof(be); len++) {
+        BN_zero(expected);
+        for (i = 0; i < len; i++) {
+            le[len - 1 - i] = be[i];
+            if (!TEST_true(BN_lshift(expected, expected, 8))
+                || !TEST_true(BN_add_word(expected, be[i])))
+                goto err;
+        }
+        if (!TEST_ptr(BN_bin2bn(be, len, bn))
+            || !TEST_BN_eq(bn, expected)
+            || !TEST_ptr(BN_lebin2bn(le, len, bn))
+            || !TEST_BN_eq(bn, expected))
+            goto err;
+    }
+
+    ret = 1;
+ err:
+    BN_free(bn);
+    BN_free(expected);
+    return ret;
+}
+
 static int test_bin2bn_lengths(void)
 {
     unsigned char input[] = { 1, 2 };
@@ -2982,6 +3020,7 @@ int setup_tests(void)
         ADD_TEST(test_asc2bn);
         ADD_TEST(test_bin2zero);
         ADD_TEST(test_bin2bn_lengths);
+        ADD_TEST(test_bin2bn_chunks);
         ADD_ALL_TESTS(test_mpi, (int)OSSL_NELEM(kMPITests));
         ADD_ALL_TESTS(test_bn2signed, (int)OSSL_NELEM(kSignedTests_BE));
         ADD_TEST(test_negzero);
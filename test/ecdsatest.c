@@ -22,6 +22,7 @@
 # include <openssl/bn.h>
 # include <openssl/ec.h>
 # include <openssl/rand.h>
+# include <openssl/core_names.h>
 # include <internal/nelem.h>
 # include <test/ecdsatest.h>
 
@@ -347,6 +348,67 @@ static int test_builtin_as_sm2(int n)
 }
 # endif
 
+/*
+ * Verify good and bad signatures before and after the public key's
+ * multiples have been precomputed, which happens on the second verification
+ * here, and check that a duplicate of the key keeps the setting.
+ */
+static int test_pub_precompute(int n)
+{
+    EVP_PKEY *pkey = NULL, *dup_pk = NULL;
+    EVP_PKEY_CTX *ctx = NULL;
+    unsigned char tbs[3][32], sig[3][256];
+    size_t sig_len[3];
+    int nid = curves[n].nid, after = 0, ret = 0, i, j;
+
+    if (nid == NID_ipsec4 || nid == NID_ipsec3 || nid == NID_sm2) {
+        TEST_info("skipped: ECDSA unsupported for curve %s", OBJ_nid2sn(nid));
+        return 1;
+    }
+
+    if (!TEST_ptr(pkey = EVP_PKEY_Q_keygen(NULL, NULL, "EC",
+                                           OBJ_nid2sn(nid)))
+            || !TEST_true(EVP_PKEY_set_int_param(pkey,
+                                                 OSSL_PKEY_PARAM_EC_PUB_PRECOMPUTE,
+                                                 2))
+            || !TEST_ptr(ctx = EVP_PKEY_CTX_new(pkey, NULL))
+            || !TEST_int_eq(EVP_PKEY_sign_init(ctx), 1))
+        goto err;
+    for (i = 0; i < 3; i++) {
+        sig_len[i] = sizeof(sig[i]);
+        if (!TEST_int_gt(RAND_bytes(tbs[i], sizeof(tbs[i])), 0)
+                || !TEST_int_eq(EVP_PKEY_sign(ctx, sig[i], &sig_len[i],
+                                              tbs[i], sizeof(tbs[i])), 1))
+            goto err;
+    }
+
+    if (!TEST_int_eq(EVP_PKEY_verify_init(ctx), 1))
+        goto err;
+    for (j = 0; j < 4; j++) {
+        for (i = 0; i < 3; i++) {
+            if (!TEST_int_eq(EVP_PKEY_verify(ctx, sig[i], sig_len[i], tbs[i],
+                                             sizeof(tbs[i])), 1)
+                    || !TEST_int_eq(EVP_PKEY_verify(ctx, sig[i], sig_len[i],
+                                                    tbs[(i + 1) % 3],
+                                                    sizeof(tbs[i])), 0))
+                goto err;
+        }
+    }
+
+    if (!TEST_ptr(dup_pk = EVP_PKEY_dup(pkey))
+            || !TEST_true(EVP_PKEY_get_int_param(dup_pk,
+                                                 OSSL_PKEY_PARAM_EC_PUB_PRECOMPUTE,
+                                                 &after))
+            || !TEST_int_eq(after, 2))
+        goto err;
+    ret = 1;
+ err:
+    EVP_PKEY_CTX_free(ctx);
+    EVP_PKEY_free(pkey);
+    EVP_PKEY_free(dup_pk);
+    return ret;
+}
+
 static int test_ecdsa_sig_NULL(void)
 {
     int ret;
@@ -406,6 +468,7 @@ int setup_tests(void)
     }
     ADD_ALL_TESTS(test_builtin_as_ec, crv_len);
     ADD_TEST(test_ecdsa_sig_NULL);
+    ADD_ALL_TESTS(test_pub_precompute, crv_len);
 # ifndef OPENSSL_NO_SM2
     ADD_ALL_TESTS(test_builtin_as_sm2, crv_len);
 # endif
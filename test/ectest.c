@@ -638,6 +638,221 @@ static int internal_curve_test_method(int n)
     return r;
 }
 
+/*
+ * Check EC_POINTs_mul() with enough points for the bucket method against
+ * the sum of the single multiplications, including awkward inputs: zero,
+ * negative and oversized scalars, repeated points, a point and its inverse
+ * with the same scalar and the point at infinity.  Without the generator,
+ * the P-256 and P-384 methods use a bucket method of their own.
+ */
+static int multi_scalar_mul_test(int n)
+{
+    const size_t num = 130;
+    int r = 0, nid = curves[n].nid;
+    size_t i;
+    EC_GROUP *group = NULL;
+    BN_CTX *ctx = NULL;
+    const BIGNUM *order;
+    BIGNUM *k = NULL, **scalars = NULL;
+    EC_POINT **points = NULL, *P = NULL, *Q = NULL, *R = NULL;
+
+    TEST_info("Curve %s multi scalar mul test", OBJ_nid2sn(nid));
+
+    if (!TEST_ptr(ctx = BN_CTX_new())
+        || !TEST_ptr(group = EC_GROUP_new_by_curve_name(nid))
+        || !TEST_ptr(points = OPENSSL_zalloc(num * sizeof(*points)))
+        || !TEST_ptr(scalars = OPENSSL_zalloc(num * sizeof(*scalars)))
+        || !TEST_ptr(P = EC_POINT_new(group))
+        || !TEST_ptr(Q = EC_POINT_new(group))
+        || !TEST_ptr(R = EC_POINT_new(group))
+        || !TEST_ptr(k = BN_new()))
+        goto err;
+    order = EC_GROUP_get0_order(group);
+
+    for (i = 0; i < num; i++) {
+        if (!TEST_ptr(points[i] = EC_POINT_new(group))
+            || !TEST_ptr(scalars[i] = BN_new())
+            || !TEST_true(BN_rand_range(k, order))
+            || !TEST_true(EC_POINT_mul(group, points[i], k, NULL, NULL, ctx))
+            || !TEST_true(BN_rand_range(scalars[i], order)))
+            goto err;
+    }
+    BN_zero(scalars[1]);
+    BN_set_negative(scalars[2], 1);
+    if (!TEST_true(BN_add(scalars[3], scalars[3], order))
+        || !TEST_true(BN_lshift(scalars[4], scalars[4], 64))
+        || !TEST_true(EC_POINT_copy(points[6], points[5]))
+        || !TEST_ptr(BN_copy(scalars[6], scalars[5]))
+        || !TEST_true(EC_POINT_copy(points[8], points[7]))
+        || !TEST_true(EC_POINT_invert(group, points[8], ctx))
+        || !TEST_ptr(BN_copy(scalars[8], scalars[7]))
+        || !TEST_true(EC_POINT_set_to_infinity(group, points[9]))
+        || !TEST_true(BN_rand_range(k, order)))
+        goto err;
+
+    /* R = k * G + sum(scalars[i] * points[i]) */
+    if (!TEST_true(EC_POINT_mul(group, R, k, NULL, NULL, ctx)))
+        goto err;
+    for (i = 0; i < num; i++) {
+        if (!TEST_true(EC_POINT_mul(group, Q, NULL, points[i], scalars[i],
+                                    ctx))
+            || !TEST_true(EC_POINT_add(group, R, R, Q, ctx)))
+            goto err;
+    }
+
+    if (!TEST_true(EC_POINTs_mul(group, P, k, num,
+                                 (const EC_POINT **)points,
+                                 (const BIGNUM **)scalars, ctx))
+        || !TEST_int_eq(0, EC_POINT_cmp(group, P, R, ctx)))
+        goto err;
+
+    /* And without the generator */
+    if (!TEST_true(EC_POINT_mul(group, Q, k, NULL, NULL, ctx))
+        || !TEST_true(EC_POINT_invert(group, Q, ctx))
+        || !TEST_true(EC_POINT_add(group, R, R, Q, ctx))
+        || !TEST_true(EC_POINTs_mul(group, P, NULL, num,
+                                    (const EC_POINT **)points,
+                                    (const BIGNUM **)scalars, ctx))
+        || !TEST_int_eq(0, EC_POINT_cmp(group, P, R, ctx)))
+        goto err;
+
+    r = 1;
+ err:
+    if (points != NULL)
+        for (i = 0; i < num; i++)
+            EC_POINT_free(points[i]);
+    if (scalars != NULL)
+        for (i = 0; i < num; i++)
+            BN_free(scalars[i]);
+    OPENSSL_free(points);
+    OPENSSL_free(scalars);
+    EC_POINT_free(P);
+    EC_POINT_free(Q);
+    EC_POINT_free(R);
+    BN_free(k);
+    EC_GROUP_free(group);
+    BN_CTX_free(ctx);
+    return r;
+}
+
+/*
+ * Check single multiplications in a named group, which may have a method of
+ * its own, against the same curve built from its parameters, including for
+ * the scalars next to zero and to the order.
+ */
+static int named_method_mul_test(int n)
+{
+    int r = 0, i = 0, nid = curves[n].nid;
+    EC_GROUP *group = NULL, *generic = NULL;
+    BN_CTX *ctx = NULL;
+    BIGNUM *p, *a, *b, *x, *y, *k;
+    const BIGNUM *order;
+    EC_POINT *G = NULL, *P = NULL, *Q = NULL, *R = NULL, *S = NULL;
+
+    if (!TEST_ptr(ctx = BN_CTX_new()))
+        return 0;
+    BN_CTX_start(ctx);
+    p = BN_CTX_get(ctx);
+    a = BN_CTX_get(ctx);
+    b = BN_CTX_get(ctx);
+    x = BN_CTX_get(ctx);
+    y = BN_CTX_get(ctx);
+    k = BN_CTX_get(ctx);
+    if (!TEST_ptr(k)
+        || !TEST_ptr(group = EC_GROUP_new_by_curve_name(nid)))
+        goto err;
+    if (EC_GROUP_get_field_type(group) != NID_X9_62_prime_field) {
+        r = 1;
+        goto err;
+    }
+    order = EC_GROUP_get0_order(group);
+    if (!TEST_true(EC_GROUP_get_curve(group, p, a, b, ctx))
+        || !TEST_ptr(generic = EC_GROUP_new_curve_GFp(p, a, b, ctx))
+        || !TEST_true(EC_POINT_get_affine_coordinates(group,
+                          EC_GROUP_get0_generator(group), x, y, ctx))
+        || !TEST_ptr(G = EC_POINT_new(generic))
+        || !TEST_true(EC_POINT_set_affine_coordinates(generic, G, x, y, ctx))
+        || !TEST_true(EC_GROUP_set_generator(generic, G, order,
+                                             EC_GROUP_get0_cofactor(group)))
+        || !TEST_ptr(P = EC_POINT_new(group))
+        || !TEST_ptr(Q = EC_POINT_new(generic))
+        || !TEST_ptr(R = EC_POINT_new(group))
+        || !TEST_ptr(S = EC_POINT_new(generic))
+        || !TEST_true(BN_rand_range(k, order))
+        || !TEST_true(EC_POINT_mul(group, P, k, NULL, NULL, ctx))
+        || !TEST_true(EC_POINT_get_affine_coordinates(group, P, x, y, ctx))
+        || !TEST_true(EC_POINT_set_affine_coordinates(generic, Q, x, y, ctx)))
+        goto err;
+
+    for (i = 0; i < 8; i++) {
+        switch (i) {
+        case 0:
+            BN_zero(k);
+            break;
+        case 1:
+            BN_one(k);
+            break;
+        case 2:
+        case 3:
+        case 4:
+            if (!TEST_ptr(BN_copy(k, order))
+                || !TEST_true(BN_add_word(k, 4))
+                || !TEST_true(BN_sub_word(k, i + 1)))
+                goto err;
+            break;
+        case 5:
+            if (!TEST_true(BN_rand_range(k, order)))
+                goto err;
+            BN_set_negative(k, 1);
+            break;
+        default:
+            if (!TEST_true(BN_rand(k, BN_num_bits(order) + 64 * (i - 6),
+                                   BN_RAND_TOP_ANY, BN_RAND_BOTTOM_ANY)))
+                goto err;
+            break;
+        }
+        if (!TEST_true(EC_POINT_mul(group, R, k, NULL, NULL, ctx))
+            || !TEST_true(EC_POINT_mul(generic, S, k, NULL, NULL, ctx))
+            || !TEST_int_eq(EC_POINT_is_at_infinity(group, R),
+                            EC_POINT_is_at_infinity(generic, S)))
+            goto err;
+        if (!EC_POINT_is_at_infinity(group, R)
+            && (!TEST_true(EC_POINT_get_affine_coordinates(group, R, x, y,
+                                                           ctx))
+                || !TEST_true(EC_POINT_get_affine_coordinates(generic, S, a, b,
+                                                              ctx))
+                || !TEST_BN_eq(x, a) || !TEST_BN_eq(y, b)))
+            goto err;
+
+        if (!TEST_true(EC_POINT_mul(group, R, NULL, P, k, ctx))
+            || !TEST_true(EC_POINT_mul(generic, S, NULL, Q, k, ctx))
+            || !TEST_int_eq(EC_POINT_is_at_infinity(group, R),
+                            EC_POINT_is_at_infinity(generic, S)))
+            goto err;
+        if (!EC_POINT_is_at_infinity(group, R)
+            && (!TEST_true(EC_POINT_get_affine_coordinates(group, R, x, y,
+                                                           ctx))
+                || !TEST_true(EC_POINT_get_affine_coordinates(generic, S, a, b,
+                                                              ctx))
+                || !TEST_BN_eq(x, a) || !TEST_BN_eq(y, b)))
+            goto err;
+    }
+    r = 1;
+ err:
+    if (!r)
+        TEST_info("Curve %s, scalar %d", OBJ_nid2sn(nid), i);
+    EC_POINT_free(G);
+    EC_POINT_free(P);
+    EC_POINT_free(Q);
+    EC_POINT_free(R);
+    EC_POINT_free(S);
+    EC_GROUP_free(generic);
+    EC_GROUP_free(group);
+    BN_CTX_end(ctx);
+    BN_CTX_free(ctx);
+    return r;
+}
+
 static int group_field_test(void)
 {
     int r = 1;
@@ -722,6 +937,38 @@ static const struct nistp_test_params nistp_tests_params[] = {
      /* d */
      "c477f9f65c22cce20657faa5b2d1d8122336f851a508a1ed04e479c34985bf96",
      },
+    {
+     /* P-384 */
+     NID_secp384r1,
+     384,
+     /* p */
+                                     "ffffffffffffffffffffffffffffffff"
+     "fffffffffffffffffffffffffffffffeffffffff0000000000000000ffffffff",
+     /* a */
+                                     "ffffffffffffffffffffffffffffffff"
+     "fffffffffffffffffffffffffffffffeffffffff0000000000000000fffffffc",
+     /* b */
+                                     "b3312fa7e23ee7e4988e056be3f82d19"
+     "181d9c6efe8141120314088f5013875ac656398d8a2ed19d2a85c8edd3ec2aef",
+     /* Qx */
+                                     "3bf701bc9e9d36b4d5f1455343f09126"
+     "f2564390f2b487365071243c61e6471fb9d2ab74657b82f9086489d9ef0f5cb5",
+     /* Qy */
+                                     "d1a358eafbf952e68d533855ccbdaa6f"
+     "f75b137a5101443199325583552a6295ffe5382d00cfcda30344a9b5b68db855",
+     /* Gx */
+                                     "aa87ca22be8b05378eb1c71ef320ad74"
+     "6e1d3b628ba79b9859f741e082542a385502f25dbf55296c3a545e3872760ab7",
+     /* Gy */
+                                     "3617de4a96262c6f5d9e98bf9292dc29"
+     "f8f41dbd289a147ce9da3113b5f0b8c00a60b1ce1d7e819d7a431d7c90ea0e5f",
+     /* order */
+                                     "ffffffffffffffffffffffffffffffff"
+     "ffffffffffffffffc7634d81f4372ddf581a0db248b0a77aecec196accc52973",
+     /* d */
+                                     "f92c02ed629e4b48c0584b1c6ce3a3e3"
+     "b4faae4afc6acb0455e73dfc392e6a0ae393a8565e6b9714d1224b57d83f8a08",
+     },
     {
      /* P-521 */
      NID_secp521r1,
@@ -2452,6 +2699,8 @@ int setup_tests(void)
     ADD_ALL_TESTS(nistp_single_test, OSSL_NELEM(nistp_tests_params));
     ADD_ALL_TESTS(internal_curve_test, crv_len);
     ADD_ALL_TESTS(internal_curve_test_method, crv_len);
+    ADD_ALL_TESTS(multi_scalar_mul_test, crv_len);
+    ADD_ALL_TESTS(named_method_mul_test, crv_len);
     ADD_TEST(group_field_test);
     ADD_ALL_TESTS(check_named_curve_test, crv_len);
     ADD_ALL_TESTS(check_named_curve_lookup_test, crv_len);
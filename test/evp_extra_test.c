@@ -1791,6 +1791,379 @@ static int test_EVP_Digest(void)
     return ret;
 }
 
+/*
+ * Repeatedly copy a running digest into the same destination context, as is
+ * done for TLS handshake transcripts, and check that each copy continues
+ * from the right state regardless of what the destination held before.
+ */
+static const char *copy_digests[] = { "SHA256", "SHA512", "SHA3-256", "SHAKE128" };
+
+static int digest_final(EVP_MD_CTX *ctx, unsigned char *out, size_t outlen)
+{
+    if ((EVP_MD_get_flags(EVP_MD_CTX_get0_md(ctx)) & EVP_MD_FLAG_XOF) != 0)
+        return EVP_DigestFinalXOF(ctx, out, outlen);
+    return EVP_DigestFinal_ex(ctx, out, NULL);
+}
+
+static int test_EVP_MD_CTX_copy_reuse(int idx)
+{
+    int ret = 0, i, j;
+    EVP_MD *md = NULL;
+    EVP_MD_CTX *running = NULL, *copy = NULL, *fresh = NULL;
+    unsigned char expected[EVP_MAX_MD_SIZE], got[EVP_MAX_MD_SIZE];
+    size_t mdlen;
+    static const unsigned char suffix[] = "suffix";
+
+    if (!TEST_ptr(md = EVP_MD_fetch(testctx, copy_digests[idx], testpropq))
+            || !TEST_ptr(running = EVP_MD_CTX_new())
+            || !TEST_ptr(copy = EVP_MD_CTX_new())
+            || !TEST_ptr(fresh = EVP_MD_CTX_new())
+            || !TEST_true(EVP_DigestInit_ex(running, md, NULL)))
+        goto out;
+    mdlen = (EVP_MD_get_flags(md) & EVP_MD_FLAG_XOF) != 0
+            ? 32 : (size_t)EVP_MD_get_size(md);
+
+    for (i = 0; i < 4; i++) {
+        if (!TEST_true(EVP_DigestUpdate(running, kMsg, sizeof(kMsg)))
+                || !TEST_true(EVP_MD_CTX_copy_ex(copy, running))
+                || !TEST_true(EVP_DigestUpdate(copy, suffix, i))
+                || !TEST_true(digest_final(copy, got, mdlen)))
+            goto out;
+
+        /* Recompute the same thing from scratch in a reused context */
+        if (!TEST_true(EVP_DigestInit_ex(fresh, md, NULL)))
+            goto out;
+        for (j = 0; j <= i; j++)
+            if (!TEST_true(EVP_DigestUpdate(fresh, kMsg, sizeof(kMsg))))
+                goto out;
+        if (!TEST_true(EVP_DigestUpdate(fresh, suffix, i))
+                || !TEST_true(digest_final(fresh, expected, mdlen))
+                || !TEST_mem_eq(got, mdlen, expected, mdlen))
+            goto out;
+    }
+    ret = 1;
+
+ out:
+    EVP_MD_CTX_free(running);
+    EVP_MD_CTX_free(copy);
+    EVP_MD_CTX_free(fresh);
+    EVP_MD_free(md);
+    return ret;
+}
+
+#ifndef OPENSSL_NO_EC
+# define BATCH_KEYS 3
+# define BATCH_SIZE 40
+
+static const char *batch_instances[] = { "Ed25519", "Ed25519ctx", "Ed25519ph" };
+
+/*
+ * Check EVP_DigestVerifyBatch() against EVP_DigestVerify() for a batch with
+ * several keys, with some of the signatures gone bad.
+ */
+static int test_EVP_DigestVerifyBatch(int idx)
+{
+    int ret = 0, i, expected;
+    EVP_PKEY *keys[BATCH_KEYS] = { NULL };
+    EVP_PKEY *pkeys[BATCH_SIZE];
+    EVP_MD_CTX *ctx = NULL;
+    unsigned char sigbuf[BATCH_SIZE][64], msgbuf[BATCH_SIZE][20];
+    const unsigned char *sigs[BATCH_SIZE], *tbs[BATCH_SIZE];
+    size_t siglens[BATCH_SIZE], tbslens[BATCH_SIZE];
+    int results[BATCH_SIZE];
+    unsigned char context[] = "batch";
+    OSSL_PARAM params[3], *p = params;
+
+    *p++ = OSSL_PARAM_construct_utf8_string(OSSL_SIGNATURE_PARAM_INSTANCE,
+                                            (char *)batch_instances[idx], 0);
+    if (idx == 1)
+        *p++ = OSSL_PARAM_construct_octet_string(OSSL_SIGNATURE_PARAM_CONTEXT_STRING,
+                                                 context, sizeof(context));
+    *p = OSSL_PARAM_construct_end();
+
+    for (i = 0; i < BATCH_KEYS; i++)
+        if (!TEST_ptr(keys[i] = EVP_PKEY_Q_keygen(testctx, testpropq,
+                                                  "ED25519")))
+            goto err;
+
+    for (i = 0; i < BATCH_SIZE; i++) {
+        pkeys[i] = keys[(i / 2) % BATCH_KEYS];
+        memset(msgbuf[i], i, sizeof(msgbuf[i]));
+        tbs[i] = msgbuf[i];
+        tbslens[i] = i % sizeof(msgbuf[i]);
+        sigs[i] = sigbuf[i];
+        siglens[i] = sizeof(sigbuf[i]);
+        EVP_MD_CTX_free(ctx);
+        if (!TEST_ptr(ctx = EVP_MD_CTX_new())
+                || !TEST_true(EVP_DigestSignInit_ex(ctx, NULL, NULL, testctx,
+                                                    testpropq, pkeys[i],
+                                                    params))
+                || !TEST_true(EVP_DigestSign(ctx, sigbuf[i], &siglens[i],
+                                             tbs[i], tbslens[i])))
+            goto err;
+    }
+
+    EVP_MD_CTX_free(ctx);
+    if (!TEST_ptr(ctx = EVP_MD_CTX_new())
+            || !TEST_true(EVP_DigestVerifyInit_ex(ctx, NULL, NULL, testctx,
+                                                  testpropq, keys[0], params))
+            || !TEST_int_eq(EVP_DigestVerifyBatch(ctx, BATCH_SIZE, pkeys, sigs,
+                                                  siglens, tbs, tbslens,
+                                                  results), 1))
+        goto err;
+    for (i = 0; i < BATCH_SIZE; i++)
+        if (!TEST_int_eq(results[i], 1))
+            goto err;
+
+    /* A bad s, a bad R, a wrong message, a short signature and a wrong key */
+    sigbuf[3][40] ^= 1;
+    sigbuf[10][0] ^= 1;
+    msgbuf[17][0] ^= 1;
+    siglens[22] = 63;
+    pkeys[31] = keys[(31 / 2 + 1) % BATCH_KEYS];
+    if (!TEST_int_eq(EVP_DigestVerifyBatch(ctx, BATCH_SIZE, pkeys, sigs,
+                                           siglens, tbs, tbslens, results), 0))
+        goto err;
+    for (i = 0; i < BATCH_SIZE; i++) {
+        expected = i != 3 && i != 10 && i != 17 && i != 22 && i != 31;
+        if (!TEST_int_eq(results[i], expected))
+            goto err;
+    }
+
+    /* Without an array of keys, the key |ctx| was set up with is used */
+    if (!TEST_int_eq(EVP_DigestVerifyBatch(ctx, 2, NULL, sigs, siglens, tbs,
+                                           tbslens, results), 1)
+            || !TEST_int_eq(EVP_DigestVerifyBatch(ctx, 4, NULL, sigs, siglens,
+                                                  tbs, tbslens, results), 0)
+            || !TEST_int_eq(results[1], 1)
+            || !TEST_int_eq(results[2], 0))
+        goto err;
+
+    ret = 1;
+ err:
+    EVP_MD_CTX_free(ctx);
+    for (i = 0; i < BATCH_KEYS; i++)
+        EVP_PKEY_free(keys[i]);
+    return ret;
+}
+#endif
+
+#define RSA_BATCH_SIZE 8
+
+/*
+ * EVP_DigestVerifyBatch() with RSA, PKCS#1 v1.5 for |idx| 0 and PSS for 1,
+ * against the key |ctx| was set up with and against another key of the same
+ * size.
+ */
+static int test_EVP_DigestVerifyBatch_RSA(int idx)
+{
+    int ret = 0, i, expected;
+    int pad = idx == 0 ? RSA_PKCS1_PADDING : RSA_PKCS1_PSS_PADDING;
+    EVP_PKEY *key = NULL, *other = NULL;
+    EVP_PKEY *pkeys[RSA_BATCH_SIZE];
+    EVP_MD_CTX *ctx = NULL;
+    EVP_PKEY_CTX *pctx;
+    unsigned char sigbuf[RSA_BATCH_SIZE][256], msgbuf[RSA_BATCH_SIZE][20];
+    const unsigned char *sigs[RSA_BATCH_SIZE], *tbs[RSA_BATCH_SIZE];
+    size_t siglens[RSA_BATCH_SIZE], tbslens[RSA_BATCH_SIZE];
+    int results[RSA_BATCH_SIZE];
+
+    if (!TEST_ptr(key = load_example_rsa_key())
+            || !TEST_ptr(other = EVP_PKEY_Q_keygen(testctx, testpropq, "RSA",
+                                                   (size_t)EVP_PKEY_get_bits(key))))
+        goto err;
+
+    for (i = 0; i < RSA_BATCH_SIZE; i++) {
+        pkeys[i] = i == 5 ? other : key;
+        memset(msgbuf[i], i, sizeof(msgbuf[i]));
+        tbs[i] = msgbuf[i];
+        tbslens[i] = i;
+        sigs[i] = sigbuf[i];
+        siglens[i] = sizeof(sigbuf[i]);
+        EVP_MD_CTX_free(ctx);
+        if (!TEST_ptr(ctx = EVP_MD_CTX_new())
+                || !TEST_true(EVP_DigestSignInit_ex(ctx, &pctx, "SHA2-256",
+                                                    testctx, testpropq,
+                                                    pkeys[i], NULL))
+                || !TEST_int_gt(EVP_PKEY_CTX_set_rsa_padding(pctx, pad), 0)
+                || !TEST_true(EVP_DigestSign(ctx, sigbuf[i], &siglens[i],
+                                             tbs[i], tbslens[i])))
+            goto err;
+    }
+
+    EVP_MD_CTX_free(ctx);
+    if (!TEST_ptr(ctx = EVP_MD_CTX_new())
+            || !TEST_true(EVP_DigestVerifyInit_ex(ctx, &pctx, "SHA2-256",
+                                                  testctx, testpropq, key,
+                                                  NULL))
+            || !TEST_int_gt(EVP_PKEY_CTX_set_rsa_padding(pctx, pad), 0)
+            || !TEST_int_eq(EVP_DigestVerifyBatch(ctx, RSA_BATCH_SIZE, pkeys,
+                                                  sigs, siglens, tbs, tbslens,
+                                                  results), 1))
+        goto err;
+
+    /* A bad signature, a wrong message and a wrong key */
+    sigbuf[1][10] ^= 1;
+    msgbuf[3][0] ^= 1;
+    pkeys[6] = other;
+    if (!TEST_int_eq(EVP_DigestVerifyBatch(ctx, RSA_BATCH_SIZE, pkeys, sigs,
+                                           siglens, tbs, tbslens, results), 0))
+        goto err;
+    for (i = 0; i < RSA_BATCH_SIZE; i++) {
+        expected = i != 1 && i != 3 && i != 6;
+        if (!TEST_int_eq(results[i], expected))
+            goto err;
+    }
+
+    /* Without an array of keys, the key |ctx| was set up with is used */
+    if (!TEST_int_eq(EVP_DigestVerifyBatch(ctx, 1, NULL, sigs, siglens, tbs,
+                                           tbslens, results), 1)
+            || !TEST_int_eq(EVP_DigestVerifyBatch(ctx, 6, NULL, sigs, siglens,
+                                                  tbs, tbslens, results), 0)
+            || !TEST_int_eq(results[4], 1)
+            || !TEST_int_eq(results[5], 0))
+        goto err;
+
+    ret = 1;
+ err:
+    EVP_MD_CTX_free(ctx);
+    EVP_PKEY_free(key);
+    EVP_PKEY_free(other);
+    return ret;
+}
+
+#ifndef OPENSSL_NO_EC
+# define GEN_BATCH_SIZE 40
+
+static const char *gen_batch_types[] = { "X25519", "X448", "ED25519" };
+
+/*
+ * Check that EVP_PKEY_generate_batch() gives distinct keys whose public
+ * halves match what is computed from the private halves one at a time.
+ */
+static int test_EVP_PKEY_generate_batch(int idx)
+{
+    int ret = 0, i;
+    EVP_PKEY_CTX *ctx = NULL;
+    EVP_PKEY *pkeys[GEN_BATCH_SIZE] = { NULL }, *check = NULL;
+    unsigned char priv[GEN_BATCH_SIZE][64], pub[64], pub2[64];
+    size_t privlen, publen, publen2;
+
+    if (!TEST_ptr(ctx = EVP_PKEY_CTX_new_from_name(testctx,
+                                                   gen_batch_types[idx],
+                                                   testpropq))
+            || !TEST_int_le(EVP_PKEY_generate_batch(ctx, pkeys,
+                                                    GEN_BATCH_SIZE), 0)
+            || !TEST_ptr_null(pkeys[0])
+            || !TEST_int_gt(EVP_PKEY_keygen_init(ctx), 0)
+            || !TEST_int_eq(EVP_PKEY_generate_batch(ctx, pkeys,
+                                                    GEN_BATCH_SIZE), 1))
+        goto err;
+
+    for (i = 0; i < GEN_BATCH_SIZE; i++) {
+        privlen = sizeof(priv[i]);
+        publen = sizeof(pub);
+        publen2 = sizeof(pub2);
+        if (!TEST_ptr(pkeys[i])
+                || !TEST_true(EVP_PKEY_is_a(pkeys[i], gen_batch_types[idx]))
+                || !TEST_true(EVP_PKEY_get_raw_private_key(pkeys[i], priv[i],
+                                                           &privlen))
+                || !TEST_true(EVP_PKEY_get_raw_public_key(pkeys[i], pub,
+                                                          &publen))
+                || !TEST_ptr(check = EVP_PKEY_new_raw_private_key_ex(
+                                 testctx, gen_batch_types[idx], testpropq,
+                                 priv[i], privlen))
+                || !TEST_true(EVP_PKEY_get_raw_public_key(check, pub2,
+                                                          &publen2))
+                || !TEST_mem_eq(pub, publen, pub2, publen2))
+            goto err;
+        EVP_PKEY_free(check);
+        check = NULL;
+        if (i > 0 && !TEST_mem_ne(priv[i - 1], privlen, priv[i], privlen))
+            goto err;
+    }
+
+    ret = 1;
+ err:
+    EVP_PKEY_free(check);
+    for (i = 0; i < GEN_BATCH_SIZE; i++)
+        EVP_PKEY_free(pkeys[i]);
+    EVP_PKEY_CTX_free(ctx);
+    return ret;
+}
+#endif
+
+#define DIGEST_BATCH_SIZE 37
+
+static const char *digest_batch_names[] = { "SHA256", "SHA512", NULL };
+
+/*
+ * Check EVP_DigestBatch() against EVP_Digest() for messages whose lengths
+ * fall either side of the padding boundaries, with some long enough to be
+ * still in progress while others finish.  The last case uses the legacy
+ * EVP_sha256() which has to be implicitly fetched.
+ */
+static int test_EVP_DigestBatch(int idx)
+{
+    static const size_t lens[] = {
+        0, 1, 55, 56, 63, 64, 119, 120, 200, 256, 257, 1000, 5000
+    };
+    int ret = 0;
+    size_t i, len[DIGEST_BATCH_SIZE];
+    EVP_MD *fetched = NULL;
+    const EVP_MD *md;
+    unsigned char *buf = NULL, *out = NULL, expected[EVP_MAX_MD_SIZE];
+    const unsigned char *data[DIGEST_BATCH_SIZE];
+    unsigned char *mds[DIGEST_BATCH_SIZE];
+    unsigned int mdlen;
+
+    if (digest_batch_names[idx] == NULL) {
+        if (nullprov != NULL)
+            return TEST_skip("Test does not support a non-default library context");
+        md = EVP_sha256();
+    } else {
+        if (!TEST_ptr(fetched = EVP_MD_fetch(testctx, digest_batch_names[idx],
+                                             testpropq)))
+            return 0;
+        md = fetched;
+    }
+    if (!TEST_ptr(buf = OPENSSL_malloc(6000))
+            || !TEST_ptr(out = OPENSSL_malloc(DIGEST_BATCH_SIZE
+                                              * EVP_MAX_MD_SIZE)))
+        goto err;
+    for (i = 0; i < 6000; i++)
+        buf[i] = (unsigned char)(i * 7 + (i >> 8));
+
+    for (i = 0; i < DIGEST_BATCH_SIZE; i++) {
+        len[i] = lens[(i * 5) % OSSL_NELEM(lens)];
+        data[i] = buf + i;
+        mds[i] = out + i * EVP_MAX_MD_SIZE;
+    }
+    if (!TEST_true(EVP_DigestBatch(md, 0, NULL, NULL, NULL))
+            || !TEST_true(EVP_DigestBatch(md, DIGEST_BATCH_SIZE, data, len,
+                                          mds)))
+        goto err;
+    for (i = 0; i < DIGEST_BATCH_SIZE; i++)
+        if (!TEST_true(EVP_Digest(data[i], len[i], expected, &mdlen, md,
+                                  NULL))
+                || !TEST_mem_eq(mds[i], mdlen, expected, mdlen))
+            goto err;
+
+    /* Too few messages for the multi-buffer code to be used */
+    if (!TEST_true(EVP_DigestBatch(md, 3, data + 10, len + 10, mds))
+            || !TEST_true(EVP_Digest(data[12], len[12], expected, &mdlen, md,
+                                     NULL))
+            || !TEST_mem_eq(mds[2], mdlen, expected, mdlen))
+        goto err;
+
+    ret = 1;
+ err:
+    OPENSSL_free(buf);
+    OPENSSL_free(out);
+    EVP_MD_free(fetched);
+    return ret;
+}
+
 static int test_EVP_md_null(void)
 {
     int ret = 0;
@@ -5562,6 +5935,13 @@ int setup_tests(void)
 #endif
     ADD_TEST(test_EVP_Digest);
     ADD_TEST(test_EVP_md_null);
+    ADD_ALL_TESTS(test_EVP_MD_CTX_copy_reuse, OSSL_NELEM(copy_digests));
+#ifndef OPENSSL_NO_EC
+    ADD_ALL_TESTS(test_EVP_DigestVerifyBatch, OSSL_NELEM(batch_instances));
+    ADD_ALL_TESTS(test_EVP_PKEY_generate_batch, OSSL_NELEM(gen_batch_types));
+#endif
+    ADD_ALL_TESTS(test_EVP_DigestBatch, OSSL_NELEM(digest_batch_names));
+    ADD_ALL_TESTS(test_EVP_DigestVerifyBatch_RSA, 2);
     ADD_ALL_TESTS(test_EVP_PKEY_sign, 3);
 #ifndef OPENSSL_NO_DEPRECATED_3_0
     ADD_ALL_TESTS(test_EVP_PKEY_sign_with_app_method, 2);
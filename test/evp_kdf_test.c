@@ -16,6 +16,7 @@
 #include <openssl/evp.h>
 #include <openssl/kdf.h>
 #include <openssl/core_names.h>
+#include <openssl/thread.h>
 #include <internal/numbers.h>
 #include <test/testutil.h>
 
@@ -896,8 +897,126 @@ static int test_kdf_scrypt(void)
     EVP_KDF_CTX_free(kctx);
     return ret;
 }
+
+/*
+ * A derivation can use fewer threads than asked for, and a context can
+ * derive again with smaller parameters, in the memory it already has.
+ */
+static int test_kdf_scrypt_reuse(void)
+{
+    int ret, pool = 0;
+    EVP_KDF_CTX *kctx;
+    OSSL_PARAM params[6], thread_params[2], *p = params;
+    unsigned char out[64];
+    unsigned int nu = 1024, ru = 8, pu = 16, threads = 4;
+    static const unsigned char expected_big[sizeof(out)] = {
+        0xfd, 0xba, 0xbe, 0x1c, 0x9d, 0x34, 0x72, 0x00,
+        0x78, 0x56, 0xe7, 0x19, 0x0d, 0x01, 0xe9, 0xfe,
+        0x7c, 0x6a, 0xd7, 0xcb, 0xc8, 0x23, 0x78, 0x30,
+        0xe7, 0x73, 0x76, 0x63, 0x4b, 0x37, 0x31, 0x62,
+        0x2e, 0xaf, 0x30, 0xd9, 0x2e, 0x22, 0xa3, 0x88,
+        0x6f, 0xf1, 0x09, 0x27, 0x9d, 0x98, 0x30, 0xda,
+        0xc7, 0x27, 0xaf, 0xb9, 0x4a, 0x83, 0xee, 0x6d,
+        0x83, 0x60, 0xcb, 0xdf, 0xa2, 0xcc, 0x06, 0x40
+    };
+    static const unsigned char expected[sizeof(out)] = {
+        0x77, 0xd6, 0x57, 0x62, 0x38, 0x65, 0x7b, 0x20,
+        0x3b, 0x19, 0xca, 0x42, 0xc1, 0x8a, 0x04, 0x97,
+        0xf1, 0x6b, 0x48, 0x44, 0xe3, 0x07, 0x4a, 0xe8,
+        0xdf, 0xdf, 0xfa, 0x3f, 0xed, 0xe2, 0x14, 0x42,
+        0xfc, 0xd0, 0x06, 0x9d, 0xed, 0x09, 0x48, 0xf8,
+        0x32, 0x6a, 0x75, 0x3a, 0x0f, 0xc8, 0x1f, 0x17,
+        0xe8, 0xd3, 0xe0, 0xfb, 0x2e, 0x0d, 0x36, 0x28,
+        0xcf, 0x35, 0xe2, 0x0c, 0x38, 0xd1, 0x89, 0x06
+    };
+
+    *p++ = OSSL_PARAM_construct_octet_string(OSSL_KDF_PARAM_PASSWORD,
+                                             (char *)"password", 8);
+    *p++ = OSSL_PARAM_construct_octet_string(OSSL_KDF_PARAM_SALT,
+                                             (char *)"NaCl", 4);
+    *p++ = OSSL_PARAM_construct_uint(OSSL_KDF_PARAM_SCRYPT_N, &nu);
+    *p++ = OSSL_PARAM_construct_uint(OSSL_KDF_PARAM_SCRYPT_R, &ru);
+    *p++ = OSSL_PARAM_construct_uint(OSSL_KDF_PARAM_SCRYPT_P, &pu);
+    *p = OSSL_PARAM_construct_end();
+    thread_params[0] = OSSL_PARAM_construct_uint(OSSL_KDF_PARAM_THREADS,
+                                                 &threads);
+    thread_params[1] = OSSL_PARAM_construct_end();
+
+    /* A pool of one thread, so that four threads become two */
+    if ((OSSL_get_thread_support_flags()
+         & OSSL_THREAD_SUPPORT_FLAG_DEFAULT_SPAWN) != 0
+        && !TEST_int_eq(pool = OSSL_set_max_threads(NULL, 1), 1))
+        return 0;
+
+    ret =
+        TEST_ptr(kctx = get_kdfbyname(OSSL_KDF_NAME_SCRYPT))
+        && TEST_true(EVP_KDF_CTX_set_params(kctx, params))
+        && TEST_true(EVP_KDF_CTX_set_params(kctx, thread_params))
+        && TEST_int_gt(EVP_KDF_derive(kctx, out, sizeof(out), NULL), 0)
+        && TEST_mem_eq(out, sizeof(out), expected_big, sizeof(expected_big))
+        && TEST_true(OSSL_PARAM_set_uint(&params[2], 16))
+        && TEST_true(OSSL_PARAM_set_uint(&params[3], 1))
+        && TEST_true(OSSL_PARAM_set_uint(&params[4], 1));
+    if (ret) {
+        params[0] = OSSL_PARAM_construct_octet_string(OSSL_KDF_PARAM_PASSWORD,
+                                                      (char *)"", 0);
+        params[1] = OSSL_PARAM_construct_octet_string(OSSL_KDF_PARAM_SALT,
+                                                      (char *)"", 0);
+        ret = TEST_int_gt(EVP_KDF_derive(kctx, out, sizeof(out), params), 0)
+            && TEST_mem_eq(out, sizeof(out), expected, sizeof(expected));
+    }
+
+    if (pool)
+        OSSL_set_max_threads(NULL, 0);
+    EVP_KDF_CTX_free(kctx);
+    return ret;
+}
 #endif /* OPENSSL_NO_SCRYPT */
 
+#ifndef OPENSSL_NO_ARGON2
+/* A context keeps its memory between derivations, whatever their size */
+static int test_kdf_argon2_reuse(void)
+{
+    int ret;
+    EVP_KDF_CTX *kctx;
+    OSSL_PARAM params[6], *p = params;
+    unsigned char pwd[32], salt[16], out[32], out_big[32];
+    uint32_t lanes = 4, iter = 3, memcost = 32, memcost_big = 64;
+    static const unsigned char expected[sizeof(out)] = {
+        0x03, 0xaa, 0xb9, 0x65, 0xc1, 0x20, 0x01, 0xc9,
+        0xd7, 0xd0, 0xd2, 0xde, 0x33, 0x19, 0x2c, 0x04,
+        0x94, 0xb6, 0x84, 0xbb, 0x14, 0x81, 0x96, 0xd7,
+        0x3c, 0x1d, 0xf1, 0xac, 0xaf, 0x6d, 0x0c, 0x2e
+    };
+
+    memset(pwd, 1, sizeof(pwd));
+    memset(salt, 2, sizeof(salt));
+    *p++ = OSSL_PARAM_construct_octet_string(OSSL_KDF_PARAM_PASSWORD,
+                                             pwd, sizeof(pwd));
+    *p++ = OSSL_PARAM_construct_octet_string(OSSL_KDF_PARAM_SALT,
+                                             salt, sizeof(salt));
+    *p++ = OSSL_PARAM_construct_uint32(OSSL_KDF_PARAM_ARGON2_LANES, &lanes);
+    *p++ = OSSL_PARAM_construct_uint32(OSSL_KDF_PARAM_ITER, &iter);
+    *p++ = OSSL_PARAM_construct_uint32(OSSL_KDF_PARAM_ARGON2_MEMCOST,
+                                       &memcost_big);
+    *p = OSSL_PARAM_construct_end();
+
+    ret =
+        TEST_ptr(kctx = get_kdfbyname("ARGON2ID"))
+        && TEST_true(EVP_KDF_CTX_set_params(kctx, params))
+        && TEST_int_gt(EVP_KDF_derive(kctx, out_big, sizeof(out_big), NULL), 0)
+        && TEST_true(OSSL_PARAM_set_uint32(p - 1, memcost))
+        && TEST_int_gt(EVP_KDF_derive(kctx, out, sizeof(out), params), 0)
+        && TEST_mem_eq(out, sizeof(out), expected, sizeof(expected))
+        && TEST_mem_ne(out_big, sizeof(out_big), expected, sizeof(expected))
+        && TEST_int_gt(EVP_KDF_derive(kctx, out, sizeof(out), NULL), 0)
+        && TEST_mem_eq(out, sizeof(out), expected, sizeof(expected));
+
+    EVP_KDF_CTX_free(kctx);
+    return ret;
+}
+#endif /* OPENSSL_NO_ARGON2 */
+
 static int test_kdf_ss_hash(void)
 {
     int ret;
@@ -2017,6 +2136,10 @@ int setup_tests(void)
     ADD_TEST(test_kdf_pbkdf2_invalid_digest);
 #ifndef OPENSSL_NO_SCRYPT
     ADD_TEST(test_kdf_scrypt);
+    ADD_TEST(test_kdf_scrypt_reuse);
+#endif
+#ifndef OPENSSL_NO_ARGON2
+    ADD_TEST(test_kdf_argon2_reuse);
 #endif
     ADD_TEST(test_kdf_ss_hash);
     ADD_TEST(test_kdf_ss_hmac);
@@ -0,0 +1,316 @@
+/*
+ * Copyright 2024 The OpenSSL Project Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License 2.0 (the "License").  You may not use
+ * this file except in compliance with the License.  You can obtain a copy
+ * in the file LICENSE in the source distribution or at
+ * https://www.openssl.org/source/license.html
+ */
+
+#include <string.h>
+#include <openssl/evp.h>
+#include <openssl/core_names.h>
+#include <openssl/params.h>
+#include <internal/nelem.h>
+#include <test/testutil.h>
+
+static OSSL_LIB_CTX *libctx = NULL;
+
+/*
+ * Known answers for key generation from the seed d = 0x00..0x1f,
+ * z = 0x20..0x3f and encapsulation with m = 0x40..0x5f.  The keys and the
+ * ciphertext are large, so only their SHA3-256 digests are recorded.
+ * |rejected| is the implicit rejection secret for the ciphertext with the
+ * low bit of its first byte flipped.
+ */
+typedef struct {
+    const char *alg;
+    size_t publen, prvlen, ctlen;
+    const char *pubhash, *prvhash, *cthash, *secret, *rejected;
+} ML_KEM_KAT;
+
+static const ML_KEM_KAT ml_kem_kats[] = {
+    {
+        "ML-KEM-512", 800, 1632, 768,
+        "82f101ff648063b376e2bb6c5b7455f655a50c2feadade150efa0e0e6f365aea",
+        "0bd3f5df01098ac9c29d687c7f1bd0588a5573feeef8f1e3b4573fa7f6ab57c8",
+        "e3fdddb90255869185c07cdf1c1880b2efe08b6f04da4997b693c0dea61503bd",
+        "14cace3e48771b316676afad2cfcfe8488daaa4fad954e57236caa3f24a42cf7",
+        "32ee1fb3f7bd2915218e9c1b2d0d2da88f0edce6804278bab3a6123c5bb64fc4"
+    },
+    {
+        "ML-KEM-768", 1184, 2400, 1088,
+        "a24e16d8f8f9383a95b77050f4d9fd2f5733eec1d63ef3c23ebf9918173669a7",
+        "1149f17c3c4ac6ab1e3e2d9d8bd0171355ac0fa31bb8855c48ceade874c0864b",
+        "b4cfbd24cef67afd3764276c6980e0f88f8e9ca57f59b7f12fe1a9c1e72f4710",
+        "9cddd089ffe70e3996e76f7c8d06746df34d07e8657bc0fcf2bb0e1c3084aea1",
+        "dcfc80c6db46ff7028e3a4398651c063ae7a42c107a6dc8cb07141861698ab92"
+    },
+    {
+        "ML-KEM-1024", 1568, 3168, 1568,
+        "61349e5c131a7e116a0463861d7d18663c5627c38c7147ddaadfd48acd7a4535",
+        "f0db5d938027fcd9bad87847d52c14cf0c4abcf0703b749793f212111ffb303b",
+        "c1579fa02c614f3762b2a799b51e41cebb8f820f34fa736af02c56de2460ce3c",
+        "0ad8d1ea1b8dd788979b4379581218df9321bdce5567eca42ae6be7d395f1a54",
+        "8f2c880890996c587aa500cf8b6da03372de706a9f96075744bb0956ea6fbaac"
+    },
+};
+
+static int check_hash(const unsigned char *data, size_t len, const char *hex)
+{
+    unsigned char md[32], *expected = NULL;
+    long explen = 0;
+    int ret;
+
+    ret = TEST_ptr(expected = OPENSSL_hexstr2buf(hex, &explen))
+        && TEST_true(EVP_Q_digest(libctx, "SHA3-256", NULL, data, len,
+                                  md, NULL))
+        && TEST_mem_eq(md, sizeof(md), expected, explen);
+    OPENSSL_free(expected);
+    return ret;
+}
+
+static int check_bytes(const unsigned char *data, size_t len, const char *hex)
+{
+    unsigned char *expected = NULL;
+    long explen = 0;
+    int ret;
+
+    ret = TEST_ptr(expected = OPENSSL_hexstr2buf(hex, &explen))
+        && TEST_mem_eq(data, len, expected, explen);
+    OPENSSL_free(expected);
+    return ret;
+}
+
+/* Generates a key, deterministically from a fixed seed if |seeded| */
+static EVP_PKEY *keygen(const char *alg, int seeded)
+{
+    unsigned char seed[64];
+    OSSL_PARAM params[2];
+    EVP_PKEY_CTX *ctx = NULL;
+    EVP_PKEY *pkey = NULL;
+    size_t i;
+
+    for (i = 0; i < sizeof(seed); i++)
+        seed[i] = (unsigned char)i;
+    params[0] = OSSL_PARAM_construct_octet_string(OSSL_PKEY_PARAM_ML_KEM_SEED,
+                                                  seed, sizeof(seed));
+    params[1] = OSSL_PARAM_construct_end();
+
+    if (!TEST_ptr(ctx = EVP_PKEY_CTX_new_from_name(libctx, alg, NULL))
+        || !TEST_int_gt(EVP_PKEY_keygen_init(ctx), 0)
+        || (seeded && !TEST_true(EVP_PKEY_CTX_set_params(ctx, params)))
+        || !TEST_int_gt(EVP_PKEY_generate(ctx, &pkey), 0))
+        pkey = NULL;
+    EVP_PKEY_CTX_free(ctx);
+    return pkey;
+}
+
+static int test_ml_kem_kat(int idx)
+{
+    const ML_KEM_KAT *t = &ml_kem_kats[idx];
+    unsigned char entropy[32], secret[32], *pub = NULL, *prv = NULL;
+    unsigned char *ct = NULL;
+    size_t publen = 0, prvlen = 0, ctlen = 0, secretlen = sizeof(secret);
+    OSSL_PARAM params[2];
+    EVP_PKEY_CTX *ctx = NULL;
+    EVP_PKEY *pkey = NULL;
+    size_t i;
+    int ret = 0;
+
+    for (i = 0; i < sizeof(entropy); i++)
+        entropy[i] = (unsigned char)(64 + i);
+    params[0] = OSSL_PARAM_construct_octet_string(OSSL_KEM_PARAM_IKME,
+                                                  entropy, sizeof(entropy));
+    params[1] = OSSL_PARAM_construct_end();
+
+    if (!TEST_ptr(pkey = keygen(t->alg, 1))
+        || !TEST_true(EVP_PKEY_get_octet_string_param(pkey,
+                                                      OSSL_PKEY_PARAM_PUB_KEY,
+                                                      NULL, 0, &publen))
+        || !TEST_size_t_eq(publen, t->publen)
+        || !TEST_ptr(pub = OPENSSL_malloc(publen))
+        || !TEST_true(EVP_PKEY_get_octet_string_param(pkey,
+                                                      OSSL_PKEY_PARAM_PUB_KEY,
+                                                      pub, publen, &publen))
+        || !check_hash(pub, publen, t->pubhash)
+        || !TEST_true(EVP_PKEY_get_octet_string_param(pkey,
+                                                      OSSL_PKEY_PARAM_PRIV_KEY,
+                                                      NULL, 0, &prvlen))
+        || !TEST_size_t_eq(prvlen, t->prvlen)
+        || !TEST_ptr(prv = OPENSSL_malloc(prvlen))
+        || !TEST_true(EVP_PKEY_get_octet_string_param(pkey,
+                                                      OSSL_PKEY_PARAM_PRIV_KEY,
+                                                      prv, prvlen, &prvlen))
+        || !check_hash(prv, prvlen, t->prvhash))
+        goto err;
+
+    if (!TEST_ptr(ctx = EVP_PKEY_CTX_new_from_pkey(libctx, pkey, NULL))
+        || !TEST_int_gt(EVP_PKEY_encapsulate_init(ctx, params), 0)
+        || !TEST_int_gt(EVP_PKEY_encapsulate(ctx, NULL, &ctlen, NULL,
+                                             &secretlen), 0)
+        || !TEST_size_t_eq(ctlen, t->ctlen)
+        || !TEST_size_t_eq(secretlen, sizeof(secret))
+        || !TEST_ptr(ct = OPENSSL_malloc(ctlen))
+        || !TEST_int_gt(EVP_PKEY_encapsulate(ctx, ct, &ctlen, secret,
+                                             &secretlen), 0)
+        || !check_hash(ct, ctlen, t->cthash)
+        || !check_bytes(secret, secretlen, t->secret))
+        goto err;
+
+    memset(secret, 0, sizeof(secret));
+    if (!TEST_int_gt(EVP_PKEY_decapsulate_init(ctx, NULL), 0)
+        || !TEST_int_gt(EVP_PKEY_decapsulate(ctx, secret, &secretlen,
+                                             ct, ctlen), 0)
+        || !check_bytes(secret, secretlen, t->secret))
+        goto err;
+
+    /* A modified ciphertext gives the implicit rejection secret */
+    ct[0] ^= 1;
+    if (!TEST_int_gt(EVP_PKEY_decapsulate(ctx, secret, &secretlen,
+                                          ct, ctlen), 0)
+        || !check_bytes(secret, secretlen, t->rejected))
+        goto err;
+
+    /* Short ciphertexts are refused outright */
+    if (!TEST_int_le(EVP_PKEY_decapsulate(ctx, secret, &secretlen,
+                                          ct, ctlen - 1), 0))
+        goto err;
+    ret = 1;
+ err:
+    EVP_PKEY_CTX_free(ctx);
+    EVP_PKEY_free(pkey);
+    OPENSSL_free(pub);
+    OPENSSL_free(prv);
+    OPENSSL_free(ct);
+    return ret;
+}
+
+/*
+ * Check that a fresh key pair round trips, including through a public key
+ * made from the encoding a TLS client sends.
+ */
+static const char *roundtrip_algs[] = {
+    "ML-KEM-512",
+    "ML-KEM-768",
+    "ML-KEM-1024",
+#ifndef OPENSSL_NO_EC
+    "X25519MLKEM768",
+#endif
+};
+
+static int test_kem_roundtrip(int idx)
+{
+    const char *alg = roundtrip_algs[idx];
+    EVP_PKEY_CTX *ctx = NULL;
+    EVP_PKEY *pkey = NULL, *peer = NULL, *dup = NULL;
+    unsigned char *enc = NULL, *ct = NULL;
+    unsigned char secret[64], secret2[64];
+    size_t enclen, ctlen = 0, secretlen = 0, secret2len = sizeof(secret2);
+    int ret = 0;
+
+    if (!TEST_ptr(pkey = keygen(alg, 0))
+        || !TEST_size_t_gt(enclen = EVP_PKEY_get1_encoded_public_key(pkey,
+                                                                     &enc),
+                           0))
+        goto err;
+
+    /* Build the peer's copy the way a TLS server does */
+    if (!TEST_ptr(ctx = EVP_PKEY_CTX_new_from_name(libctx, alg, NULL))
+        || !TEST_int_gt(EVP_PKEY_paramgen_init(ctx), 0)
+        || !TEST_int_gt(EVP_PKEY_paramgen(ctx, &peer), 0)
+        || !TEST_true(EVP_PKEY_set1_encoded_public_key(peer, enc, enclen))
+        || !TEST_int_eq(EVP_PKEY_eq(pkey, peer), 1))
+        goto err;
+
+    EVP_PKEY_CTX_free(ctx);
+    if (!TEST_ptr(ctx = EVP_PKEY_CTX_new_from_pkey(libctx, peer, NULL))
+        || !TEST_int_gt(EVP_PKEY_encapsulate_init(ctx, NULL), 0)
+        || !TEST_int_gt(EVP_PKEY_encapsulate(ctx, NULL, &ctlen, NULL,
+                                             &secretlen), 0)
+        || !TEST_size_t_le(secretlen, sizeof(secret))
+        || !TEST_ptr(ct = OPENSSL_malloc(ctlen))
+        || !TEST_int_gt(EVP_PKEY_encapsulate(ctx, ct, &ctlen, secret,
+                                             &secretlen), 0))
+        goto err;
+
+    EVP_PKEY_CTX_free(ctx);
+    if (!TEST_ptr(ctx = EVP_PKEY_CTX_new_from_pkey(libctx, pkey, NULL))
+        || !TEST_int_gt(EVP_PKEY_decapsulate_init(ctx, NULL), 0)
+        || !TEST_int_gt(EVP_PKEY_decapsulate(ctx, secret2, &secret2len,
+                                             ct, ctlen), 0)
+        || !TEST_mem_eq(secret, secretlen, secret2, secret2len))
+        goto err;
+
+    /* And so does a duplicate of the key pair */
+    EVP_PKEY_CTX_free(ctx);
+    secret2len = sizeof(secret2);
+    if (!TEST_ptr(dup = EVP_PKEY_dup(pkey))
+        || !TEST_ptr(ctx = EVP_PKEY_CTX_new_from_pkey(libctx, dup, NULL))
+        || !TEST_int_gt(EVP_PKEY_decapsulate_init(ctx, NULL), 0)
+        || !TEST_int_gt(EVP_PKEY_decapsulate(ctx, secret2, &secret2len,
+                                             ct, ctlen), 0)
+        || !TEST_mem_eq(secret, secretlen, secret2, secret2len))
+        goto err;
+
+    /* Decapsulation needs the private key */
+    EVP_PKEY_CTX_free(ctx);
+    if (!TEST_ptr(ctx = EVP_PKEY_CTX_new_from_pkey(libctx, peer, NULL))
+        || !TEST_int_le(EVP_PKEY_decapsulate_init(ctx, NULL), 0))
+        goto err;
+    ret = 1;
+ err:
+    EVP_PKEY_CTX_free(ctx);
+    EVP_PKEY_free(pkey);
+    EVP_PKEY_free(peer);
+    EVP_PKEY_free(dup);
+    OPENSSL_free(enc);
+    OPENSSL_free(ct);
+    return ret;
+}
+
+/* A private key whose embedded public key hash is wrong is rejected */
+static int test_ml_kem_bad_private_key(void)
+{
+    EVP_PKEY *pkey = NULL, *bad = NULL;
+    unsigned char *prv = NULL;
+    size_t prvlen = 0;
+    int ret = 0;
+
+    if (!TEST_ptr(pkey = keygen("ML-KEM-768", 1))
+        || !TEST_true(EVP_PKEY_get_octet_string_param(pkey,
+                                                      OSSL_PKEY_PARAM_PRIV_KEY,
+                                                      NULL, 0, &prvlen))
+        || !TEST_ptr(prv = OPENSSL_malloc(prvlen))
+        || !TEST_true(EVP_PKEY_get_octet_string_param(pkey,
+                                                      OSSL_PKEY_PARAM_PRIV_KEY,
+                                                      prv, prvlen, &prvlen)))
+        goto err;
+
+    /* The hash H(ek) sits just before the final 32 byte z */
+    prv[prvlen - 64] ^= 1;
+    bad = EVP_PKEY_new_raw_private_key_ex(libctx, "ML-KEM-768", NULL,
+                                          prv, prvlen);
+    ret = TEST_ptr_null(bad);
+ err:
+    EVP_PKEY_free(pkey);
+    EVP_PKEY_free(bad);
+    OPENSSL_free(prv);
+    return ret;
+}
+
+int setup_tests(void)
+{
+    if (!TEST_ptr(libctx = OSSL_LIB_CTX_new()))
+        return 0;
+
+    ADD_ALL_TESTS(test_ml_kem_kat, OSSL_NELEM(ml_kem_kats));
+    ADD_ALL_TESTS(test_kem_roundtrip, OSSL_NELEM(roundtrip_algs));
+    ADD_TEST(test_ml_kem_bad_private_key);
+    return 1;
+}
+
+void cleanup_tests(void)
+{
+    OSSL_LIB_CTX_free(libctx);
+}
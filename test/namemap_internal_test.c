@@ -8,6 +8,7 @@
  */
 
 #include <openssl/evp.h>
+#include <openssl/err.h>
 #include <internal/namemap.h>
 #include <test/testutil.h>
 
@@ -170,6 +171,68 @@ static int test_digest_is_a(void)
     return rv;
 }
 
+#define SHA256_OID "2.16.840.1.101.3.4.2.1"
+
+/*
+ * Test that enumerating the names of a number gives the legacy names too,
+ * without any earlier lookup having loaded them.
+ */
+static int test_namemap_legacy_names(void)
+{
+    OSSL_LIB_CTX *libctx = OSSL_LIB_CTX_new();
+    OSSL_NAMEMAP *nm;
+    const char *name;
+    size_t i;
+    int id, ok = 0;
+
+    if (!TEST_ptr(libctx)
+            || !TEST_ptr(nm = ossl_namemap_stored(libctx))
+            || !TEST_int_ne(id = ossl_namemap_add_name(nm, 0, "SHA256"), 0))
+        goto err;
+
+    for (i = 0; (name = ossl_namemap_num2name(nm, id, i)) != NULL; i++)
+        if (strcmp(name, SHA256_OID) == 0)
+            break;
+    if (!TEST_ptr(name)
+            || !TEST_int_eq(ossl_namemap_name2num(nm, SHA256_OID), id))
+        goto err;
+    ok = 1;
+ err:
+    OSSL_LIB_CTX_free(libctx);
+    return ok;
+}
+
+/*
+ * Test that legacy names already registered under different numbers are
+ * reported as conflicting rather than merged when the legacy names load.
+ */
+static int test_namemap_legacy_conflict(void)
+{
+    OSSL_LIB_CTX *libctx = OSSL_LIB_CTX_new();
+    OSSL_NAMEMAP *nm;
+    int id1, id2, ok = 0;
+
+    if (!TEST_ptr(libctx)
+            || !TEST_ptr(nm = ossl_namemap_stored(libctx))
+            || !TEST_int_ne(id1 = ossl_namemap_add_name(nm, 0, "SHA256"), 0)
+            || !TEST_int_ne(id2 = ossl_namemap_add_name(nm, 0, SHA256_OID), 0)
+            || !TEST_int_ne(id1, id2))
+        goto err;
+
+    ERR_clear_error();
+    if (!TEST_int_eq(ossl_namemap_name2num(nm, "cookie"), 0)
+            || !TEST_int_eq(ERR_GET_REASON(ERR_peek_error()),
+                            CRYPTO_R_CONFLICTING_NAMES)
+            || !TEST_int_eq(ossl_namemap_name2num(nm, "SHA256"), id1)
+            || !TEST_int_eq(ossl_namemap_name2num(nm, SHA256_OID), id2))
+        goto err;
+    ok = 1;
+ err:
+    ERR_clear_error();
+    OSSL_LIB_CTX_free(libctx);
+    return ok;
+}
+
 int setup_tests(void)
 {
     ADD_TEST(test_namemap_empty);
@@ -179,5 +242,7 @@ int setup_tests(void)
     ADD_TEST(test_cipherbyname);
     ADD_TEST(test_digest_is_a);
     ADD_TEST(test_cipher_is_a);
+    ADD_TEST(test_namemap_legacy_names);
+    ADD_TEST(test_namemap_legacy_conflict);
     return 1;
 }
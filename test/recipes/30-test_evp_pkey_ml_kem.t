@@ -0,0 +1,19 @@
+#! /usr/bin/env perl
+# Copyright 2024 The OpenSSL Project Authors. All Rights Reserved.
+#
+# Licensed under the Apache License 2.0 (the "License").  You may not use
+# this file except in compliance with the License.  You can obtain a copy
+# in the file LICENSE in the source distribution or at
+# https://www.openssl.org/source/license.html
+
+use strict;
+use OpenSSL::Test;
+use OpenSSL::Test::Simple;
+use OpenSSL::Test::Utils;
+
+setup("test_evp_pkey_ml_kem");
+
+plan skip_all => "This test is unsupported in a no-ml-kem build"
+    if disabled("ml-kem");
+
+simple_test("test_evp_pkey_ml_kem", "evp_pkey_ml_kem_test");
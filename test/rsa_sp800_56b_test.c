@@ -17,11 +17,13 @@
 #include <string.h>
 
 #include <internal/nelem.h>
+#include <internal/thread.h>
 
 #include <openssl/crypto.h>
 #include <openssl/err.h>
 #include <openssl/rand.h>
 #include <openssl/bn.h>
+#include <openssl/thread.h>
 
 #include <test/testutil.h>
 
@@ -501,6 +503,53 @@ static int test_sp80056b_keygen(int id)
     return ret;
 }
 
+static int keygen_pool_busy;
+
+/* Notes whether the pool has no thread to spare while p is generated */
+static int keygen_threads_cb(int a, int b, BN_GENCB *cb)
+{
+    if (ossl_get_avail_threads(NULL) == 0)
+        keygen_pool_busy = 1;
+    return 1;
+}
+
+/*
+ * With a pool of one thread, the first q comes from that thread, which is
+ * taken for as long as p is being generated and returned at the end.
+ */
+static int test_sp80056b_keygen_threads(void)
+{
+    RSA *key = NULL;
+    BN_GENCB *cb = NULL;
+    int ret;
+
+    if ((OSSL_get_thread_support_flags()
+         & OSSL_THREAD_SUPPORT_FLAG_DEFAULT_SPAWN) == 0)
+        return TEST_skip("no default thread pool");
+    if (!TEST_int_eq(OSSL_set_max_threads(NULL, 1), 1)
+        || !TEST_uint64_t_eq(OSSL_get_max_threads(NULL), 1))
+        return 0;
+
+    keygen_pool_busy = 0;
+    ret = TEST_ptr(cb = BN_GENCB_new())
+          && TEST_ptr(key = RSA_new());
+    if (ret) {
+        BN_GENCB_set(cb, keygen_threads_cb, NULL);
+        ret = TEST_true(ossl_rsa_sp800_56b_generate_key(key, 2048, NULL, cb))
+              && TEST_true(keygen_pool_busy)
+              && TEST_uint64_t_eq(ossl_get_avail_threads(NULL), 1)
+              && TEST_true(ossl_rsa_sp800_56b_check_public(key))
+              && TEST_true(ossl_rsa_sp800_56b_check_private(key))
+              && TEST_true(ossl_rsa_sp800_56b_check_keypair(key, NULL, -1,
+                                                            2048));
+    }
+
+    OSSL_set_max_threads(NULL, 0);
+    BN_GENCB_free(cb);
+    RSA_free(key);
+    return ret;
+}
+
 static int test_check_private_key(void)
 {
     int ret = 0;
@@ -587,5 +636,6 @@ int setup_tests(void)
     ADD_TEST(test_invalid_keypair);
     ADD_TEST(test_pq_diff);
     ADD_ALL_TESTS(test_sp80056b_keygen, (int)OSSL_NELEM(keygen_size));
+    ADD_TEST(test_sp80056b_keygen_threads);
     return 1;
 }
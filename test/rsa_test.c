@@ -28,6 +28,7 @@
 #include <test/testutil.h>
 
 #include <openssl/rsa.h>
+#include "crypto/rsa.h"
 
 #define SetKey \
     RSA_set0_key(key,                                           \
@@ -709,6 +710,80 @@ err:
     return ret;
 }
 
+static int rsa_keys_eq(const RSA *a, const RSA *b)
+{
+    const BIGNUM *an, *ae, *ad, *ap, *aq, *admp1, *admq1, *aiqmp;
+    const BIGNUM *bn, *be, *bd, *bp, *bq, *bdmp1, *bdmq1, *biqmp;
+
+    RSA_get0_key(a, &an, &ae, &ad);
+    RSA_get0_factors(a, &ap, &aq);
+    RSA_get0_crt_params(a, &admp1, &admq1, &aiqmp);
+    RSA_get0_key(b, &bn, &be, &bd);
+    RSA_get0_factors(b, &bp, &bq);
+    RSA_get0_crt_params(b, &bdmp1, &bdmq1, &biqmp);
+    return TEST_BN_eq(an, bn) && TEST_BN_eq(ae, be) && TEST_BN_eq(ad, bd)
+           && TEST_BN_eq(ap, bp) && TEST_BN_eq(aq, bq)
+           && TEST_BN_eq(admp1, bdmp1) && TEST_BN_eq(admq1, bdmq1)
+           && TEST_BN_eq(aiqmp, biqmp)
+           && TEST_true(BN_get_flags(bd, BN_FLG_CONSTTIME))
+           && TEST_true(BN_get_flags(bp, BN_FLG_CONSTTIME));
+}
+
+/*
+ * ossl_rsa_d2i_private_key() must give the same key as d2i_RSAPrivateKey(),
+ * both on DER it reads itself and on the encodings it hands over to it.
+ */
+static int test_rsa_d2i_private_key(int idx)
+{
+    int ret = 0, derlen;
+    RSA *key = NULL, *key2 = NULL;
+    unsigned char *der = NULL, *ber = NULL;
+    const unsigned char *p;
+
+    rsa_setkey(&key, NULL, idx);
+    if (!TEST_ptr(key)
+            || !TEST_int_gt(derlen = i2d_RSAPrivateKey(key, &der), 0)
+            || !TEST_ptr(ber = OPENSSL_malloc(derlen + 4)))
+        goto err;
+
+    /* DER, with trailing bytes that must be left alone */
+    memcpy(ber, der, derlen);
+    memset(ber + derlen, 0, 4);
+    p = ber;
+    if (!TEST_ptr(key2 = ossl_rsa_d2i_private_key(NULL, &p, derlen + 4))
+            || !TEST_ptr_eq(p, ber + derlen)
+            || !rsa_keys_eq(key, key2))
+        goto err;
+    RSA_free(key2);
+
+    /* A redundant length octet, which isn't DER but is accepted */
+    if (!TEST_int_gt(der[1], 0x80))
+        goto err;
+    ber[0] = der[0];
+    ber[1] = der[1] + 1;
+    ber[2] = 0;
+    memcpy(ber + 3, der + 2, derlen - 2);
+    p = ber;
+    if (!TEST_ptr(key2 = ossl_rsa_d2i_private_key(NULL, &p, derlen + 1))
+            || !TEST_ptr_eq(p, ber + derlen + 1)
+            || !rsa_keys_eq(key, key2))
+        goto err;
+    RSA_free(key2);
+
+    /* Truncated */
+    p = der;
+    if (!TEST_ptr_null(key2 = ossl_rsa_d2i_private_key(NULL, &p, derlen - 1)))
+        goto err;
+
+    ret = 1;
+err:
+    RSA_free(key);
+    RSA_free(key2);
+    OPENSSL_free(der);
+    OPENSSL_free(ber);
+    return ret;
+}
+
 int setup_tests(void)
 {
     ADD_ALL_TESTS(test_rsa_pkcs1, 3);
@@ -716,5 +791,6 @@ int setup_tests(void)
     ADD_ALL_TESTS(test_rsa_security_bit, OSSL_NELEM(rsa_security_bits_cases));
     ADD_TEST(test_rsa_saos);
     ADD_TEST(test_EVP_rsa_legacy_key);
+    ADD_ALL_TESTS(test_rsa_d2i_private_key, 3);
     return 1;
 }
@@ -0,0 +1,91 @@
+/*
+ * Copyright 2024 The OpenSSL Project Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License 2.0 (the "License").  You may not use
+ * this file except in compliance with the License.  You can obtain a copy
+ * in the file LICENSE in the source distribution or at
+ * https://www.openssl.org/source/license.html
+ */
+
+/*
+ * Internal tests for the four-way SHA-3 sponges, which must give the same
+ * output as the ordinary ones.
+ */
+
+#include <string.h>
+#include <internal/nelem.h>
+#include <internal/sha3.h>
+#include <test/testutil.h>
+
+static const struct {
+    unsigned char pad;
+    size_t bitlen;
+} sponges[] = {
+    { 0x1f, 128 },              /* SHAKE128 */
+    { 0x1f, 256 },              /* SHAKE256 */
+    { 0x06, 256 },              /* SHA3-256 */
+    { 0x06, 512 },              /* SHA3-512 */
+};
+
+static const size_t inlens[] = { 0, 1, 33, 71, 72, 135, 136, 137, 168, 500 };
+
+/*
+ * Runs the four sponges for each input length, with and without the
+ * four-way permutation, squeezing some whole blocks then a partial one.
+ */
+static int test_sha3_x4(int idx)
+{
+    KECCAK1600_CTX ctx;
+    KECCAK1600_X4_CTX ctx4;
+    unsigned char in[4][500], out[4][3 * 168 + 20], expected[3 * 168 + 20];
+    const unsigned char *ins[4] = { in[0], in[1], in[2], in[3] };
+    unsigned char *outs[4], *outs2[4];
+    size_t i, l, bsz, outlen;
+    int x4;
+
+    for (l = 0; l < 4; l++) {
+        for (i = 0; i < sizeof(in[l]); i++)
+            in[l][i] = (unsigned char)(i * 31 + l);
+        outs[l] = out[l];
+        outs2[l] = out[l] + 2 * SHA3_BLOCKSIZE(sponges[idx].bitlen);
+    }
+
+    for (i = 0; i < OSSL_NELEM(inlens); i++) {
+        for (x4 = 0; x4 < 2; x4++) {
+            if (!TEST_true(ossl_sha3_init_x4(&ctx4, sponges[idx].pad,
+                                             sponges[idx].bitlen)))
+                return 0;
+            /* Not every machine has it, so only ever turn it off */
+            ctx4.x4 &= x4;
+            bsz = ctx4.block_size;
+            outlen = 2 * bsz + 20;
+            memset(out, 0, sizeof(out));
+            if (!TEST_true(ossl_sha3_absorb_x4(&ctx4, ins, inlens[i]))
+                    || !TEST_false(ossl_sha3_absorb_x4(&ctx4, ins, inlens[i]))
+                    || !TEST_true(ossl_sha3_squeeze_x4(&ctx4, outs, 2 * bsz))
+                    || !TEST_true(ossl_sha3_squeeze_x4(&ctx4, outs2, 20))
+                    || !TEST_false(ossl_sha3_squeeze_x4(&ctx4, outs, 1)))
+                return 0;
+
+            for (l = 0; l < 4; l++) {
+                if (!TEST_true(ossl_sha3_init(&ctx, sponges[idx].pad,
+                                              sponges[idx].bitlen))
+                        || !TEST_true(ossl_sha3_update(&ctx, in[l], inlens[i]))
+                        || !TEST_true(ossl_sha3_squeeze(&ctx, expected,
+                                                        outlen))
+                        || !TEST_mem_eq(out[l], outlen, expected, outlen)) {
+                    TEST_info("input length %zu, lane %zu, x4 %d",
+                              inlens[i], l, x4);
+                    return 0;
+                }
+            }
+        }
+    }
+    return 1;
+}
+
+int setup_tests(void)
+{
+    ADD_ALL_TESTS(test_sha3_x4, OSSL_NELEM(sponges));
+    return 1;
+}
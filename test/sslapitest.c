@@ -7142,6 +7142,49 @@ static int test_ssl_clear(int idx)
     return testresult;
 }
 
+/*
+ * Test that a connection can be made with contexts that were frozen after
+ * they were configured, and that a frozen library context can still fetch.
+ */
+static int test_ssl_ctx_freeze(void)
+{
+    SSL_CTX *cctx = NULL, *sctx = NULL;
+    SSL *clientssl = NULL, *serverssl = NULL;
+    EVP_MD *md = NULL;
+    char *rootfile = NULL;
+    int testresult = 0;
+
+    if (!TEST_ptr(rootfile = test_mk_file_path(certsdir, "rootcert.pem"))
+            || !TEST_true(create_ssl_ctx_pair(libctx, TLS_server_method(),
+                                              TLS_client_method(),
+                                              TLS1_VERSION, 0,
+                                              &sctx, &cctx, cert, privkey))
+            || !TEST_true(SSL_CTX_load_verify_file(cctx, rootfile))
+            || !TEST_true(SSL_CTX_freeze(sctx))
+            || !TEST_true(SSL_CTX_freeze(cctx))
+            || !TEST_ptr(md = EVP_MD_fetch(libctx, "SHA2-256", NULL)))
+        goto end;
+
+    SSL_CTX_set_verify(cctx, SSL_VERIFY_PEER, NULL);
+    if (!TEST_true(create_ssl_objects(sctx, cctx, &serverssl, &clientssl,
+                                      NULL, NULL))
+            || !TEST_true(create_ssl_connection(serverssl, clientssl,
+                                                SSL_ERROR_NONE)))
+        goto end;
+
+    testresult = 1;
+
+ end:
+    EVP_MD_free(md);
+    SSL_free(serverssl);
+    SSL_free(clientssl);
+    SSL_CTX_free(sctx);
+    SSL_CTX_free(cctx);
+    OPENSSL_free(rootfile);
+
+    return testresult;
+}
+
 /* Parse CH and retrieve any MFL extension value if present */
 static int get_MFL_from_client_hello(BIO *bio, int *mfl_codemfl_code)
 {
@@ -9637,6 +9680,60 @@ static int test_pluggable_group(int idx)
     return testresult;
 }
 
+#if !defined(OPENSSL_NO_ML_KEM) && !defined(OSSL_NO_USABLE_TLS1_3)
+/*
+ * Test 0-3: a handshake using each ML-KEM group from the default provider
+ * Test 4: the client's first key share is for x25519, so the server, which
+ * only accepts X25519MLKEM768, has to send a HelloRetryRequest
+ */
+static int test_ml_kem_group(int idx)
+{
+    static const char *groups[] = {
+        "MLKEM512", "MLKEM768", "MLKEM1024", "X25519MLKEM768",
+        "X25519MLKEM768"
+    };
+    SSL_CTX *cctx = NULL, *sctx = NULL;
+    SSL *clientssl = NULL, *serverssl = NULL;
+    const char *group_name = groups[idx];
+    const char *client_groups = idx == 4 ? "x25519:X25519MLKEM768" : group_name;
+    int testresult = 0;
+
+    if (is_fips)
+        return TEST_skip("ML-KEM is not available in the FIPS provider");
+# ifdef OPENSSL_NO_EC
+    if (strcmp(group_name, "X25519MLKEM768") == 0)
+        return TEST_skip("X25519MLKEM768 needs ec");
+# endif
+
+    if (!TEST_true(create_ssl_ctx_pair(libctx, TLS_server_method(),
+                                       TLS_client_method(),
+                                       TLS1_3_VERSION, TLS1_3_VERSION,
+                                       &sctx, &cctx, cert, privkey))
+            || !TEST_true(SSL_CTX_set1_groups_list(sctx, group_name))
+            || !TEST_true(SSL_CTX_set1_groups_list(cctx, client_groups))
+            || !TEST_true(create_ssl_objects(sctx, cctx, &serverssl,
+                                             &clientssl, NULL, NULL))
+            || !TEST_true(create_ssl_connection(serverssl, clientssl,
+                                                SSL_ERROR_NONE)))
+        goto end;
+
+    if (!TEST_str_eq(group_name, SSL_get0_group_name(serverssl))
+            || !TEST_str_eq(group_name, SSL_get0_group_name(clientssl))
+            || !TEST_int_eq(SSL_version(serverssl), TLS1_3_VERSION))
+        goto end;
+
+    testresult = 1;
+
+ end:
+    SSL_free(serverssl);
+    SSL_free(clientssl);
+    SSL_CTX_free(sctx);
+    SSL_CTX_free(cctx);
+
+    return testresult;
+}
+#endif
+
 /*
  * This function triggers encode, decode and sign functions
  * of the artificial "xorhmacsig" algorithm implemented in tls-provider
@@ -12152,6 +12249,7 @@ int setup_tests(void)
     ADD_ALL_TESTS(test_key_update_local_in_read, 2);
 #endif
     ADD_ALL_TESTS(test_ssl_clear, 8);
+    ADD_TEST(test_ssl_ctx_freeze);
     ADD_ALL_TESTS(test_max_fragment_len_ext, OSSL_NELEM(max_fragment_len_test));
 #if !defined(OPENSSL_NO_COMP_ALG)
     /* Add compression case */
@@ -12178,6 +12276,9 @@ int setup_tests(void)
     ADD_ALL_TESTS(test_sigalgs_available, 6);
 #endif
     ADD_ALL_TESTS(test_pluggable_group, 2);
+#if !defined(OPENSSL_NO_ML_KEM) && !defined(OSSL_NO_USABLE_TLS1_3)
+    ADD_ALL_TESTS(test_ml_kem_group, 5);
+#endif
     ADD_ALL_TESTS(test_pluggable_signature, 4);
 #ifndef OPENSSL_NO_TLS1_2
     ADD_TEST(test_ssl_dup);
@@ -859,6 +859,52 @@ static void thread_shared_evp_pkey(void)
         multi_set_success(0);
 }
 
+/*
+ * Several threads signing with the same RSA key at once each borrow their own
+ * blinding from the key's pool, so run enough signatures per thread for the
+ * blindings to be handed back and reused.
+ */
+static void thread_shared_evp_pkey_sign(void)
+{
+    const char *msg = "Hello World";
+    unsigned char sig[256];
+    size_t siglen;
+    EVP_MD_CTX *mdctx = NULL;
+    int success = 0;
+    int i;
+
+    for (i = 0; i < 20; i++) {
+        EVP_MD_CTX_free(mdctx);
+        if (!TEST_ptr(mdctx = EVP_MD_CTX_new()))
+            goto err;
+        siglen = sizeof(sig);
+        if (!TEST_true(EVP_DigestSignInit_ex(mdctx, NULL, "SHA2-256",
+                                             multi_libctx, NULL,
+                                             shared_evp_pkey, NULL))
+                || !TEST_true(EVP_DigestSign(mdctx, sig, &siglen,
+                                             (const unsigned char *)msg,
+                                             strlen(msg))))
+            goto err;
+
+        EVP_MD_CTX_free(mdctx);
+        if (!TEST_ptr(mdctx = EVP_MD_CTX_new())
+                || !TEST_true(EVP_DigestVerifyInit_ex(mdctx, NULL, "SHA2-256",
+                                                      multi_libctx, NULL,
+                                                      shared_evp_pkey, NULL))
+                || !TEST_int_eq(EVP_DigestVerify(mdctx, sig, siglen,
+                                                 (const unsigned char *)msg,
+                                                 strlen(msg)), 1))
+            goto err;
+    }
+
+    success = 1;
+
+ err:
+    EVP_MD_CTX_free(mdctx);
+    if (!success)
+        multi_set_success(0);
+}
+
 static void thread_provider_load_unload(void)
 {
     OSSL_PROVIDER *deflt = OSSL_PROVIDER_load(multi_libctx, "default");
@@ -936,6 +982,28 @@ static int test_multi_shared_pkey(void)
     return test_multi_shared_pkey_common(&thread_shared_evp_pkey);
 }
 
+static int test_multi_shared_pkey_sign(void)
+{
+    int testresult = 0;
+
+    multi_intialise();
+    if (!thread_setup_libctx(1, default_provider)
+            || !TEST_ptr(shared_evp_pkey = load_pkey_pem(privkey, multi_libctx))
+            || !start_threads(3, &thread_shared_evp_pkey_sign))
+        goto err;
+
+    thread_shared_evp_pkey_sign();
+
+    if (!teardown_threads()
+            || !TEST_true(multi_success))
+        goto err;
+    testresult = 1;
+ err:
+    EVP_PKEY_free(shared_evp_pkey);
+    thead_teardown_libctx();
+    return testresult;
+}
+
 static int test_multi_load_unload_provider(void)
 {
     EVP_MD *sha256 = NULL;
@@ -1238,6 +1306,7 @@ int setup_tests(void)
     ADD_TEST(test_multi_general_worker_fips_provider);
     ADD_TEST(test_multi_fetch_worker);
     ADD_TEST(test_multi_shared_pkey);
+    ADD_TEST(test_multi_shared_pkey_sign);
 #ifndef OPENSSL_NO_DEPRECATED_3_0
     ADD_TEST(test_multi_downgrade_shared_pkey);
 #endif
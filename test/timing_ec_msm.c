@@ -0,0 +1,171 @@
+/*
+ * Copyright 2024 The OpenSSL Project Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License 2.0 (the "License").  You may not use
+ * this file except in compliance with the License.  You can obtain a copy
+ * in the file LICENSE in the source distribution or at
+ * https://www.openssl.org/source/license.html
+ */
+
+/*
+ * Measures EC_POINTs_mul() on P-256 and P-384 for a growing number of
+ * points, the way an aggregate verification would use it: random public
+ * scalars and affine points.
+ */
+
+/* We need to use some deprecated APIs */
+#define OPENSSL_SUPPRESS_DEPRECATED
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <openssl/e_os2.h>
+
+#ifdef OPENSSL_SYS_UNIX
+# include <sys/resource.h>
+# include <openssl/bn.h>
+# include <openssl/ec.h>
+# include <openssl/err.h>
+# include <openssl/obj_mac.h>
+# include <internal/e_os.h>
+# if defined(_POSIX_VERSION) && _POSIX_VERSION >= 200112L
+
+static char *prog;
+
+static void die(const char *what)
+{
+    fprintf(stderr, "%s: %s failed\n", prog, what);
+    ERR_print_errors_fp(stderr);
+    exit(EXIT_FAILURE);
+}
+
+static double user_seconds(void)
+{
+    struct rusage ru;
+
+    if (getrusage(RUSAGE_SELF, &ru) < 0) {
+        perror("getrusage");
+        exit(EXIT_FAILURE);
+    }
+    return ru.ru_utime.tv_sec + ru.ru_utime.tv_usec / 1e6;
+}
+
+static void sweep(int nid, const char *name, size_t maxnum, double mintime)
+{
+    EC_GROUP *group = EC_GROUP_new_by_curve_name(nid);
+    BN_CTX *ctx = BN_CTX_new();
+    EC_POINT **points = NULL, *step = NULL, *r = NULL;
+    BIGNUM **scalars = NULL, *k = NULL;
+    size_t i, num;
+    double start, elapsed;
+    long count;
+
+    if (group == NULL || ctx == NULL)
+        die("EC_GROUP_new_by_curve_name");
+    points = calloc(maxnum, sizeof(*points));
+    scalars = calloc(maxnum, sizeof(*scalars));
+    if (points == NULL || scalars == NULL)
+        die("calloc");
+    if ((step = EC_POINT_new(group)) == NULL
+            || (r = EC_POINT_new(group)) == NULL
+            || (k = BN_new()) == NULL
+            || !BN_rand_range(k, EC_GROUP_get0_order(group))
+            || !EC_POINT_mul(group, step, k, NULL, NULL, ctx))
+        die("setup");
+
+    /* Consecutive multiples of a random point are as good as random ones */
+    for (i = 0; i < maxnum; i++) {
+        if ((points[i] = EC_POINT_new(group)) == NULL
+                || (scalars[i] = BN_new()) == NULL
+                || !BN_rand_range(scalars[i], EC_GROUP_get0_order(group)))
+            die("setup");
+        if (i == 0 ? !EC_POINT_copy(points[i], step)
+                   : !EC_POINT_add(group, points[i], points[i - 1], step, ctx))
+            die("EC_POINT_add");
+    }
+    if (!EC_POINTs_make_affine(group, maxnum, points, ctx))
+        die("EC_POINTs_make_affine");
+
+    for (num = 2; num <= maxnum; num *= 2) {
+        start = user_seconds();
+        count = 0;
+        do {
+            if (!EC_POINTs_mul(group, r, NULL, num,
+                               (const EC_POINT **)points,
+                               (const BIGNUM **)scalars, ctx))
+                die("EC_POINTs_mul");
+            count++;
+            elapsed = user_seconds() - start;
+        } while (elapsed < mintime);
+        printf("%s %6zu points %12.1f microsec per mul %8.2f per point\n",
+               name, num, elapsed * 1e6 / count, elapsed * 1e6 / count / num);
+        fflush(stdout);
+    }
+
+    for (i = 0; i < maxnum; i++) {
+        EC_POINT_free(points[i]);
+        BN_free(scalars[i]);
+    }
+    free(points);
+    free(scalars);
+    BN_free(k);
+    EC_POINT_free(step);
+    EC_POINT_free(r);
+    BN_CTX_free(ctx);
+    EC_GROUP_free(group);
+}
+
+static void usage(void)
+{
+    fprintf(stderr, "Usage: %s [flags]\n", prog);
+    fprintf(stderr, "Flags:\n");
+    fprintf(stderr, "  -c curve Only time P-256 or P-384\n");
+    fprintf(stderr, "  -n #     Largest number of points, default 65536\n");
+    fprintf(stderr, "  -t #     Minimum time per size in milliseconds, default 200\n");
+    exit(EXIT_FAILURE);
+}
+# endif
+#endif
+
+int main(int ac, char **av)
+{
+#if defined(_POSIX_VERSION) && _POSIX_VERSION >= 200112L
+    int i, maxnum = 65536, msec = 200;
+    const char *curve = NULL;
+
+    /* Parse JCL. */
+    prog = av[0];
+    while ((i = getopt(ac, av, "c:n:t:")) != EOF) {
+        switch (i) {
+        default:
+            usage();
+            break;
+        case 'c':
+            if (strcmp(optarg, "P-256") != 0 && strcmp(optarg, "P-384") != 0)
+                usage();
+            curve = optarg;
+            break;
+        case 'n':
+            if ((maxnum = atoi(optarg)) < 2)
+                usage();
+            break;
+        case 't':
+            if ((msec = atoi(optarg)) < 0)
+                usage();
+            break;
+        }
+    }
+
+    if (curve == NULL || strcmp(curve, "P-256") == 0)
+        sweep(NID_X9_62_prime256v1, "P-256", maxnum, msec / 1000.0);
+    if (curve == NULL || strcmp(curve, "P-384") == 0)
+        sweep(NID_secp384r1, "P-384", maxnum, msec / 1000.0);
+
+    return EXIT_SUCCESS;
+#else
+    fprintf(stderr,
+            "This tool is not supported on this platform for lack of POSIX1.2001 support\n");
+    exit(EXIT_FAILURE);
+#endif
+}
@@ -0,0 +1,161 @@
+/*
+ * Copyright 2024 The OpenSSL Project Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License 2.0 (the "License").  You may not use
+ * this file except in compliance with the License.  You can obtain a copy
+ * in the file LICENSE in the source distribution or at
+ * https://www.openssl.org/source/license.html
+ */
+
+/*
+ * Measures complete TLS 1.3 handshakes between a client and a server in the
+ * same process, connected by a BIO pair, the way ssl_handshake_rtt_test
+ * runs them.  The time per handshake is for both ends together.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <openssl/e_os2.h>
+
+#ifdef OPENSSL_SYS_UNIX
+# include <sys/resource.h>
+# include <openssl/bio.h>
+# include <openssl/err.h>
+# include <openssl/ssl.h>
+# include <internal/e_os.h>
+# if defined(_POSIX_VERSION) && _POSIX_VERSION >= 200112L
+
+static char *prog;
+
+static void die(const char *what)
+{
+    fprintf(stderr, "%s: %s failed\n", prog, what);
+    ERR_print_errors_fp(stderr);
+    exit(EXIT_FAILURE);
+}
+
+static double user_seconds(void)
+{
+    struct rusage ru;
+
+    if (getrusage(RUSAGE_SELF, &ru) < 0) {
+        perror("getrusage");
+        exit(EXIT_FAILURE);
+    }
+    return ru.ru_utime.tv_sec + ru.ru_utime.tv_usec / 1e6;
+}
+
+static SSL_CTX *make_ctx(const SSL_METHOD *meth, const char *groups)
+{
+    SSL_CTX *ctx = SSL_CTX_new(meth);
+
+    if (ctx == NULL
+            || !SSL_CTX_set_min_proto_version(ctx, TLS1_3_VERSION)
+            || !SSL_CTX_set_ciphersuites(ctx, "TLS_AES_128_GCM_SHA256")
+            || !SSL_CTX_set1_groups_list(ctx, groups))
+        die("SSL_CTX_new");
+    /* Each handshake is a full one */
+    SSL_CTX_set_session_cache_mode(ctx, SSL_SESS_CACHE_OFF);
+    SSL_CTX_set_options(ctx, SSL_OP_NO_TICKET);
+    return ctx;
+}
+
+static void handshake(SSL_CTX *cctx, SSL_CTX *sctx)
+{
+    SSL *client = SSL_new(cctx), *server = SSL_new(sctx);
+    BIO *cbio, *sbio;
+    int cdone = 0, sdone = 0, ret;
+
+    if (client == NULL || server == NULL
+            || !BIO_new_bio_pair(&cbio, 0, &sbio, 0))
+        die("SSL_new");
+    SSL_set_bio(client, cbio, cbio);
+    SSL_set_bio(server, sbio, sbio);
+    SSL_set_connect_state(client);
+    SSL_set_accept_state(server);
+
+    while (!cdone || !sdone) {
+        if (!cdone) {
+            if ((ret = SSL_do_handshake(client)) == 1)
+                cdone = 1;
+            else if (SSL_get_error(client, ret) != SSL_ERROR_WANT_READ)
+                die("client handshake");
+        }
+        if (!sdone) {
+            if ((ret = SSL_do_handshake(server)) == 1)
+                sdone = 1;
+            else if (SSL_get_error(server, ret) != SSL_ERROR_WANT_READ)
+                die("server handshake");
+        }
+    }
+    SSL_free(client);
+    SSL_free(server);
+}
+
+static void usage(void)
+{
+    fprintf(stderr, "Usage: %s [flags] cert-file key-file\n", prog);
+    fprintf(stderr, "Flags:\n");
+    fprintf(stderr, "  -c #  Repeat count, default 1000\n");
+    fprintf(stderr, "  -g L  Key exchange groups, default X25519\n");
+    exit(EXIT_FAILURE);
+}
+# endif
+#endif
+
+int main(int ac, char **av)
+{
+#if defined(_POSIX_VERSION) && _POSIX_VERSION >= 200112L
+    int i, count = 1000;
+    const char *groups = "X25519";
+    SSL_CTX *cctx, *sctx;
+    double start, elapsed;
+
+    /* Parse JCL. */
+    prog = av[0];
+    while ((i = getopt(ac, av, "c:g:")) != EOF) {
+        switch (i) {
+        default:
+            usage();
+            break;
+        case 'c':
+            if ((count = atoi(optarg)) <= 0)
+                usage();
+            break;
+        case 'g':
+            groups = optarg;
+            break;
+        }
+    }
+    ac -= optind;
+    av += optind;
+    if (ac != 2)
+        usage();
+
+    cctx = make_ctx(TLS_client_method(), groups);
+    sctx = make_ctx(TLS_server_method(), groups);
+    if (SSL_CTX_use_certificate_chain_file(sctx, av[0]) != 1
+            || SSL_CTX_use_PrivateKey_file(sctx, av[1], SSL_FILETYPE_PEM) != 1)
+        die(av[0]);
+
+    /* Try to prep system cache, etc. */
+    for (i = 10; i > 0; i--)
+        handshake(cctx, sctx);
+
+    start = user_seconds();
+    for (i = count; i > 0; i--)
+        handshake(cctx, sctx);
+    elapsed = user_seconds() - start;
+    printf("%d handshakes %.1f microsec per handshake\n", count,
+           elapsed * 1e6 / count);
+
+    SSL_CTX_free(cctx);
+    SSL_CTX_free(sctx);
+    return EXIT_SUCCESS;
+#else
+    fprintf(stderr,
+            "This tool is not supported on this platform for lack of POSIX1.2001 support\n");
+    exit(EXIT_FAILURE);
+#endif
+}
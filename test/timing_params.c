@@ -0,0 +1,228 @@
+/*
+ * Copyright 2024 The OpenSSL Project Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License 2.0 (the "License").  You may not use
+ * this file except in compliance with the License.  You can obtain a copy
+ * in the file LICENSE in the source distribution or at
+ * https://www.openssl.org/source/license.html
+ */
+
+/*
+ * Measures the calls that hand a few OSSL_PARAMs to a provider context and
+ * do little else: getting and setting cipher context parameters, getting
+ * digest parameters and setting signature context parameters.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <openssl/e_os2.h>
+
+#ifdef OPENSSL_SYS_UNIX
+# include <sys/resource.h>
+# include <openssl/core_names.h>
+# include <openssl/evp.h>
+# include <openssl/err.h>
+# include <openssl/params.h>
+# include <openssl/rsa.h>
+# include <internal/e_os.h>
+# if defined(_POSIX_VERSION) && _POSIX_VERSION >= 200112L
+
+static char *prog;
+static double mintime;
+
+static void die(const char *what)
+{
+    fprintf(stderr, "%s: %s failed\n", prog, what);
+    ERR_print_errors_fp(stderr);
+    exit(EXIT_FAILURE);
+}
+
+static double user_seconds(void)
+{
+    struct rusage ru;
+
+    if (getrusage(RUSAGE_SELF, &ru) < 0) {
+        perror("getrusage");
+        exit(EXIT_FAILURE);
+    }
+    return ru.ru_utime.tv_sec + ru.ru_utime.tv_usec / 1e6;
+}
+
+/* Calls |fn| in batches of 1000 for at least |mintime| seconds */
+static void run(const char *name, int (*fn)(void *), void *arg)
+{
+    double start = user_seconds(), elapsed;
+    long count = 0;
+    int i;
+
+    do {
+        for (i = 0; i < 1000; i++)
+            if (!fn(arg))
+                die(name);
+        count += 1000;
+        elapsed = user_seconds() - start;
+    } while (elapsed < mintime);
+    printf("%-40s %8.1f ns per call\n", name, elapsed * 1e9 / count);
+    fflush(stdout);
+}
+
+static int cipher_get_params(void *arg)
+{
+    size_t keylen, ivlen;
+    unsigned int pad;
+    OSSL_PARAM params[4];
+
+    params[0] = OSSL_PARAM_construct_size_t(OSSL_CIPHER_PARAM_KEYLEN, &keylen);
+    params[1] = OSSL_PARAM_construct_size_t(OSSL_CIPHER_PARAM_IVLEN, &ivlen);
+    params[2] = OSSL_PARAM_construct_uint(OSSL_CIPHER_PARAM_PADDING, &pad);
+    params[3] = OSSL_PARAM_construct_end();
+    return EVP_CIPHER_CTX_get_params(arg, params);
+}
+
+static int cipher_set_padding(void *arg)
+{
+    return EVP_CIPHER_CTX_set_padding(arg, 1);
+}
+
+static int aead_get_tag(void *arg)
+{
+    unsigned char tag[16];
+
+    return EVP_CIPHER_CTX_ctrl(arg, EVP_CTRL_AEAD_GET_TAG, sizeof(tag),
+                               tag) > 0;
+}
+
+static int digest_get_params(void *arg)
+{
+    size_t blocksize, size;
+    int xof;
+    OSSL_PARAM params[4];
+
+    params[0] = OSSL_PARAM_construct_size_t(OSSL_DIGEST_PARAM_BLOCK_SIZE,
+                                            &blocksize);
+    params[1] = OSSL_PARAM_construct_size_t(OSSL_DIGEST_PARAM_SIZE, &size);
+    params[2] = OSSL_PARAM_construct_int(OSSL_DIGEST_PARAM_XOF, &xof);
+    params[3] = OSSL_PARAM_construct_end();
+    return EVP_MD_get_params(arg, params);
+}
+
+static int ecdsa_set_params(void *arg)
+{
+    unsigned int nonce_type = 0;
+    OSSL_PARAM params[2];
+
+    params[0] = OSSL_PARAM_construct_uint(OSSL_SIGNATURE_PARAM_NONCE_TYPE,
+                                          &nonce_type);
+    params[1] = OSSL_PARAM_construct_end();
+    return EVP_PKEY_CTX_set_params(arg, params);
+}
+
+static int rsa_set_params(void *arg)
+{
+    int saltlen = 32;
+    OSSL_PARAM params[3];
+
+    params[0] = OSSL_PARAM_construct_utf8_string(OSSL_SIGNATURE_PARAM_PAD_MODE,
+                                                 OSSL_PKEY_RSA_PAD_MODE_PSS, 0);
+    params[1] = OSSL_PARAM_construct_int(OSSL_SIGNATURE_PARAM_PSS_SALTLEN,
+                                         &saltlen);
+    params[2] = OSSL_PARAM_construct_end();
+    return EVP_PKEY_CTX_set_params(arg, params);
+}
+
+static EVP_CIPHER_CTX *cipher_ctx(const char *name)
+{
+    static const unsigned char key[32], iv[16];
+    EVP_CIPHER *cipher = EVP_CIPHER_fetch(NULL, name, NULL);
+    EVP_CIPHER_CTX *ctx = EVP_CIPHER_CTX_new();
+
+    if (cipher == NULL || ctx == NULL
+            || !EVP_EncryptInit_ex2(ctx, cipher, key, iv, NULL))
+        die(name);
+    EVP_CIPHER_free(cipher);
+    return ctx;
+}
+
+/* Takes over |pkey| */
+static EVP_MD_CTX *sign_ctx(const char *name, EVP_PKEY *pkey,
+                            EVP_PKEY_CTX **pctx)
+{
+    EVP_MD_CTX *ctx = EVP_MD_CTX_new();
+
+    if (pkey == NULL || ctx == NULL
+            || !EVP_DigestSignInit_ex(ctx, pctx, "SHA256", NULL, NULL, pkey,
+                                      NULL))
+        die(name);
+    EVP_PKEY_free(pkey);
+    return ctx;
+}
+
+static void usage(void)
+{
+    fprintf(stderr, "Usage: %s [flags]\n", prog);
+    fprintf(stderr, "Flags:\n");
+    fprintf(stderr, "  -t #  Minimum time per call in milliseconds, default 500\n");
+    exit(EXIT_FAILURE);
+}
+# endif
+#endif
+
+int main(int ac, char **av)
+{
+#if defined(_POSIX_VERSION) && _POSIX_VERSION >= 200112L
+    int i, msec = 500;
+    EVP_CIPHER_CTX *cbc, *chacha;
+    EVP_MD *sha256;
+    EVP_MD_CTX *ecdsa, *rsa;
+    EVP_PKEY_CTX *ecdsa_pctx = NULL, *rsa_pctx = NULL;
+    unsigned char buf[64];
+    int outl;
+
+    /* Parse JCL. */
+    prog = av[0];
+    while ((i = getopt(ac, av, "t:")) != EOF) {
+        switch (i) {
+        default:
+            usage();
+            break;
+        case 't':
+            if ((msec = atoi(optarg)) < 0)
+                usage();
+            break;
+        }
+    }
+    mintime = msec / 1000.0;
+
+    cbc = cipher_ctx("AES-128-CBC");
+    chacha = cipher_ctx("ChaCha20-Poly1305");
+    if (!EVP_EncryptUpdate(chacha, buf, &outl, buf, sizeof(buf))
+            || !EVP_EncryptFinal_ex(chacha, buf, &outl))
+        die("ChaCha20-Poly1305");
+    if ((sha256 = EVP_MD_fetch(NULL, "SHA256", NULL)) == NULL)
+        die("SHA256");
+    ecdsa = sign_ctx("ECDSA", EVP_PKEY_Q_keygen(NULL, NULL, "EC", "P-256"),
+                     &ecdsa_pctx);
+    rsa = sign_ctx("RSA", EVP_PKEY_Q_keygen(NULL, NULL, "RSA", (size_t)2048),
+                   &rsa_pctx);
+
+    run("EVP_CIPHER_CTX_get_params AES-128-CBC", cipher_get_params, cbc);
+    run("EVP_CIPHER_CTX_set_padding AES-128-CBC", cipher_set_padding, cbc);
+    run("EVP_CTRL_AEAD_GET_TAG ChaCha20-Poly1305", aead_get_tag, chacha);
+    run("EVP_MD_get_params SHA256", digest_get_params, sha256);
+    run("EVP_PKEY_CTX_set_params ECDSA", ecdsa_set_params, ecdsa_pctx);
+    run("EVP_PKEY_CTX_set_params RSA-PSS", rsa_set_params, rsa_pctx);
+
+    EVP_MD_CTX_free(rsa);
+    EVP_MD_CTX_free(ecdsa);
+    EVP_MD_free(sha256);
+    EVP_CIPHER_CTX_free(chacha);
+    EVP_CIPHER_CTX_free(cbc);
+    return EXIT_SUCCESS;
+#else
+    fprintf(stderr,
+            "This tool is not supported on this platform for lack of POSIX1.2001 support\n");
+    exit(EXIT_FAILURE);
+#endif
+}
@@ -0,0 +1,155 @@
+/*
+ * Copyright 2024 The OpenSSL Project Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License 2.0 (the "License").  You may not use
+ * this file except in compliance with the License.  You can obtain a copy
+ * in the file LICENSE in the source distribution or at
+ * https://www.openssl.org/source/license.html
+ */
+
+/*
+ * Measures RSA signing with one key shared by 1, 2, 4, ... threads, each
+ * with its own EVP_PKEY_CTX, the way a server signs handshakes.  The rate
+ * is in wall-clock time, so it only grows with the thread count while
+ * there are idle CPUs; on a machine with N CPUs the speedup up to N
+ * threads shows how well signing with a shared key scales.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <openssl/e_os2.h>
+
+#ifdef OPENSSL_SYS_UNIX
+# include <time.h>
+# include <pthread.h>
+# include <openssl/evp.h>
+# include <openssl/err.h>
+# include <internal/e_os.h>
+# if defined(_POSIX_VERSION) && _POSIX_VERSION >= 200112L
+
+static char *prog;
+static EVP_PKEY *pkey;
+static int count;
+
+static void die(const char *what)
+{
+    fprintf(stderr, "%s: %s failed\n", prog, what);
+    ERR_print_errors_fp(stderr);
+    exit(EXIT_FAILURE);
+}
+
+static double wall_seconds(void)
+{
+    struct timespec ts;
+
+    if (clock_gettime(CLOCK_MONOTONIC, &ts) < 0) {
+        perror("clock_gettime");
+        exit(EXIT_FAILURE);
+    }
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static void *signer(void *arg)
+{
+    static const unsigned char tbs[32];
+    unsigned char sig[512];
+    size_t siglen;
+    EVP_PKEY_CTX *ctx = EVP_PKEY_CTX_new_from_pkey(NULL, pkey, NULL);
+    int i;
+
+    if (ctx == NULL || EVP_PKEY_sign_init(ctx) <= 0)
+        die("EVP_PKEY_sign_init");
+    for (i = count; i > 0; i--) {
+        siglen = sizeof(sig);
+        if (EVP_PKEY_sign(ctx, sig, &siglen, tbs, sizeof(tbs)) <= 0)
+            die("EVP_PKEY_sign");
+    }
+    EVP_PKEY_CTX_free(ctx);
+    return NULL;
+}
+
+/* Returns the signatures per second of |n| threads signing together */
+static double run(int n)
+{
+    pthread_t *threads = malloc(n * sizeof(*threads));
+    double start, elapsed;
+    int i;
+
+    if (threads == NULL)
+        die("malloc");
+    start = wall_seconds();
+    for (i = 0; i < n; i++)
+        if (pthread_create(&threads[i], NULL, signer, NULL) != 0)
+            die("pthread_create");
+    for (i = 0; i < n; i++)
+        pthread_join(threads[i], NULL);
+    elapsed = wall_seconds() - start;
+    free(threads);
+    return (double)n * count / elapsed;
+}
+
+static void usage(void)
+{
+    fprintf(stderr, "Usage: %s [flags]\n", prog);
+    fprintf(stderr, "Flags:\n");
+    fprintf(stderr, "  -b #  Key size in bits, default 2048\n");
+    fprintf(stderr, "  -c #  Signatures per thread, default 500\n");
+    fprintf(stderr, "  -t #  Largest thread count, default 8\n");
+    exit(EXIT_FAILURE);
+}
+# endif
+#endif
+
+int main(int ac, char **av)
+{
+#if defined(_POSIX_VERSION) && _POSIX_VERSION >= 200112L
+    int i, n, bits = 2048, maxthreads = 8;
+    double one, rate;
+
+    /* Parse JCL. */
+    prog = av[0];
+    count = 500;
+    while ((i = getopt(ac, av, "b:c:t:")) != EOF) {
+        switch (i) {
+        default:
+            usage();
+            break;
+        case 'b':
+            if ((bits = atoi(optarg)) < 512)
+                usage();
+            break;
+        case 'c':
+            if ((count = atoi(optarg)) <= 0)
+                usage();
+            break;
+        case 't':
+            if ((maxthreads = atoi(optarg)) <= 0)
+                usage();
+            break;
+        }
+    }
+
+    if ((pkey = EVP_PKEY_Q_keygen(NULL, NULL, "RSA", (size_t)bits)) == NULL)
+        die("EVP_PKEY_Q_keygen");
+
+    /* Try to prep system cache, etc. */
+    signer(NULL);
+
+    one = run(1);
+    printf("%2d threads %8.1f signatures per sec\n", 1, one);
+    for (n = 2; n <= maxthreads; n *= 2) {
+        rate = run(n);
+        printf("%2d threads %8.1f signatures per sec, %.2fx\n", n, rate,
+               rate / one);
+    }
+
+    EVP_PKEY_free(pkey);
+    return EXIT_SUCCESS;
+#else
+    fprintf(stderr,
+            "This tool is not supported on this platform for lack of POSIX1.2001 support\n");
+    exit(EXIT_FAILURE);
+#endif
+}
@@ -0,0 +1,159 @@
+/*
+ * Copyright 2024 The OpenSSL Project Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License 2.0 (the "License").  You may not use
+ * this file except in compliance with the License.  You can obtain a copy
+ * in the file LICENSE in the source distribution or at
+ * https://www.openssl.org/source/license.html
+ */
+
+/*
+ * Measures what a short-lived process pays before its first operation:
+ * creating a library context, loading the default provider and fetching a
+ * few algorithms by name.  Each iteration uses a fresh library context.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <openssl/e_os2.h>
+
+#ifdef OPENSSL_SYS_UNIX
+# include <sys/resource.h>
+# include <openssl/crypto.h>
+# include <openssl/evp.h>
+# include <openssl/err.h>
+# include <internal/e_os.h>
+# if defined(_POSIX_VERSION) && _POSIX_VERSION >= 200112L
+
+# ifndef timersub
+/* struct timeval * subtraction; a must be greater than or equal to b */
+#  define timersub(a, b, res)                                         \
+     do {                                                             \
+         (res)->tv_sec = (a)->tv_sec - (b)->tv_sec;                   \
+         if ((a)->tv_usec < (b)->tv_usec) {                           \
+             (res)->tv_usec = (a)->tv_usec + 1000000 - (b)->tv_usec;  \
+             --(res)->tv_sec;                                         \
+         } else {                                                     \
+             (res)->tv_usec = (a)->tv_usec - (b)->tv_usec;            \
+         }                                                            \
+     } while(0)
+# endif
+
+static char *prog;
+
+static void startup(int what)
+{
+    OSSL_LIB_CTX *libctx = OSSL_LIB_CTX_new();
+    EVP_MD *md = NULL;
+    EVP_CIPHER *cipher = NULL;
+    EVP_KEYMGMT *keymgmt = NULL;
+
+    if (libctx == NULL
+            || (md = EVP_MD_fetch(libctx, "SHA256", NULL)) == NULL
+            || (what == 'c'
+                && (cipher = EVP_CIPHER_fetch(libctx, "AES-128-GCM",
+                                              NULL)) == NULL)
+            || (what == 'k'
+                && (keymgmt = EVP_KEYMGMT_fetch(libctx, "RSA",
+                                                NULL)) == NULL)) {
+        ERR_print_errors_fp(stderr);
+        exit(EXIT_FAILURE);
+    }
+    EVP_KEYMGMT_free(keymgmt);
+    EVP_CIPHER_free(cipher);
+    EVP_MD_free(md);
+    OSSL_LIB_CTX_free(libctx);
+}
+
+static void print_timeval(const char *what, struct timeval *tp, int count)
+{
+    long usec = (long)tp->tv_sec * 1000000 + tp->tv_usec;
+
+    printf("%s %d sec %d microsec (%ld microsec per startup)\n", what,
+           (int)tp->tv_sec, (int)tp->tv_usec, usec / count);
+}
+
+static void usage(void)
+{
+    fprintf(stderr, "Usage: %s [flags]\n", prog);
+    fprintf(stderr, "Flags, with the default being '-wd':\n");
+    fprintf(stderr, "  -c #  Repeat count\n");
+    fprintf(stderr, "  -w<T> What to fetch besides SHA256, T is a single character:\n");
+    fprintf(stderr, "          d for nothing else\n");
+    fprintf(stderr, "          c for AES-128-GCM\n");
+    fprintf(stderr, "          k for the RSA key manager\n");
+    exit(EXIT_FAILURE);
+}
+# endif
+#endif
+
+int main(int ac, char **av)
+{
+#if defined(_POSIX_VERSION) && _POSIX_VERSION >= 200112L
+    int i, count = 100, what = 'd';
+    struct rusage start, end, elapsed;
+    struct timeval e_start, e_end, e_elapsed;
+
+    /* Parse JCL. */
+    prog = av[0];
+    while ((i = getopt(ac, av, "c:w:")) != EOF) {
+        switch (i) {
+        default:
+            usage();
+            break;
+        case 'c':
+            if ((count = atoi(optarg)) <= 0)
+                usage();
+            break;
+        case 'w':
+            if (optarg[1] != '\0')
+                usage();
+            switch (*optarg) {
+            default:
+                usage();
+                break;
+            case 'd':
+            case 'c':
+            case 'k':
+                what = *optarg;
+                break;
+            }
+            break;
+        }
+    }
+
+    if (gettimeofday(&e_start, NULL) < 0) {
+        perror("elapsed start");
+        exit(EXIT_FAILURE);
+    }
+    if (getrusage(RUSAGE_SELF, &start) < 0) {
+        perror("start");
+        exit(EXIT_FAILURE);
+    }
+    for (i = count; i > 0; i--)
+        startup(what);
+    if (getrusage(RUSAGE_SELF, &end) < 0) {
+        perror("getrusage");
+        exit(EXIT_FAILURE);
+    }
+    if (gettimeofday(&e_end, NULL) < 0) {
+        perror("gettimeofday");
+        exit(EXIT_FAILURE);
+    }
+
+    timersub(&end.ru_stime, &start.ru_stime, &elapsed.ru_stime);
+    timersub(&end.ru_utime, &start.ru_utime, &elapsed.ru_utime);
+    timersub(&e_end, &e_start, &e_elapsed);
+    print_timeval("user     ", &elapsed.ru_utime, count);
+    print_timeval("sys      ", &elapsed.ru_stime, count);
+    print_timeval("elapsed  ", &e_elapsed, count);
+    printf("max rss   %ld KiB\n", end.ru_maxrss);
+
+    return EXIT_SUCCESS;
+#else
+    fprintf(stderr,
+            "This tool is not supported on this platform for lack of POSIX1.2001 support\n");
+    exit(EXIT_FAILURE);
+#endif
+}
@@ -412,8 +412,117 @@ static int test_handshake_secrets(void)
     return ret;
 }
 
+static size_t hkdf_cache_entries(SSL *s)
+{
+    size_t i, n = 0;
+
+    for (i = 0; i < OSSL_NELEM(s->s3.hkdf_keys); i++)
+        if (s->s3.hkdf_keys[i].secretlen != 0)
+            n++;
+    return n;
+}
+
+/*
+ * Expand |secret| through the connection's HKDF cache and check the result
+ * against the uncached tls13_hkdf_expand_ex(). |hit| says whether the secret
+ * is expected to be in the cache already.
+ */
+static int test_hkdf_expand_one(SSL *s, const EVP_MD *md,
+                                const unsigned char *secret, size_t outlen,
+                                int hit)
+{
+    static const unsigned char label[] = "test label";
+    static const unsigned char data[] = "some context";
+    unsigned char out[128], ref[128];
+    size_t next = s->s3.hkdf_next;
+    size_t entries = hkdf_cache_entries(s);
+
+    if (!TEST_size_t_le(outlen, sizeof(out))
+            || !TEST_true(tls13_hkdf_expand(s, md, secret, label,
+                                            sizeof(label) - 1, data,
+                                            sizeof(data) - 1, out, outlen, 1))
+            || !TEST_true(tls13_hkdf_expand_ex(NULL, NULL, md, secret, label,
+                                               sizeof(label) - 1, data,
+                                               sizeof(data) - 1, ref, outlen,
+                                               0))
+            || !TEST_mem_eq(out, outlen, ref, outlen))
+        return 0;
+
+    if (hit)
+        return TEST_size_t_eq(s->s3.hkdf_next, next)
+            && TEST_size_t_eq(hkdf_cache_entries(s), entries);
+    return TEST_size_t_eq(s->s3.hkdf_next,
+                          (next + 1) % OSSL_NELEM(s->s3.hkdf_keys))
+        && TEST_size_t_eq(hkdf_cache_entries(s),
+                          entries < OSSL_NELEM(s->s3.hkdf_keys) ? entries + 1
+                                                                : entries);
+}
+
+static int test_hkdf_cache(void)
+{
+    SSL_CTX *ctx = NULL;
+    SSL *s = NULL;
+    EVP_MD *sha256 = NULL, *sha3 = NULL, *sha384 = NULL;
+    unsigned char secrets[TLS13_HKDF_CACHE_SIZE + 1][EVP_MAX_MD_SIZE];
+    size_t i;
+    int ret = 0;
+
+    for (i = 0; i < OSSL_NELEM(secrets); i++)
+        memset(secrets[i], (int)i + 1, sizeof(secrets[i]));
+
+    if (!TEST_ptr(ctx = SSL_CTX_new(TLS_method()))
+            || !TEST_ptr(s = SSL_new(ctx))
+            || !TEST_ptr(sha256 = EVP_MD_fetch(NULL, "SHA2-256", NULL))
+            || !TEST_ptr(sha3 = EVP_MD_fetch(NULL, "SHA3-256", NULL))
+            || !TEST_ptr(sha384 = EVP_MD_fetch(NULL, "SHA2-384", NULL)))
+        goto err;
+
+    /* A miss, then hits for the same secret, including a multi-block one */
+    if (!TEST_true(test_hkdf_expand_one(s, sha256, secrets[0], 16, 0))
+            || !TEST_true(test_hkdf_expand_one(s, sha256, secrets[0], 12, 1))
+            || !TEST_true(test_hkdf_expand_one(s, sha256, secrets[0], 100, 1)))
+        goto err;
+
+    /* Same secret bytes and length with another digest must not hit */
+    if (!TEST_true(test_hkdf_expand_one(s, sha3, secrets[0], 32, 0))
+            || !TEST_true(test_hkdf_expand_one(s, sha256, secrets[0], 32, 1))
+            || !TEST_true(test_hkdf_expand_one(s, sha3, secrets[0], 32, 1)))
+        goto err;
+
+    /* A secret differing in its last byte must not hit */
+    memcpy(secrets[1], secrets[0], sizeof(secrets[1]));
+    secrets[1][31] ^= 1;
+    if (!TEST_true(test_hkdf_expand_one(s, sha256, secrets[1], 32, 0))
+            || !TEST_true(test_hkdf_expand_one(s, sha384, secrets[2], 48, 0)))
+        goto err;
+
+    /* Filling the cache evicts the oldest secret, and only that one */
+    if (!TEST_true(test_hkdf_expand_one(s, sha256, secrets[3], 32, 0))
+            || !TEST_true(test_hkdf_expand_one(s, sha3, secrets[0], 32, 1))
+            || !TEST_true(test_hkdf_expand_one(s, sha256, secrets[0], 32, 0))
+            || !TEST_true(test_hkdf_expand_one(s, sha384, secrets[2], 48, 1)))
+        goto err;
+
+    /* Freeing the cache forgets everything */
+    tls13_hkdf_cache_free(s);
+    if (!TEST_size_t_eq(hkdf_cache_entries(s), 0)
+            || !TEST_true(test_hkdf_expand_one(s, sha384, secrets[2], 48, 0))
+            || !TEST_true(test_hkdf_expand_one(s, sha384, secrets[2], 48, 1)))
+        goto err;
+
+    ret = 1;
+ err:
+    EVP_MD_free(sha256);
+    EVP_MD_free(sha3);
+    EVP_MD_free(sha384);
+    SSL_free(s);
+    SSL_CTX_free(ctx);
+    return ret;
+}
+
 int setup_tests(void)
 {
     ADD_TEST(test_handshake_secrets);
+    ADD_TEST(test_hkdf_cache);
     return 1;
 }